@@ -75,7 +75,13 @@ builder.Services.AddDbContextFactory<PrfVfsTestContext>(options =>
 
 // Register SqliteWasm database management service
 var baseHref = new Uri(builder.HostEnvironment.BaseAddress).AbsolutePath;
-builder.Services.AddSqliteWasm(o => o.BaseHref = baseHref);
+// Two snapshot read workers, so every write-then-read test also covers
+// read routing (ReadWorkers_RouteCurrentSnapshotsOnly checks it directly).
+builder.Services.AddSqliteWasm(o =>
+{
+    o.BaseHref = baseHref;
+    o.ReadWorkerCount = 2;
+});
 
 // Register SqliteWasmBlazor.Crypto services (SubtleCrypto + @awasm/noble)
 builder.Services.AddSqliteWasmBlazorCrypto(configure: o => o.BaseHref = baseHref);
@@ -129,6 +129,14 @@ internal class TestFactory
                             "VFS Encryption", diskImportGuidedReject.Name, () => diskImportGuidedReject.RunAsync()));
                     }
 
+                    // Chunked Stream export/import of ciphertext: temporary
+                    // export copy, streamed opaque import with its
+                    // refuse-on-existing and verify-on-write checks.
+                    var encryptedStream = new EncryptedStreamExportImportTest(
+                        prfFactory, databaseService, session);
+                    _entries.Add(new TestEntry(
+                        "VFS Encryption", encryptedStream.Name, () => encryptedStream.RunAsync()));
+
                     // Pure-plain ZIP round-trip — exercises the new
                     // ISqliteWasmDatabaseService.ExportAll/ImportAll batch
                     // primitives on a Plain disk (no encryption involved).
@@ -169,10 +177,10 @@ internal class TestFactory
                         "VFS Encryption", macReject.Name, () => macReject.RunAsync()));
 
                     // Codex audit invariant: EnterEncryptedAsync with a
-                    // non-empty pre-existing pool snapshots every plain
-                    // DB before encrypt-in-place. Happy-path test — the
-                    // rollback branch needs bridge fault-injection,
-                    // tracked separately.
+                    // non-empty pre-existing pool encrypts every plain DB
+                    // in place before the manifest is written. Happy-path
+                    // test — the rollback branch needs bridge
+                    // fault-injection, tracked separately.
                     var preExistingPlain = new VfsEnterEncryptedPreExistingPlainDbTest(
                         prfFactory, databaseService, session);
                     _entries.Add(new TestEntry(
@@ -296,6 +304,10 @@ internal class TestFactory
         Add("Type Marshalling", new CharSingleCharStringTest(factory));
         Add("Type Marshalling", new GuidUtf8ByteArrayTest(factory));
         Add("Type Marshalling", new GuidHasDataSeedQueryTest(factory));
+        Add("Type Marshalling", new ColumnarStorageClassTest(factory));
+        Add("Type Marshalling", new EncodedParameterRoundTripTest(factory));
+        Add("Type Marshalling", new EncodedIndexBindingTest(factory));
+        Add("Type Marshalling", new BlobIncrementalStreamTest(factory));
 
         // JSON Collection Tests
         Add("JSON Collections", new IntListRoundTripTest(factory));
@@ -310,10 +322,23 @@ internal class TestFactory
         Add("CRUD", new BulkInsert100EntitiesTest(factory));
         Add("CRUD", new FTS5SearchTest(factory));
         Add("CRUD", new FTS5SoftDeleteThenClearTest(factory));
+        Add("CRUD", new StatementCacheReuseTest(factory, databaseService));
+        Add("CRUD", new StreamingReaderBatchesTest(factory));
+        Add("CRUD", new SynchronousCommandTest(factory));
+        Add("CRUD", new CommandCancellationTest(factory));
+        Add("CRUD", new CommandTimeoutTest(factory));
+        Add("CRUD", new RequestStatisticsTest(factory, databaseService));
+        Add("CRUD", new BatchExecutionTest(factory));
+        Add("CRUD", new BatchCancellationTest(factory));
+        Add("CRUD", new SaveChangesBatchedTest(factory, databaseService));
+        Add("CRUD", new NativeEngineInProcessTest(factory));
+        Add("CRUD", new ReadWorkerRoutingTest(factory));
+        Add("CRUD", new SaveChangesInterceptorTest(factory));
 
         // Transaction Tests
         Add("Transactions", new TransactionCommitTest(factory));
         Add("Transactions", new TransactionRollbackTest(factory));
+        Add("Transactions", new TransactionLazyBeginTest(factory));
 
         // Relationship Tests (binary(16) Guid keys + one-to-many)
         Add("Relationships", new TodoListCreateWithGuidKeyTest(factory));
@@ -322,6 +347,7 @@ internal class TestFactory
         Add("Relationships", new TodoListCascadeDeleteTest(factory));
         Add("Relationships", new TodoComplexQueryWithJoinTest(factory));
         Add("Relationships", new TodoNullableDateTimeTest(factory));
+        Add("Relationships", new TodoJoinColumnTypesTest(factory));
 
         // Migration Tests (EF Core migrations in WASM/OPFS)
         Add("Migrations", new FreshDatabaseMigrateTest(factory));
@@ -350,6 +376,10 @@ internal class TestFactory
         Add("Import/Export", new RawDatabaseImportWithBackupTest(factory, databaseService));
         Add("Import/Export", new RawDatabaseBackupRestoreOnFailureTest(factory, databaseService));
         Add("Import/Export", new RawDatabaseExportReOpenTest(factory, databaseService));
+        Add("Import/Export", new RawDatabaseOnlineExportTest(factory, databaseService));
+        Add("Import/Export", new RawDatabaseStreamExportImportTest(factory, databaseService));
+        Add("Import/Export", new RawDatabaseStreamImportFailureTest(factory, databaseService));
+        Add("Import/Export", new RawDatabaseParallelZipExportTest(factory, databaseService));
         Add("Import/Export", new RawDatabaseImportIntoNewTest(factory, databaseService));
         Add("Import/Export", new RawDatabaseImportIncompatibleSchemaTest(factory, databaseService));
         Add("Import/Export", new RawDatabaseAutoReOpenAfterImportTest(factory, databaseService));
@@ -22,6 +22,10 @@ public static class TestRegistry
         "Char_SingleCharString",
         "Guid_Utf8ByteArray",
         "Guid_HasDataSeedQuery",
+        "Columnar_MixedStorageClasses",
+        "Encoded_ParameterRoundTrip",
+        "Encoded_IndexBinding",
+        "Blob_IncrementalStream",
 
         // JSON Collections
         "IntList_RoundTrip",
@@ -36,10 +40,23 @@ public static class TestRegistry
         "BulkInsert_100Entities",
         "FTS5_Search",
         "FTS5_SoftDeleteThenClear",
+        "StatementCache_ReusesPreparedStatements",
+        "Reader_StreamingCursorBatches",
+        "Sync_CommandExecution",
+        "Command_CancelInterruptsStatement",
+        "Command_TimeoutInterruptsStatement",
+        "Statistics_RecordsRequestPhases",
+        "Batch_ExecutesInOneRoundTrip",
+        "Batch_CancelInterruptsStatement",
+        "SaveChanges_BatchedAtomic",
+        "NativeEngine_InProcess",
+        "ReadWorkers_RouteCurrentSnapshotsOnly",
+        "SaveChanges_LogsAndIntercepts",
 
         // Transactions
         "Transaction_Commit",
         "Transaction_Rollback",
+        "Transaction_LazyBegin",
 
         // Relationships
         "TodoList_CreateWithGuidKey",
@@ -48,6 +65,7 @@ public static class TestRegistry
         "TodoList_CascadeDelete",
         "Todo_ComplexQueryWithJoin",
         "Todo_NullableDateTime",
+        "Todo_JoinColumnTypes",
 
         // Migrations
         "Migration_FreshDatabaseMigrate",
@@ -79,6 +97,10 @@ public static class TestRegistry
         "ImportRawDatabase_WithBackup",
         "ImportRawDatabase_BackupRestoreOnFailure",
         "ExportRawDatabase_ReOpenAfterExport",
+        "ExportRawDatabase_OnlineKeepsOpen",
+        "ExportImportRawDatabase_Stream",
+        "ImportRawDatabase_StreamFailureKeepsDatabase",
+        "ExportAllDatabases_ParallelZip",
         "ImportRawDatabase_IntoNewDatabase",
         "ImportRawDatabase_IncompatibleSchema",
         "ImportRawDatabase_AutoReOpenAfterImport",
@@ -109,6 +131,7 @@ public static class TestRegistry
         "Synthetic_PrfSeed_EncryptInPlace_PreservesRowsUnderKey",
         "Synthetic_PrfSeed_DecryptInPlace_PreservesRowsAsPlain",
         "Encrypted_ToPlain_ViaLeaveAndExportAll_RoundTrip",
+        "Encrypted_StreamExportImport_RoundTrip",
         "Disk_ExportToPubkey_AsymmetricRoundTrip",
         "Disk_ImportGuided_CrossKeyRoundTrip",
         "Disk_ImportGuided_RejectDoesNotWipePlainDisk",
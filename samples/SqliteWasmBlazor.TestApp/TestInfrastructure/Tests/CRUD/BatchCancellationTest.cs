@@ -0,0 +1,75 @@
+using System.Diagnostics;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// <see cref="SqliteWasmBatch.Cancel"/> on a batch whose second command runs
+/// long: the execution ends with <see cref="OperationCanceledException"/>.
+/// On a cross-origin-isolated host the worker interrupts the command, so
+/// the next query does not wait for it and the atomic batch leaves nothing
+/// behind.
+/// </summary>
+internal class BatchCancellationTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Batch_CancelInterruptsStatement";
+
+    // Runs for several seconds unless interrupted
+    private const string LongQuery =
+        "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 30000000) SELECT count(*) FROM c";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using var command = connection.CreateCommand();
+        command.CommandText = "CREATE TABLE IF NOT EXISTS CancelProbe (Id INTEGER PRIMARY KEY, Name TEXT)";
+        await command.ExecuteNonQueryAsync();
+
+        await using var batch = new SqliteWasmBatch(connection) { Atomic = true };
+        batch.BatchCommands.Add(new SqliteWasmBatchCommand("INSERT INTO CancelProbe (Name) VALUES ('cancelled')"));
+        batch.BatchCommands.Add(new SqliteWasmBatchCommand(LongQuery));
+
+        var execution = batch.ExecuteNonQueryAsync();
+        await Task.Delay(100);
+        batch.Cancel();
+        var cancelledAt = Stopwatch.StartNew();
+
+        try
+        {
+            await execution;
+            throw new InvalidOperationException("Cancelled batch completed instead of being cancelled");
+        }
+        catch (OperationCanceledException)
+        {
+            // Expected
+        }
+
+        command.CommandText = "SELECT COUNT(*) FROM CancelProbe";
+        var count = await command.ExecuteScalarAsync();
+
+        // The interrupt buffer needs the same isolation as the sync channel;
+        // without it the running batch completes in the worker
+        if (SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
+        {
+            if (cancelledAt.ElapsedMilliseconds > 2000)
+            {
+                throw new InvalidOperationException(
+                    $"Query after cancellation waited {cancelledAt.ElapsedMilliseconds} ms; the batch was not interrupted");
+            }
+            if (count is not 0L)
+            {
+                throw new InvalidOperationException("Insert of the interrupted atomic batch was kept");
+            }
+        }
+
+        command.CommandText = "DROP TABLE CancelProbe";
+        await command.ExecuteNonQueryAsync();
+
+        return "OK";
+    }
+}
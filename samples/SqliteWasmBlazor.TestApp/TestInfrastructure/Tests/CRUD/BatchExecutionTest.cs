@@ -0,0 +1,93 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// DbBatch runs DDL, parameterized writes (one with a blob) and a query in
+/// one 'executeBatch' round trip, with
+/// per-command RecordsAffected and the query's rows as the reader's result.
+/// </summary>
+internal class BatchExecutionTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Batch_ExecutesInOneRoundTrip";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        if (!connection.CanCreateBatch)
+        {
+            throw new InvalidOperationException("Connection must support DbBatch");
+        }
+
+        await using var batch = connection.CreateBatch();
+        batch.BatchCommands.Add(new SqliteWasmBatchCommand(
+            "CREATE TABLE IF NOT EXISTS BatchProbe (Id INTEGER PRIMARY KEY, Name TEXT, Data BLOB)"));
+
+        var insert = new SqliteWasmBatchCommand("INSERT INTO BatchProbe (Name, Data) VALUES (@name, @data)");
+        insert.Parameters.Add("@name", "first");
+        insert.Parameters.Add("@data", new byte[] { 1, 2, 3 });
+        batch.BatchCommands.Add(insert);
+
+        var insertMany = new SqliteWasmBatchCommand("INSERT INTO BatchProbe (Name) VALUES (@a), (@b)");
+        insertMany.Parameters.Add("@a", "second");
+        insertMany.Parameters.Add("@b", "third");
+        batch.BatchCommands.Add(insertMany);
+
+        batch.BatchCommands.Add(new SqliteWasmBatchCommand(
+            "SELECT Name, length(Data) FROM BatchProbe ORDER BY Id"));
+
+        await using (var reader = await batch.ExecuteReaderAsync())
+        {
+            var rows = new List<string>();
+            while (await reader.ReadAsync())
+            {
+                rows.Add(reader.IsDBNull(1) ? reader.GetString(0) : $"{reader.GetString(0)}:{reader.GetInt64(1)}");
+            }
+            if (!rows.SequenceEqual(["first:3", "second", "third"]))
+            {
+                throw new InvalidOperationException($"Batch query returned [{string.Join(",", rows)}]");
+            }
+            if (await reader.NextResultAsync())
+            {
+                throw new InvalidOperationException("Batch has only one command with columns");
+            }
+        }
+
+        if (batch.BatchCommands[1].RecordsAffected != 1 || batch.BatchCommands[2].RecordsAffected != 2)
+        {
+            throw new InvalidOperationException(
+                $"RecordsAffected {batch.BatchCommands[1].RecordsAffected}/{batch.BatchCommands[2].RecordsAffected}, expected 1/2");
+        }
+
+        // A failing command aborts the rest and names its position
+        await using var failing = connection.CreateBatch();
+        failing.BatchCommands.Add(new SqliteWasmBatchCommand("DELETE FROM BatchProbe WHERE Name = 'first'"));
+        failing.BatchCommands.Add(new SqliteWasmBatchCommand("INSERT INTO NoSuchTable VALUES (1)"));
+        failing.BatchCommands.Add(new SqliteWasmBatchCommand("DELETE FROM BatchProbe"));
+        try
+        {
+            await failing.ExecuteNonQueryAsync();
+            throw new InvalidOperationException("Batch with a bad command must fail");
+        }
+        catch (Exception ex) when (ex.Message.Contains("Batch command 2 of 3"))
+        {
+        }
+
+        await using var count = connection.CreateCommand();
+        count.CommandText = "SELECT COUNT(*) FROM BatchProbe";
+        if (await count.ExecuteScalarAsync() is not long remaining || remaining != 2)
+        {
+            throw new InvalidOperationException("Commands after the failing one must not run");
+        }
+
+        count.CommandText = "DROP TABLE BatchProbe";
+        await count.ExecuteNonQueryAsync();
+
+        return "OK";
+    }
+}
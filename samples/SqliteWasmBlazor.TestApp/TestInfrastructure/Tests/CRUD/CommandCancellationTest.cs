@@ -0,0 +1,63 @@
+using System.Diagnostics;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// <see cref="SqliteWasmCommand.Cancel"/> on a long-running query: the
+/// execution ends with <see cref="OperationCanceledException"/>. On a
+/// cross-origin-isolated host the worker interrupts the statement, so the
+/// next query does not wait for the cancelled one to finish.
+/// </summary>
+internal class CommandCancellationTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Command_CancelInterruptsStatement";
+
+    // Runs for several seconds unless interrupted
+    private const string LongQuery =
+        "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 30000000) SELECT count(*) FROM c";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using var longCommand = connection.CreateCommand();
+        longCommand.CommandText = LongQuery;
+        longCommand.Priority = SqliteWasmRequestPriority.Background;
+
+        var execution = longCommand.ExecuteScalarAsync();
+        await Task.Delay(100);
+        longCommand.Cancel();
+        var cancelledAt = Stopwatch.StartNew();
+
+        try
+        {
+            await execution;
+            throw new InvalidOperationException("Cancelled query completed instead of being cancelled");
+        }
+        catch (OperationCanceledException)
+        {
+            // Expected
+        }
+
+        await using var command = connection.CreateCommand();
+        command.CommandText = "SELECT 40 + 2";
+        if (await command.ExecuteScalarAsync() is not long answer || answer != 42)
+        {
+            throw new InvalidOperationException("Query after cancellation returned wrong value");
+        }
+
+        // The interrupt buffer needs the same isolation as the sync channel
+        if (SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable && cancelledAt.ElapsedMilliseconds > 2000)
+        {
+            throw new InvalidOperationException(
+                $"Query after cancellation waited {cancelledAt.ElapsedMilliseconds} ms; the statement was not interrupted");
+        }
+
+        return "OK";
+    }
+}
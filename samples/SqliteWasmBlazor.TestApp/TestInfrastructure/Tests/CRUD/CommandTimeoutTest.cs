@@ -0,0 +1,58 @@
+using System.Diagnostics;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// <see cref="SqliteWasmCommand.CommandTimeout"/> applies to asynchronous
+/// execution: a query running past it ends with <see cref="TimeoutException"/>
+/// and, on a cross-origin-isolated host, is interrupted in the worker like a
+/// cancelled one.
+/// </summary>
+internal class CommandTimeoutTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Command_TimeoutInterruptsStatement";
+
+    // Runs for several seconds unless interrupted
+    private const string LongQuery =
+        "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 30000000) SELECT count(*) FROM c";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using var longCommand = connection.CreateCommand();
+        longCommand.CommandText = LongQuery;
+        longCommand.CommandTimeout = 1;
+
+        try
+        {
+            await longCommand.ExecuteScalarAsync();
+            throw new InvalidOperationException("Query completed instead of timing out");
+        }
+        catch (TimeoutException)
+        {
+            // Expected
+        }
+
+        var timedOutAt = Stopwatch.StartNew();
+        await using var command = connection.CreateCommand();
+        command.CommandText = "SELECT 40 + 2";
+        if (await command.ExecuteScalarAsync() is not long answer || answer != 42)
+        {
+            throw new InvalidOperationException("Query after timeout returned wrong value");
+        }
+
+        if (SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable && timedOutAt.ElapsedMilliseconds > 2000)
+        {
+            throw new InvalidOperationException(
+                $"Query after timeout waited {timedOutAt.ElapsedMilliseconds} ms; the statement was not interrupted");
+        }
+
+        return "OK";
+    }
+}
@@ -0,0 +1,49 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// In-process engine. Built with SqliteWasmNativeEngine=true a plain
+/// SqliteConnection executes inside the .NET module; with the default stub
+/// the engine must report unavailable instead of handing out a connection
+/// that silently fails.
+/// </summary>
+internal class NativeEngineInProcessTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "NativeEngine_InProcess";
+
+    public override ValueTask<string?> RunTestAsync()
+    {
+        if (!SqliteWasmNativeEngine.IsAvailable)
+        {
+            try
+            {
+                SqliteWasmNativeEngine.CreateConnection();
+            }
+            catch (InvalidOperationException)
+            {
+                return ValueTask.FromResult<string?>("OK");
+            }
+            throw new InvalidOperationException("CreateConnection must throw when only the stub is linked");
+        }
+
+        using var connection = SqliteWasmNativeEngine.CreateConnection();
+        connection.Open();
+
+        using var command = connection.CreateCommand();
+        command.CommandText = "CREATE TABLE Lookup (Code TEXT PRIMARY KEY, Label TEXT); " +
+                              "INSERT INTO Lookup VALUES ('a', 'Alpha'), ('b', 'Beta');";
+        command.ExecuteNonQuery();
+
+        command.CommandText = "SELECT Label FROM Lookup WHERE Code = $code";
+        command.Parameters.AddWithValue("$code", "b");
+        if (command.ExecuteScalar() as string != "Beta")
+        {
+            throw new InvalidOperationException("In-process lookup returned the wrong row");
+        }
+
+        return ValueTask.FromResult<string?>("OK");
+    }
+}
@@ -0,0 +1,139 @@
+using System.Data.Common;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// Snapshot read workers (<see cref="SqliteWasmOptions.ReadWorkerCount"/>):
+/// a read right after a write sees the write, because the write makes every
+/// reader's copy stale and the read goes to the owning worker. Once writes
+/// stop, reads move to a reader; a statement the reader cannot run falls
+/// back to the owning worker.
+/// </summary>
+/// <remarks>
+/// Where a statement ran is told by <c>pragma_query_only</c>: only a
+/// reader's copy is query-only.
+/// </remarks>
+internal class ReadWorkerRoutingTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "ReadWorkers_RouteCurrentSnapshotsOnly";
+
+    private const string ReaderProbe = "SELECT query_only FROM pragma_query_only";
+
+    // Well past the bridge's 100 ms refresh delay
+    private const int ProbeIntervalMs = 250;
+    private const int ProbeAttempts = 40;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (SqliteWasmWorkerBridge.Instance.ReadWorkerCount == 0)
+        {
+            return "SKIPPED";
+        }
+
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        // Phase 1 — a read right after a write sees it
+        await AddAsync(context, "Routed 1");
+        if (await CountAsync(context, "Routed 1") != 1)
+        {
+            throw new InvalidOperationException("Read right after the first write missed the new row");
+        }
+
+        // Phase 2 — once writes stop, reads run on a reader's copy
+        if (!await WaitForReaderAsync(connection))
+        {
+            throw new InvalidOperationException("No read reached a snapshot reader after writes stopped");
+        }
+        if (await CountAsync(context, "Routed 1") != 1)
+        {
+            throw new InvalidOperationException("Read on the snapshot reader missed the committed row");
+        }
+
+        // Phase 3 — the next write makes the copies stale at once
+        await AddAsync(context, "Routed 2");
+        if (await ScalarAsync(connection, ReaderProbe) != 0)
+        {
+            throw new InvalidOperationException("Read after a write ran on a stale snapshot");
+        }
+        if (await CountAsync(context, "Routed 2") != 1)
+        {
+            throw new InvalidOperationException("Read right after the second write missed the new row");
+        }
+
+        // Phase 4 — a TEMP table exists only on the owning worker's
+        // connection: the reader fails the query, the owning worker runs it
+        await ExecuteAsync(connection, "CREATE TEMP TABLE routing_probe(v INTEGER)");
+        await ExecuteAsync(connection, "INSERT INTO routing_probe VALUES (42)");
+        try
+        {
+            if (!await WaitForReaderAsync(connection))
+            {
+                throw new InvalidOperationException("No read reached a snapshot reader after the TEMP table");
+            }
+            if (await ScalarAsync(connection, "SELECT v FROM routing_probe") != 42)
+            {
+                throw new InvalidOperationException("Fallback to the owning worker returned the wrong value");
+            }
+        }
+        finally
+        {
+            await ExecuteAsync(connection, "DROP TABLE temp.routing_probe");
+        }
+
+        return "OK";
+    }
+
+    private static async Task AddAsync(TodoDbContext context, string title)
+    {
+        context.TodoItems.Add(new TodoItem
+        {
+            Id = Guid.NewGuid(),
+            Title = title,
+            Description = "Read worker routing",
+            UpdatedAt = DateTime.UtcNow
+        });
+        await context.SaveChangesAsync();
+    }
+
+    private static Task<int> CountAsync(TodoDbContext context, string title)
+        => context.TodoItems.AsNoTracking().CountAsync(t => t.Title == title);
+
+    /// <summary>
+    /// Probe until a read runs on a reader. Until then each probe goes to
+    /// the owning worker, which schedules the next snapshot refresh.
+    /// </summary>
+    private static async Task<bool> WaitForReaderAsync(DbConnection connection)
+    {
+        for (var i = 0; i < ProbeAttempts; i++)
+        {
+            if (await ScalarAsync(connection, ReaderProbe) == 1)
+            {
+                return true;
+            }
+            await Task.Delay(ProbeIntervalMs);
+        }
+        return false;
+    }
+
+    private static async Task<long> ScalarAsync(DbConnection connection, string sql)
+    {
+        await using var command = connection.CreateCommand();
+        command.CommandText = sql;
+        return await command.ExecuteScalarAsync() is long value
+            ? value
+            : throw new InvalidOperationException($"'{sql}' returned no integer");
+    }
+
+    private static async Task ExecuteAsync(DbConnection connection, string sql)
+    {
+        await using var command = connection.CreateCommand();
+        command.CommandText = sql;
+        await command.ExecuteNonQueryAsync();
+    }
+}
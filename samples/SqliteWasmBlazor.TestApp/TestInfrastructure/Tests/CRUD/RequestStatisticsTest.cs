@@ -0,0 +1,54 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// <see cref="ISqliteWasmDatabaseService.GetStatistics"/> records every
+/// asynchronous execute with its worker-side and bridge-side phases.
+/// </summary>
+internal class RequestStatisticsTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "Statistics_RecordsRequestPhases";
+
+    private const int Iterations = 5;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        await using var context = await Factory.CreateDbContextAsync();
+        var before = Execute(DatabaseService.GetStatistics());
+
+        for (var i = 0; i < Iterations; i++)
+        {
+            await context.TodoItems.AsNoTracking().CountAsync();
+        }
+
+        var after = Execute(DatabaseService.GetStatistics())
+            ?? throw new InvalidOperationException("No statistics recorded for 'execute'");
+
+        var executed = after.Execute.Count - (before?.Execute.Count ?? 0);
+        var completed = after.Total.Count - (before?.Total.Count ?? 0);
+        if (executed < Iterations || completed < Iterations)
+        {
+            throw new InvalidOperationException(
+                $"Expected at least {Iterations} recorded executes, got {executed} (total {completed})");
+        }
+
+        if (after.Total.MaxMs < after.Total.P50Ms || after.Total.P99Ms < after.Total.P50Ms)
+        {
+            throw new InvalidOperationException(
+                $"Inconsistent percentiles: p50 {after.Total.P50Ms} ms, p99 {after.Total.P99Ms} ms, max {after.Total.MaxMs} ms");
+        }
+
+        return "OK";
+    }
+
+    private static SqliteWasmOperationStatistics? Execute(SqliteWasmStatistics statistics)
+        => statistics.Operations.FirstOrDefault(operation => operation.Operation == "execute");
+}
@@ -0,0 +1,114 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// SaveChanges sends its modifications as one atomic batch: identical
+/// inserts reuse one prepared statement, and a failing command rolls back
+/// the ones before it even without an explicit transaction.
+/// </summary>
+internal class SaveChangesBatchedTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "SaveChanges_BatchedAtomic";
+
+    private const string DbName = "TestDb.db";
+    private const int EntityCount = 1000;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        // EF Core orders inserts into one table by key: the high Id puts the
+        // duplicate after the low-Id insert it has to roll back
+        var existing = new TodoItem
+        {
+            Id = new Guid($"ffffffff{Guid.NewGuid().ToString("N")[8..]}"),
+            Title = "Existing",
+            Description = "Batched SaveChanges",
+            UpdatedAt = DateTime.UtcNow
+        };
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            context.TodoItems.Add(existing);
+            await context.SaveChangesAsync();
+        }
+
+        var before = await DatabaseService.GetStatementCacheStatisticsAsync(DbName);
+        int initialCount;
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            initialCount = await context.TodoItems.CountAsync();
+
+            context.TodoItems.AddRange(Enumerable.Range(1, EntityCount).Select(i => new TodoItem
+            {
+                Id = Guid.NewGuid(),
+                Title = $"Batched {i}",
+                Description = "Batched SaveChanges",
+                UpdatedAt = DateTime.UtcNow
+            }));
+            var saved = await context.SaveChangesAsync();
+            if (saved != EntityCount)
+            {
+                throw new InvalidOperationException($"SaveChanges reported {saved} rows, expected {EntityCount}");
+            }
+        }
+
+        var after = await DatabaseService.GetStatementCacheStatisticsAsync(DbName);
+        if (after.Capacity > 0 && after.Hits - before.Hits < EntityCount - 1)
+        {
+            throw new InvalidOperationException(
+                $"Expected the inserts to share a prepared statement, got {after.Hits - before.Hits} cache hits");
+        }
+
+        // The duplicate key fails after the first insert ran; the savepoint must undo it
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            context.TodoItems.Add(new TodoItem
+            {
+                Id = new Guid($"00000000{Guid.NewGuid().ToString("N")[8..]}"),
+                Title = "Rolled back",
+                Description = "Batched SaveChanges",
+                UpdatedAt = DateTime.UtcNow
+            });
+            context.TodoItems.Add(new TodoItem
+            {
+                Id = existing.Id,
+                Title = "Duplicate",
+                Description = "Batched SaveChanges",
+                UpdatedAt = DateTime.UtcNow
+            });
+
+            try
+            {
+                await context.SaveChangesAsync();
+                throw new InvalidOperationException("SaveChanges with a duplicate key succeeded");
+            }
+            catch (DbUpdateException)
+            {
+            }
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            var count = await context.TodoItems.CountAsync();
+            if (count != initialCount + EntityCount)
+            {
+                throw new InvalidOperationException(
+                    $"Expected {initialCount + EntityCount} items after the failed batch, got {count}");
+            }
+            if (await context.TodoItems.AnyAsync(t => t.Title == "Rolled back"))
+            {
+                throw new InvalidOperationException("Insert before the failing command was not rolled back");
+            }
+        }
+
+        return "OK";
+    }
+}
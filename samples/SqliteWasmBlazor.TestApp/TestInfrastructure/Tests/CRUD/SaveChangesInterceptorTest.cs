@@ -0,0 +1,109 @@
+using System.Data.Common;
+using Microsoft.EntityFrameworkCore;
+using Microsoft.EntityFrameworkCore.Diagnostics;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// SaveChanges keeps EF's command pipeline: without interceptors the
+/// batched path still logs the executed INSERT, and a registered
+/// <see cref="DbCommandInterceptor"/> sees every SaveChanges command.
+/// </summary>
+internal class SaveChangesInterceptorTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "SaveChanges_LogsAndIntercepts";
+
+    private const string ConnectionString = "Data Source=TestDb.db";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        // Phase 1 — the batched path raises CommandExecuted
+        var logged = new List<string>();
+        var loggingOptions = new DbContextOptionsBuilder<TodoDbContext>()
+            .UseSqliteWasm(ConnectionString)
+            .LogTo(logged.Add, [RelationalEventId.CommandExecuted])
+            .Options;
+        await using (var context = new TodoDbContext(loggingOptions))
+        {
+            AddItems(context, "Logged");
+            await context.SaveChangesAsync();
+        }
+        if (!logged.Any(m => m.Contains("INSERT INTO", StringComparison.Ordinal)))
+        {
+            throw new InvalidOperationException($"No executed INSERT logged for SaveChanges ({logged.Count} messages)");
+        }
+
+        // Phase 2 — a command interceptor sees the SaveChanges commands
+        var interceptor = new RecordingInterceptor();
+        var interceptedOptions = new DbContextOptionsBuilder<TodoDbContext>()
+            .UseSqliteWasm(ConnectionString)
+            .AddInterceptors(interceptor)
+            .Options;
+        await using (var context = new TodoDbContext(interceptedOptions))
+        {
+            AddItems(context, "Intercepted");
+            await context.SaveChangesAsync();
+        }
+        if (!interceptor.SaveChangesCommands.Any(sql => sql.Contains("INSERT INTO", StringComparison.Ordinal)))
+        {
+            throw new InvalidOperationException(
+                $"Interceptor saw no SaveChanges INSERT ({interceptor.SaveChangesCommands.Count} commands)");
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            var count = await context.TodoItems.CountAsync(t => t.Title.StartsWith("Logged") || t.Title.StartsWith("Intercepted"));
+            if (count != 6)
+            {
+                throw new InvalidOperationException($"Expected 6 saved items, got {count}");
+            }
+        }
+
+        return "OK";
+    }
+
+    private static void AddItems(TodoDbContext context, string prefix)
+    {
+        for (var i = 0; i < 3; i++)
+        {
+            context.TodoItems.Add(new TodoItem
+            {
+                Id = Guid.NewGuid(),
+                Title = $"{prefix} {i}",
+                Description = "SaveChanges pipeline",
+                UpdatedAt = DateTime.UtcNow
+            });
+        }
+    }
+
+    private sealed class RecordingInterceptor : DbCommandInterceptor
+    {
+        public List<string> SaveChangesCommands { get; } = [];
+
+        public override InterceptionResult<DbDataReader> ReaderExecuting(
+            DbCommand command, CommandEventData eventData, InterceptionResult<DbDataReader> result)
+        {
+            Record(command, eventData);
+            return result;
+        }
+
+        public override ValueTask<InterceptionResult<DbDataReader>> ReaderExecutingAsync(
+            DbCommand command, CommandEventData eventData, InterceptionResult<DbDataReader> result,
+            CancellationToken cancellationToken = default)
+        {
+            Record(command, eventData);
+            return ValueTask.FromResult(result);
+        }
+
+        private void Record(DbCommand command, CommandEventData eventData)
+        {
+            if (eventData.CommandSource == CommandSource.SaveChanges)
+            {
+                SaveChangesCommands.Add(command.CommandText);
+            }
+        }
+    }
+}
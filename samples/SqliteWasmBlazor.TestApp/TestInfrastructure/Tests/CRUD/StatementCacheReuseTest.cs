@@ -0,0 +1,78 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// Re-running the same EF Core query shape must hit the worker's prepared-
+/// statement cache instead of recompiling, and a reused statement must not
+/// leak bindings or rows from the previous execution.
+/// </summary>
+internal class StatementCacheReuseTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "StatementCache_ReusesPreparedStatements";
+
+    private const string DbName = "TestDb.db";
+    private const int Iterations = 10;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        await using var context = await Factory.CreateDbContextAsync();
+
+        var ids = new List<Guid>();
+        for (var i = 0; i < Iterations; i++)
+        {
+            var item = new TodoItem
+            {
+                Id = Guid.NewGuid(),
+                Title = $"Cached {i}",
+                Description = "Statement cache",
+                UpdatedAt = DateTime.UtcNow
+            };
+            context.TodoItems.Add(item);
+            ids.Add(item.Id);
+        }
+        await context.SaveChangesAsync();
+
+        var before = await DatabaseService.GetStatementCacheStatisticsAsync(DbName);
+        if (before.Capacity <= 0)
+        {
+            return "OK"; // Cache disabled via StatementCacheSize = 0 — nothing to assert
+        }
+
+        // Same SQL text every iteration, different parameter values
+        for (var i = 0; i < Iterations; i++)
+        {
+            var id = ids[i];
+            var found = await context.TodoItems.AsNoTracking().SingleOrDefaultAsync(t => t.Id == id);
+            if (found?.Title != $"Cached {i}")
+            {
+                throw new InvalidOperationException(
+                    $"Iteration {i}: expected 'Cached {i}', got '{found?.Title ?? "<null>"}'");
+            }
+        }
+
+        var after = await DatabaseService.GetStatementCacheStatisticsAsync(DbName);
+        var hits = after.Hits - before.Hits;
+        if (hits < Iterations - 1)
+        {
+            throw new InvalidOperationException(
+                $"Expected at least {Iterations - 1} cache hits for a repeated query, got {hits} " +
+                $"(misses {after.Misses - before.Misses})");
+        }
+
+        if (after.Size > after.Capacity)
+        {
+            throw new InvalidOperationException($"Cache size {after.Size} exceeds capacity {after.Capacity}");
+        }
+
+        return "OK";
+    }
+}
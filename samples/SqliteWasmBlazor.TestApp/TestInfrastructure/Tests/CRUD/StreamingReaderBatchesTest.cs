@@ -0,0 +1,95 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// A reader with a batch size streams rows from a worker-side cursor:
+/// every row arrives exactly once across batch boundaries, and disposing a
+/// reader before the end releases the cursor without disturbing later
+/// commands on the same connection.
+/// </summary>
+internal class StreamingReaderBatchesTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Reader_StreamingCursorBatches";
+
+    private const int RowCount = 1000;
+    private const int BatchSize = 128;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+
+        context.TodoItems.AddRange(Enumerable.Range(0, RowCount).Select(i => new TodoItem
+        {
+            Id = Guid.NewGuid(),
+            Title = $"Row {i:D4}",
+            Description = "Streamed",
+            UpdatedAt = DateTime.UtcNow
+        }));
+        await context.SaveChangesAsync();
+
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        // Full scan across several batches
+        await using (var command = connection.CreateCommand())
+        {
+            command.CommandText = "SELECT \"Title\" FROM \"TodoItems\" ORDER BY \"Title\"";
+            ((SqliteWasmCommand)command).ReaderBatchSize = BatchSize;
+
+            await using var reader = await command.ExecuteReaderAsync();
+            var read = 0;
+            while (await reader.ReadAsync())
+            {
+                var expected = $"Row {read:D4}";
+                if (reader.GetString(0) != expected)
+                {
+                    throw new InvalidOperationException($"Row {read}: expected '{expected}', got '{reader.GetString(0)}'");
+                }
+                read++;
+            }
+
+            if (read != RowCount)
+            {
+                throw new InvalidOperationException($"Expected {RowCount} streamed rows, got {read}");
+            }
+        }
+
+        // Abandon a cursor after the first batch
+        await using (var command = connection.CreateCommand())
+        {
+            command.CommandText = "SELECT \"Id\" FROM \"TodoItems\"";
+            ((SqliteWasmCommand)command).ReaderBatchSize = BatchSize;
+
+            await using var reader = await command.ExecuteReaderAsync();
+            for (var i = 0; i < 10; i++)
+            {
+                if (!await reader.ReadAsync())
+                {
+                    throw new InvalidOperationException("Partial read ended early");
+                }
+            }
+        }
+
+        // Connection stays usable, including writes, after the early dispose
+        context.TodoItems.Add(new TodoItem
+        {
+            Id = Guid.NewGuid(),
+            Title = "After cursor",
+            Description = "Streamed",
+            UpdatedAt = DateTime.UtcNow
+        });
+        await context.SaveChangesAsync();
+
+        var count = await context.TodoItems.CountAsync();
+        if (count != RowCount + 1)
+        {
+            throw new InvalidOperationException($"Expected {RowCount + 1} rows after write, got {count}");
+        }
+
+        return "OK";
+    }
+}
@@ -0,0 +1,73 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.CRUD;
+
+/// <summary>
+/// Synchronous ADO.NET calls. With the shared sync channel (cross-origin
+/// isolated host + SynchronousChannelSize) they execute for real; without
+/// it they keep the documented no-op fallbacks and must not reach the worker.
+/// </summary>
+internal class SynchronousCommandTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Sync_CommandExecution";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using var command = connection.CreateCommand();
+        command.CommandText = "SELECT 40 + 2";
+
+        if (!SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
+        {
+            if (command.ExecuteScalar() is not null)
+            {
+                throw new InvalidOperationException("ExecuteScalar without sync channel must return null");
+            }
+            return "OK";
+        }
+
+        if (command.ExecuteScalar() is not long answer || answer != 42)
+        {
+            throw new InvalidOperationException("Sync ExecuteScalar returned wrong value");
+        }
+
+        command.CommandText = "CREATE TABLE IF NOT EXISTS SyncProbe (Id INTEGER PRIMARY KEY, Name TEXT)";
+        command.ExecuteNonQuery();
+
+        using (var transaction = connection.BeginTransaction())
+        {
+            command.Transaction = transaction;
+            command.CommandText = "INSERT INTO SyncProbe (Name) VALUES ('a'), ('b'), ('c')";
+            if (command.ExecuteNonQuery() != 3)
+            {
+                throw new InvalidOperationException("Sync INSERT did not report 3 rows");
+            }
+            transaction.Commit();
+        }
+
+        command.Transaction = null;
+        command.CommandText = "SELECT Name FROM SyncProbe ORDER BY Id";
+        using (var reader = command.ExecuteReader())
+        {
+            var names = new List<string>();
+            while (reader.Read())
+            {
+                names.Add(reader.GetString(0));
+            }
+            if (!names.SequenceEqual(["a", "b", "c"]))
+            {
+                throw new InvalidOperationException($"Sync reader returned [{string.Join(",", names)}]");
+            }
+        }
+
+        command.CommandText = "DROP TABLE SyncProbe";
+        command.ExecuteNonQuery();
+
+        return "OK";
+    }
+}
@@ -6,7 +6,7 @@ namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.ImportExport;
 
 /// <summary>
 /// Tests that the database can be re-opened and used normally after export.
-/// Export closes the DB for a consistent snapshot — this verifies the re-open path.
+/// Covers the re-open path a fresh DbContext takes after an export.
 /// </summary>
 internal class RawDatabaseExportReOpenTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
     : SqliteWasmTest(factory, databaseService)
@@ -33,7 +33,7 @@ internal class RawDatabaseExportReOpenTest(IDbContextFactory<TodoDbContext> fact
             await context.SaveChangesAsync();
         }
 
-        // Export (closes DB)
+        // Export
         var exportedBytes = await DatabaseService.ExportDatabaseAsync(DbName);
 
         if (exportedBytes.Length == 0)
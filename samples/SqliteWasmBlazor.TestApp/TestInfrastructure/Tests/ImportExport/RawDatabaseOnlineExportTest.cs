@@ -0,0 +1,91 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.ImportExport;
+
+/// <summary>
+/// Tests the online export: the database stays open while it is copied,
+/// a query issued during the export completes, and the exported image
+/// holds the data as of the export.
+/// </summary>
+internal class RawDatabaseOnlineExportTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "ExportRawDatabase_OnlineKeepsOpen";
+
+    private const string DbName = "TestDb.db";
+    private const int ItemCount = 500;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        // Enough rows for the backup to take several page steps
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            for (var i = 0; i < ItemCount; i++)
+            {
+                context.TodoItems.Add(new TodoItem
+                {
+                    Id = Guid.NewGuid(), Title = $"Item {i}", Description = new string('x', 1000),
+                    IsCompleted = false, UpdatedAt = DateTime.UtcNow
+                });
+            }
+            await context.SaveChangesAsync();
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            await context.Database.OpenConnectionAsync();
+            var connection = context.Database.GetDbConnection();
+
+            // Query while the export is running
+            var exportTask = DatabaseService.ExportDatabaseAsync(DbName);
+            var countDuringExport = await context.TodoItems.CountAsync();
+            var exportedBytes = await exportTask;
+
+            if (countDuringExport != ItemCount)
+            {
+                throw new InvalidOperationException($"Expected {ItemCount} items during export, got {countDuringExport}");
+            }
+
+            if (exportedBytes.Length < 16 || !exportedBytes.AsSpan(0, 16).SequenceEqual("SQLite format 3\0"u8))
+            {
+                throw new InvalidOperationException("Online export did not return a SQLite database image");
+            }
+
+            if (connection.State != System.Data.ConnectionState.Open)
+            {
+                throw new InvalidOperationException($"Connection should stay open across an online export, was {connection.State}");
+            }
+
+            // Same connection keeps writing without a re-open
+            context.TodoItems.Add(new TodoItem
+            {
+                Id = Guid.NewGuid(), Title = "After Export", Description = "Added on the open connection",
+                IsCompleted = false, UpdatedAt = DateTime.UtcNow
+            });
+            await context.SaveChangesAsync();
+
+            await context.Database.CloseConnectionAsync();
+
+            // The image holds the rows as of the export, not the later write
+            await DatabaseService.ImportDatabaseAsync(DbName, exportedBytes);
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            var count = await context.TodoItems.CountAsync();
+            if (count != ItemCount)
+            {
+                throw new InvalidOperationException($"Expected {ItemCount} items after re-import, got {count}");
+            }
+        }
+
+        return "OK";
+    }
+}
@@ -0,0 +1,104 @@
+using System.IO.Compression;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.ImportExport;
+
+/// <summary>
+/// Tests the worker-compressed ZIP export with several databases: every
+/// entry is readable by <see cref="ZipArchive"/> (CRC-checked on read),
+/// holds a SQLite image of its database, and the archive imports back.
+/// </summary>
+internal class RawDatabaseParallelZipExportTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "ExportAllDatabases_ParallelZip";
+
+    private const string DbName = "TestDb.db";
+    private const int ItemCount = 300;
+    private static readonly string[] Copies = ["ZipCopy1.db", "ZipCopy2.db", "ZipCopy3.db", "ZipCopy4.db", "ZipCopy5.db"];
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            for (var i = 0; i < ItemCount; i++)
+            {
+                context.TodoItems.Add(new TodoItem
+                {
+                    Id = Guid.NewGuid(), Title = $"Item {i}", Description = new string((char)('a' + i % 26), 1000),
+                    IsCompleted = false, UpdatedAt = DateTime.UtcNow
+                });
+            }
+            await context.SaveChangesAsync();
+        }
+
+        // More databases than compression helpers, so entries queue
+        var image = await DatabaseService.ExportDatabaseAsync(DbName);
+        foreach (var copy in Copies)
+        {
+            await DatabaseService.ImportDatabaseAsync(copy, image);
+        }
+
+        try
+        {
+            using var archive = new MemoryStream();
+            await DatabaseService.ExportAllDatabasesAsync(archive);
+
+            archive.Position = 0;
+            using (var zip = new ZipArchive(archive, ZipArchiveMode.Read, leaveOpen: true))
+            {
+                var names = await DatabaseService.ListDatabasesAsync();
+                if (zip.Entries.Count != names.Count)
+                {
+                    throw new InvalidOperationException($"Expected {names.Count} ZIP entries, got {zip.Entries.Count}");
+                }
+
+                foreach (var copy in Copies.Append(DbName))
+                {
+                    var entry = zip.GetEntry(copy) ?? throw new InvalidOperationException($"ZIP has no entry {copy}");
+                    using var data = new MemoryStream();
+                    await using (var entryStream = entry.Open())
+                    {
+                        await entryStream.CopyToAsync(data);
+                    }
+
+                    if (data.Length != image.Length || !data.GetBuffer().AsSpan(0, 16).SequenceEqual("SQLite format 3\0"u8))
+                    {
+                        throw new InvalidOperationException(
+                            $"Entry {copy}: expected a {image.Length}-byte SQLite image, got {data.Length} bytes");
+                    }
+                }
+            }
+
+            archive.Position = 0;
+            var result = await DatabaseService.ImportAllDatabasesAsync(archive);
+            if (result != DiskImportResult.OK)
+            {
+                throw new InvalidOperationException($"ZIP import returned {result}");
+            }
+
+            await using var context = await Factory.CreateDbContextAsync();
+            var count = await context.TodoItems.CountAsync();
+            if (count != ItemCount)
+            {
+                throw new InvalidOperationException($"Expected {ItemCount} items after ZIP import, got {count}");
+            }
+        }
+        finally
+        {
+            foreach (var copy in Copies)
+            {
+                await DatabaseService.DeleteDatabaseAsync(copy);
+            }
+        }
+
+        return "OK";
+    }
+}
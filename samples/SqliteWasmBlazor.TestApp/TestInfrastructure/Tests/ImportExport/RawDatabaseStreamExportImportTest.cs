@@ -0,0 +1,89 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.ImportExport;
+
+/// <summary>
+/// Tests the chunked Stream overloads: a database larger than one chunk is
+/// exported to a stream and imported back from it, then the same round
+/// trip runs through the streamed ZIP archive.
+/// </summary>
+internal class RawDatabaseStreamExportImportTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "ExportImportRawDatabase_Stream";
+
+    private const string DbName = "TestDb.db";
+    private const int ItemCount = 6000;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        // ~6 MB of rows so the transfer spans several chunks
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            for (var i = 0; i < ItemCount; i++)
+            {
+                context.TodoItems.Add(new TodoItem
+                {
+                    Id = Guid.NewGuid(), Title = $"Item {i}", Description = new string((char)('a' + i % 26), 1000),
+                    IsCompleted = i % 2 == 0, UpdatedAt = DateTime.UtcNow
+                });
+            }
+            await context.SaveChangesAsync();
+        }
+
+        using var exported = new MemoryStream();
+        await DatabaseService.ExportDatabaseAsync(DbName, exported);
+        if (exported.Length < 4 * 1024 * 1024)
+        {
+            throw new InvalidOperationException($"Expected a multi-chunk export, got {exported.Length} bytes");
+        }
+
+        await DatabaseService.DeleteDatabaseAsync(DbName);
+        exported.Position = 0;
+        var result = await DatabaseService.ImportDatabaseAsync(DbName, exported);
+        if (result != DiskImportResult.OK)
+        {
+            throw new InvalidOperationException($"Stream import returned {result}");
+        }
+
+        await VerifyItemsAsync("stream import");
+
+        // Same round trip through the incrementally written ZIP archive
+        using var archive = new MemoryStream();
+        await DatabaseService.ExportAllDatabasesAsync(archive);
+        archive.Position = 0;
+        result = await DatabaseService.ImportAllDatabasesAsync(archive);
+        if (result != DiskImportResult.OK)
+        {
+            throw new InvalidOperationException($"Streamed ZIP import returned {result}");
+        }
+
+        await VerifyItemsAsync("streamed ZIP import");
+
+        return "OK";
+    }
+
+    private async Task VerifyItemsAsync(string stage)
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+
+        var count = await context.TodoItems.CountAsync();
+        if (count != ItemCount)
+        {
+            throw new InvalidOperationException($"Expected {ItemCount} items after {stage}, got {count}");
+        }
+
+        var last = await context.TodoItems.FirstOrDefaultAsync(t => t.Title == $"Item {ItemCount - 1}");
+        if (last is null || last.Description.Length != 1000 || last.Description[0] != (char)('a' + (ItemCount - 1) % 26))
+        {
+            throw new InvalidOperationException($"Data mismatch after {stage}");
+        }
+    }
+}
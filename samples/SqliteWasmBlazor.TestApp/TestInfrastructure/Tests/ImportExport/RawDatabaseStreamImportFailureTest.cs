@@ -0,0 +1,118 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.ImportExport;
+
+/// <summary>
+/// A Stream import whose source throws after the first chunk is written:
+/// the chunks went to a temporary file, so the existing database keeps
+/// every row, including one added after the export being imported.
+/// </summary>
+internal class RawDatabaseStreamImportFailureTest(IDbContextFactory<TodoDbContext> factory, ISqliteWasmDatabaseService databaseService)
+    : SqliteWasmTest(factory, databaseService)
+{
+    public override string Name => "ImportRawDatabase_StreamFailureKeepsDatabase";
+
+    private const string DbName = "TestDb.db";
+    private const int ItemCount = 4000;
+
+    // Past the first 2 MB chunk, inside the second
+    private const int FailAfterBytes = 3 * 1024 * 1024;
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        if (DatabaseService is null)
+        {
+            throw new InvalidOperationException("ISqliteWasmDatabaseService not available");
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            for (var i = 0; i < ItemCount; i++)
+            {
+                context.TodoItems.Add(new TodoItem
+                {
+                    Id = Guid.NewGuid(), Title = $"Item {i}", Description = new string('k', 1000),
+                    UpdatedAt = DateTime.UtcNow
+                });
+            }
+            await context.SaveChangesAsync();
+        }
+
+        using var exported = new MemoryStream();
+        await DatabaseService.ExportDatabaseAsync(DbName, exported);
+        if (exported.Length <= FailAfterBytes)
+        {
+            throw new InvalidOperationException($"Expected an export past {FailAfterBytes} bytes, got {exported.Length}");
+        }
+
+        // A row the export does not have: only the original DB carries it
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            context.TodoItems.Add(new TodoItem
+            {
+                Id = Guid.NewGuid(), Title = "After export", Description = "kept", UpdatedAt = DateTime.UtcNow
+            });
+            await context.SaveChangesAsync();
+        }
+
+        try
+        {
+            await DatabaseService.ImportDatabaseAsync(DbName, new FailingStream(exported.ToArray(), FailAfterBytes));
+            throw new InvalidOperationException("Import from a failing stream completed");
+        }
+        catch (IOException)
+        {
+            // Expected: the source's error
+        }
+
+        await using (var context = await Factory.CreateDbContextAsync())
+        {
+            var count = await context.TodoItems.CountAsync();
+            if (count != ItemCount + 1)
+            {
+                throw new InvalidOperationException($"Expected {ItemCount + 1} items after the failed import, got {count}");
+            }
+            if (!await context.TodoItems.AnyAsync(t => t.Title == "After export"))
+            {
+                throw new InvalidOperationException("Row added after the export is gone after the failed import");
+            }
+        }
+
+        return "OK";
+    }
+
+    /// <summary>Serves <c>failAfter</c> bytes of <c>data</c>, then throws.</summary>
+    private sealed class FailingStream(byte[] data, int failAfter) : Stream
+    {
+        private int _position;
+
+        public override bool CanRead => true;
+        public override bool CanSeek => false;
+        public override bool CanWrite => false;
+        public override long Length => throw new NotSupportedException();
+        public override long Position
+        {
+            get => _position;
+            set => throw new NotSupportedException();
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            if (_position >= failAfter)
+            {
+                throw new IOException("Source failed mid-import");
+            }
+            var n = Math.Min(count, failAfter - _position);
+            Array.Copy(data, _position, buffer, offset, n);
+            _position += n;
+            return n;
+        }
+
+        public override void Flush() { }
+        public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+        public override void SetLength(long value) => throw new NotSupportedException();
+        public override void Write(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+    }
+}
@@ -0,0 +1,94 @@
+using System.Data.Common;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.Relationships;
+
+/// <summary>
+/// Column types reported by the reader must come from the executing statement,
+/// not from the first table named in FROM: aliased columns of a JOINed table
+/// and expression columns each get their own affinity.
+/// </summary>
+internal class TodoJoinColumnTypesTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Todo_JoinColumnTypes";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+
+        var listId = Guid.NewGuid();
+        context.TodoLists.Add(new TodoList
+        {
+            Id = listId,
+            Title = "Typed List",
+            IsActive = true,
+            CreatedAt = DateTime.UtcNow
+        });
+        context.Todos.Add(new Todo
+        {
+            Id = Guid.NewGuid(),
+            Title = "Typed Todo",
+            TodoListId = listId,
+            Priority = 3
+        });
+        await context.SaveChangesAsync();
+
+        var connection = context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using var command = connection.CreateCommand();
+        command.CommandText =
+            """
+            SELECT l."Title" AS ListTitle,
+                   l."IsActive" AS Active,
+                   l."Id" AS ListId,
+                   t."Priority" AS TodoPriority,
+                   t."Priority" * 1.5 AS Weighted,
+                   t."DueDate" AS Due
+            FROM "todos" AS t
+            INNER JOIN "todoLists" AS l ON t."TodoListId" = l."Id"
+            """;
+
+        await using var reader = await command.ExecuteReaderAsync();
+        if (!await reader.ReadAsync())
+        {
+            throw new InvalidOperationException("JOIN returned no rows");
+        }
+
+        Expect(reader, 0, "ListTitle", "TEXT");
+        Expect(reader, 1, "Active", "INTEGER");
+        Expect(reader, 2, "ListId", "BLOB");
+        Expect(reader, 3, "TodoPriority", "INTEGER");
+        Expect(reader, 4, "Weighted", "REAL");
+        Expect(reader, 5, "Due", "TEXT");
+
+        if (reader.GetString(0) != "Typed List" || reader.GetInt64(3) != 3 || Math.Abs(reader.GetDouble(4) - 4.5) > 1e-9)
+        {
+            throw new InvalidOperationException("JOIN row values mismatch");
+        }
+
+        if (!reader.IsDBNull(5))
+        {
+            throw new InvalidOperationException("DueDate should be NULL");
+        }
+
+        return "OK";
+    }
+
+    private static void Expect(DbDataReader reader, int ordinal, string name, string type)
+    {
+        if (reader.GetName(ordinal) != name)
+        {
+            throw new InvalidOperationException($"Column {ordinal}: expected name '{name}', got '{reader.GetName(ordinal)}'");
+        }
+
+        if (reader.GetDataTypeName(ordinal) != type)
+        {
+            throw new InvalidOperationException(
+                $"Column '{name}': expected type {type}, got {reader.GetDataTypeName(ordinal)}");
+        }
+    }
+}
@@ -0,0 +1,98 @@
+using System.Data.Common;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.Transactions;
+
+/// <summary>
+/// BEGIN travels with the first command of a transaction: an empty
+/// transaction commits and rolls back without error, rollback discards what
+/// the carrying command wrote, and a first statement that fails still leaves
+/// the transaction open for the commands that follow.
+/// </summary>
+internal class TransactionLazyBeginTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Transaction_LazyBegin";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await ExecuteAsync(connection, null, "DROP TABLE IF EXISTS LazyBeginTest");
+        await ExecuteAsync(connection, null, "CREATE TABLE LazyBeginTest (Id INTEGER PRIMARY KEY)");
+
+        try
+        {
+            // Empty transactions never reach the worker
+            await using (var empty = await connection.BeginTransactionAsync())
+            {
+                await empty.CommitAsync();
+            }
+            await using (var empty = await connection.BeginTransactionAsync())
+            {
+                await empty.RollbackAsync();
+            }
+
+            // The first command carries BEGIN
+            await using (var transaction = await connection.BeginTransactionAsync())
+            {
+                await ExecuteAsync(connection, transaction, "INSERT INTO LazyBeginTest (Id) VALUES (1)");
+                await transaction.RollbackAsync();
+            }
+            await ExpectCountAsync(connection, 0, "after rollback");
+
+            await using (var transaction = await connection.BeginTransactionAsync())
+            {
+                await ExecuteAsync(connection, transaction, "INSERT INTO LazyBeginTest (Id) VALUES (2)");
+                await ExecuteAsync(connection, transaction, "INSERT INTO LazyBeginTest (Id) VALUES (3)");
+                await transaction.CommitAsync();
+            }
+            await ExpectCountAsync(connection, 2, "after commit");
+
+            // A failing first statement must not lose the transaction
+            await using (var transaction = await connection.BeginTransactionAsync())
+            {
+                try
+                {
+                    await ExecuteAsync(connection, transaction, "INSERT INTO NoSuchTable (Id) VALUES (1)");
+                    throw new InvalidOperationException("Insert into a missing table succeeded");
+                }
+                catch (Exception ex) when (ex.Message.Contains("NoSuchTable", StringComparison.OrdinalIgnoreCase))
+                {
+                }
+
+                await ExecuteAsync(connection, transaction, "INSERT INTO LazyBeginTest (Id) VALUES (4)");
+                await transaction.RollbackAsync();
+            }
+            await ExpectCountAsync(connection, 2, "after rollback following a failed first statement");
+        }
+        finally
+        {
+            await ExecuteAsync(connection, null, "DROP TABLE IF EXISTS LazyBeginTest");
+        }
+
+        return "OK";
+    }
+
+    private static async Task ExecuteAsync(DbConnection connection, DbTransaction? transaction, string sql)
+    {
+        await using var command = connection.CreateCommand();
+        command.Transaction = transaction;
+        command.CommandText = sql;
+        await command.ExecuteNonQueryAsync();
+    }
+
+    private static async Task ExpectCountAsync(DbConnection connection, long expected, string stage)
+    {
+        await using var command = connection.CreateCommand();
+        command.CommandText = "SELECT COUNT(*) FROM LazyBeginTest";
+        var count = Convert.ToInt64(await command.ExecuteScalarAsync());
+        if (count != expected)
+        {
+            throw new InvalidOperationException($"Expected {expected} rows {stage}, found {count}");
+        }
+    }
+}
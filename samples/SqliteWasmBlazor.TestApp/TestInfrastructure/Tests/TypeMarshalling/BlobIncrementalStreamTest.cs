@@ -0,0 +1,138 @@
+using System.Data;
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+using SqliteWasmBlazor.Models.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.TypeMarshalling;
+
+/// <summary>
+/// A SequentialAccess reader that selects the row's INTEGER PRIMARY KEY
+/// returns a large BLOB as a <see cref="SqliteWasmBlob"/> instead of its
+/// bytes; the stream reads the value in ranges, a second stream overwrites
+/// a range in place, and a default reader still gets the bytes inline.
+/// </summary>
+internal class BlobIncrementalStreamTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Blob_IncrementalStream";
+
+    private const string Sql = "SELECT \"Id\", \"BlobValue\" FROM \"TypeTests\" WHERE \"Id\" = @id";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        var blob = new byte[3 * 1024 * 1024 + 17];
+        new Random(7).NextBytes(blob);
+
+        var entity = new TypeTestEntity { BlobValue = blob };
+        await using (var writeCtx = await Factory.CreateDbContextAsync())
+        {
+            writeCtx.TypeTests.Add(entity);
+            await writeCtx.SaveChangesAsync();
+        }
+
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        // Deferred: the reader holds a reference, the stream fetches ranges
+        await using (var command = connection.CreateCommand())
+        {
+            command.CommandText = Sql;
+            command.Parameters.Add("@id", entity.Id);
+            await using var reader = await command.ExecuteReaderAsync(CommandBehavior.SequentialAccess);
+            if (!await reader.ReadAsync())
+            {
+                throw new InvalidOperationException("Entity not found");
+            }
+
+            await using var stream = reader.GetStream(1);
+            if (stream is not SqliteWasmBlob)
+            {
+                throw new InvalidOperationException($"Expected SqliteWasmBlob, got {stream.GetType().Name}");
+            }
+            if (stream.Length != blob.Length)
+            {
+                throw new InvalidOperationException($"Stream length {stream.Length}, expected {blob.Length}");
+            }
+
+            var read = new byte[blob.Length];
+            var total = 0;
+            int n;
+            while ((n = await stream.ReadAsync(read.AsMemory(total, Math.Min(256 * 1024, read.Length - total)))) > 0)
+            {
+                total += n;
+            }
+            if (total != blob.Length || !read.AsSpan().SequenceEqual(blob))
+            {
+                throw new InvalidOperationException($"Streamed content mismatch ({total} bytes read)");
+            }
+
+            stream.Seek(-16, SeekOrigin.End);
+            var tail = new byte[32];
+            var tailLength = await stream.ReadAsync(tail);
+            if (tailLength != 16 || !tail.AsSpan(0, 16).SequenceEqual(blob.AsSpan(blob.Length - 16)))
+            {
+                throw new InvalidOperationException($"Tail read returned {tailLength} bytes");
+            }
+
+            var whole = await reader.GetFieldValueAsync<byte[]>(1);
+            if (!whole.AsSpan().SequenceEqual(blob))
+            {
+                throw new InvalidOperationException("GetFieldValueAsync<byte[]> content mismatch");
+            }
+        }
+
+        // In-place write of a range inside the existing value
+        var patch = new byte[64 * 1024];
+        new Random(11).NextBytes(patch);
+        const int patchOffset = 1024 * 1024;
+        await using (var writable = await SqliteWasmBlob.OpenAsync(connection, "TypeTests", "BlobValue", entity.Id))
+        {
+            writable.Position = patchOffset;
+            await writable.WriteAsync(patch);
+
+            var grow = false;
+            try
+            {
+                writable.Seek(0, SeekOrigin.End);
+                await writable.WriteAsync(new byte[1]);
+            }
+            catch (NotSupportedException)
+            {
+                grow = true;
+            }
+            if (!grow)
+            {
+                throw new InvalidOperationException("Writing past the end of the blob should fail");
+            }
+        }
+        patch.CopyTo(blob, patchOffset);
+
+        // Default behavior: bytes inline, GetStream over the received value
+        await using (var command = connection.CreateCommand())
+        {
+            command.CommandText = Sql;
+            command.Parameters.Add("@id", entity.Id);
+            await using var reader = await command.ExecuteReaderAsync();
+            if (!await reader.ReadAsync())
+            {
+                throw new InvalidOperationException("Entity not found after write");
+            }
+
+            await using var stream = reader.GetStream(1);
+            if (stream is SqliteWasmBlob)
+            {
+                throw new InvalidOperationException("Default reader should not defer BLOBs");
+            }
+
+            var read = new byte[blob.Length];
+            await stream.ReadExactlyAsync(read);
+            if (!read.AsSpan().SequenceEqual(blob))
+            {
+                throw new InvalidOperationException("Content after in-place write mismatch");
+            }
+        }
+
+        return "OK";
+    }
+}
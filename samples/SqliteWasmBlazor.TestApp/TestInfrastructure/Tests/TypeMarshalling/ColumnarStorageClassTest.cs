@@ -0,0 +1,79 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.TypeMarshalling;
+
+/// <summary>
+/// The columnar result buffer keeps each cell's own storage class: an
+/// untyped column mixing INTEGER / REAL / TEXT / BLOB / NULL reads back
+/// per row with the right CLR type, and 64-bit integers beyond 2^53 survive
+/// the trip without going through a JS number.
+/// </summary>
+internal class ColumnarStorageClassTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Columnar_MixedStorageClasses";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using var command = connection.CreateCommand();
+        command.CommandText =
+            "SELECT 9007199254740993 AS v UNION ALL " +
+            "SELECT -2.5 UNION ALL " +
+            "SELECT 'héllo 🚀' UNION ALL " +
+            "SELECT x'00FF10' UNION ALL " +
+            "SELECT NULL";
+
+        await using var reader = await command.ExecuteReaderAsync();
+
+        await ReadRowAsync(reader);
+        if (reader.GetFieldType(0) != typeof(long) || reader.GetInt64(0) != 9007199254740993L)
+        {
+            throw new InvalidOperationException($"INTEGER row: got {reader.GetValue(0)} ({reader.GetFieldType(0).Name})");
+        }
+
+        await ReadRowAsync(reader);
+        if (reader.GetFieldType(0) != typeof(double) || reader.GetDouble(0) != -2.5)
+        {
+            throw new InvalidOperationException($"REAL row: got {reader.GetValue(0)} ({reader.GetFieldType(0).Name})");
+        }
+
+        await ReadRowAsync(reader);
+        if (reader.GetFieldType(0) != typeof(string) || reader.GetString(0) != "héllo 🚀")
+        {
+            throw new InvalidOperationException($"TEXT row: got {reader.GetValue(0)} ({reader.GetFieldType(0).Name})");
+        }
+
+        await ReadRowAsync(reader);
+        var blob = reader.GetFieldValue<byte[]>(0);
+        if (!blob.SequenceEqual(new byte[] { 0x00, 0xFF, 0x10 }) || reader.GetBytes(0, 0, null, 0, 0) != 3)
+        {
+            throw new InvalidOperationException($"BLOB row: got {Convert.ToHexString(blob)}");
+        }
+
+        await ReadRowAsync(reader);
+        if (!reader.IsDBNull(0) || reader.GetValue(0) is not DBNull)
+        {
+            throw new InvalidOperationException($"NULL row: got {reader.GetValue(0)}");
+        }
+
+        if (await reader.ReadAsync())
+        {
+            throw new InvalidOperationException("Expected exactly 5 rows");
+        }
+
+        return "OK";
+    }
+
+    private static async Task ReadRowAsync(System.Data.Common.DbDataReader reader)
+    {
+        if (!await reader.ReadAsync())
+        {
+            throw new InvalidOperationException("Result ended early");
+        }
+    }
+}
@@ -0,0 +1,90 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.TypeMarshalling;
+
+/// <summary>
+/// The worker binds encoded parameters by statement index: a name used
+/// twice binds once, a name added without prefix finds its <c>:name</c>
+/// placeholder, integers on both sides of the 32-bit boundary keep their
+/// value, and empty TEXT / BLOB stay distinct from NULL — for single
+/// commands and for batch commands alike.
+/// </summary>
+internal class EncodedIndexBindingTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Encoded_IndexBinding";
+
+    private const string Sql =
+        "SELECT @v + @v, :bare, @small, @large, typeof(@text), length(@text), typeof(@blob), length(@blob)";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        await using (var command = connection.CreateCommand())
+        {
+            command.CommandText = Sql;
+            AddParameters(command.Parameters);
+            await using var reader = await command.ExecuteReaderAsync();
+            await VerifyAsync(reader, "command");
+        }
+
+        await using (var batch = connection.CreateBatch())
+        {
+            for (var i = 0; i < 2; i++)
+            {
+                var batchCommand = new SqliteWasmBatchCommand(Sql);
+                AddParameters(batchCommand.Parameters);
+                batch.BatchCommands.Add(batchCommand);
+            }
+
+            await using var reader = await batch.ExecuteReaderAsync();
+            await VerifyAsync(reader, "batch command 1");
+            if (!await reader.NextResultAsync())
+            {
+                throw new InvalidOperationException("Second batch result missing");
+            }
+            await VerifyAsync(reader, "batch command 2");
+        }
+
+        return "OK";
+    }
+
+    private static void AddParameters(SqliteWasmParameterCollection parameters)
+    {
+        parameters.Add("@v", 21);
+        parameters.Add("bare", "no prefix");
+        parameters.Add("@small", (long)int.MinValue);
+        parameters.Add("@large", (long)int.MaxValue + 1);
+        parameters.Add("@text", string.Empty);
+        parameters.Add("@blob", Array.Empty<byte>());
+    }
+
+    private static async Task VerifyAsync(System.Data.Common.DbDataReader reader, string source)
+    {
+        if (!await reader.ReadAsync())
+        {
+            throw new InvalidOperationException($"{source}: no row returned");
+        }
+
+        if (reader.GetInt64(0) != 42 || reader.GetString(1) != "no prefix")
+        {
+            throw new InvalidOperationException($"{source}: repeated / unprefixed parameters came back as {reader.GetValue(0)} / {reader.GetValue(1)}");
+        }
+        if (reader.GetInt64(2) != int.MinValue || reader.GetInt64(3) != (long)int.MaxValue + 1)
+        {
+            throw new InvalidOperationException($"{source}: integers came back as {reader.GetValue(2)} / {reader.GetValue(3)}");
+        }
+        if (reader.GetString(4) != "text" || reader.GetInt64(5) != 0)
+        {
+            throw new InvalidOperationException($"{source}: empty text came back as {reader.GetValue(4)} ({reader.GetValue(5)})");
+        }
+        if (reader.GetString(6) != "blob" || reader.GetInt64(7) != 0)
+        {
+            throw new InvalidOperationException($"{source}: empty blob came back as {reader.GetValue(6)} ({reader.GetValue(7)})");
+        }
+    }
+}
@@ -0,0 +1,71 @@
+using Microsoft.EntityFrameworkCore;
+using SqliteWasmBlazor.Models;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.Tests.TypeMarshalling;
+
+/// <summary>
+/// Command parameters travel in the binary request encoding: each value
+/// binds with its own storage class, 64-bit integers beyond 2^53 stay
+/// INTEGER, TEXT needing JSON escapes and BLOBs arrive byte-exact, and an
+/// unencodable value type still works through the JSON fallback.
+/// </summary>
+internal class EncodedParameterRoundTripTest(IDbContextFactory<TodoDbContext> factory)
+    : SqliteWasmTest(factory)
+{
+    public override string Name => "Encoded_ParameterRoundTrip";
+
+    public override async ValueTask<string?> RunTestAsync()
+    {
+        await using var context = await Factory.CreateDbContextAsync();
+        var connection = (SqliteWasmConnection)context.Database.GetDbConnection();
+        await connection.OpenAsync();
+
+        const long bigInteger = 9007199254740993L;
+        const string text = "quote \" backslash \\ newline \n tab \t 🚀";
+        var blob = new byte[] { 0x00, 0x22, 0x5C, 0xFF };
+
+        await using var command = connection.CreateCommand();
+        command.CommandText =
+            "SELECT @i, typeof(@i), @r, @t, @b, typeof(@n), @flag, @c";
+        command.Parameters.Add("@i", bigInteger);
+        command.Parameters.Add("@r", 0.1);
+        command.Parameters.Add("@t", text);
+        command.Parameters.Add("@b", blob);
+        command.Parameters.Add("@n", DBNull.Value);
+        command.Parameters.Add("@flag", true);
+        command.Parameters.Add("@c", 'x');
+
+        await using var reader = await command.ExecuteReaderAsync();
+        if (!await reader.ReadAsync())
+        {
+            throw new InvalidOperationException("No row returned");
+        }
+
+        if (reader.GetInt64(0) != bigInteger || reader.GetString(1) != "integer")
+        {
+            throw new InvalidOperationException($"Integer parameter came back as {reader.GetValue(0)} ({reader.GetString(1)})");
+        }
+        if (reader.GetDouble(2) != 0.1)
+        {
+            throw new InvalidOperationException($"Real parameter came back as {reader.GetDouble(2)}");
+        }
+        if (reader.GetString(3) != text)
+        {
+            throw new InvalidOperationException($"Text parameter came back as '{reader.GetString(3)}'");
+        }
+        if (!reader.GetFieldValue<byte[]>(4).SequenceEqual(blob))
+        {
+            throw new InvalidOperationException("Blob parameter did not round-trip");
+        }
+        if (reader.GetString(5) != "null" || reader.GetInt64(6) != 1)
+        {
+            throw new InvalidOperationException($"Null/bool parameters came back as {reader.GetString(5)} / {reader.GetValue(6)}");
+        }
+        if (reader.GetString(7) != "x")
+        {
+            throw new InvalidOperationException($"Fallback char parameter came back as '{reader.GetValue(7)}'");
+        }
+
+        return "OK";
+    }
+}
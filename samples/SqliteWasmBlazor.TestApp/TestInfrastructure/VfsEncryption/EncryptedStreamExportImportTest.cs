@@ -0,0 +1,146 @@
+using System.Security.Cryptography;
+using Microsoft.EntityFrameworkCore;
+
+namespace SqliteWasmBlazor.TestApp.TestInfrastructure.VfsEncryption;
+
+/// <summary>
+/// Chunked <see cref="ISqliteWasmDatabaseService.ExportDatabaseAsync(string, Stream, CancellationToken)"/>
+/// / <see cref="ISqliteWasmDatabaseService.ImportDatabaseAsync(string, Stream, CancellationToken)"/>
+/// on an Encrypted+Unlocked disk. The database spans several 2 MB chunks,
+/// so the ciphertext goes through the temporary export copy and the
+/// streamed opaque import rather than one buffer.
+///
+/// <para>
+/// Validates: the exported stream is slot-format ciphertext (no SQLite
+/// header); importing it over the existing DB is refused; after a delete
+/// it imports back with every row; a stream with a flipped byte in slot 0
+/// fails verify-on-write and leaves no DB behind.
+/// </para>
+/// </summary>
+internal sealed class EncryptedStreamExportImportTest
+{
+    private const int RowCount = 600;
+    private const int PayloadLength = 4000;
+
+    private readonly IDbContextFactory<PrfVfsTestContext> _factory;
+    private readonly ISqliteWasmDatabaseService _databaseService;
+    private readonly IEncryptedSqliteWasmDatabaseService _session;
+
+    public string Name => "Encrypted_StreamExportImport_RoundTrip";
+
+    public EncryptedStreamExportImportTest(
+        IDbContextFactory<PrfVfsTestContext> factory,
+        ISqliteWasmDatabaseService databaseService,
+        IEncryptedSqliteWasmDatabaseService session)
+    {
+        _factory = factory;
+        _databaseService = databaseService;
+        _session = session;
+    }
+
+    public async ValueTask<string?> RunAsync()
+    {
+        var dbName = PrfVfsTestContext.DatabaseName;
+        await CleanupAsync();
+
+        var k = new byte[32];
+        for (var i = 0; i < 32; i++) { k[i] = (byte)(0xa0 + i); }
+
+        try
+        {
+            // Phase 1 — encrypt + populate past one stream chunk.
+            await _session.EnterEncryptedAsync(k, "test-credential-id-encrypted-stream");
+            await using (var ctx = await _factory.CreateDbContextAsync())
+            {
+                await ctx.Database.EnsureCreatedAsync();
+                for (var i = 0; i < RowCount; i++)
+                {
+                    ctx.Items.Add(new VfsTestItem
+                    {
+                        Marker = $"stream-{i}",
+                        Payload = new string((char)('a' + i % 26), PayloadLength),
+                    });
+                }
+                await ctx.SaveChangesAsync();
+            }
+
+            // Phase 2 — stream the ciphertext out.
+            using var exported = new MemoryStream();
+            await _databaseService.ExportDatabaseAsync(dbName, exported);
+            var bytes = exported.ToArray();
+            if (bytes.Length < 3 * 1024 * 1024 || bytes.Length % 4124 != 0)
+            {
+                return $"FAIL: expected multi-chunk slot-format ciphertext, got {bytes.Length} bytes";
+            }
+            if (bytes.AsSpan(0, 15).SequenceEqual("SQLite format 3"u8))
+            {
+                return "FAIL: encrypted export carries a plain SQLite header";
+            }
+
+            // Phase 3 — refuse-on-existing holds for the streamed import.
+            var overExisting = await _databaseService.ImportDatabaseAsync(dbName, new MemoryStream(bytes));
+            if (overExisting != DiskImportResult.EXISTING_DB_REFUSED)
+            {
+                return $"FAIL: import over existing DB expected EXISTING_DB_REFUSED, got {overExisting}";
+            }
+
+            // Phase 4 — verify-on-write rejects tampered ciphertext.
+            await _databaseService.DeleteDatabaseAsync(dbName);
+            var tampered = (byte[])bytes.Clone();
+            tampered[100] ^= 0x01;
+            var tamperedOutcome = await _databaseService.ImportDatabaseAsync(dbName, new MemoryStream(tampered));
+            if (tamperedOutcome != DiskImportResult.WRONG_KEY)
+            {
+                return $"FAIL: tampered import expected WRONG_KEY, got {tamperedOutcome}";
+            }
+            if ((await _databaseService.ListDatabasesAsync()).Contains(dbName))
+            {
+                return "FAIL: rejected import left a DB behind";
+            }
+
+            // Phase 5 — the intact stream imports back.
+            var outcome = await _databaseService.ImportDatabaseAsync(dbName, new MemoryStream(bytes));
+            if (outcome != DiskImportResult.OK)
+            {
+                return $"FAIL: stream import expected OK, got {outcome}";
+            }
+
+            await using (var ctx = await _factory.CreateDbContextAsync())
+            {
+                var rows = await ctx.Items.OrderBy(x => x.Id).ToListAsync();
+                if (rows.Count != RowCount)
+                {
+                    return $"FAIL: expected {RowCount} rows after stream import, got {rows.Count}";
+                }
+                for (var i = 0; i < RowCount; i++)
+                {
+                    if (rows[i].Marker != $"stream-{i}" || rows[i].Payload.Length != PayloadLength)
+                    {
+                        return $"FAIL: row {i} mismatch (Marker '{rows[i].Marker}')";
+                    }
+                }
+            }
+
+            return "OK";
+        }
+        finally
+        {
+            await CleanupAsync();
+            CryptographicOperations.ZeroMemory(k);
+        }
+    }
+
+    private async Task CleanupAsync()
+    {
+        try { await _session.ResetDiskAsync(); } catch { }
+        try
+        {
+            var names = await _databaseService.ListDatabasesAsync();
+            foreach (var n in names)
+            {
+                try { await _databaseService.DeleteDatabaseAsync(n); } catch { }
+            }
+        }
+        catch { }
+    }
+}
@@ -5,19 +5,17 @@ namespace SqliteWasmBlazor.TestApp.TestInfrastructure.VfsEncryption;
 
 /// <summary>
 /// Codex audit invariant: <c>EnterEncryptedAsync</c> with a non-empty
-/// pre-existing pool snapshots every plain DB <i>before</i> encrypt-in-place,
-/// then stamps the manifest, then verifies. The snapshot exists to
-/// power the rollback path; this test exercises the <i>happy path</i>
-/// across the new orchestration to confirm pre-existing rows survive
-/// the encrypt-in-place transition and the snapshot copy doesn't
-/// corrupt the source.
+/// pre-existing pool encrypts every plain DB in place, then stamps the
+/// manifest, then verifies. This test exercises the <i>happy path</i>
+/// to confirm pre-existing rows survive the chunked encrypt-in-place
+/// transition.
 ///
 /// <para>
 /// <b>What this covers (and doesn't).</b> Pre-existing Plain rows are
-/// readable as encrypted rows post-transition: snapshot → encrypt →
+/// readable as encrypted rows post-transition: encrypt in place →
 /// manifest write → verify-MAC under the same key. The <i>rollback</i>
 /// branch (Phase 1 / 2 / 3 throws → <c>RollBackEnterEncryptedAsync</c>
-/// restores plaintext from <c>backups</c>) requires fault injection at
+/// decrypts in place with the same key) requires fault injection at
 /// the worker bridge — out of scope here. A bridge-decorator-based
 /// fault-injection harness would close the gap; left as a follow-up.
 /// </para>
@@ -55,8 +53,8 @@ internal sealed class VfsEnterEncryptedPreExistingPlainDbTest
         {
             // Phase 1 — populate the Plain disk with deterministic rows.
             // No EnterEncryptedAsync yet — the pool is intentionally not
-            // empty when Phase 2 runs, so the snapshot loop has DBs to
-            // copy.
+            // empty when Phase 2 runs, so the encrypt loop has DBs to
+            // convert.
             await using (var ctx = await _factory.CreateDbContextAsync())
             {
                 await ctx.Database.EnsureCreatedAsync();
@@ -81,11 +79,11 @@ internal sealed class VfsEnterEncryptedPreExistingPlainDbTest
             var listBefore = await _databaseService.ListDatabasesAsync();
             if (!listBefore.Contains(dbName))
             {
-                return $"FAIL[phase1]: pool must contain '{dbName}' to exercise the snapshot loop, got [{string.Join(',', listBefore)}]";
+                return $"FAIL[phase1]: pool must contain '{dbName}' to exercise the encrypt loop, got [{string.Join(',', listBefore)}]";
             }
 
             // Phase 2 — EnterEncryptedAsync on a non-empty pool.
-            // Codex's flow: Phase 0 snapshot → Phase 1 encrypt-in-place
+            // Codex's flow: Phase 1 encrypt-in-place
             // → Phase 2 install key → Phase 3 write+verify manifest.
             await _session.EnterEncryptedAsync(key, CredentialId);
 
@@ -100,9 +98,9 @@ internal sealed class VfsEnterEncryptedPreExistingPlainDbTest
             }
 
             // Phase 3 — pre-existing rows must be readable through the
-            // encrypted hot path. If the snapshot phase corrupted the
-            // source, or encrypt-in-place dropped pages, row count would
-            // be off or payloads would mismatch.
+            // encrypted hot path. If encrypt-in-place dropped or
+            // overwrote pages, row count would be off or payloads would
+            // mismatch.
             List<VfsTestItem> rows;
             await using (var ctx = await _factory.CreateDbContextAsync())
             {
@@ -79,6 +79,56 @@ public enum DiskImportResult
     EXISTING_DB_REFUSED = 2,
 }
 
+/// <summary>
+/// Snapshot of the worker's prepared-statement cache for one database,
+/// returned by <see cref="ISqliteWasmDatabaseService.GetStatementCacheStatisticsAsync"/>.
+/// Counters accumulate from the first execute after the database was opened
+/// and reset when it is closed.
+/// </summary>
+/// <param name="Hits">Executions that reused a cached prepared statement.</param>
+/// <param name="Misses">Executions that had to compile the SQL.</param>
+/// <param name="Size">Statements currently held in the cache.</param>
+/// <param name="Capacity">Configured <see cref="SqliteWasmOptions.StatementCacheSize"/>.</param>
+public sealed record SqliteWasmStatementCacheStatistics(long Hits, long Misses, int Size, int Capacity);
+
+/// <summary>
+/// Latency distribution of one request phase, in milliseconds. Percentiles
+/// come from exponential buckets, so they are upper bounds within a factor
+/// of √2, capped at <paramref name="MaxMs"/>.
+/// </summary>
+public sealed record SqliteWasmLatencyStatistics(long Count, double MeanMs, double P50Ms, double P95Ms, double P99Ms, double MaxMs);
+
+/// <summary>
+/// Latency of one worker request type, split into the phases it passes
+/// through. The three worker phases are measured in the worker, the rest
+/// in the bridge.
+/// </summary>
+/// <param name="Operation">Worker request type (<c>execute</c>, <c>executeBatch</c>, <c>fetch</c>, <c>open</c>, ...).</param>
+/// <param name="QueueWait">Worker: waiting behind other requests (see <see cref="SqliteWasmRequestPriority"/>).</param>
+/// <param name="Execute">Worker: SQLite work, including building the result rows.</param>
+/// <param name="Serialize">Worker: finishing the response payload.</param>
+/// <param name="Transfer">Posting to the worker and back, plus .NET scheduling — what remains of <paramref name="Total"/>.</param>
+/// <param name="Deserialize">.NET: decoding the response.</param>
+/// <param name="Total">Send to decoded response. Transfer and total are missing (count 0) for requests whose send time the bridge does not track.</param>
+public sealed record SqliteWasmOperationStatistics(
+    string Operation,
+    SqliteWasmLatencyStatistics QueueWait,
+    SqliteWasmLatencyStatistics Execute,
+    SqliteWasmLatencyStatistics Serialize,
+    SqliteWasmLatencyStatistics Transfer,
+    SqliteWasmLatencyStatistics Deserialize,
+    SqliteWasmLatencyStatistics Total);
+
+/// <summary>
+/// Request latency since startup, returned by
+/// <see cref="ISqliteWasmDatabaseService.GetStatistics"/>, one entry per
+/// request type in name order. The same measurements are published as
+/// histograms on the <c>SqliteWasmBlazor</c> <see cref="System.Diagnostics.Metrics.Meter"/>.
+/// Synchronous commands answer through the shared channel and are not
+/// included.
+/// </summary>
+public sealed record SqliteWasmStatistics(IReadOnlyList<SqliteWasmOperationStatistics> Operations);
+
 /// <summary>
 /// Plain SQLite database management on OPFS. Single-DB ops (Exists / Delete
 /// / Rename / Close / Import / Export native <c>.db</c>), the pool-wide
@@ -174,13 +224,38 @@ public interface ISqliteWasmDatabaseService
     Task<DiskImportResult> ImportDatabaseAsync(string databaseName, byte[] data,
         CancellationToken cancellationToken = default);
 
+    /// <summary>
+    /// Chunked variant of <see cref="ImportDatabaseAsync(string, byte[], CancellationToken)"/>:
+    /// <paramref name="source"/> is read in chunks of a few MB, each
+    /// written to a temporary OPFS file as it arrives, so the file is never
+    /// held whole on either side. As with the byte[] overload an existing
+    /// plain DB at the path is overwritten, but only once the last chunk is
+    /// on disk: until then the DB stays open and unchanged, and a failed or
+    /// cancelled import leaves it as it was. The temporary file takes one
+    /// extra pool slot while the import runs.
+    ///
+    /// <para>
+    /// Ciphertext (no SQLite header) is detected from the first chunk and
+    /// gets the byte[] overload's checks: an existing DB at the path is
+    /// refused before anything is written, and slot 0 is AEAD-tested before
+    /// the file takes the path.
+    /// </para>
+    /// </summary>
+    /// <param name="databaseName">The database filename (e.g., "mydb.db").</param>
+    /// <param name="source">Read from its current position to the end; not disposed.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    Task<DiskImportResult> ImportDatabaseAsync(string databaseName, Stream source,
+        CancellationToken cancellationToken = default);
+
     /// <summary>
     /// Exports a single database as raw native SQLite bytes — equivalent
     /// to dumping the on-disk file. Plain DBs return standard SQLite pages
     /// (<c>sqlite3 file.db</c> opens them); encrypted DBs return slot-format
     /// ciphertext under the active globalKey (only re-importable on a disk
-    /// holding the same key). The worker closes the DB before exporting
-    /// for a consistent snapshot — caller must re-open afterwards.
+    /// holding the same key). Plain DBs that are open are copied with an
+    /// online backup that yields between page steps, so the DB stays open
+    /// and queries keep running during the export; encrypted DBs are closed
+    /// first for a consistent slot snapshot and re-open on the next query.
     ///
     /// <para>
     /// For batch (multi-DB) export, use <see cref="ExportAllDatabasesAsync"/>
@@ -194,6 +269,28 @@ public interface ISqliteWasmDatabaseService
     Task<byte[]> ExportDatabaseAsync(string databaseName,
         CancellationToken cancellationToken = default);
 
+    /// <summary>
+    /// Chunked variant of <see cref="ExportDatabaseAsync(string, CancellationToken)"/>:
+    /// the same bytes, written to <paramref name="destination"/> in chunks
+    /// of a few MB as the worker reads them. Neither the worker nor .NET
+    /// holds the whole database at once, so large databases export without
+    /// a matching peak in the WASM heap.
+    ///
+    /// <para>
+    /// Plain DBs are snapshotted online into a temporary OPFS file that is
+    /// removed when the export completes; the DB stays open and writable
+    /// and the stream contains it as of the snapshot. Encrypted DBs are
+    /// closed and their slot-format ciphertext is copied, a chunk at a
+    /// time, to a temporary OPFS file that the export reads back in
+    /// ranges.
+    /// </para>
+    /// </summary>
+    /// <param name="databaseName">The database filename (e.g., "mydb.db").</param>
+    /// <param name="destination">Written from its current position; not disposed.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    Task ExportDatabaseAsync(string databaseName, Stream destination,
+        CancellationToken cancellationToken = default);
+
     /// <summary>
     /// Plain (non-encrypted) row import from a V2 MessagePack payload built
     /// via <c>MessagePackFileHeaderV2</c>. Worker streams rows into the
@@ -223,9 +320,11 @@ public interface ISqliteWasmDatabaseService
     /// "back up all my plain DBs to one file" workflows.
     ///
     /// <para>
-    /// Implementation: loops <see cref="ListDatabasesAsync"/> and calls
-    /// <see cref="ExportDatabaseAsync"/> per file, packaging into a
-    /// <see cref="System.IO.Compression.ZipArchive"/>. ZIP container is
+    /// Implementation: one entry per file of <see cref="ListDatabasesAsync"/>,
+    /// each an online snapshot as in <see cref="ExportDatabaseAsync"/>.
+    /// Entries are deflated in the worker, on compression helper workers
+    /// in parallel, and never on the .NET thread unless the browser lacks
+    /// a <c>deflate-raw</c> <c>CompressionStream</c>. ZIP container is
     /// the standard cross-tool folder representation; no MessagePack /
     /// custom format involved.
     /// </para>
@@ -239,6 +338,17 @@ public interface ISqliteWasmDatabaseService
     /// <returns>ZIP archive bytes; one entry per database in the pool.</returns>
     Task<byte[]> ExportAllDatabasesAsync(CancellationToken cancellationToken = default);
 
+    /// <summary>
+    /// <see cref="ExportAllDatabasesAsync(CancellationToken)"/> written to
+    /// <paramref name="destination"/>. Entries are written as they come out
+    /// of the worker's compressors; only the compressed entries in flight
+    /// are held, never the archive — pass a file or download stream to
+    /// back up databases larger than the heap.
+    /// </summary>
+    /// <param name="destination">Receives the ZIP archive; not disposed.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    Task ExportAllDatabasesAsync(Stream destination, CancellationToken cancellationToken = default);
+
     /// <summary>
     /// Batch import: replace the entire SAH pool with the contents of the
     /// supplied <b>ZIP archive</b>. Wipes every currently-registered DB
@@ -265,4 +375,37 @@ public interface ISqliteWasmDatabaseService
     /// </returns>
     Task<DiskImportResult> ImportAllDatabasesAsync(byte[] zipBytes,
         CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// <see cref="ImportAllDatabasesAsync(byte[], CancellationToken)"/> from a
+    /// stream. Each plain entry is decompressed straight into
+    /// <see cref="ImportDatabaseAsync(string, Stream, CancellationToken)"/>.
+    /// <see cref="System.IO.Compression.ZipArchive"/> needs a seekable
+    /// stream to read entries in place; a non-seekable one is buffered
+    /// whole first.
+    /// </summary>
+    /// <param name="zipSource">The ZIP archive; not disposed.</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    Task<DiskImportResult> ImportAllDatabasesAsync(Stream zipSource,
+        CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// Prepared-statement cache counters for an open database. Diagnostic
+    /// only — use it to size <see cref="SqliteWasmOptions.StatementCacheSize"/>
+    /// (a steady stream of misses on a warm app means the cache is too small).
+    /// Returns zeros for a database that has not executed anything yet.
+    /// </summary>
+    /// <param name="databaseName">The database filename (e.g., "mydb.db").</param>
+    /// <param name="cancellationToken">Cancellation token.</param>
+    Task<SqliteWasmStatementCacheStatistics> GetStatementCacheStatisticsAsync(string databaseName,
+        CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// Request latency per worker request type, split into queue wait,
+    /// execute, serialize, transfer and deserialize. Use it to tell SQLite
+    /// time (execute) from waiting (queue wait) and from bridge or GC
+    /// overhead (transfer, deserialize). Diagnostic only; answered from
+    /// counters in .NET without a worker round trip.
+    /// </summary>
+    SqliteWasmStatistics GetStatistics();
 }
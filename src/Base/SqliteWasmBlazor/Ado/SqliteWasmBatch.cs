@@ -0,0 +1,247 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Data;
+using System.Data.Common;
+using System.Diagnostics.CodeAnalysis;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Runs several SQL statements in one worker round trip ('executeBatch')
+/// instead of one postMessage exchange per command.
+/// </summary>
+/// <remarks>
+/// Commands execute in order and stop at the first failure. Unless
+/// <see cref="Atomic"/> is set, the commands before the failing one stay
+/// applied, so run the batch inside a transaction when that matters. The
+/// synchronous methods need the shared sync channel (see
+/// <see cref="SqliteWasmOptions.SynchronousChannelSize"/>).
+/// </remarks>
+public sealed class SqliteWasmBatch : DbBatch
+{
+    private CancellationTokenSource? _cancellation;
+
+    public SqliteWasmBatch()
+    {
+    }
+
+    public SqliteWasmBatch(SqliteWasmConnection connection)
+    {
+        Connection = connection;
+    }
+
+    public new SqliteWasmBatchCommandCollection BatchCommands { get; } = new();
+
+    protected override DbBatchCommandCollection DbBatchCommands => BatchCommands;
+
+    private int? _timeout;
+
+    /// <summary>
+    /// Seconds for the whole batch, enforced like
+    /// <see cref="SqliteWasmCommand.CommandTimeout"/>: always by the
+    /// synchronous methods, asynchronously only when set.
+    /// </summary>
+    public override int Timeout
+    {
+        get => _timeout ?? SqliteWasmCommand.DefaultCommandTimeout;
+        set => _timeout = value;
+    }
+
+    /// <summary>
+    /// Run the commands under a savepoint that is rolled back when one of
+    /// them fails: the batch applies all or nothing, inside or outside a
+    /// transaction, without a BEGIN/COMMIT round trip of its own.
+    /// </summary>
+    public bool Atomic { get; set; }
+
+    public new SqliteWasmConnection? Connection { get; set; }
+
+    protected override DbConnection? DbConnection
+    {
+        get => Connection;
+        set => Connection = (SqliteWasmConnection?)value;
+    }
+
+    public new SqliteWasmTransaction? Transaction { get; set; }
+
+    protected override DbTransaction? DbTransaction
+    {
+        get => Transaction;
+        set => Transaction = (SqliteWasmTransaction?)value;
+    }
+
+    public override int ExecuteNonQuery()
+    {
+        return ExecuteSync()?.RowsAffected ?? 0;
+    }
+
+    public override async Task<int> ExecuteNonQueryAsync(CancellationToken cancellationToken = default)
+    {
+        var result = await ExecuteAsync(cancellationToken);
+        return result?.RowsAffected ?? 0;
+    }
+
+    public override object? ExecuteScalar()
+    {
+        return GetScalar(ExecuteSync());
+    }
+
+    public override async Task<object?> ExecuteScalarAsync(CancellationToken cancellationToken = default)
+    {
+        return GetScalar(await ExecuteAsync(cancellationToken));
+    }
+
+    protected override DbDataReader ExecuteDbDataReader(CommandBehavior behavior)
+    {
+        return new SqliteWasmDataReader(ExecuteSync() ?? new SqlQueryResult());
+    }
+
+    protected override async Task<DbDataReader> ExecuteDbDataReaderAsync(
+        CommandBehavior behavior,
+        CancellationToken cancellationToken)
+    {
+        return new SqliteWasmDataReader(await ExecuteAsync(cancellationToken) ?? new SqlQueryResult());
+    }
+
+    public override void Prepare()
+    {
+        // No-op: the worker's statement cache prepares on first use
+    }
+
+    public override Task PrepareAsync(CancellationToken cancellationToken = default)
+    {
+        return Task.CompletedTask;
+    }
+
+    /// <summary>
+    /// Cancel the asynchronous execution in flight, as
+    /// <see cref="SqliteWasmCommand.Cancel"/> does: the worker drops the
+    /// request if it is still queued or interrupts the running command.
+    /// </summary>
+    public override void Cancel()
+    {
+        _cancellation?.Cancel();
+    }
+
+    protected override DbBatchCommand CreateDbBatchCommand()
+    {
+        return new SqliteWasmBatchCommand();
+    }
+
+    /// <summary>Null when the batch has no commands — nothing is sent.</summary>
+    private async Task<SqlQueryResult?> ExecuteAsync(CancellationToken cancellationToken)
+    {
+        ValidateConnection();
+        if (BatchCommands.Count == 0)
+        {
+            return null;
+        }
+
+        var commands = BuildRequest();
+
+        // Linked so Cancel() can cancel this execution
+        using var cancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        _cancellation = cancellation;
+
+        var begin = Connection.TakeDeferredBegin();
+        SqlQueryResult result;
+        try
+        {
+            result = await SqliteWasmWorkerBridge.Instance.ExecuteBatchAsync(
+                Connection.Database, commands, begin, Atomic, Connection.Priority, _timeout, cancellation.Token);
+            Connection.CompleteDeferredBegin(null);
+        }
+        catch (Exception ex) when (begin is not null)
+        {
+            Connection.CompleteDeferredBegin(ex);
+            throw;
+        }
+        finally
+        {
+            _cancellation = null;
+        }
+        return ApplyRecordsAffected(result);
+    }
+
+    private SqlQueryResult? ExecuteSync()
+    {
+        ValidateConnection();
+        if (!SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
+        {
+            throw new NotSupportedException(
+                "Synchronous batch execution requires SqliteWasmOptions.SynchronousChannelSize on a cross-origin-isolated page. Use the async methods instead.");
+        }
+        if (BatchCommands.Count == 0)
+        {
+            return null;
+        }
+
+        var commands = BuildRequest();
+        var begin = Connection.TakeDeferredBegin();
+        SqlQueryResult result;
+        try
+        {
+            result = SqliteWasmWorkerBridge.Instance.ExecuteBatch(
+                Connection.Database, commands, begin, Atomic, Timeout);
+            Connection.CompleteDeferredBegin(null);
+        }
+        catch (Exception ex) when (begin is not null)
+        {
+            Connection.CompleteDeferredBegin(ex);
+            throw;
+        }
+        return ApplyRecordsAffected(result);
+    }
+
+    /// <summary>Preprocessed SQL and parameters of each command, in order.</summary>
+    private List<(string Sql, SqliteWasmParameterCollection Parameters)> BuildRequest()
+    {
+        var commands = new List<(string Sql, SqliteWasmParameterCollection Parameters)>(BatchCommands.Count);
+        foreach (SqliteWasmBatchCommand command in BatchCommands)
+        {
+            if (string.IsNullOrWhiteSpace(command.CommandText))
+            {
+                throw new InvalidOperationException("CommandText has not been set on every batch command.");
+            }
+
+            commands.Add((SqliteWasmCommand.PreprocessSql(command.CommandText), command.Parameters));
+        }
+        return commands;
+    }
+
+    private SqlQueryResult ApplyRecordsAffected(SqlQueryResult result)
+    {
+        var results = result.BatchResults ?? [];
+        for (var i = 0; i < BatchCommands.Count; i++)
+        {
+            BatchCommands[i].SetRecordsAffected(i < results.Count ? results[i].RowsAffected : 0);
+        }
+        return result;
+    }
+
+    /// <summary>First column of the first row of the first command that returned columns.</summary>
+    private static object? GetScalar(SqlQueryResult? result)
+    {
+        var first = result?.BatchResults?.FirstOrDefault(r => r.ColumnNames.Count > 0);
+        if (first is null || first.Rows.RowCount == 0 || first.Rows.ColumnCount == 0)
+        {
+            return null;
+        }
+        return first.Rows.GetValue(0, 0);
+    }
+
+    [MemberNotNull(nameof(Connection))]
+    private void ValidateConnection()
+    {
+        if (Connection == null)
+        {
+            throw new InvalidOperationException("Connection property has not been initialized.");
+        }
+
+        if (Connection.State != ConnectionState.Open)
+        {
+            throw new InvalidOperationException("Connection must be Open.");
+        }
+    }
+}
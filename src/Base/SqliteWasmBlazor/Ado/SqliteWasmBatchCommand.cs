@@ -0,0 +1,135 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Data;
+using System.Data.Common;
+using System.Diagnostics.CodeAnalysis;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// One SQL statement of a <see cref="SqliteWasmBatch"/>.
+/// </summary>
+public sealed class SqliteWasmBatchCommand : DbBatchCommand
+{
+    private string _commandText = string.Empty;
+    private int _recordsAffected;
+
+    public SqliteWasmBatchCommand()
+    {
+    }
+
+    public SqliteWasmBatchCommand(string commandText)
+    {
+        CommandText = commandText;
+    }
+
+    [AllowNull]
+    public override string CommandText
+    {
+        get => _commandText;
+        set => _commandText = value ?? string.Empty;
+    }
+
+    public override CommandType CommandType { get; set; } = CommandType.Text;
+
+    public override int RecordsAffected => _recordsAffected;
+
+    protected override DbParameterCollection DbParameterCollection => Parameters;
+
+    public new SqliteWasmParameterCollection Parameters { get; } = new();
+
+    public override bool CanCreateParameter => true;
+
+    public override DbParameter CreateParameter()
+    {
+        return new SqliteWasmParameter();
+    }
+
+    internal void SetRecordsAffected(int recordsAffected)
+    {
+        _recordsAffected = recordsAffected;
+    }
+}
+
+/// <summary>
+/// Commands of a <see cref="SqliteWasmBatch"/>, in execution order.
+/// </summary>
+public sealed class SqliteWasmBatchCommandCollection : DbBatchCommandCollection
+{
+    private readonly List<SqliteWasmBatchCommand> _commands = [];
+
+    public override int Count => _commands.Count;
+
+    public override bool IsReadOnly => false;
+
+    public new SqliteWasmBatchCommand this[int index]
+    {
+        get => _commands[index];
+        set => _commands[index] = value;
+    }
+
+    public override void Add(DbBatchCommand item)
+    {
+        _commands.Add(Cast(item));
+    }
+
+    public override void Clear()
+    {
+        _commands.Clear();
+    }
+
+    public override bool Contains(DbBatchCommand item)
+    {
+        return item is SqliteWasmBatchCommand command && _commands.Contains(command);
+    }
+
+    public override void CopyTo(DbBatchCommand[] array, int arrayIndex)
+    {
+        for (var i = 0; i < _commands.Count; i++)
+        {
+            array[arrayIndex + i] = _commands[i];
+        }
+    }
+
+    public override IEnumerator<DbBatchCommand> GetEnumerator()
+    {
+        return ((IEnumerable<DbBatchCommand>)_commands).GetEnumerator();
+    }
+
+    public override int IndexOf(DbBatchCommand item)
+    {
+        return item is SqliteWasmBatchCommand command ? _commands.IndexOf(command) : -1;
+    }
+
+    public override void Insert(int index, DbBatchCommand item)
+    {
+        _commands.Insert(index, Cast(item));
+    }
+
+    public override bool Remove(DbBatchCommand item)
+    {
+        return item is SqliteWasmBatchCommand command && _commands.Remove(command);
+    }
+
+    public override void RemoveAt(int index)
+    {
+        _commands.RemoveAt(index);
+    }
+
+    protected override DbBatchCommand GetBatchCommand(int index)
+    {
+        return _commands[index];
+    }
+
+    protected override void SetBatchCommand(int index, DbBatchCommand batchCommand)
+    {
+        _commands[index] = Cast(batchCommand);
+    }
+
+    private static SqliteWasmBatchCommand Cast(DbBatchCommand item)
+    {
+        return item as SqliteWasmBatchCommand
+               ?? throw new ArgumentException("Value must be a SqliteWasmBatchCommand.", nameof(item));
+    }
+}
@@ -0,0 +1,330 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Stream over a single BLOB value, read and written incrementally through a
+/// <c>sqlite3_blob_open</c> handle held by the worker — the counterpart of
+/// Microsoft.Data.Sqlite's <c>SqliteBlob</c>.
+/// </summary>
+/// <remarks>
+/// Only the ranges a caller reads or writes cross the thread boundary, in
+/// chunks of at most <see cref="MaxChunkSize"/> bytes, so a multi-megabyte
+/// attachment never has to exist as one <c>byte[]</c> in the managed heap.
+/// The blob's size is fixed: writes cannot extend it (allocate the space
+/// first, e.g. <c>UPDATE ... SET Data = zeroblob(@length)</c>).
+/// <para>
+/// The asynchronous members work on every page. The constructors and the
+/// synchronous <see cref="Read(Span{byte})"/> / <see cref="Write(ReadOnlySpan{byte})"/>
+/// block on the worker and require <see cref="SqliteWasmOptions.SynchronousChannelSize"/>
+/// on a cross-origin-isolated page; use <see cref="OpenAsync"/> and the
+/// async members otherwise.
+/// </para>
+/// <para>
+/// As with <c>sqlite3_blob_open</c>, the handle expires when the row is
+/// modified by anything but this stream; further I/O then throws.
+/// </para>
+/// </remarks>
+public sealed class SqliteWasmBlob : Stream
+{
+    /// <summary>Largest range moved between the worker and .NET per round trip.</summary>
+    public const int MaxChunkSize = 1024 * 1024;
+
+    private readonly SqliteWasmWorkerBridge _bridge;
+    private readonly string _database;
+    private readonly SqliteWasmBlobReference _source;
+    private readonly bool _readOnly;
+    private long _length;
+    private long _position;
+    private int _handle;
+    private bool _disposed;
+
+    /// <summary>
+    /// Open the BLOB in <paramref name="columnName"/> of the row with
+    /// <paramref name="rowid"/> in table <paramref name="tableName"/>.
+    /// </summary>
+    public SqliteWasmBlob(SqliteWasmConnection connection, string tableName, string columnName, long rowid, bool readOnly = false)
+        : this(connection, "main", tableName, columnName, rowid, readOnly)
+    {
+    }
+
+    /// <summary>
+    /// Open the BLOB in <paramref name="columnName"/> of the row with
+    /// <paramref name="rowid"/> in <paramref name="databaseName"/>.<paramref name="tableName"/>.
+    /// </summary>
+    public SqliteWasmBlob(SqliteWasmConnection connection, string databaseName, string tableName, string columnName, long rowid, bool readOnly = false)
+        : this(connection, new SqliteWasmBlobReference(databaseName, tableName, columnName, rowid, -1), readOnly)
+    {
+        EnsureOpen();
+    }
+
+    private SqliteWasmBlob(SqliteWasmConnection connection, SqliteWasmBlobReference source, bool readOnly)
+    {
+        ArgumentNullException.ThrowIfNull(connection);
+        if (connection.State != System.Data.ConnectionState.Open)
+        {
+            throw new InvalidOperationException("Connection must be Open.");
+        }
+
+        _bridge = SqliteWasmWorkerBridge.Instance;
+        _database = connection.Database;
+        _source = source;
+        _readOnly = readOnly;
+        _length = source.Length;
+    }
+
+    /// <summary>
+    /// Asynchronous counterpart of the constructor; does not need the
+    /// synchronous channel.
+    /// </summary>
+    public static async Task<SqliteWasmBlob> OpenAsync(
+        SqliteWasmConnection connection,
+        string tableName,
+        string columnName,
+        long rowid,
+        bool readOnly = false,
+        CancellationToken cancellationToken = default)
+    {
+        var blob = new SqliteWasmBlob(connection, new SqliteWasmBlobReference("main", tableName, columnName, rowid, -1), readOnly);
+        await blob.EnsureOpenAsync(cancellationToken);
+        return blob;
+    }
+
+    /// <summary>
+    /// Read-only stream over a deferred BLOB cell of a data reader. The
+    /// handle is opened by the first read, so a stream that is never read
+    /// costs no round trip.
+    /// </summary>
+    internal static SqliteWasmBlob FromReference(SqliteWasmConnection connection, SqliteWasmBlobReference source)
+    {
+        return new SqliteWasmBlob(connection, source, readOnly: true);
+    }
+
+    public override bool CanRead => !_disposed;
+
+    public override bool CanWrite => !_disposed && !_readOnly;
+
+    public override bool CanSeek => !_disposed;
+
+    public override long Length
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            if (_length < 0)
+            {
+                EnsureOpen();
+            }
+            return _length;
+        }
+    }
+
+    public override long Position
+    {
+        get => _position;
+        set
+        {
+            ArgumentOutOfRangeException.ThrowIfNegative(value);
+            _position = value;
+        }
+    }
+
+    public override long Seek(long offset, SeekOrigin origin)
+    {
+        var position = origin switch
+        {
+            SeekOrigin.Begin => offset,
+            SeekOrigin.Current => _position + offset,
+            SeekOrigin.End => Length + offset,
+            _ => throw new ArgumentOutOfRangeException(nameof(origin))
+        };
+
+        ArgumentOutOfRangeException.ThrowIfNegative(position, nameof(offset));
+        _position = position;
+        return position;
+    }
+
+    public override int Read(byte[] buffer, int offset, int count)
+    {
+        ValidateBufferArguments(buffer, offset, count);
+        return Read(buffer.AsSpan(offset, count));
+    }
+
+    public override int Read(Span<byte> buffer)
+    {
+        EnsureOpen();
+        var count = NextReadSize(buffer.Length);
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        var bytes = _bridge.ReadBlob(_handle, _position, count);
+        bytes.CopyTo(buffer);
+        _position += bytes.Length;
+        return bytes.Length;
+    }
+
+    public override Task<int> ReadAsync(byte[] buffer, int offset, int count, CancellationToken cancellationToken)
+    {
+        ValidateBufferArguments(buffer, offset, count);
+        return ReadAsync(buffer.AsMemory(offset, count), cancellationToken).AsTask();
+    }
+
+    public override async ValueTask<int> ReadAsync(Memory<byte> buffer, CancellationToken cancellationToken = default)
+    {
+        await EnsureOpenAsync(cancellationToken);
+        var count = NextReadSize(buffer.Length);
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        var bytes = await _bridge.ReadBlobAsync(_handle, _position, count, cancellationToken);
+        bytes.CopyTo(buffer);
+        _position += bytes.Length;
+        return bytes.Length;
+    }
+
+    public override void Write(byte[] buffer, int offset, int count)
+    {
+        ValidateBufferArguments(buffer, offset, count);
+        Write(buffer.AsSpan(offset, count));
+    }
+
+    public override void Write(ReadOnlySpan<byte> buffer)
+    {
+        EnsureOpen();
+        ValidateWrite(buffer.Length);
+        while (!buffer.IsEmpty)
+        {
+            var chunk = buffer[..Math.Min(buffer.Length, MaxChunkSize)];
+            _bridge.WriteBlob(_handle, _position, chunk);
+            _position += chunk.Length;
+            buffer = buffer[chunk.Length..];
+        }
+    }
+
+    public override Task WriteAsync(byte[] buffer, int offset, int count, CancellationToken cancellationToken)
+    {
+        ValidateBufferArguments(buffer, offset, count);
+        return WriteAsync(buffer.AsMemory(offset, count), cancellationToken).AsTask();
+    }
+
+    public override async ValueTask WriteAsync(ReadOnlyMemory<byte> buffer, CancellationToken cancellationToken = default)
+    {
+        await EnsureOpenAsync(cancellationToken);
+        ValidateWrite(buffer.Length);
+        while (!buffer.IsEmpty)
+        {
+            var chunk = buffer[..Math.Min(buffer.Length, MaxChunkSize)];
+            await _bridge.WriteBlobAsync(_handle, _position, chunk, cancellationToken);
+            _position += chunk.Length;
+            buffer = buffer[chunk.Length..];
+        }
+    }
+
+    public override void Flush()
+    {
+        // Writes go straight to the database
+    }
+
+    public override Task FlushAsync(CancellationToken cancellationToken) => Task.CompletedTask;
+
+    public override void SetLength(long value)
+    {
+        throw new NotSupportedException("The size of a BLOB cannot be changed through SqliteWasmBlob.");
+    }
+
+    protected override void Dispose(bool disposing)
+    {
+        if (!_disposed && disposing && _handle != 0)
+        {
+            var handle = _handle;
+            _handle = 0;
+            if (_bridge.IsSynchronousExecutionAvailable)
+            {
+                _bridge.CloseBlob(handle);
+            }
+            else
+            {
+                // Can't block here — release in the background; the worker
+                // also drops the handle when the database is closed.
+                _ = CloseInBackgroundAsync(handle);
+            }
+        }
+        _disposed = true;
+        base.Dispose(disposing);
+    }
+
+    public override async ValueTask DisposeAsync()
+    {
+        if (!_disposed && _handle != 0)
+        {
+            var handle = _handle;
+            _handle = 0;
+            await _bridge.CloseBlobAsync(handle, CancellationToken.None);
+        }
+        _disposed = true;
+        await base.DisposeAsync();
+    }
+
+    private async Task CloseInBackgroundAsync(int handle)
+    {
+        try
+        {
+            await _bridge.CloseBlobAsync(handle, CancellationToken.None);
+        }
+        catch (Exception ex)
+        {
+            Console.Error.WriteLine($"[SqliteWasmBlob] Failed to close blob handle {handle}: {ex.Message}");
+        }
+    }
+
+    private void EnsureOpen()
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        if (_handle != 0)
+        {
+            return;
+        }
+
+        var (handle, length) = _bridge.OpenBlob(_database, _source.Schema, _source.Table, _source.Column, _source.Rowid, !_readOnly);
+        _handle = handle;
+        _length = length;
+    }
+
+    private async ValueTask EnsureOpenAsync(CancellationToken cancellationToken)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        if (_handle != 0)
+        {
+            return;
+        }
+
+        var (handle, length) = await _bridge.OpenBlobAsync(
+            _database, _source.Schema, _source.Table, _source.Column, _source.Rowid, !_readOnly, cancellationToken);
+        _handle = handle;
+        _length = length;
+    }
+
+    private int NextReadSize(int requested)
+    {
+        return (int)Math.Clamp(_length - _position, 0, Math.Min(requested, MaxChunkSize));
+    }
+
+    private void ValidateWrite(int count)
+    {
+        if (_readOnly)
+        {
+            throw new NotSupportedException("Stream does not support writing.");
+        }
+
+        if (_position + count > _length)
+        {
+            throw new NotSupportedException(
+                "The size of a BLOB cannot be changed through SqliteWasmBlob; write within its current length.");
+        }
+    }
+}
@@ -14,6 +14,7 @@ public sealed class SqliteWasmCommand : DbCommand
 {
     private string _commandText = string.Empty;
     private readonly SqliteWasmParameterCollection _parameters;
+    private CancellationTokenSource? _cancellation;
 
     public SqliteWasmCommand()
     {
@@ -27,7 +28,36 @@ public sealed class SqliteWasmCommand : DbCommand
         set => _commandText = value ?? string.Empty;
     }
 
-    public override int CommandTimeout { get; set; } = 30;
+    internal const int DefaultCommandTimeout = 30;
+
+    private int? _commandTimeout;
+
+    /// <summary>
+    /// Seconds before the command is cancelled (30 unless set; 0 waits
+    /// indefinitely). The synchronous methods always block for at most this
+    /// long. Asynchronous execution only enforces a value that was set: an
+    /// unset timeout keeps the bridge's five-minute request limit, so EF Core
+    /// migrations and other long statements are not interrupted at 30 s.
+    /// </summary>
+    public override int CommandTimeout
+    {
+        get => _commandTimeout ?? DefaultCommandTimeout;
+        set => _commandTimeout = value;
+    }
+
+    /// <summary>
+    /// Rows per round trip when this command's reader streams a read-only
+    /// result set. <c>null</c> uses <see cref="SqliteWasmOptions.ReaderBatchSize"/>;
+    /// 0 forces the whole result set into one response.
+    /// </summary>
+    public int? ReaderBatchSize { get; set; }
+
+    /// <summary>
+    /// Scheduling class in the worker's queue, taken from
+    /// <see cref="SqliteWasmConnection.Priority"/> when the connection
+    /// creates the command.
+    /// </summary>
+    public SqliteWasmRequestPriority Priority { get; set; }
 
     public override CommandType CommandType { get; set; } = CommandType.Text;
 
@@ -49,24 +79,34 @@ public sealed class SqliteWasmCommand : DbCommand
 
     protected override DbTransaction? DbTransaction { get; set; }
 
+    /// <summary>
+    /// Cancel the asynchronous execution in progress, as if its token had
+    /// been cancelled: the worker drops the request if it is still queued
+    /// and interrupts its statement if it is running. That needs a
+    /// cross-origin-isolated page. No-op when nothing is executing.
+    /// </summary>
     public override void Cancel()
     {
-        // sqlite-wasm doesn't support cancellation in same way
+        _cancellation?.Cancel();
     }
 
     public override int ExecuteNonQuery()
     {
-        // Synchronous execution not supported in WebAssembly
-        // Return 0 as EF Core will use async methods for actual work
-        // This is primarily called during schema checks where return value isn't critical
-        return 0;
+        if (!SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
+        {
+            // Synchronous execution needs the shared channel (SqliteWasmOptions.SynchronousChannelSize)
+            // Return 0 as EF Core will use async methods for actual work
+            // This is primarily called during schema checks where return value isn't critical
+            return 0;
+        }
+
+        return ExecuteSync().RowsAffected;
     }
     
     public override async Task<int> ExecuteNonQueryAsync(CancellationToken cancellationToken)
     {
         ValidateConnection();
 
-        var bridge = SqliteWasmWorkerBridge.Instance;
         var sql = PreprocessSql(_commandText);
 
         // DEBUG: Log UPDATE operations
@@ -76,10 +116,7 @@ public sealed class SqliteWasmCommand : DbCommand
             Console.WriteLine($"[SqliteWasmCommand] Parameters: {string.Join(", ", _parameters.GetParameterValues().Select((v, i) => $"${i}={v}"))}");
         }
 
-        var (parameterDict, packedBlobs) = _parameters.GetParameterValuesWithBlobs();
-        var result = packedBlobs is null
-            ? await bridge.ExecuteSqlAsync(Connection.Database, sql, parameterDict, cancellationToken)
-            : await bridge.ExecuteSqlWithBlobsAsync(Connection.Database, sql, parameterDict, packedBlobs, cancellationToken);
+        var result = await ExecuteCoreAsync(sql, 0, deferBlobs: false, cancellationToken);
 
         // DEBUG: Log result of UPDATE operations
         if (sql.TrimStart().StartsWith("UPDATE", StringComparison.OrdinalIgnoreCase))
@@ -92,8 +129,19 @@ public sealed class SqliteWasmCommand : DbCommand
 
     public override object? ExecuteScalar()
     {
-        // Synchronous execution not supported in WebAssembly
-        // Return null as EF Core will use async methods for actual work
+        if (!SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
+        {
+            // Synchronous execution needs the shared channel (SqliteWasmOptions.SynchronousChannelSize)
+            // Return null as EF Core will use async methods for actual work
+            return null;
+        }
+
+        var result = ExecuteSync();
+        if (result.Rows.RowCount > 0 && result.Rows.ColumnCount > 0)
+        {
+            return result.Rows.GetValue(0, 0);
+        }
+
         return null;
     }
 
@@ -101,16 +149,12 @@ public sealed class SqliteWasmCommand : DbCommand
     {
         ValidateConnection();
 
-        var bridge = SqliteWasmWorkerBridge.Instance;
         var sql = PreprocessSql(_commandText);
-        var (parameterDict, packedBlobs) = _parameters.GetParameterValuesWithBlobs();
-        var result = packedBlobs is null
-            ? await bridge.ExecuteSqlAsync(Connection.Database, sql, parameterDict, cancellationToken)
-            : await bridge.ExecuteSqlWithBlobsAsync(Connection.Database, sql, parameterDict, packedBlobs, cancellationToken);
+        var result = await ExecuteCoreAsync(sql, 0, deferBlobs: false, cancellationToken);
 
-        if (result.Rows.Length > 0 && result.Rows[0].Length > 0)
+        if (result.Rows.RowCount > 0 && result.Rows.ColumnCount > 0)
         {
-            return result.Rows[0][0];
+            return result.Rows.GetValue(0, 0);
         }
 
         return null;
@@ -118,10 +162,16 @@ public sealed class SqliteWasmCommand : DbCommand
 
     protected override DbDataReader ExecuteDbDataReader(CommandBehavior behavior)
     {
-        // Synchronous execution not supported in WebAssembly
-        // Return empty reader as EF Core will use async methods for actual work
-        var result = new SqlQueryResult();
-        return new SqliteWasmDataReader(result);
+        if (!SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
+        {
+            // Synchronous execution needs the shared channel (SqliteWasmOptions.SynchronousChannelSize)
+            // Return empty reader as EF Core will use async methods for actual work
+            var result = new SqlQueryResult();
+            return new SqliteWasmDataReader(result);
+        }
+
+        // Whole result set in one response — a cursor would need async fetches
+        return new SqliteWasmDataReader(ExecuteSync(DefersBlobs(behavior)), connection: Connection);
     }
 
     protected override async Task<DbDataReader> ExecuteDbDataReaderAsync(
@@ -132,12 +182,77 @@ public sealed class SqliteWasmCommand : DbCommand
 
         var bridge = SqliteWasmWorkerBridge.Instance;
         var sql = PreprocessSql(_commandText);
-        var (parameterDict, packedBlobs) = _parameters.GetParameterValuesWithBlobs();
-        var result = packedBlobs is null
-            ? await bridge.ExecuteSqlAsync(Connection.Database, sql, parameterDict, cancellationToken)
-            : await bridge.ExecuteSqlWithBlobsAsync(Connection.Database, sql, parameterDict, packedBlobs, cancellationToken);
 
-        return new SqliteWasmDataReader(result);
+        // A single-row read gains nothing from a cursor
+        var batchSize = (behavior & CommandBehavior.SingleRow) != 0
+            ? 0
+            : Math.Max(0, ReaderBatchSize ?? bridge.ReaderBatchSize);
+
+        var result = await ExecuteCoreAsync(sql, batchSize, DefersBlobs(behavior), cancellationToken);
+
+        return new SqliteWasmDataReader(result, batchSize, Connection);
+    }
+
+    /// <summary>
+    /// SequentialAccess readers get large BLOBs as <see cref="SqliteWasmBlob"/>
+    /// streams instead of their bytes (see <see cref="SqliteWasmDataReader"/>).
+    /// </summary>
+    private static bool DefersBlobs(CommandBehavior behavior)
+    {
+        return (behavior & CommandBehavior.SequentialAccess) != 0;
+    }
+
+    /// <summary>
+    /// Blocking execute over the bridge's synchronous channel, bounded by
+    /// <see cref="CommandTimeout"/>.
+    /// </summary>
+    private SqlQueryResult ExecuteSync(bool deferBlobs = false)
+    {
+        ValidateConnection();
+
+        var sql = PreprocessSql(_commandText);
+        var begin = Connection.TakeDeferredBegin();
+        try
+        {
+            var result = SqliteWasmWorkerBridge.Instance.ExecuteCommand(Connection.Database, sql, _parameters, begin, deferBlobs, CommandTimeout);
+            Connection.CompleteDeferredBegin(null);
+            return result;
+        }
+        catch (Exception ex) when (begin is not null)
+        {
+            Connection.CompleteDeferredBegin(ex);
+            throw;
+        }
+    }
+
+    /// <summary>
+    /// Send the command, prefixed with the BEGIN of a transaction that has not
+    /// started in the worker yet (see <see cref="SqliteWasmTransaction"/>).
+    /// </summary>
+    private async Task<SqlQueryResult> ExecuteCoreAsync(string sql, int batchSize, bool deferBlobs, CancellationToken cancellationToken)
+    {
+        // Linked so Cancel() can cancel this execution
+        using var cancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        _cancellation = cancellation;
+
+        var begin = Connection!.TakeDeferredBegin();
+        try
+        {
+            var result = await SqliteWasmWorkerBridge.Instance.ExecuteCommandAsync(
+                Connection.Database, sql, _parameters, batchSize, begin, deferBlobs, Connection.HasTransaction,
+                Priority, _commandTimeout, cancellation.Token);
+            Connection.CompleteDeferredBegin(null);
+            return result;
+        }
+        catch (Exception ex) when (begin is not null)
+        {
+            Connection.CompleteDeferredBegin(ex);
+            throw;
+        }
+        finally
+        {
+            _cancellation = null;
+        }
     }
 
     public override void Prepare()
@@ -174,7 +289,7 @@ public sealed class SqliteWasmCommand : DbCommand
     /// This allows leveraging SQLite's native, optimized aggregate implementations.
     /// Arithmetic functions (ef_add, ef_multiply, etc.) are kept and handled by TypeScript.
     /// </summary>
-    private static string PreprocessSql(string sql)
+    internal static string PreprocessSql(string sql)
     {
         // Replace EF Core aggregate functions with native SQLite equivalents
         // Native SQLite aggregates are optimized and don't require custom state management
@@ -44,6 +44,14 @@ public sealed class SqliteWasmConnection : DbConnection
         set => _connectionString = value ?? string.Empty;
     }
 
+    /// <summary>
+    /// Worker scheduling class for commands created by this connection and
+    /// for its batches (EF Core SaveChanges). Set it to
+    /// <see cref="SqliteWasmRequestPriority.Background"/> on a context that
+    /// does background work, so it does not hold up interactive queries.
+    /// </summary>
+    public SqliteWasmRequestPriority Priority { get; set; }
+
     public override string Database => GetDatabaseName();
 
     public override string DataSource => GetDatabaseName();
@@ -86,6 +94,22 @@ public sealed class SqliteWasmConnection : DbConnection
             return;
         }
 
+        if (_bridge.IsSynchronousExecutionAvailable)
+        {
+            _state = ConnectionState.Connecting;
+            try
+            {
+                _bridge.OpenDatabase(Database);
+                _state = ConnectionState.Open;
+            }
+            catch
+            {
+                _state = ConnectionState.Broken;
+                throw;
+            }
+            return;
+        }
+
         _state = ConnectionState.Open;
 
         // Fire and forget - reuse OpenAsync logic
@@ -149,18 +173,47 @@ public sealed class SqliteWasmConnection : DbConnection
         return Task.CompletedTask;
     }
 
-    protected override DbCommand CreateDbCommand()
+    /// <summary>
+    /// Typed <see cref="DbConnection.CreateCommand"/>, so callers reach
+    /// <see cref="SqliteWasmCommand.Parameters"/> without a cast.
+    /// </summary>
+    public new SqliteWasmCommand CreateCommand()
     {
         return new SqliteWasmCommand
         {
-            Connection = this
+            Connection = this,
+            Priority = Priority
         };
     }
 
+    protected override DbCommand CreateDbCommand()
+    {
+        return CreateCommand();
+    }
+
+    public override bool CanCreateBatch => true;
+
+    protected override DbBatch CreateDbBatch()
+    {
+        return new SqliteWasmBatch(this);
+    }
+
     protected override DbTransaction BeginDbTransaction(IsolationLevel isolationLevel)
     {
-        throw new NotSupportedException(
-            "Synchronous transactions are not supported in WebAssembly. Use BeginTransactionAsync instead.");
+        if (!_bridge.IsSynchronousExecutionAvailable)
+        {
+            throw new NotSupportedException(
+                "Synchronous transactions require SqliteWasmOptions.SynchronousChannelSize on a cross-origin-isolated page. Use BeginTransactionAsync instead.");
+        }
+
+        if (_currentTransaction is not null)
+        {
+            throw new InvalidOperationException("A transaction is already active on this connection.");
+        }
+
+        var transaction = SqliteWasmTransaction.Create(this, isolationLevel);
+        _currentTransaction = transaction;
+        return transaction;
     }
 
     protected override async ValueTask<DbTransaction> BeginDbTransactionAsync(
@@ -185,6 +238,29 @@ public sealed class SqliteWasmConnection : DbConnection
         }
     }
 
+    /// <summary>
+    /// True while a transaction is active; its statements stay on the
+    /// worker that owns the database (no snapshot read workers).
+    /// </summary>
+    internal bool HasTransaction => _currentTransaction is not null;
+
+    /// <summary>
+    /// BEGIN statement of a transaction that has not started in the worker
+    /// yet, to be sent ahead of the next command. Null when there is none.
+    /// </summary>
+    internal string? TakeDeferredBegin()
+    {
+        return _currentTransaction?.TakeDeferredBegin();
+    }
+
+    /// <summary>
+    /// Report the outcome of the command that carried <see cref="TakeDeferredBegin"/>.
+    /// </summary>
+    internal void CompleteDeferredBegin(Exception? error)
+    {
+        _currentTransaction?.CompleteDeferredBegin(error);
+    }
+
     public override void ChangeDatabase(string databaseName)
     {
         throw new NotSupportedException("Changing database is not supported.");
@@ -9,19 +9,85 @@ namespace SqliteWasmBlazor;
 /// <summary>
 /// DataReader that wraps results from sqlite-wasm worker.
 /// </summary>
+/// <remarks>
+/// When the command ran with a reader batch size and the worker left a
+/// cursor open (<see cref="SqlQueryResult.CursorId"/> non-zero), only the
+/// current batch is held in memory: <see cref="ReadAsync(CancellationToken)"/>
+/// fetches the next batch once the current one is consumed, and
+/// <see cref="CloseAsync"/> / <see cref="DisposeAsync"/> release the cursor.
+/// The synchronous <see cref="Read"/> cannot wait for the worker and throws
+/// when it would have to fetch.
+/// <para>
+/// Rows stay in the worker's columnar buffer (<see cref="ColumnarRowSet"/>).
+/// The typed getters read INTEGER / REAL / TEXT / BLOB cells directly and only
+/// fall back to boxing through <see cref="GetValue"/> for cross-type
+/// conversions.
+/// </para>
+/// <para>
+/// A reader over a <see cref="SqliteWasmBatch"/> exposes one result per
+/// command that returned columns; <see cref="NextResult"/> moves between
+/// them and <see cref="RecordsAffected"/> is the batch total.
+/// </para>
+/// <para>
+/// A reader opened with <see cref="System.Data.CommandBehavior.SequentialAccess"/>
+/// leaves large BLOBs in the database when their row's rowid (or INTEGER
+/// PRIMARY KEY) is part of the result: <see cref="GetStream"/> returns a
+/// <see cref="SqliteWasmBlob"/> that reads them on demand, and
+/// <see cref="GetBytes"/> fetches only the requested range. Reading such a
+/// cell as <c>byte[]</c> fetches the whole value.
+/// </para>
+/// </remarks>
 public sealed class SqliteWasmDataReader : DbDataReader
 {
-    private readonly SqlQueryResult _result;
+    private readonly List<SqlQueryResult>? _results;
+    private readonly int _recordsAffected;
+    private readonly int _batchSize;
+    private SqlQueryResult _result;
+    private int _resultIndex;
+    private ColumnarRowSet _rows;
+    private int _cursorId;
+    private readonly SqliteWasmConnection? _connection;
     private int _currentRowIndex = -1;
     private bool _isClosed;
 
-    internal SqliteWasmDataReader(SqlQueryResult result)
+    internal SqliteWasmDataReader(SqlQueryResult result, int batchSize = 0, SqliteWasmConnection? connection = null)
     {
+        _connection = connection;
+        _recordsAffected = result.RowsAffected;
+        _batchSize = batchSize;
+        _results = result.BatchResults;
+        _resultIndex = -1;
         _result = result;
+        if (_results is null || !MoveToNextResultSet())
+        {
+            _result = _results?.Count > 0 ? _results[^1] : result;
+        }
+        _rows = _result.Rows;
+        _cursorId = _result.CursorId;
     }
 
     public override T GetFieldValue<T>(int ordinal)
     {
+        // Unboxed reads for the storage class's own CLR type
+        switch (GetStorageClass(ordinal))
+        {
+            case SqliteStorageClass.Integer when typeof(T) == typeof(long):
+                return (T)(object)_rows.GetInt64(_currentRowIndex, ordinal);
+            case SqliteStorageClass.Real when typeof(T) == typeof(double):
+                return (T)(object)_rows.GetDouble(_currentRowIndex, ordinal);
+            case SqliteStorageClass.Text when typeof(T) == typeof(string):
+                return (T)(object)_rows.GetString(_currentRowIndex, ordinal);
+            case SqliteStorageClass.Blob when typeof(T) == typeof(byte[]):
+                return (T)(object)_rows.GetBytes(_currentRowIndex, ordinal).ToArray();
+            case SqliteStorageClass.BlobReference when typeof(T) == typeof(byte[]):
+                return (T)(object)ReadDeferredBlob(ordinal);
+        }
+
+        if (typeof(T) == typeof(Stream))
+        {
+            return (T)(object)GetStream(ordinal);
+        }
+
         // Special handling for DateTimeOffset since there's no GetDateTimeOffset() in DbDataReader
         if (typeof(T) == typeof(DateTimeOffset))
         {
@@ -38,15 +104,47 @@ public sealed class SqliteWasmDataReader : DbDataReader
         return base.GetFieldValue<T>(ordinal);
     }
 
+    public override async Task<T> GetFieldValueAsync<T>(int ordinal, CancellationToken cancellationToken)
+    {
+        // A deferred BLOB can be fetched without the synchronous channel
+        if (typeof(T) == typeof(byte[]) && GetStorageClass(ordinal) == SqliteStorageClass.BlobReference)
+        {
+            await using var blob = (SqliteWasmBlob)GetStream(ordinal);
+            var bytes = new byte[blob.Length];
+            await blob.ReadExactlyAsync(bytes, cancellationToken);
+            return (T)(object)bytes;
+        }
+
+        return GetFieldValue<T>(ordinal);
+    }
+
+    /// <summary>
+    /// Stream over a BLOB cell: a <see cref="SqliteWasmBlob"/> for a BLOB
+    /// left in the database (SequentialAccess readers), otherwise a read-only
+    /// view of the bytes already received.
+    /// </summary>
+    public override Stream GetStream(int ordinal)
+    {
+        switch (GetStorageClass(ordinal))
+        {
+            case SqliteStorageClass.BlobReference:
+                return SqliteWasmBlob.FromReference(RequireConnection(), _rows.GetBlobReference(_currentRowIndex, ordinal));
+            case SqliteStorageClass.Blob:
+                return new MemoryStream(_rows.GetBytes(_currentRowIndex, ordinal).ToArray(), writable: false);
+            default:
+                return base.GetStream(ordinal);
+        }
+    }
+
     public override int Depth => 0;
 
     public override int FieldCount => _result.ColumnNames.Count;
 
-    public override bool HasRows => _result.Rows.Length > 0;
+    public override bool HasRows => _result.Rows.RowCount > 0;
 
     public override bool IsClosed => _isClosed;
 
-    public override int RecordsAffected => _result.RowsAffected;
+    public override int RecordsAffected => _recordsAffected;
 
     public override object this[int ordinal] => GetValue(ordinal);
 
@@ -54,37 +152,54 @@ public sealed class SqliteWasmDataReader : DbDataReader
 
     public override bool GetBoolean(int ordinal)
     {
+        if (GetStorageClass(ordinal) == SqliteStorageClass.Integer)
+        {
+            return _rows.GetInt64(_currentRowIndex, ordinal) != 0;
+        }
         var value = GetValue(ordinal);
         return Convert.ToBoolean(value);
     }
 
     public override byte GetByte(int ordinal)
     {
+        if (GetStorageClass(ordinal) == SqliteStorageClass.Integer)
+        {
+            return checked((byte)_rows.GetInt64(_currentRowIndex, ordinal));
+        }
         var value = GetValue(ordinal);
         return Convert.ToByte(value);
     }
 
     public override long GetBytes(int ordinal, long dataOffset, byte[]? buffer, int bufferOffset, int length)
     {
-        var value = GetValue(ordinal);
-        byte[] bytes;
-
-        if (value is byte[] byteArray)
+        var storageClass = GetStorageClass(ordinal);
+        if (storageClass == SqliteStorageClass.BlobReference)
         {
-            bytes = byteArray;
+            var source = _rows.GetBlobReference(_currentRowIndex, ordinal);
+            if (buffer == null)
+            {
+                return source.Length;
+            }
+
+            // Only the requested range crosses from the worker
+            using var blob = SqliteWasmBlob.FromReference(RequireConnection(), source);
+            blob.Position = dataOffset;
+            return blob.ReadAtLeast(buffer.AsSpan(bufferOffset, length), length, throwOnEndOfStream: false);
         }
-        else
+
+        if (storageClass != SqliteStorageClass.Blob)
         {
             throw new InvalidCastException($"Column {ordinal} is not a byte array.");
         }
 
+        var bytes = _rows.GetBytes(_currentRowIndex, ordinal);
         if (buffer == null)
         {
             return bytes.Length;
         }
 
         var bytesToCopy = Math.Min(length, bytes.Length - (int)dataOffset);
-        Array.Copy(bytes, dataOffset, buffer, bufferOffset, bytesToCopy);
+        bytes.Slice((int)dataOffset, bytesToCopy).CopyTo(buffer.AsSpan(bufferOffset));
         return bytesToCopy;
     }
 
@@ -196,30 +311,66 @@ public sealed class SqliteWasmDataReader : DbDataReader
 
     public override double GetDouble(int ordinal)
     {
+        switch (GetStorageClass(ordinal))
+        {
+            case SqliteStorageClass.Real:
+                return _rows.GetDouble(_currentRowIndex, ordinal);
+            case SqliteStorageClass.Integer:
+                return _rows.GetInt64(_currentRowIndex, ordinal);
+        }
         var value = GetValue(ordinal);
         return Convert.ToDouble(value);
     }
 
     public override Type GetFieldType(int ordinal)
     {
-        if (_currentRowIndex < 0 || _currentRowIndex >= _result.Rows.Length)
+        if (_currentRowIndex < 0 || _currentRowIndex >= _rows.RowCount)
         {
             // Return string as default if no data yet
             return typeof(string);
         }
 
-        var value = _result.Rows[_currentRowIndex][ordinal];
-        return value?.GetType() ?? typeof(object);
+        return GetStorageClass(ordinal) switch
+        {
+            SqliteStorageClass.Integer => typeof(long),
+            SqliteStorageClass.Real => typeof(double),
+            SqliteStorageClass.Text => typeof(string),
+            SqliteStorageClass.Blob or SqliteStorageClass.BlobReference => typeof(byte[]),
+            _ => typeof(object)
+        };
     }
 
     public override float GetFloat(int ordinal)
     {
+        switch (GetStorageClass(ordinal))
+        {
+            case SqliteStorageClass.Real:
+                return (float)_rows.GetDouble(_currentRowIndex, ordinal);
+            case SqliteStorageClass.Integer:
+                return _rows.GetInt64(_currentRowIndex, ordinal);
+        }
         var value = GetValue(ordinal);
         return Convert.ToSingle(value);
     }
 
     public override Guid GetGuid(int ordinal)
     {
+        switch (GetStorageClass(ordinal))
+        {
+            case SqliteStorageClass.Text:
+                return Guid.Parse(_rows.GetString(_currentRowIndex, ordinal));
+            case SqliteStorageClass.Blob:
+            {
+                // Match Microsoft.Data.Sqlite behavior:
+                // If 16 bytes, interpret as Guid directly
+                // Otherwise, interpret as UTF-8 encoded Guid string
+                var bytes = _rows.GetBytes(_currentRowIndex, ordinal);
+                return bytes.Length == 16
+                    ? new Guid(bytes)
+                    : Guid.Parse(System.Text.Encoding.UTF8.GetString(bytes));
+            }
+        }
+
         var value = GetValue(ordinal);
         if (value is Guid guid)
         {
@@ -243,18 +394,30 @@ public sealed class SqliteWasmDataReader : DbDataReader
 
     public override short GetInt16(int ordinal)
     {
+        if (GetStorageClass(ordinal) == SqliteStorageClass.Integer)
+        {
+            return checked((short)_rows.GetInt64(_currentRowIndex, ordinal));
+        }
         var value = GetValue(ordinal);
         return Convert.ToInt16(value);
     }
 
     public override int GetInt32(int ordinal)
     {
+        if (GetStorageClass(ordinal) == SqliteStorageClass.Integer)
+        {
+            return checked((int)_rows.GetInt64(_currentRowIndex, ordinal));
+        }
         var value = GetValue(ordinal);
         return Convert.ToInt32(value);
     }
 
     public override long GetInt64(int ordinal)
     {
+        if (GetStorageClass(ordinal) == SqliteStorageClass.Integer)
+        {
+            return _rows.GetInt64(_currentRowIndex, ordinal);
+        }
         var value = GetValue(ordinal);
         return Convert.ToInt64(value);
     }
@@ -280,56 +443,114 @@ public sealed class SqliteWasmDataReader : DbDataReader
 
     public override string GetString(int ordinal)
     {
+        if (GetStorageClass(ordinal) == SqliteStorageClass.Text)
+        {
+            return _rows.GetString(_currentRowIndex, ordinal);
+        }
         var value = GetValue(ordinal);
         return Convert.ToString(value) ?? string.Empty;
     }
 
     public override object GetValue(int ordinal)
     {
-        if (_currentRowIndex < 0 || _currentRowIndex >= _result.Rows.Length)
+        EnsureCell(ordinal);
+        if (_rows.GetStorageClass(_currentRowIndex, ordinal) == SqliteStorageClass.BlobReference)
+        {
+            return ReadDeferredBlob(ordinal);
+        }
+        return _rows.GetValue(_currentRowIndex, ordinal) ?? DBNull.Value;
+    }
+
+    public override int GetValues(object[] values)
+    {
+        if (_currentRowIndex < 0 || _currentRowIndex >= _rows.RowCount)
         {
             throw new InvalidOperationException("No current row.");
         }
 
-        if (ordinal < 0 || ordinal >= _result.Rows[_currentRowIndex].Length)
+        var count = Math.Min(values.Length, FieldCount);
+        for (var i = 0; i < count; i++)
         {
-            throw new ArgumentOutOfRangeException(nameof(ordinal));
+            values[i] = GetValue(i);
         }
+        return count;
+    }
 
-        var value = _result.Rows[_currentRowIndex][ordinal];
+    public override bool IsDBNull(int ordinal)
+    {
+        return GetStorageClass(ordinal) == SqliteStorageClass.Null;
+    }
+
+    private SqliteStorageClass GetStorageClass(int ordinal)
+    {
+        EnsureCell(ordinal);
+        return _rows.GetStorageClass(_currentRowIndex, ordinal);
+    }
 
-        if (value is null)
+    /// <summary>
+    /// Whole value of a deferred BLOB, fetched over the synchronous channel.
+    /// </summary>
+    private byte[] ReadDeferredBlob(int ordinal)
+    {
+        if (!SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable)
         {
-            return DBNull.Value;
+            throw new InvalidOperationException(
+                $"Column {ordinal} holds a BLOB left in the database (SequentialAccess). " +
+                "Read it with GetStream or GetFieldValueAsync<byte[]>, or enable SqliteWasmOptions.SynchronousChannelSize.");
         }
 
-        return value;
+        using var blob = SqliteWasmBlob.FromReference(RequireConnection(), _rows.GetBlobReference(_currentRowIndex, ordinal));
+        var bytes = new byte[blob.Length];
+        blob.ReadExactly(bytes);
+        return bytes;
     }
 
-    public override int GetValues(object[] values)
+    private SqliteWasmConnection RequireConnection()
     {
-        if (_currentRowIndex < 0 || _currentRowIndex >= _result.Rows.Length)
+        return _connection ?? throw new InvalidOperationException("This reader has no connection to open a BLOB on.");
+    }
+
+    private void EnsureCell(int ordinal)
+    {
+        if (_currentRowIndex < 0 || _currentRowIndex >= _rows.RowCount)
         {
             throw new InvalidOperationException("No current row.");
         }
 
-        var count = Math.Min(values.Length, FieldCount);
-        for (var i = 0; i < count; i++)
+        if (ordinal < 0 || ordinal >= _rows.ColumnCount)
         {
-            values[i] = GetValue(i);
+            throw new ArgumentOutOfRangeException(nameof(ordinal));
         }
-        return count;
     }
 
-    public override bool IsDBNull(int ordinal)
+    public override bool NextResult()
     {
-        var value = GetValue(ordinal);
-        return value is DBNull;
+        // Only batch readers carry more than one result; batch results are never cursors
+        if (_results is null || !MoveToNextResultSet())
+        {
+            return false;
+        }
+
+        _rows = _result.Rows;
+        _cursorId = 0;
+        _currentRowIndex = -1;
+        return true;
     }
 
-    public override bool NextResult()
+    /// <summary>
+    /// Advance <see cref="_result"/> to the next batch result that has
+    /// columns, skipping those of non-query commands.
+    /// </summary>
+    private bool MoveToNextResultSet()
     {
-        // SQLite doesn't support multiple result sets
+        while (++_resultIndex < _results!.Count)
+        {
+            if (_results[_resultIndex].ColumnNames.Count > 0)
+            {
+                _result = _results[_resultIndex];
+                return true;
+            }
+        }
         return false;
     }
 
@@ -340,8 +561,42 @@ public sealed class SqliteWasmDataReader : DbDataReader
             throw new InvalidOperationException("DataReader is closed.");
         }
 
+        if (_currentRowIndex + 1 >= _rows.RowCount && _cursorId != 0)
+        {
+            throw new InvalidOperationException(
+                "This reader streams its rows from the worker; use ReadAsync to fetch the next batch.");
+        }
+
         _currentRowIndex++;
-        return _currentRowIndex < _result.Rows.Length;
+        return _currentRowIndex < _rows.RowCount;
+    }
+
+    public override async Task<bool> ReadAsync(CancellationToken cancellationToken)
+    {
+        if (_isClosed)
+        {
+            throw new InvalidOperationException("DataReader is closed.");
+        }
+
+        _currentRowIndex++;
+        if (_currentRowIndex < _rows.RowCount)
+        {
+            return true;
+        }
+
+        while (_cursorId != 0)
+        {
+            var batch = await SqliteWasmWorkerBridge.Instance.FetchCursorAsync(_cursorId, _batchSize, cancellationToken);
+            _cursorId = batch.CursorId;
+            _rows = batch.Rows;
+            _currentRowIndex = 0;
+            if (_rows.RowCount > 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
     }
 
     public override IEnumerator GetEnumerator()
@@ -351,7 +606,55 @@ public sealed class SqliteWasmDataReader : DbDataReader
 
     public override void Close()
     {
+        if (_isClosed)
+        {
+            return;
+        }
+
         _isClosed = true;
+        if (_cursorId != 0)
+        {
+            // Can't await here — release in the background; the worker also
+            // drops any leftover cursor when the database is closed.
+            _ = ReleaseCursorAsync();
+        }
+    }
+
+    public override async Task CloseAsync()
+    {
+        if (_isClosed)
+        {
+            return;
+        }
+
+        _isClosed = true;
+        await ReleaseCursorAsync();
+    }
+
+    public override async ValueTask DisposeAsync()
+    {
+        await CloseAsync();
+        await base.DisposeAsync();
+    }
+
+    private async Task ReleaseCursorAsync()
+    {
+        var cursorId = _cursorId;
+        if (cursorId == 0)
+        {
+            return;
+        }
+
+        _cursorId = 0;
+        _rows = ColumnarRowSet.Empty;
+        try
+        {
+            await SqliteWasmWorkerBridge.Instance.CloseCursorAsync(cursorId, CancellationToken.None);
+        }
+        catch (Exception ex)
+        {
+            Console.Error.WriteLine($"[SqliteWasmDataReader] Failed to close cursor {cursorId}: {ex.Message}");
+        }
     }
 
     protected override void Dispose(bool disposing)
@@ -205,6 +205,19 @@ public sealed class SqliteWasmParameterCollection : DbParameterCollection
         _parameters[index] = (SqliteWasmParameter)value;
     }
 
+    /// <summary>
+    /// Ensure the parameter name has a prefix (<c>@</c> unless it already
+    /// carries <c>@</c>, <c>$</c> or <c>:</c>) for SQLite compatibility.
+    /// </summary>
+    internal static string NormalizeParameterName(string parameterName)
+    {
+        if (!string.IsNullOrEmpty(parameterName) && !parameterName.StartsWith('@') && !parameterName.StartsWith('$') && !parameterName.StartsWith(':'))
+        {
+            return "@" + parameterName;
+        }
+        return parameterName;
+    }
+
     /// <summary>
     /// Gets parameter values as dictionary for sending to worker.
     /// Each parameter includes value and type metadata for proper SQLite binding.
@@ -282,12 +295,7 @@ public sealed class SqliteWasmParameterCollection : DbParameterCollection
                 sqliteType = "text";
             }
 
-            // Ensure parameter name has @ prefix for SQLite compatibility
-            var paramName = param.ParameterName;
-            if (!string.IsNullOrEmpty(paramName) && !paramName.StartsWith('@') && !paramName.StartsWith('$') && !paramName.StartsWith(':'))
-            {
-                paramName = "@" + paramName;
-            }
+            var paramName = NormalizeParameterName(param.ParameterName);
 
             // Send parameter with type metadata
             result[paramName] = new Dictionary<string, object?>
@@ -408,11 +416,7 @@ public sealed class SqliteWasmParameterCollection : DbParameterCollection
                 sqliteType = "text";
             }
 
-            var paramName = param.ParameterName;
-            if (!string.IsNullOrEmpty(paramName) && !paramName.StartsWith('@') && !paramName.StartsWith('$') && !paramName.StartsWith(':'))
-            {
-                paramName = "@" + paramName;
-            }
+            var paramName = NormalizeParameterName(param.ParameterName);
 
             result[paramName] = new Dictionary<string, object?>
             {
@@ -0,0 +1,30 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Scheduling class of a command in the worker. Requests waiting for the
+/// worker start highest class first, in order within a class. A running
+/// statement is never preempted by a higher class. Values match the
+/// worker's PRIORITY_* constants (request-scheduler.ts).
+/// </summary>
+public enum SqliteWasmRequestPriority : byte
+{
+    /// <summary>
+    /// Default: queries and updates a user is waiting for.
+    /// </summary>
+    Interactive = 0,
+
+    /// <summary>
+    /// Work nobody waits on (sync, prefetch, indexing); runs when no
+    /// interactive request is waiting.
+    /// </summary>
+    Background = 1,
+
+    /// <summary>
+    /// Runs after all other waiting work. Exports, imports and snapshot
+    /// copies always run in this class.
+    /// </summary>
+    Maintenance = 2
+}
@@ -9,26 +9,52 @@ namespace SqliteWasmBlazor;
 /// <summary>
 /// Transaction that wraps BEGIN/COMMIT/ROLLBACK SQL commands.
 /// </summary>
+/// <remarks>
+/// BEGIN is deferred: nothing is sent when the transaction is created. The
+/// first command executed on the connection carries the BEGIN statement as a
+/// prefix the worker runs in the same round trip. A transaction that never
+/// executes a command commits or rolls back without contacting the worker.
+/// </remarks>
 public sealed class SqliteWasmTransaction : DbTransaction
 {
+    // Error prefix of runDeferredBegin (TypeScript-Common/src/sql-execute.ts)
+    private const string DeferredBeginFailed = "Deferred BEGIN failed";
+
     private readonly SqliteWasmConnection _connection;
     private readonly IsolationLevel _isolationLevel;
+    private BeginState _beginState = BeginState.Deferred;
     private bool _completed;
 
+    private enum BeginState
+    {
+        /// <summary>BEGIN not sent yet.</summary>
+        Deferred,
+        /// <summary>BEGIN travelling with a command whose response is pending.</summary>
+        Sent,
+        /// <summary>BEGIN ran; the worker holds an open transaction.</summary>
+        Active,
+        /// <summary>BEGIN itself failed; there is nothing to commit or roll back.</summary>
+        Failed
+    }
+
     private SqliteWasmTransaction(SqliteWasmConnection connection, IsolationLevel isolationLevel)
     {
         _connection = connection ?? throw new ArgumentNullException(nameof(connection));
         _isolationLevel = isolationLevel;
     }
 
-    internal static async Task<SqliteWasmTransaction> CreateAsync(
+    internal static Task<SqliteWasmTransaction> CreateAsync(
         SqliteWasmConnection connection,
         IsolationLevel isolationLevel,
         CancellationToken cancellationToken = default)
     {
-        var transaction = new SqliteWasmTransaction(connection, isolationLevel);
-        await transaction.ExecuteNonQueryAsync(GetBeginSql(isolationLevel), cancellationToken);
-        return transaction;
+        cancellationToken.ThrowIfCancellationRequested();
+        return Task.FromResult(new SqliteWasmTransaction(connection, isolationLevel));
+    }
+
+    internal static SqliteWasmTransaction Create(SqliteWasmConnection connection, IsolationLevel isolationLevel)
+    {
+        return new SqliteWasmTransaction(connection, isolationLevel);
     }
 
     public override IsolationLevel IsolationLevel => _isolationLevel;
@@ -42,7 +68,11 @@ public sealed class SqliteWasmTransaction : DbTransaction
             throw new InvalidOperationException("Transaction has already been committed or rolled back.");
         }
 
-        ExecuteNonQuery("COMMIT");
+        ThrowIfBeginFailed();
+        if (_beginState == BeginState.Active)
+        {
+            ExecuteNonQuery("COMMIT");
+        }
         _completed = true;
         _connection.ClearCurrentTransaction(this);
     }
@@ -54,7 +84,10 @@ public sealed class SqliteWasmTransaction : DbTransaction
             throw new InvalidOperationException("Transaction has already been committed or rolled back.");
         }
 
-        ExecuteNonQuery("ROLLBACK");
+        if (_beginState == BeginState.Active)
+        {
+            ExecuteNonQuery("ROLLBACK");
+        }
         _completed = true;
         _connection.ClearCurrentTransaction(this);
     }
@@ -66,7 +99,11 @@ public sealed class SqliteWasmTransaction : DbTransaction
             throw new InvalidOperationException("Transaction has already been committed or rolled back.");
         }
 
-        await ExecuteNonQueryAsync("COMMIT", cancellationToken);
+        ThrowIfBeginFailed();
+        if (_beginState == BeginState.Active)
+        {
+            await ExecuteNonQueryAsync("COMMIT", cancellationToken);
+        }
         _completed = true;
         _connection.ClearCurrentTransaction(this);
     }
@@ -78,7 +115,10 @@ public sealed class SqliteWasmTransaction : DbTransaction
             throw new InvalidOperationException("Transaction has already been committed or rolled back.");
         }
 
-        await ExecuteNonQueryAsync("ROLLBACK", cancellationToken);
+        if (_beginState == BeginState.Active)
+        {
+            await ExecuteNonQueryAsync("ROLLBACK", cancellationToken);
+        }
         _completed = true;
         _connection.ClearCurrentTransaction(this);
     }
@@ -103,6 +143,46 @@ public sealed class SqliteWasmTransaction : DbTransaction
         base.Dispose(disposing);
     }
 
+    /// <summary>
+    /// The BEGIN statement to prefix to the next command, or null once it
+    /// has been handed out. Must be paired with <see cref="CompleteDeferredBegin"/>.
+    /// </summary>
+    internal string? TakeDeferredBegin()
+    {
+        if (_completed || _beginState != BeginState.Deferred)
+        {
+            return null;
+        }
+
+        _beginState = BeginState.Sent;
+        return GetBeginSql(_isolationLevel);
+    }
+
+    /// <summary>
+    /// Record the outcome of the command that carried the BEGIN. A failing
+    /// statement still leaves the transaction open; only a failure of the
+    /// BEGIN itself (tagged by the worker) means none was started.
+    /// </summary>
+    internal void CompleteDeferredBegin(Exception? error)
+    {
+        if (_beginState != BeginState.Sent)
+        {
+            return;
+        }
+
+        _beginState = error?.Message.Contains(DeferredBeginFailed, StringComparison.Ordinal) == true
+            ? BeginState.Failed
+            : BeginState.Active;
+    }
+
+    private void ThrowIfBeginFailed()
+    {
+        if (_beginState == BeginState.Failed)
+        {
+            throw new InvalidOperationException("The transaction could not be started; there is nothing to commit.");
+        }
+    }
+
     private void ExecuteNonQuery(string sql)
     {
         using var command = _connection.CreateCommand();
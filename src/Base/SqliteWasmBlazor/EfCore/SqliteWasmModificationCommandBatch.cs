@@ -0,0 +1,235 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Diagnostics;
+using System.Text.RegularExpressions;
+using Microsoft.EntityFrameworkCore;
+using Microsoft.EntityFrameworkCore.Diagnostics;
+using Microsoft.EntityFrameworkCore.Storage;
+using Microsoft.EntityFrameworkCore.Update;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// SaveChanges batch that ships its INSERT/UPDATE/DELETE commands to the
+/// worker as one atomic 'executeBatch' request instead of one concatenated
+/// command per batch (or, with the stock SQLite factory, one round trip per
+/// entity).
+/// </summary>
+/// <remarks>
+/// The SQL generator's output is kept per modification command. Each
+/// command's parameters are renamed to <c>@p0..@pN</c> so that identical
+/// modifications produce identical SQL and hit the worker's prepared
+/// statement cache. The worker runs the batch under a savepoint, which
+/// makes it all-or-nothing on its own: a SaveChanges that fits into one
+/// batch needs no BEGIN/COMMIT and completes in a single round trip.
+/// Generated values and row counts come back as one framed result and are
+/// consumed by the base class exactly as from a multi-result reader.
+/// <para>
+/// The batch is logged like the command EF would have run: the command
+/// events carry the generated SQL and its parameters. Command interceptors
+/// cannot see or replace a batch, so with one registered SaveChanges takes
+/// the base per-command path instead.
+/// </para>
+/// </remarks>
+internal sealed partial class SqliteWasmModificationCommandBatch : AffectedCountModificationCommandBatch
+{
+    private readonly List<(string Sql, int ParameterEnd)> _segments = [];
+
+    public SqliteWasmModificationCommandBatch(ModificationCommandBatchFactoryDependencies dependencies, int maxBatchSize)
+        : base(dependencies, maxBatchSize)
+    {
+    }
+
+    /// <summary>
+    /// The worker's savepoint makes every batch atomic; the base path
+    /// used with command interceptors needs the transaction.
+    /// </summary>
+    public override bool RequiresTransaction => UsesCommandInterceptors && base.RequiresTransaction;
+
+    private bool UsesCommandInterceptors
+        => Dependencies.Logger.Interceptors?.Aggregate<IDbCommandInterceptor>() is not null;
+
+    protected override void AddCommand(IReadOnlyModificationCommand modificationCommand)
+    {
+        var sqlStart = SqlBuilder.Length;
+        base.AddCommand(modificationCommand);
+        _segments.Add((SqlBuilder.ToString(sqlStart, SqlBuilder.Length - sqlStart), RelationalCommandBuilder.Parameters.Count));
+    }
+
+    protected override void RollbackLastCommand(IReadOnlyModificationCommand modificationCommand)
+    {
+        _segments.RemoveAt(_segments.Count - 1);
+        base.RollbackLastCommand(modificationCommand);
+    }
+
+    public override void Execute(IRelationalConnection connection)
+    {
+        if (connection.DbConnection is not SqliteWasmConnection sqliteConnection
+            || !SqliteWasmWorkerBridge.Instance.IsSynchronousExecutionAvailable
+            || UsesCommandInterceptors)
+        {
+            base.Execute(connection);
+            return;
+        }
+
+        connection.Open();
+        var logger = Dependencies.Logger;
+        var commandId = Guid.NewGuid();
+        var startTime = DateTimeOffset.UtcNow;
+        var stopwatch = Stopwatch.StartNew();
+        SqliteWasmCommand? command = null;
+        RelationalDataReader? reader = null;
+        try
+        {
+            command = sqliteConnection.CreateCommand();
+            var batch = CreateStoreBatch(connection, command);
+
+            // No command interceptors on this path: the interception result is always empty
+            logger.CommandReaderExecuting(
+                connection, command, connection.Context, commandId, connection.ConnectionId, startTime, CommandSource.SaveChanges);
+            var dataReader = logger.CommandReaderExecuted(
+                connection, command, connection.Context, commandId, connection.ConnectionId,
+                batch.ExecuteReader(), startTime, stopwatch.Elapsed, CommandSource.SaveChanges);
+
+            reader = new RelationalDataReader();
+            reader.Initialize(connection, command, dataReader, commandId, logger);
+            Consume(reader);
+        }
+        catch (Exception ex) when (ex is not DbUpdateException and not OperationCanceledException)
+        {
+            if (command is not null && reader is null)
+            {
+                logger.CommandError(
+                    connection, command, connection.Context, DbCommandMethod.ExecuteReader, commandId, connection.ConnectionId,
+                    ex, startTime, stopwatch.Elapsed, CommandSource.SaveChanges);
+            }
+            throw new DbUpdateException(RelationalStrings.UpdateStoreException, ex, ModificationCommands.SelectMany(c => c.Entries).ToList());
+        }
+        finally
+        {
+            // The reader closes the connection it was given; without one, close it here
+            if (reader is not null)
+            {
+                reader.Dispose();
+            }
+            else
+            {
+                connection.Close();
+            }
+        }
+    }
+
+    public override async Task ExecuteAsync(IRelationalConnection connection, CancellationToken cancellationToken = default)
+    {
+        if (connection.DbConnection is not SqliteWasmConnection sqliteConnection || UsesCommandInterceptors)
+        {
+            await base.ExecuteAsync(connection, cancellationToken);
+            return;
+        }
+
+        await connection.OpenAsync(cancellationToken);
+        var logger = Dependencies.Logger;
+        var commandId = Guid.NewGuid();
+        var startTime = DateTimeOffset.UtcNow;
+        var stopwatch = Stopwatch.StartNew();
+        SqliteWasmCommand? command = null;
+        RelationalDataReader? reader = null;
+        try
+        {
+            command = sqliteConnection.CreateCommand();
+            var batch = CreateStoreBatch(connection, command);
+
+            await logger.CommandReaderExecutingAsync(
+                connection, command, connection.Context, commandId, connection.ConnectionId, startTime,
+                CommandSource.SaveChanges, cancellationToken);
+            var dataReader = await logger.CommandReaderExecutedAsync(
+                connection, command, connection.Context, commandId, connection.ConnectionId,
+                await batch.ExecuteReaderAsync(cancellationToken), startTime, stopwatch.Elapsed,
+                CommandSource.SaveChanges, cancellationToken);
+
+            reader = new RelationalDataReader();
+            reader.Initialize(connection, command, dataReader, commandId, logger);
+            await ConsumeAsync(reader, cancellationToken);
+        }
+        catch (Exception ex) when (ex is not DbUpdateException and not OperationCanceledException)
+        {
+            if (command is not null && reader is null)
+            {
+                await logger.CommandErrorAsync(
+                    connection, command, connection.Context, DbCommandMethod.ExecuteReader, commandId, connection.ConnectionId,
+                    ex, startTime, stopwatch.Elapsed, CommandSource.SaveChanges, cancellationToken);
+            }
+            throw new DbUpdateException(RelationalStrings.UpdateStoreException, ex, ModificationCommands.SelectMany(c => c.Entries).ToList());
+        }
+        finally
+        {
+            if (reader is not null)
+            {
+                await reader.DisposeAsync();
+            }
+            else
+            {
+                await connection.CloseAsync();
+            }
+        }
+    }
+
+    /// <summary>
+    /// One atomic batch command per modification. The parameters are
+    /// materialized through <paramref name="command"/> — their type mappings
+    /// apply value converters and DbType — and copied to the batch command of
+    /// the modification they belong to. <paramref name="command"/> keeps the
+    /// generated SQL and parameters for the command events.
+    /// </summary>
+    private SqliteWasmBatch CreateStoreBatch(IRelationalConnection connection, SqliteWasmCommand command)
+    {
+        var storeCommand = StoreCommand!;
+        command.CommandText = storeCommand.RelationalCommand.CommandText;
+        foreach (var parameter in storeCommand.RelationalCommand.Parameters)
+        {
+            parameter.AddDbParameter(command, storeCommand.ParameterValues);
+        }
+
+        var parameters = command.Parameters.Cast<SqliteWasmParameter>().ToArray();
+        var batch = new SqliteWasmBatch((SqliteWasmConnection)connection.DbConnection) { Atomic = true };
+
+        // Only a configured timeout is passed on; unset, async SaveChanges keeps the bridge's limit
+        if (connection.CommandTimeout is { } commandTimeout)
+        {
+            command.CommandTimeout = commandTimeout;
+            batch.Timeout = commandTimeout;
+        }
+
+        var parameterStart = 0;
+        foreach (var (sql, parameterEnd) in _segments)
+        {
+            var batchCommand = new SqliteWasmBatchCommand();
+            var renamed = new Dictionary<string, string>(parameterEnd - parameterStart, StringComparer.Ordinal);
+            for (var i = parameterStart; i < parameterEnd; i++)
+            {
+                var parameter = parameters[i];
+                var canonicalName = "@p" + (i - parameterStart);
+                renamed[SqliteWasmParameterCollection.NormalizeParameterName(parameter.ParameterName)] = canonicalName;
+                batchCommand.Parameters.Add(new SqliteWasmParameter(canonicalName, parameter.Value)
+                {
+                    DbType = parameter.DbType,
+                    Direction = parameter.Direction,
+                    IsNullable = parameter.IsNullable,
+                    Size = parameter.Size
+                });
+            }
+
+            batchCommand.CommandText = renamed.Count == 0
+                ? sql
+                : ParameterPlaceholder().Replace(sql, m => renamed.TryGetValue(m.Value, out var name) ? name : m.Value);
+            batch.BatchCommands.Add(batchCommand);
+            parameterStart = parameterEnd;
+        }
+
+        return batch;
+    }
+
+    [GeneratedRegex(@"[@$:]\w+")]
+    private static partial Regex ParameterPlaceholder();
+}
@@ -0,0 +1,40 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using Microsoft.EntityFrameworkCore.Infrastructure;
+using Microsoft.EntityFrameworkCore.Update;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Replaces the SQLite provider's one-command-per-batch factory. In-process
+/// SQLite gains nothing from batching, but every command here is a worker
+/// round trip, so SaveChanges groups up to <see cref="DefaultMaxBatchSize"/>
+/// modifications into one <see cref="SqliteWasmModificationCommandBatch"/>.
+/// <c>MaxBatchSize</c> from the relational options overrides the default.
+/// </summary>
+internal sealed class SqliteWasmModificationCommandBatchFactory : IModificationCommandBatchFactory
+{
+    /// <summary>
+    /// Statements are bound one by one in the worker, so SQLite's
+    /// host-parameter limit does not apply; this only bounds message size.
+    /// </summary>
+    public const int DefaultMaxBatchSize = 1000;
+
+    private readonly ModificationCommandBatchFactoryDependencies _dependencies;
+    private readonly int _maxBatchSize;
+
+    public SqliteWasmModificationCommandBatchFactory(
+        ModificationCommandBatchFactoryDependencies dependencies,
+        IDbContextOptions options)
+    {
+        _dependencies = dependencies;
+        _maxBatchSize = options.Extensions.OfType<RelationalOptionsExtension>().FirstOrDefault()?.MaxBatchSize
+            ?? DefaultMaxBatchSize;
+    }
+
+    public ModificationCommandBatch Create()
+    {
+        return new SqliteWasmModificationCommandBatch(_dependencies, _maxBatchSize);
+    }
+}
@@ -4,6 +4,7 @@
 using Microsoft.EntityFrameworkCore;
 using Microsoft.EntityFrameworkCore.Migrations;
 using Microsoft.EntityFrameworkCore.Storage;
+using Microsoft.EntityFrameworkCore.Update;
 
 namespace SqliteWasmBlazor;
 
@@ -37,6 +38,10 @@ public static class SqliteWasmDbContextOptionsExtensions
         // The EF Core migration lock mechanism causes infinite polling in WASM
         optionsBuilder.ReplaceService<IHistoryRepository, SqliteWasmHistoryRepository>();
 
+        // Replace the one-command-per-batch factory so SaveChanges sends its
+        // modifications to the worker in one atomic round trip
+        optionsBuilder.ReplaceService<IModificationCommandBatchFactory, SqliteWasmModificationCommandBatchFactory>();
+
         return optionsBuilder;
     }
 
@@ -15,4 +15,61 @@ public sealed class SqliteWasmOptions : SqliteWasmAssetOptions
     {
         AssetRoot = "_content/SqliteWasmBlazor/";
     }
+
+    /// <summary>
+    /// Maximum number of prepared statements the worker keeps per open
+    /// database, keyed by SQL text (LRU eviction). EF Core re-issues the same
+    /// parameterized SQL for every query shape, so a hit skips SQLite's
+    /// parse/plan step entirely. Defaults to 64; set to 0 to prepare on every
+    /// call. Applied once, when the worker is created.
+    /// </summary>
+    public int StatementCacheSize { get; set; } = 64;
+
+    /// <summary>
+    /// Rows per round trip for <see cref="SqliteWasmDataReader"/> over
+    /// read-only queries. When greater than 0 the worker keeps the statement
+    /// open as a cursor and <c>ReadAsync</c> pulls the next batch on demand,
+    /// bounding memory and time-to-first-row on large scans. Defaults to 0
+    /// (the whole result set arrives in one message). Individual commands can
+    /// override it via <see cref="SqliteWasmCommand.ReaderBatchSize"/>.
+    /// Values between 256 and 4096 are a good range.
+    /// </summary>
+    public int ReaderBatchSize { get; set; }
+
+    /// <summary>
+    /// Size in bytes of the shared-memory channel that makes the synchronous
+    /// ADO.NET surface (<c>ExecuteNonQuery</c>, <c>ExecuteScalar</c>,
+    /// <c>ExecuteReader</c>, <c>Open</c>, <c>BeginTransaction</c>) — and with it
+    /// EF Core's synchronous <c>SaveChanges</c> / <c>Find</c> / LINQ paths —
+    /// actually execute. The calling thread blocks until the worker answers
+    /// or <see cref="System.Data.Common.DbCommand.CommandTimeout"/> elapses.
+    /// Requires a cross-origin-isolated page (<c>Cross-Origin-Opener-Policy:
+    /// same-origin</c> + <c>Cross-Origin-Embedder-Policy: require-corp</c>) for
+    /// <c>SharedArrayBuffer</c>; without it, or at the default 0, synchronous
+    /// calls keep their no-op fallback. A result larger than the channel
+    /// fails; 4 MB (4 * 1024 * 1024) suits typical point queries and writes.
+    /// </summary>
+    public int SynchronousChannelSize { get; set; }
+
+    /// <summary>
+    /// Number of snapshot read workers next to the worker that owns the
+    /// database files. Read-only queries outside a transaction run on the
+    /// least-loaded reader against an in-memory copy of the database, so a
+    /// long report no longer holds up point lookups and writes. A copy is
+    /// used only while no write has happened since it was taken. It is
+    /// refreshed after writes stop for 100 ms, and meanwhile reads go to the
+    /// owning worker. Each copy is a full database image per reader, so
+    /// this suits read-heavy databases of moderate size; see
+    /// <see cref="ReadWorkerMaxSnapshotSize"/>. Defaults to 0 (one worker).
+    /// Applied once, when the worker is created.
+    /// </summary>
+    public int ReadWorkerCount { get; set; }
+
+    /// <summary>
+    /// Largest database, in bytes, that is copied to the snapshot read
+    /// workers (<see cref="ReadWorkerCount"/>). Reads of a larger database
+    /// stay on the owning worker, so no reader holds its image. Defaults to
+    /// 64 MB (64 * 1024 * 1024); 0 copies databases of any size.
+    /// </summary>
+    public long ReadWorkerMaxSnapshotSize { get; set; } = 64 * 1024 * 1024;
 }
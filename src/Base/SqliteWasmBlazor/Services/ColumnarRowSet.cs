@@ -0,0 +1,263 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Buffers.Binary;
+using System.Text;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// SQLite storage class of a single result cell — the
+/// <c>sqlite3_column_type</c> code the worker stored as the cell's tag.
+/// </summary>
+internal enum SqliteStorageClass : byte
+{
+    Integer = 1,
+    Real = 2,
+    Text = 3,
+    Blob = 4,
+    Null = 5,
+
+    /// <summary>
+    /// Not a SQLite storage class: a BLOB the worker left in the database
+    /// (SequentialAccess readers), see <see cref="ColumnarRowSet.GetBlobReference"/>.
+    /// </summary>
+    BlobReference = 6
+}
+
+/// <summary>
+/// Location of a deferred BLOB cell — the arguments of <c>sqlite3_blob_open</c>
+/// plus the blob's length.
+/// </summary>
+internal readonly record struct SqliteWasmBlobReference(string Schema, string Table, string Column, long Rowid, long Length);
+
+/// <summary>
+/// Read-only view over the columnar result buffer produced by the worker's
+/// <c>ColumnarResultBuilder</c> (TypeScript-Common/src/columnar-result.ts;
+/// the layout is documented there). Each column is a tag array followed by
+/// one fixed 8-byte cell per row, with TEXT / BLOB bytes in a trailing heap,
+/// so the typed getters read straight out of the buffer — nothing is boxed
+/// or decoded until a value is actually asked for.
+/// </summary>
+internal sealed class ColumnarRowSet
+{
+    private const byte FormatVersion = 1;
+    private const int HeaderSize = 32;
+    private const byte FlagHasMetadata = 1;
+    private const byte BatchMarker = 0x80;
+    private const int BatchHeaderSize = 8;
+
+    private static readonly string[] AffinityNames = ["TEXT", "INTEGER", "REAL", "TEXT", "BLOB"];
+
+    public static readonly ColumnarRowSet Empty = new([], 0, 0, 0, 0);
+
+    private readonly byte[] _buffer;
+    private readonly int _columnsOffset;
+    private readonly int _tagsSize;
+    private readonly int _columnSize;
+    private readonly int _heapOffset;
+
+    private ColumnarRowSet(byte[] buffer, int columnCount, int rowCount, int columnsOffset, int heapOffset)
+    {
+        _buffer = buffer;
+        ColumnCount = columnCount;
+        RowCount = rowCount;
+        _columnsOffset = columnsOffset;
+        _tagsSize = Align8(rowCount);
+        _columnSize = _tagsSize + rowCount * 8;
+        _heapOffset = heapOffset;
+    }
+
+    public int RowCount { get; }
+
+    public int ColumnCount { get; }
+
+    /// <summary>
+    /// Decode an 'execute' / 'fetch' response, or an 'executeBatch' frame
+    /// (one result per command in <see cref="SqlQueryResult.BatchResults"/>).
+    /// Column names and types are only present on the first message of a
+    /// result; 'fetch' batches leave them empty.
+    /// </summary>
+    public static SqlQueryResult ReadResult(byte[] buffer)
+    {
+        if (buffer.Length > 0 && buffer[0] == BatchMarker)
+        {
+            return ReadBatch(buffer);
+        }
+        return ReadResult(buffer, 0, buffer.Length);
+    }
+
+    private static SqlQueryResult ReadBatch(byte[] buffer)
+    {
+        if (buffer.Length < BatchHeaderSize)
+        {
+            throw new InvalidOperationException($"Batch result truncated: {buffer.Length} bytes");
+        }
+
+        var count = BinaryPrimitives.ReadInt32LittleEndian(buffer.AsSpan(4));
+        var results = new List<SqlQueryResult>(count);
+        var rowsAffected = 0;
+        var offset = BatchHeaderSize;
+        for (var i = 0; i < count; i++)
+        {
+            var length = BinaryPrimitives.ReadInt32LittleEndian(buffer.AsSpan(offset));
+            var result = ReadResult(buffer, offset + 8, length);
+            rowsAffected += result.RowsAffected;
+            results.Add(result);
+            offset += 8 + Align8(length);
+        }
+
+        return new SqlQueryResult
+        {
+            RowsAffected = rowsAffected,
+            LastInsertId = results.Count > 0 ? results[^1].LastInsertId : 0,
+            BatchResults = results
+        };
+    }
+
+    private static SqlQueryResult ReadResult(byte[] buffer, int start, int length)
+    {
+        if (length < HeaderSize || start + length > buffer.Length)
+        {
+            throw new InvalidOperationException($"Columnar result truncated: {length} bytes");
+        }
+
+        var header = buffer.AsSpan(start, length);
+        if (header[0] != FormatVersion)
+        {
+            throw new InvalidOperationException($"Unsupported columnar result version {header[0]}");
+        }
+
+        var hasMetadata = (header[1] & FlagHasMetadata) != 0;
+        var columnCount = BinaryPrimitives.ReadInt32LittleEndian(header[4..]);
+        var rowCount = BinaryPrimitives.ReadInt32LittleEndian(header[8..]);
+        var rowsAffected = BinaryPrimitives.ReadInt32LittleEndian(header[12..]);
+        var cursorId = BinaryPrimitives.ReadInt32LittleEndian(header[16..]);
+        var heapOffset = BinaryPrimitives.ReadInt32LittleEndian(header[20..]);
+        var lastInsertId = BinaryPrimitives.ReadInt64LittleEndian(header[24..]);
+
+        var columnNames = new List<string>(hasMetadata ? columnCount : 0);
+        var columnTypes = new List<string>(hasMetadata ? columnCount : 0);
+        var offset = HeaderSize;
+        if (hasMetadata)
+        {
+            for (var i = 0; i < columnCount; i++)
+            {
+                var nameLength = BinaryPrimitives.ReadInt32LittleEndian(header[offset..]);
+                offset += 4;
+                columnNames.Add(Encoding.UTF8.GetString(header.Slice(offset, nameLength)));
+                offset += nameLength;
+                var affinity = header[offset++];
+                columnTypes.Add(affinity < AffinityNames.Length ? AffinityNames[affinity] : "TEXT");
+            }
+        }
+
+        var columnsOffset = Align8(offset);
+        if (heapOffset < columnsOffset || heapOffset > length
+            || (long)columnCount * (Align8(rowCount) + (long)rowCount * 8) != heapOffset - columnsOffset)
+        {
+            throw new InvalidOperationException("Columnar result layout does not match its header");
+        }
+
+        return new SqlQueryResult
+        {
+            ColumnNames = columnNames,
+            ColumnTypes = columnTypes,
+            Rows = new ColumnarRowSet(buffer, columnCount, rowCount, start + columnsOffset, start + heapOffset),
+            RowsAffected = rowsAffected,
+            LastInsertId = lastInsertId,
+            CursorId = cursorId
+        };
+    }
+
+    public SqliteStorageClass GetStorageClass(int row, int column)
+    {
+        return (SqliteStorageClass)_buffer[ColumnStart(column) + row];
+    }
+
+    public bool IsNull(int row, int column)
+    {
+        return GetStorageClass(row, column) == SqliteStorageClass.Null;
+    }
+
+    /// <summary>INTEGER cell. Caller has checked the storage class.</summary>
+    public long GetInt64(int row, int column)
+    {
+        return BinaryPrimitives.ReadInt64LittleEndian(Cell(row, column));
+    }
+
+    /// <summary>REAL cell. Caller has checked the storage class.</summary>
+    public double GetDouble(int row, int column)
+    {
+        return BinaryPrimitives.ReadDoubleLittleEndian(Cell(row, column));
+    }
+
+    /// <summary>UTF-8 bytes of a TEXT cell or the bytes of a BLOB cell.</summary>
+    public ReadOnlySpan<byte> GetBytes(int row, int column)
+    {
+        var cell = Cell(row, column);
+        var start = BinaryPrimitives.ReadInt32LittleEndian(cell);
+        var length = BinaryPrimitives.ReadInt32LittleEndian(cell[4..]);
+        return _buffer.AsSpan(_heapOffset + start, length);
+    }
+
+    /// <summary>BLOB_REF cell. Caller has checked the storage class.</summary>
+    public SqliteWasmBlobReference GetBlobReference(int row, int column)
+    {
+        var entry = GetBytes(row, column);
+        var rowid = BinaryPrimitives.ReadInt64LittleEndian(entry);
+        var length = BinaryPrimitives.ReadInt64LittleEndian(entry[8..]);
+        var offset = 16;
+        var schema = ReadName(entry, ref offset);
+        var table = ReadName(entry, ref offset);
+        var name = ReadName(entry, ref offset);
+        return new SqliteWasmBlobReference(schema, table, name, rowid, length);
+    }
+
+    private static string ReadName(ReadOnlySpan<byte> entry, ref int offset)
+    {
+        var length = BinaryPrimitives.ReadInt32LittleEndian(entry[offset..]);
+        var name = Encoding.UTF8.GetString(entry.Slice(offset + 4, length));
+        offset += 4 + length;
+        return name;
+    }
+
+    /// <summary>TEXT cell. Caller has checked the storage class.</summary>
+    public string GetString(int row, int column)
+    {
+        return Encoding.UTF8.GetString(GetBytes(row, column));
+    }
+
+    /// <summary>
+    /// Boxed value as the ADO.NET surface reports it: long, double, string,
+    /// byte[] or null. Deferred BLOBs are the reader's to fetch.
+    /// </summary>
+    public object? GetValue(int row, int column)
+    {
+        return GetStorageClass(row, column) switch
+        {
+            SqliteStorageClass.Integer => GetInt64(row, column),
+            SqliteStorageClass.Real => GetDouble(row, column),
+            SqliteStorageClass.Text => GetString(row, column),
+            SqliteStorageClass.Blob => GetBytes(row, column).ToArray(),
+            SqliteStorageClass.BlobReference => throw new InvalidOperationException(
+                "Column holds a deferred BLOB; read it through the data reader."),
+            _ => null
+        };
+    }
+
+    private int ColumnStart(int column)
+    {
+        return _columnsOffset + column * _columnSize;
+    }
+
+    private ReadOnlySpan<byte> Cell(int row, int column)
+    {
+        return _buffer.AsSpan(ColumnStart(column) + _tagsSize + row * 8, 8);
+    }
+
+    private static int Align8(int value)
+    {
+        return (value + 7) & ~7;
+    }
+}
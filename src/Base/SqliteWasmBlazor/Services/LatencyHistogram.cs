@@ -0,0 +1,65 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Fixed-size latency histogram behind <see cref="SqliteWasmWorkerBridge.GetStatistics"/>.
+/// Buckets grow by √2 from 10 µs, so 48 of them reach about three minutes
+/// (slower samples land in the last one). Recording is an index computation and an
+/// increment; percentiles are bucket upper bounds, capped at the largest
+/// sample. Not thread-safe — the bridge records under its own lock.
+/// </summary>
+internal sealed class LatencyHistogram
+{
+    private const double FirstBucketMs = 0.01;
+    private const int BucketCount = 48;
+
+    private readonly long[] _buckets = new long[BucketCount];
+    private long _count;
+    private double _sumMs;
+    private double _maxMs;
+
+    public void Record(double milliseconds)
+    {
+        var value = Math.Max(0, milliseconds);
+        var index = value <= FirstBucketMs
+            ? 0
+            : Math.Min(BucketCount - 1, (int)Math.Ceiling(2 * Math.Log2(value / FirstBucketMs)));
+        _buckets[index]++;
+        _count++;
+        _sumMs += value;
+        _maxMs = Math.Max(_maxMs, value);
+    }
+
+    public SqliteWasmLatencyStatistics Snapshot()
+    {
+        return new SqliteWasmLatencyStatistics(
+            _count,
+            _count == 0 ? 0 : _sumMs / _count,
+            Percentile(0.50),
+            Percentile(0.95),
+            Percentile(0.99),
+            _maxMs);
+    }
+
+    private double Percentile(double fraction)
+    {
+        if (_count == 0)
+        {
+            return 0;
+        }
+
+        var rank = (long)Math.Ceiling(fraction * _count);
+        long seen = 0;
+        for (var i = 0; i < BucketCount; i++)
+        {
+            seen += _buckets[i];
+            if (seen >= rank)
+            {
+                return Math.Min(_maxMs, FirstBucketMs * Math.Pow(2, i / 2.0));
+            }
+        }
+        return _maxMs;
+    }
+}
@@ -0,0 +1,137 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Buffers.Binary;
+using System.Text;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Writes a ZIP archive from entries that are already deflated — the
+/// worker's compression helpers produce the deflate-raw data, CRC-32 and
+/// sizes, so nothing is compressed on the .NET thread
+/// (<see cref="System.IO.Compression.ZipArchive"/> can only compress
+/// itself). Sizes are known before an entry starts, so each local header
+/// is final and the destination need not be seekable. No ZIP64: entries
+/// and archives past 4 GB are rejected.
+/// </summary>
+internal sealed class PrecompressedZipWriter(Stream destination)
+{
+    private const ushort Version = 20;
+    private const ushort Utf8NamesFlag = 0x0800;
+    private const ushort DeflateMethod = 8;
+
+    private readonly List<Entry> _entries = [];
+    private readonly ushort _dosTime = ToDosTime(DateTime.Now);
+    private readonly ushort _dosDate = ToDosDate(DateTime.Now);
+    private long _position;
+
+    private sealed record Entry(byte[] Name, uint Crc32, uint CompressedLength, uint Length, uint Offset);
+
+    /// <summary>
+    /// Write the local header of <paramref name="name"/>, then let
+    /// <paramref name="writeData"/> copy exactly
+    /// <paramref name="compressedLength"/> deflate-raw bytes to the stream.
+    /// </summary>
+    public async Task WriteEntryAsync(
+        string name,
+        uint crc32,
+        long length,
+        long compressedLength,
+        Func<Stream, Task> writeData,
+        CancellationToken cancellationToken)
+    {
+        var entry = new Entry(
+            Encoding.UTF8.GetBytes(name),
+            crc32,
+            ToZip32(compressedLength, name),
+            ToZip32(length, name),
+            ToZip32(_position, name));
+
+        var header = new byte[30 + entry.Name.Length];
+        var span = header.AsSpan();
+        BinaryPrimitives.WriteUInt32LittleEndian(span, 0x04034b50);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[4..], Version);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[6..], Utf8NamesFlag);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[8..], DeflateMethod);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[10..], _dosTime);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[12..], _dosDate);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[14..], entry.Crc32);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[18..], entry.CompressedLength);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[22..], entry.Length);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[26..], (ushort)entry.Name.Length);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[28..], 0);
+        entry.Name.CopyTo(span[30..]);
+
+        await destination.WriteAsync(header, cancellationToken);
+        await writeData(destination);
+        _position += header.Length + compressedLength;
+        _entries.Add(entry);
+    }
+
+    /// <summary>
+    /// Write the central directory. The archive is complete afterwards.
+    /// </summary>
+    public async Task FinishAsync(CancellationToken cancellationToken)
+    {
+        if (_entries.Count > ushort.MaxValue)
+        {
+            throw new NotSupportedException($"ZIP archive has {_entries.Count} entries; ZIP64 is not supported.");
+        }
+
+        var directoryOffset = ToZip32(_position, "central directory");
+        using var directory = new MemoryStream();
+        foreach (var entry in _entries)
+        {
+            var header = new byte[46 + entry.Name.Length];
+            var span = header.AsSpan();
+            BinaryPrimitives.WriteUInt32LittleEndian(span, 0x02014b50);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[4..], Version);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[6..], Version);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[8..], Utf8NamesFlag);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[10..], DeflateMethod);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[12..], _dosTime);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[14..], _dosDate);
+            BinaryPrimitives.WriteUInt32LittleEndian(span[16..], entry.Crc32);
+            BinaryPrimitives.WriteUInt32LittleEndian(span[20..], entry.CompressedLength);
+            BinaryPrimitives.WriteUInt32LittleEndian(span[24..], entry.Length);
+            BinaryPrimitives.WriteUInt16LittleEndian(span[28..], (ushort)entry.Name.Length);
+            // Extra field, comment, disk number, attributes: all zero
+            BinaryPrimitives.WriteUInt32LittleEndian(span[42..], entry.Offset);
+            entry.Name.CopyTo(span[46..]);
+            directory.Write(header);
+        }
+
+        var end = new byte[22];
+        var endSpan = end.AsSpan();
+        BinaryPrimitives.WriteUInt32LittleEndian(endSpan, 0x06054b50);
+        BinaryPrimitives.WriteUInt16LittleEndian(endSpan[8..], (ushort)_entries.Count);
+        BinaryPrimitives.WriteUInt16LittleEndian(endSpan[10..], (ushort)_entries.Count);
+        BinaryPrimitives.WriteUInt32LittleEndian(endSpan[12..], (uint)directory.Length);
+        BinaryPrimitives.WriteUInt32LittleEndian(endSpan[16..], directoryOffset);
+        directory.Write(end);
+
+        directory.Position = 0;
+        await directory.CopyToAsync(destination, cancellationToken);
+        _position += directory.Length;
+    }
+
+    private static uint ToZip32(long value, string what)
+    {
+        if (value is < 0 or >= uint.MaxValue)
+        {
+            throw new NotSupportedException($"ZIP archive exceeds 4 GB at {what}; ZIP64 is not supported.");
+        }
+        return (uint)value;
+    }
+
+    private static ushort ToDosTime(DateTime time)
+    {
+        return (ushort)((time.Hour << 11) | (time.Minute << 5) | (time.Second / 2));
+    }
+
+    private static ushort ToDosDate(DateTime time)
+    {
+        return (ushort)(((Math.Max(time.Year, 1980) - 1980) << 9) | (time.Month << 5) | time.Day);
+    }
+}
@@ -0,0 +1,68 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using Microsoft.Data.Sqlite;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// In-process SQLite for apps built with <c>SqliteWasmNativeEngine=true</c>,
+/// which links the real engine (<c>native/build_native.sh</c>) into the .NET
+/// WASM module instead of the symbol stub. Connections from
+/// <see cref="CreateConnection"/> are plain <see cref="SqliteConnection"/>s:
+/// no worker, no postMessage round trip — suited to read-mostly reference
+/// data, caches and scratch analytics.
+/// </summary>
+/// <remarks>
+/// Databases live on the runtime's in-memory file system and vanish with the
+/// page; persistent OPFS databases stay with the worker-backed
+/// <see cref="SqliteWasmConnection"/>. The engine is single-threaded and runs
+/// on the calling (UI) thread, so long statements block rendering.
+/// </remarks>
+public static class SqliteWasmNativeEngine
+{
+    // sqlite3_sourceid() of native/sqlite3_stub.c
+    private const string StubSourceId = "stub-wasm-worker-bridge-2025";
+
+    private static readonly Lazy<bool> _isAvailable = new(Probe);
+
+    /// <summary>
+    /// True when the linked native library is a real SQLite build rather
+    /// than the default stub.
+    /// </summary>
+    public static bool IsAvailable => _isAvailable.Value;
+
+    /// <summary>
+    /// Unopened in-process connection. <paramref name="dataSource"/> defaults
+    /// to a private in-memory database; use a <c>file:name?mode=memory&amp;cache=shared</c>
+    /// URI to share one between connections.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">The app links the stub.</exception>
+    public static SqliteConnection CreateConnection(string dataSource = ":memory:")
+    {
+        if (!IsAvailable)
+        {
+            throw new InvalidOperationException(
+                "The in-process SQLite engine is not linked. Build native/build_native.sh and set <SqliteWasmNativeEngine>true</SqliteWasmNativeEngine> in the app project.");
+        }
+
+        return new SqliteConnection(new SqliteConnectionStringBuilder { DataSource = dataSource }.ToString());
+    }
+
+    private static bool Probe()
+    {
+        try
+        {
+            // SqliteConnection's static constructor registers the SQLitePCL provider
+            using (new SqliteConnection())
+            {
+            }
+            var sourceId = SQLitePCL.raw.sqlite3_sourceid().utf8_to_string();
+            return !string.IsNullOrEmpty(sourceId) && sourceId != StubSourceId;
+        }
+        catch
+        {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,150 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Globalization;
+using System.Runtime.InteropServices;
+using System.Text.Json;
+
+namespace SqliteWasmBlazor;
+
+// Blob partial: incremental BLOB I/O for SqliteWasmBlob. The sqlite3_blob
+// handle lives in the worker (TypeScript-Common/src/blob-ops.ts); only the
+// byte ranges a stream asks for cross the thread boundary.
+internal sealed partial class SqliteWasmWorkerBridge
+{
+    /// <summary>
+    /// Open <paramref name="table"/>.<paramref name="column"/> of row
+    /// <paramref name="rowid"/> in the worker. Returns the worker's handle and
+    /// the blob's length.
+    /// </summary>
+    internal async Task<(int Handle, long Length)> OpenBlobAsync(
+        string database, string schema, string table, string column, long rowid, bool writable,
+        CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+        ThrowIfDiskLocked($"OpenBlob on '{database}'");
+
+        var result = await SendRequestAsync(BlobOpenRequest(database, schema, table, column, rowid, writable), cancellationToken);
+        return (result.RowsAffected, result.LastInsertId);
+    }
+
+    /// <summary>Blocking <see cref="OpenBlobAsync"/> over the synchronous channel.</summary>
+    internal (int Handle, long Length) OpenBlob(
+        string database, string schema, string table, string column, long rowid, bool writable)
+    {
+        ThrowIfDiskLocked($"OpenBlob on '{database}'");
+
+        var result = SendRequestSync(
+            BlobOpenRequest(database, schema, table, column, rowid, writable), DefaultSyncTimeoutMs, $"OpenBlob on '{database}'");
+        return (result.RowsAffected, result.LastInsertId);
+    }
+
+    /// <summary>
+    /// Up to <paramref name="count"/> bytes at <paramref name="offset"/>;
+    /// fewer at the end of the blob.
+    /// </summary>
+    internal async Task<byte[]> ReadBlobAsync(int handle, long offset, int count, CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+
+        var requestId = Interlocked.Increment(ref _nextRequestId);
+        var tcs = new TaskCompletionSource<byte[]>();
+        _pendingBinaryRequests[requestId] = tcs;
+
+        try
+        {
+            await using var registration = cancellationToken.Register(() =>
+            {
+                _pendingBinaryRequests.TryRemove(requestId, out _);
+                tcs.TrySetCanceled();
+            });
+
+            SendToWorker(JsonSerializer.Serialize(new { id = requestId, data = new { type = "blobRead", handle, offset, count } }));
+            return await tcs.Task;
+        }
+        finally
+        {
+            _pendingBinaryRequests.TryRemove(requestId, out _);
+        }
+    }
+
+    /// <summary>Blocking <see cref="ReadBlobAsync"/> over the synchronous channel.</summary>
+    internal byte[] ReadBlob(int handle, long offset, int count)
+    {
+        const string operation = "ReadBlob";
+        ThrowIfSyncUnavailable(operation);
+
+        var requestJson = JsonSerializer.Serialize(new
+        {
+            id = Interlocked.Increment(ref _nextRequestId),
+            data = new { type = "blobRead", handle, offset, count },
+            sync = true
+        });
+
+        // The worker publishes the raw bytes under the result kind
+        var status = (SyncStatus)SendToWorkerSync(requestJson, DefaultSyncTimeoutMs);
+        if (status == SyncStatus.Result)
+        {
+            return TakeSyncPayload();
+        }
+
+        ReadSyncResponse(status, DefaultSyncTimeoutMs, operation);
+        throw new InvalidOperationException($"{operation}: worker answered without blob data");
+    }
+
+    /// <summary>
+    /// Overwrite <paramref name="data"/>.Length bytes at <paramref name="offset"/>.
+    /// The blob's size cannot change.
+    /// </summary>
+    internal async Task WriteBlobAsync(int handle, long offset, ReadOnlyMemory<byte> data, CancellationToken cancellationToken)
+    {
+        await PostBinaryAsync(new { type = "blobWrite", handle, offset }, MemoryMarshal.AsMemory(data), cancellationToken);
+    }
+
+    /// <summary>Blocking <see cref="WriteBlobAsync"/> over the synchronous channel.</summary>
+    internal void WriteBlob(int handle, long offset, ReadOnlySpan<byte> data)
+    {
+        const string operation = "WriteBlob";
+        ThrowIfSyncUnavailable(operation);
+
+        var requestJson = JsonSerializer.Serialize(new
+        {
+            id = Interlocked.Increment(ref _nextRequestId),
+            data = new { type = "blobWrite", handle, offset },
+            sync = true
+        });
+
+        var status = (SyncStatus)SendBinaryToWorkerSync(
+            MemoryMarshal.CreateSpan(ref MemoryMarshal.GetReference(data), data.Length), requestJson, DefaultSyncTimeoutMs);
+        ReadSyncResponse(status, DefaultSyncTimeoutMs, operation);
+    }
+
+    /// <summary>Release a blob handle. Unknown handles are ignored by the worker.</summary>
+    internal async Task CloseBlobAsync(int handle, CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+        await SendRequestAsync(new { type = "blobClose", handle }, cancellationToken);
+    }
+
+    /// <summary>Blocking <see cref="CloseBlobAsync"/> over the synchronous channel.</summary>
+    internal void CloseBlob(int handle)
+    {
+        SendRequestSync(new { type = "blobClose", handle }, DefaultSyncTimeoutMs, "CloseBlob");
+    }
+
+    private static object BlobOpenRequest(
+        string database, string schema, string table, string column, long rowid, bool writable)
+    {
+        // rowid as text: a JSON number loses precision above 2^53
+        return new
+        {
+            type = "blobOpen",
+            database,
+            schema,
+            table,
+            column,
+            rowid = rowid.ToString(CultureInfo.InvariantCulture),
+            writable
+        };
+    }
+}
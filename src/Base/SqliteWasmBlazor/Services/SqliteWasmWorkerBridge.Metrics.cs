@@ -0,0 +1,152 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using System.Runtime.InteropServices.JavaScript;
+
+namespace SqliteWasmBlazor;
+
+// Metrics partial: per-request latency split into the phases a request
+// passes through. The worker measures queue wait, execute and serialize
+// and sends them with its response (RequestTimer in TypeScript-Common/src/
+// request-scheduler.ts). The bridge adds transfer and deserialize. Every
+// sample goes to the SqliteWasmBlazor Meter and to the histograms behind
+// GetStatistics().
+internal sealed partial class SqliteWasmWorkerBridge
+{
+    /// <summary>Name of the <see cref="Meter"/> the bridge publishes to.</summary>
+    internal const string MeterName = "SqliteWasmBlazor";
+
+    private const string OperationTag = "sqlitewasm.operation";
+
+    private static readonly Meter s_meter = new(MeterName);
+    private static readonly Histogram<double> s_queueWait = s_meter.CreateHistogram<double>(
+        "sqlitewasm.request.queue_wait", "ms", "Time a request waited in the worker's queue.");
+    private static readonly Histogram<double> s_execute = s_meter.CreateHistogram<double>(
+        "sqlitewasm.request.execute", "ms", "SQLite work for a request, including its result rows.");
+    private static readonly Histogram<double> s_serialize = s_meter.CreateHistogram<double>(
+        "sqlitewasm.request.serialize", "ms", "Worker time to finish a response payload.");
+    private static readonly Histogram<double> s_transfer = s_meter.CreateHistogram<double>(
+        "sqlitewasm.request.transfer", "ms", "Posting a request and its response, plus .NET scheduling.");
+    private static readonly Histogram<double> s_deserialize = s_meter.CreateHistogram<double>(
+        "sqlitewasm.request.deserialize", "ms", ".NET time to decode a response.");
+    private static readonly Histogram<double> s_duration = s_meter.CreateHistogram<double>(
+        "sqlitewasm.request.duration", "ms", "Send to decoded response.");
+
+    /// <summary>Send timestamps of requests in flight, for transfer and total.</summary>
+    private readonly ConcurrentDictionary<int, long> _requestStarts = new();
+
+    /// <summary>Worker phases of responses being delivered (OnWorkerTiming → RecordTiming).</summary>
+    private readonly ConcurrentDictionary<int, WorkerTiming> _workerTimings = new();
+
+    private readonly Dictionary<string, OperationHistograms> _statistics = new();
+
+    private readonly record struct WorkerTiming(
+        string Operation, double QueueMs, double ExecuteMs, double SerializeMs, long ArrivedAt);
+
+    private sealed class OperationHistograms
+    {
+        public readonly LatencyHistogram QueueWait = new();
+        public readonly LatencyHistogram Execute = new();
+        public readonly LatencyHistogram Serialize = new();
+        public readonly LatencyHistogram Transfer = new();
+        public readonly LatencyHistogram Deserialize = new();
+        public readonly LatencyHistogram Total = new();
+    }
+
+    /// <inheritdoc />
+    public SqliteWasmStatistics GetStatistics()
+    {
+        lock (_statistics)
+        {
+            return new SqliteWasmStatistics(_statistics
+                .OrderBy(entry => entry.Key, StringComparer.Ordinal)
+                .Select(entry => new SqliteWasmOperationStatistics(
+                    entry.Key,
+                    entry.Value.QueueWait.Snapshot(),
+                    entry.Value.Execute.Snapshot(),
+                    entry.Value.Serialize.Snapshot(),
+                    entry.Value.Transfer.Snapshot(),
+                    entry.Value.Deserialize.Snapshot(),
+                    entry.Value.Total.Snapshot()))
+                .ToList());
+        }
+    }
+
+    /// <summary>Note the send time of <paramref name="requestId"/>.</summary>
+    private void StartTiming(int requestId)
+    {
+        _requestStarts[requestId] = Stopwatch.GetTimestamp();
+    }
+
+    /// <summary>Forget <paramref name="requestId"/>'s send time once it has completed.</summary>
+    private void StopTiming(int requestId)
+    {
+        _requestStarts.TryRemove(requestId, out _);
+    }
+
+    /// <summary>
+    /// Called from JavaScript just before a response callback with the
+    /// worker-side phases of <paramref name="requestId"/>.
+    /// </summary>
+    [JSExport]
+    public static void OnWorkerTiming(int requestId, string operation, double queueMs, double executeMs, double serializeMs)
+    {
+        Instance._workerTimings[requestId] = new WorkerTiming(
+            operation, queueMs, executeMs, serializeMs, Stopwatch.GetTimestamp());
+    }
+
+    /// <summary>
+    /// Record <paramref name="requestId"/>'s phases. Called by the response
+    /// callbacks once the response is decoded and before the caller resumes,
+    /// which removes the send time.
+    /// </summary>
+    private static void RecordTiming(int requestId)
+    {
+        var bridge = Instance;
+        if (!bridge._workerTimings.TryRemove(requestId, out var worker))
+        {
+            return;
+        }
+
+        var now = Stopwatch.GetTimestamp();
+        var deserializeMs = Stopwatch.GetElapsedTime(worker.ArrivedAt, now).TotalMilliseconds;
+        var workerMs = worker.QueueMs + worker.ExecuteMs + worker.SerializeMs;
+        double? totalMs = bridge._requestStarts.TryGetValue(requestId, out var startedAt)
+            ? Stopwatch.GetElapsedTime(startedAt, now).TotalMilliseconds
+            : null;
+
+        var tag = new KeyValuePair<string, object?>(OperationTag, worker.Operation);
+        s_queueWait.Record(worker.QueueMs, tag);
+        s_execute.Record(worker.ExecuteMs, tag);
+        s_serialize.Record(worker.SerializeMs, tag);
+        s_deserialize.Record(deserializeMs, tag);
+        if (totalMs is { } total)
+        {
+            // Whatever the worker and the decoder did not account for
+            s_transfer.Record(Math.Max(0, total - workerMs - deserializeMs), tag);
+            s_duration.Record(total, tag);
+        }
+
+        lock (bridge._statistics)
+        {
+            if (!bridge._statistics.TryGetValue(worker.Operation, out var histograms))
+            {
+                histograms = new OperationHistograms();
+                bridge._statistics[worker.Operation] = histograms;
+            }
+
+            histograms.QueueWait.Record(worker.QueueMs);
+            histograms.Execute.Record(worker.ExecuteMs);
+            histograms.Serialize.Record(worker.SerializeMs);
+            histograms.Deserialize.Record(deserializeMs);
+            if (totalMs is { } sample)
+            {
+                histograms.Transfer.Record(Math.Max(0, sample - workerMs - deserializeMs));
+                histograms.Total.Record(sample);
+            }
+        }
+    }
+}
@@ -1,6 +1,7 @@
 // SqliteWasmBlazor - Minimal EF Core compatible provider
 // MIT License
 
+using System.Buffers;
 using System.Security.Cryptography;
 using System.Text.Json;
 using MessagePack;
@@ -8,8 +9,8 @@ using MessagePack;
 namespace SqliteWasmBlazor;
 
 // Persistence partial: single-DB import/export (opaque or plain, with REKEY/
-// ENCRYPT and asymmetric verify+import variants), ZIP-bundled multi-DB
-// import/export, and bulk row import.
+// ENCRYPT and asymmetric verify+import variants) as byte[] or chunked
+// Stream, ZIP-bundled multi-DB import/export, and bulk row import.
 internal sealed partial class SqliteWasmWorkerBridge
 {
     /// <summary>
@@ -39,65 +40,49 @@ internal sealed partial class SqliteWasmWorkerBridge
         var opaque = data.Length < 16 || !data.AsSpan(0, 16).SequenceEqual(SqliteHeaderMagic);
 
         var requestId = Interlocked.Increment(ref _nextRequestId);
-        var tcs = new TaskCompletionSource<SqlQueryResult>();
-
-        _pendingRequests[requestId] = tcs;
-
-        try
+        var metadataJson = JsonSerializer.Serialize(new
         {
-            await using var registration = cancellationToken.Register(() =>
-            {
-                _pendingRequests.TryRemove(requestId, out _);
-                tcs.TrySetCanceled();
-            });
-
-            var metadataJson = JsonSerializer.Serialize(new
+            id = requestId,
+            data = new
             {
-                id = requestId,
-                data = new
-                {
-                    type = "importDb",
-                    database = databaseName,
-                    opaque,
-                }
-            });
+                type = "importDb",
+                database = databaseName,
+                opaque,
+            }
+        });
 
-            SendBinaryToWorker(data.AsSpan(), metadataJson);
+        var result = await SendAndWaitAsync(
+            requestId, () => SendBinaryToWorker(data.AsSpan(), metadataJson), cancellationToken,
+            TransferRequestTimeout, "Import database");
 
-            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
-            timeoutCts.CancelAfter(60000);
+        // Worker closes the DB during import (no-op when the DB wasn't
+        // open or when the import was refused before close).
+        MarkDatabaseClosed(databaseName);
 
-            SqlQueryResult result;
-            try
-            {
-                result = await tcs.Task.WaitAsync(timeoutCts.Token);
-            }
-            catch (OperationCanceledException) when (!cancellationToken.IsCancellationRequested)
-            {
-                throw new TimeoutException("Import database operation timed out after 60 seconds.");
-            }
+        return ToImportResult(result.RowsAffected);
+    }
 
-            // Worker closes the DB during import (no-op when the DB wasn't
-            // open or when the import was refused before close).
-            _openDatabases.Remove(databaseName);
+    /// <summary>
+    /// Timeout of a byte[] import or export round trip, and of each chunk
+    /// of a Stream export.
+    /// </summary>
+    private static readonly TimeSpan TransferRequestTimeout = TimeSpan.FromSeconds(60);
 
-            // Worker encodes the import outcome in rowsAffected (same
-            // tri-state channel SetEncryptionKeyAsync uses):
-            // 0 = OK, 1 = WRONG_KEY (rolled back), 2 = EXISTING_DB_REFUSED.
-            return result.RowsAffected switch
-            {
-                0 => DiskImportResult.OK,
-                1 => DiskImportResult.WRONG_KEY,
-                2 => DiskImportResult.EXISTING_DB_REFUSED,
-                var other => throw new InvalidOperationException(
-                    $"Worker returned unexpected import outcome code {other}"),
-            };
-        }
-        catch
+    /// <summary>
+    /// Worker import outcome code (same tri-state channel
+    /// SetEncryptionKeyAsync uses): 0 = OK, 1 = WRONG_KEY (rolled back),
+    /// 2 = EXISTING_DB_REFUSED.
+    /// </summary>
+    private static DiskImportResult ToImportResult(long code)
+    {
+        return code switch
         {
-            _pendingRequests.TryRemove(requestId, out _);
-            throw;
-        }
+            0 => DiskImportResult.OK,
+            1 => DiskImportResult.WRONG_KEY,
+            2 => DiskImportResult.EXISTING_DB_REFUSED,
+            var other => throw new InvalidOperationException(
+                $"Worker returned unexpected import outcome code {other}"),
+        };
     }
 
     /// <inheritdoc />
@@ -122,39 +107,142 @@ internal sealed partial class SqliteWasmWorkerBridge
         await EnsureInitializedAsync(cancellationToken);
 
         var requestId = Interlocked.Increment(ref _nextRequestId);
-        var tcs = new TaskCompletionSource<byte[]>();
-        _pendingBinaryRequests[requestId] = tcs;
+        var requestJson = JsonSerializer.Serialize(new { id = requestId, data = request });
+
+        // An open DB is exported online and stays open; when the worker has
+        // to close it instead (slot-level exports of an encrypted DB),
+        // OnWorkerResponseRawBinary updates the mirror.
+        return await SendAndWaitAsync(
+            _pendingBinaryRequests, requestId, () => SendToWorker(requestJson), cancellationToken,
+            TransferRequestTimeout, opName);
+    }
+
+    /// <summary>
+    /// Bytes moved per round trip by the <see cref="Stream"/> overloads —
+    /// the most either side holds of a database at any time.
+    /// </summary>
+    internal const int StreamChunkSize = 2 * 1024 * 1024;
+
+    /// <inheritdoc />
+    public async Task ExportDatabaseAsync(
+        string databaseName,
+        Stream destination,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(destination);
+        await EnsureInitializedAsync(cancellationToken);
+
+        // Session id and length travel as RowsAffected / LastInsertId
+        var open = await SendRequestAsync(
+            new { type = "exportStreamOpen", database = databaseName }, cancellationToken);
+        MarkExportClosed(open);
+
+        await CopyExportStreamAsync(databaseName, open.RowsAffected, open.LastInsertId, destination, cancellationToken);
+    }
 
+    /// <summary>
+    /// Read the worker export stream <paramref name="session"/> to the end
+    /// (<paramref name="length"/> bytes) into <paramref name="destination"/>,
+    /// then close it.
+    /// </summary>
+    private async Task CopyExportStreamAsync(
+        string databaseName,
+        long session,
+        long length,
+        Stream destination,
+        CancellationToken cancellationToken)
+    {
         try
         {
-            await using var registration = cancellationToken.Register(() =>
+            for (long offset = 0; offset < length;)
             {
-                _pendingBinaryRequests.TryRemove(requestId, out _);
-                tcs.TrySetCanceled();
-            });
+                var chunk = await SendRawBinaryRequestAsync(
+                    databaseName,
+                    new { type = "exportStreamRead", session, offset, count = StreamChunkSize },
+                    "Export stream read",
+                    cancellationToken);
+                if (chunk.Length == 0)
+                {
+                    throw new InvalidOperationException(
+                        $"Export of '{databaseName}' ended at {offset} of {length} bytes.");
+                }
 
-            var requestJson = JsonSerializer.Serialize(new { id = requestId, data = request });
-            SendToWorker(requestJson);
+                await destination.WriteAsync(chunk, cancellationToken);
+                offset += chunk.Length;
+            }
+        }
+        finally
+        {
+            await SendRequestAsync(new { type = "exportStreamClose", session }, CancellationToken.None);
+        }
+    }
+
+    /// <inheritdoc />
+    public async Task<DiskImportResult> ImportDatabaseAsync(
+        string databaseName,
+        Stream source,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(source);
 
-            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
-            timeoutCts.CancelAfter(60000);
+        var buffer = ArrayPool<byte>.Shared.Rent(StreamChunkSize);
+        try
+        {
+            var filled = await source.ReadAtLeastAsync(
+                buffer.AsMemory(0, StreamChunkSize), StreamChunkSize, throwOnEndOfStream: false, cancellationToken);
+
+            // Same detection as the byte[] overload. Ciphertext keeps its
+            // refuse-on-existing (checked on open) and verify-on-write
+            // (on finish) checks.
+            var opaque = filled < 16 || !buffer.AsSpan(0, 16).SequenceEqual(SqliteHeaderMagic);
+
+            await EnsureInitializedAsync(cancellationToken);
+            // The chunks go to a temporary file; the DB stays open and
+            // intact until 'importStreamFinish' replaces it
+            var open = await SendRequestAsync(
+                new { type = "importStreamOpen", database = databaseName, opaque }, cancellationToken);
+
+            // Session and refusal code travel as RowsAffected / LastInsertId
+            var refused = ToImportResult(open.LastInsertId);
+            if (refused != DiskImportResult.OK)
+            {
+                return refused;
+            }
 
+            var session = open.RowsAffected;
             try
             {
-                var result = await tcs.Task.WaitAsync(timeoutCts.Token);
-                // Worker closes the DB during export for consistent snapshot.
-                _openDatabases.Remove(databaseName);
-                return result;
+                while (filled > 0)
+                {
+                    await PostBinaryAsync(
+                        new { type = "importStreamWrite", session }, buffer.AsMemory(0, filled), cancellationToken);
+                    filled = await source.ReadAtLeastAsync(
+                        buffer.AsMemory(0, StreamChunkSize), StreamChunkSize, throwOnEndOfStream: false, cancellationToken);
+                }
+
+                var finish = await SendRequestAsync(
+                    new { type = "importStreamFinish", database = databaseName, session }, cancellationToken);
+                // Worker closes the DB before replacing it, as for ImportDatabaseAsync(byte[])
+                MarkDatabaseClosed(databaseName);
+                return ToImportResult(finish.RowsAffected);
             }
-            catch (OperationCanceledException) when (!cancellationToken.IsCancellationRequested)
+            catch
             {
-                throw new TimeoutException($"{opName} operation timed out after 60 seconds.");
+                // Drop the temporary file; the original error is the one to report
+                try
+                {
+                    await SendRequestAsync(new { type = "importStreamAbort", session }, CancellationToken.None);
+                }
+                catch (Exception ex)
+                {
+                    Console.Error.WriteLine($"[Worker Bridge] Failed to abort import stream {session}: {ex.Message}");
+                }
+                throw;
             }
         }
-        catch
+        finally
         {
-            _pendingBinaryRequests.TryRemove(requestId, out _);
-            throw;
+            ArrayPool<byte>.Shared.Return(buffer);
         }
     }
 
@@ -162,30 +250,116 @@ internal sealed partial class SqliteWasmWorkerBridge
     public async Task<byte[]> ExportAllDatabasesAsync(
         CancellationToken cancellationToken = default)
     {
-        // Loop ListDatabasesAsync → ExportDatabaseAsync(name) (VERBATIM)
-        // and pack into a ZIP archive with one .db entry per DB. Standard
-        // cross-tool format; recipient unzips and opens each .db in any
-        // SQLite tool. For whole-disk encrypted backup, use
+        using var ms = new MemoryStream();
+        await ExportAllDatabasesAsync(ms, cancellationToken);
+        return ms.ToArray();
+    }
+
+    /// <inheritdoc />
+    public async Task ExportAllDatabasesAsync(
+        Stream destination,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(destination);
+
+        // One ZIP entry per DB (VERBATIM), in ListDatabasesAsync order.
+        // Standard cross-tool format; recipient unzips and opens each .db
+        // in any SQLite tool. For whole-disk encrypted backup, use
         // IEncryptedSqliteWasmDatabaseService.ExportDiskToPubkeyAsync
         // (asymmetric MessagePack envelope of slot-format ciphertext).
         var names = await ListDatabasesAsync(cancellationToken);
-        using var ms = new MemoryStream();
-        using (var zip = new System.IO.Compression.ZipArchive(
-            ms, System.IO.Compression.ZipArchiveMode.Create, leaveOpen: true))
+        await EnsureInitializedAsync(cancellationToken);
+        var concurrency = (await SendRequestAsync(
+            new { type = "deflateConcurrency" }, cancellationToken)).RowsAffected;
+
+        if (concurrency == 0)
         {
+            // No deflate-raw CompressionStream in this browser: compress
+            // here, each entry written chunk by chunk as the export streams in.
+            using var archive = new System.IO.Compression.ZipArchive(
+                destination, System.IO.Compression.ZipArchiveMode.Create, leaveOpen: true);
             foreach (var name in names)
             {
-                var bytes = await ExportDatabaseAsync(name, cancellationToken);
-                var entry = zip.CreateEntry(name, System.IO.Compression.CompressionLevel.Fastest);
+                var entry = archive.CreateEntry(name, System.IO.Compression.CompressionLevel.Fastest);
                 await using var entryStream = entry.Open();
-                await entryStream.WriteAsync(bytes, cancellationToken);
+                await ExportDatabaseAsync(name, entryStream, cancellationToken);
+            }
+            return;
+        }
+
+        // Each entry is snapshotted and deflated in the worker — on its
+        // compression helpers, one core per entry — with up to
+        // `concurrency` entries in flight ahead of the one being written.
+        // Only the compressed bytes cross to .NET.
+        var zip = new PrecompressedZipWriter(destination);
+        var pending = new Queue<(string Name, Task<SqlQueryResult> Entry)>();
+        try
+        {
+            foreach (var name in names)
+            {
+                if (pending.Count == concurrency)
+                {
+                    var (head, headEntry) = pending.Dequeue();
+                    await WriteDeflatedEntryAsync(zip, head, await headEntry, cancellationToken);
+                }
+                pending.Enqueue((name, SendRequestAsync(
+                    new { type = "exportDeflatedOpen", database = name }, cancellationToken)));
+            }
+
+            while (pending.TryDequeue(out var next))
+            {
+                await WriteDeflatedEntryAsync(zip, next.Name, await next.Entry, cancellationToken);
+            }
+
+            await zip.FinishAsync(cancellationToken);
+        }
+        finally
+        {
+            // After a failure, release the entries deflated but not written
+            foreach (var (_, entry) in pending)
+            {
+                try
+                {
+                    var open = await entry;
+                    MarkExportClosed(open);
+                    await SendRequestAsync(
+                        new { type = "exportStreamClose", session = open.RowsAffected }, CancellationToken.None);
+                }
+                catch (Exception ex)
+                {
+                    Console.Error.WriteLine($"[Worker Bridge] Discarded ZIP entry: {ex.Message}");
+                }
             }
         }
-        return ms.ToArray();
+    }
+
+    private async Task WriteDeflatedEntryAsync(
+        PrecompressedZipWriter zip,
+        string databaseName,
+        SqlQueryResult open,
+        CancellationToken cancellationToken)
+    {
+        MarkExportClosed(open);
+        await zip.WriteEntryAsync(
+            databaseName,
+            open.Crc32 ?? throw new InvalidOperationException($"Worker returned no CRC-32 for '{databaseName}'."),
+            open.UncompressedLength ?? 0,
+            open.LastInsertId,
+            entryStream => CopyExportStreamAsync(
+                databaseName, open.RowsAffected, open.LastInsertId, entryStream, cancellationToken),
+            cancellationToken);
+    }
+
+    private void MarkExportClosed(SqlQueryResult open)
+    {
+        if (open.ClosedDatabase is { } closed)
+        {
+            MarkDatabaseClosed(closed);
+        }
     }
 
     /// <inheritdoc />
-    public async Task<DiskImportResult> ImportAllDatabasesAsync(
+    public Task<DiskImportResult> ImportAllDatabasesAsync(
         byte[] zipBytes,
         CancellationToken cancellationToken = default)
     {
@@ -196,6 +370,16 @@ internal sealed partial class SqliteWasmWorkerBridge
                 nameof(zipBytes));
         }
 
+        return ImportAllDatabasesAsync(new MemoryStream(zipBytes, writable: false), cancellationToken);
+    }
+
+    /// <inheritdoc />
+    public async Task<DiskImportResult> ImportAllDatabasesAsync(
+        Stream zipSource,
+        CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(zipSource);
+
         // Replace-all semantics: wipe the pool first, then unpack each ZIP
         // entry. Caller is responsible for explicit user confirmation in UI.
         var existing = await ListDatabasesAsync(cancellationToken);
@@ -204,9 +388,8 @@ internal sealed partial class SqliteWasmWorkerBridge
             await DeleteDatabaseAsync(name, cancellationToken);
         }
 
-        using var ms = new MemoryStream(zipBytes);
         using var zip = new System.IO.Compression.ZipArchive(
-            ms, System.IO.Compression.ZipArchiveMode.Read);
+            zipSource, System.IO.Compression.ZipArchiveMode.Read, leaveOpen: true);
 
         foreach (var entry in zip.Entries)
         {
@@ -214,13 +397,8 @@ internal sealed partial class SqliteWasmWorkerBridge
             {
                 continue; // skip directory entries
             }
-            using var entryMs = new MemoryStream(checked((int)entry.Length));
-            await using (var entryStream = entry.Open())
-            {
-                await entryStream.CopyToAsync(entryMs, cancellationToken);
-            }
-            var bytes = entryMs.ToArray();
-            var result = await ImportDatabaseAsync(entry.Name, bytes, cancellationToken);
+            await using var entryStream = entry.Open();
+            var result = await ImportDatabaseAsync(entry.Name, entryStream, cancellationToken);
             if (result != DiskImportResult.OK)
             {
                 return result;
@@ -236,42 +414,19 @@ internal sealed partial class SqliteWasmWorkerBridge
         await EnsureInitializedAsync(cancellationToken);
 
         var requestId = Interlocked.Increment(ref _nextRequestId);
-        var tcs = new TaskCompletionSource<SqlQueryResult>();
-        _pendingRequests[requestId] = tcs;
-
-        try
+        var metadataJson = JsonSerializer.Serialize(new
         {
-            await using var registration = cancellationToken.Register(() =>
+            id = requestId,
+            data = new
             {
-                _pendingRequests.TryRemove(requestId, out _);
-                tcs.TrySetCanceled();
-            });
-
-            var metadataJson = JsonSerializer.Serialize(new
-            {
-                id = requestId,
-                data = new
-                {
-                    type = "importRows",
-                    database = databaseName
-                }
-            });
-
-            SendBinaryToWorker(data.AsSpan(), metadataJson);
-
-            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
-            timeoutCts.CancelAfter(300_000);
+                type = "importRows",
+                database = databaseName
+            }
+        });
 
-            var result = await tcs.Task.WaitAsync(timeoutCts.Token);
-            return result.RowsAffected;
-        }
-        catch (OperationCanceledException) when (!cancellationToken.IsCancellationRequested)
-        {
-            throw new TimeoutException("Row import timed out.");
-        }
-        finally
-        {
-            _pendingRequests.TryRemove(requestId, out _);
-        }
+        var result = await SendAndWaitAsync(
+            requestId, () => SendBinaryToWorker(data.AsSpan(), metadataJson), cancellationToken,
+            DefaultRequestTimeout, "Row import");
+        return result.RowsAffected;
     }
 }
@@ -0,0 +1,165 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Buffers;
+using System.Runtime.InteropServices;
+using System.Runtime.InteropServices.JavaScript;
+
+namespace SqliteWasmBlazor;
+
+// ReadWorkers partial: routing of read-only statements to the snapshot
+// read workers (SqliteWasmOptions.ReadWorkerCount). The JS bridge owns the
+// readers and the freshness of their copies (TypeScript-Common/src/
+// read-snapshot.ts); this side decides which statements may go there.
+internal sealed partial class SqliteWasmWorkerBridge
+{
+    /// <summary>
+    /// Classified SQL texts kept per set before it is reset — bounds memory
+    /// for apps that build SQL with inlined literals.
+    /// </summary>
+    private const int MaxClassifiedStatements = 1024;
+
+    /// <summary>
+    /// (database, SQL) that ran on a reader, so <c>sqlite3_stmt_readonly</c>
+    /// holds and the owning worker does not invalidate the readers' copies
+    /// for it.
+    /// </summary>
+    private readonly HashSet<(string Database, string Sql)> _readOnlyStatements = new();
+
+    /// <summary>
+    /// (database, SQL) a reader refused (not read-only, connection-scoped)
+    /// or failed; it always goes to the owning worker.
+    /// </summary>
+    private readonly HashSet<(string Database, string Sql)> _writerOnlyStatements = new();
+
+    /// <summary>
+    /// Snapshot read workers started by the bridge, from
+    /// <see cref="SqliteWasmOptions.ReadWorkerCount"/>. 0 = all statements
+    /// go to the owning worker.
+    /// </summary>
+    internal int ReadWorkerCount { get; private set; }
+
+    /// <summary>
+    /// Whether an execute may be offered to a reader: a single statement
+    /// outside a transaction, without a cursor or deferred BLOBs (both are
+    /// handles in the worker that ran it), not known to need the writer.
+    /// </summary>
+    private bool IsReadWorkerCandidate(string database, string sql, int batchSize, string? begin, bool deferBlobs, bool inTransaction)
+    {
+        return ReadWorkerCount > 0
+               && !inTransaction && begin is null && batchSize == 0 && !deferBlobs
+               && !_writerOnlyStatements.Contains((database, sql));
+    }
+
+    /// <summary>
+    /// Whether <paramref name="sql"/> has run on a reader of
+    /// <paramref name="database"/>, so the owning worker running it leaves
+    /// the readers' copies current.
+    /// </summary>
+    private bool IsKnownReadOnly(string database, string sql) => _readOnlyStatements.Contains((database, sql));
+
+    /// <summary>
+    /// Forget how <paramref name="database"/>'s statements were classified
+    /// when its schema may have changed (DDL) or it was closed, replaced or
+    /// removed: a statement a reader failed may now succeed, and one it ran
+    /// may now name another object.
+    /// </summary>
+    private void ForgetStatementClasses(string database)
+    {
+        _readOnlyStatements.RemoveWhere(s => s.Database == database);
+        _writerOnlyStatements.RemoveWhere(s => s.Database == database);
+    }
+
+    /// <summary>
+    /// <see cref="ForgetStatementClasses"/> ahead of a statement that may
+    /// change <paramref name="database"/>'s schema.
+    /// </summary>
+    private void ForgetStatementClassesOnSchemaChange(string database, string sql)
+    {
+        if (ReadWorkerCount > 0 && IsSchemaStatement(sql))
+        {
+            ForgetStatementClasses(database);
+        }
+    }
+
+    private static bool IsSchemaStatement(string sql)
+    {
+        var text = sql.AsSpan().TrimStart();
+        return text.StartsWith("CREATE", StringComparison.OrdinalIgnoreCase)
+               || text.StartsWith("ALTER", StringComparison.OrdinalIgnoreCase)
+               || text.StartsWith("DROP", StringComparison.OrdinalIgnoreCase);
+    }
+
+    /// <summary>
+    /// Post the encoded execute <paramref name="writer"/> through the bridge's
+    /// read routing. The result, or null when a reader refused or failed the
+    /// statement — the caller then runs it on the owning worker. A failure
+    /// on the owning worker (no current copy) is thrown as usual.
+    /// </summary>
+    private async Task<SqlQueryResult?> TryExecuteOnReadWorkerAsync(
+        int requestId,
+        ArrayBufferWriter<byte> writer,
+        string database,
+        string sql,
+        TimeSpan timeout,
+        CancellationToken cancellationToken)
+    {
+        var readOnly = IsKnownReadOnly(database, sql);
+        var onReader = false;
+        try
+        {
+            var result = await SendAndWaitAsync(requestId, () =>
+            {
+                try
+                {
+                    onReader = SendEncodedRead(MemoryMarshal.AsMemory(writer.WrittenMemory).Span, database, requestId, readOnly);
+                }
+                finally
+                {
+                    WorkerRequestEncoder.Return(writer);
+                }
+            }, cancellationToken, timeout);
+
+            if (onReader && !readOnly)
+            {
+                Remember(_readOnlyStatements, (database, sql));
+            }
+            return result;
+        }
+        catch (Exception ex) when (onReader && ex is not TimeoutException && !cancellationToken.IsCancellationRequested)
+        {
+            // Read-only statements have no side effects: safe to run again
+            _readOnlyStatements.Remove((database, sql));
+            Remember(_writerOnlyStatements, (database, sql));
+            return null;
+        }
+    }
+
+    /// <summary>
+    /// Discard the readers' copies. Called when the disk locks, so no
+    /// decrypted copy outlives the session.
+    /// </summary>
+    private void DropReadWorkerSnapshots()
+    {
+        if (ReadWorkerCount > 0 && _isInitialized)
+        {
+            DropSnapshots();
+        }
+    }
+
+    private static void Remember(HashSet<(string Database, string Sql)> statements, (string Database, string Sql) statement)
+    {
+        if (statements.Count >= MaxClassifiedStatements)
+        {
+            statements.Clear();
+        }
+        statements.Add(statement);
+    }
+
+    [JSImport("sendEncodedRead", "sqliteWasmWorker")]
+    private static partial bool SendEncodedRead(
+        [JSMarshalAs<JSType.MemoryView>] Span<byte> request, string database, int requestId, bool readOnly);
+
+    [JSImport("dropSnapshots", "sqliteWasmWorker")]
+    private static partial void DropSnapshots();
+}
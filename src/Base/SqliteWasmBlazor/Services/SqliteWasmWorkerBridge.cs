@@ -2,23 +2,26 @@
 // MIT License
 
 using System.Collections.Concurrent;
+using System.Runtime.InteropServices;
 using System.Runtime.InteropServices.JavaScript;
+using System.Text;
 using System.Text.Json;
 using System.Text.Json.Serialization;
-using MessagePack;
-using MessagePack.Resolvers;
 
 namespace SqliteWasmBlazor;
 
 /// <summary>
 /// Result from SQL query execution in worker.
-/// Deserialized using MessagePack typeless mode due to dynamic object?[][] data.
+/// Execute / fetch responses are decoded from the worker's columnar binary
+/// format (<see cref="ColumnarRowSet"/>); the JSON-only responses of the
+/// control operations fill the remaining properties.
 /// </summary>
 internal sealed class SqlQueryResult
 {
     public List<string> ColumnNames { get; set; } = [];
     public List<string> ColumnTypes { get; set; } = [];
-    public object?[][] Rows { get; set; } = [];
+    [JsonIgnore]
+    public ColumnarRowSet Rows { get; set; } = ColumnarRowSet.Empty;
     public int RowsAffected { get; set; }
     public long LastInsertId { get; set; }
     /// <summary>
@@ -39,6 +42,38 @@ internal sealed class SqlQueryResult
     /// Schema version byte (0x01 = v1) of a present manifest.
     /// </summary>
     public int? ManifestSchemaVersion { get; set; }
+    /// <summary>
+    /// Set by the JSON-only response of <c>statementCacheStats</c>.
+    /// </summary>
+    public SqliteWasmStatementCacheStatistics? StatementCache { get; set; }
+    /// <summary>
+    /// Non-zero when the worker kept the statement open because more rows
+    /// remain — continue with <see cref="SqliteWasmWorkerBridge.FetchCursorAsync"/>.
+    /// 0 once the result set is complete.
+    /// </summary>
+    public int CursorId { get; set; }
+    /// <summary>
+    /// Set by <c>exportStreamOpen</c> / <c>exportDeflatedOpen</c> when the
+    /// worker had to close the database to snapshot it (slot-format
+    /// ciphertext).
+    /// </summary>
+    public string? ClosedDatabase { get; set; }
+    /// <summary>
+    /// Set by <c>exportDeflatedOpen</c>: CRC-32 of the uncompressed
+    /// database, for its ZIP entry header.
+    /// </summary>
+    public uint? Crc32 { get; set; }
+    /// <summary>
+    /// Set by <c>exportDeflatedOpen</c>: size of the database before
+    /// compression (<see cref="LastInsertId"/> is the compressed size).
+    /// </summary>
+    public long? UncompressedLength { get; set; }
+    /// <summary>
+    /// Set by <c>executeBatch</c>: one result per command, in order.
+    /// <see cref="RowsAffected"/> is then the sum over all commands.
+    /// </summary>
+    [JsonIgnore]
+    public List<SqlQueryResult>? BatchResults { get; set; }
 }
 
 /// <summary>
@@ -79,6 +114,20 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     /// </summary>
     internal bool IsDatabaseOpen(string database) => _openDatabases.Contains(database);
 
+    /// <summary>
+    /// Default rows-per-fetch for <see cref="SqliteWasmDataReader"/>, from
+    /// <see cref="SqliteWasmOptions.ReaderBatchSize"/>. 0 = no cursor.
+    /// </summary>
+    internal int ReaderBatchSize { get; private set; }
+
+    /// <summary>
+    /// True when the bridge set up the shared synchronous channel
+    /// (<see cref="SqliteWasmOptions.SynchronousChannelSize"/> on a
+    /// cross-origin-isolated page) and the blocking <see cref="ExecuteSql"/> /
+    /// <see cref="OpenDatabase"/> calls are usable.
+    /// </summary>
+    internal bool IsSynchronousExecutionAvailable { get; private set; }
+
     /// <summary>
     /// True when the encrypted VFS disk is in the locked state — i.e. the
     /// disk holds ciphertext but no <c>globalKey</c> is installed. Set by
@@ -95,7 +144,14 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     /// <see cref="EncryptedSqliteWasmDatabaseService"/>, which is the single source of
     /// truth for VFS state. Idempotent.
     /// </summary>
-    internal void SetDiskLocked(bool locked) => _diskLocked = locked;
+    internal void SetDiskLocked(bool locked)
+    {
+        _diskLocked = locked;
+        if (locked)
+        {
+            DropReadWorkerSnapshots();
+        }
+    }
 
     /// <summary>
     /// Throw <see cref="DiskLockedException"/> if the disk is locked. Used
@@ -124,13 +180,6 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     // (source-generated context) when assembling its delta-export metadata.
     internal static JsonSerializerOptions JsonOptions => _jsonOptions.Value;
 
-    // ReSharper disable once InconsistentNaming
-    private static readonly Lazy<MessagePackSerializerOptions> _messagePackOptions = new(() =>
-        MessagePackSerializerOptions.Standard
-            .WithResolver(TypelessContractlessStandardResolver.Instance));
-
-    private static MessagePackSerializerOptions MessagePackOptions => _messagePackOptions.Value;
-
     private SqliteWasmWorkerBridge()
     {
     }
@@ -139,7 +188,8 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     /// Initialize the worker bridge. Invoked from <see cref="SqliteWasmServiceCollectionExtensions.InitializeSqliteWasmAsync"/>
     /// with options resolved from DI — callers should not invoke this directly.
     /// </summary>
-    /// <param name="options">Resolved <see cref="SqliteWasmOptions"/> carrying <c>BaseHref</c> and <c>AssetRoot</c>.</param>
+    /// <param name="options">Resolved <see cref="SqliteWasmOptions"/> carrying <c>BaseHref</c>, <c>AssetRoot</c>
+    /// and the worker tuning knobs forwarded in the init message.</param>
     /// <param name="cancellationToken">Cancellation token.</param>
     public async Task InitializeAsync(SqliteWasmOptions options, CancellationToken cancellationToken = default)
     {
@@ -158,7 +208,18 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
 
         // Single awaitable JSImport: creates the Worker and posts the init message.
         // CSP-safe (no DOM read, no data: URLs); worker ready/error signal arrives via JSExport.
-        await InitializeBridgeAsync(options.BaseHref, options.AssetRoot);
+        ReaderBatchSize = Math.Max(0, options.ReaderBatchSize);
+        ReadWorkerCount = Math.Max(0, options.ReadWorkerCount);
+
+        var workerOptionsJson = JsonSerializer.Serialize(
+            new WorkerInitOptions
+            {
+                StatementCacheSize = options.StatementCacheSize,
+                SynchronousChannelSize = Math.Max(0, options.SynchronousChannelSize),
+                ReadWorkerCount = ReadWorkerCount,
+                ReadWorkerMaxSnapshotSize = Math.Max(0, options.ReadWorkerMaxSnapshotSize)
+            }, JsonOptions);
+        await InitializeBridgeAsync(options.BaseHref, options.AssetRoot, workerOptionsJson);
 
         var ready = await _initializationTcs.Task;
         if (!ready)
@@ -167,6 +228,8 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
         }
 
         _isInitialized = true;
+        // Only once the worker is ready — a sync request must not reach it mid-init
+        IsSynchronousExecutionAvailable = IsSyncChannelAvailable();
     }
 
     /// <summary>
@@ -196,6 +259,20 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
         _openDatabases.Add(database);
     }
 
+    /// <summary>
+    /// Blocking <see cref="OpenDatabaseAsync"/> over the synchronous channel,
+    /// for <see cref="SqliteWasmConnection.Open"/>. Requires
+    /// <see cref="IsSynchronousExecutionAvailable"/>.
+    /// </summary>
+    internal void OpenDatabase(string database)
+    {
+        ThrowIfDiskLocked($"OpenDatabase('{database}')");
+
+        var request = new { type = "open", database };
+        SendRequestSync(request, DefaultSyncTimeoutMs, $"OpenDatabase('{database}')");
+        _openDatabases.Add(database);
+    }
+
     /// <summary>
     /// Close a database connection in the worker, releasing the OPFS SAH.
     /// </summary>
@@ -212,7 +289,7 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
         };
 
         await SendRequestAsync(request, cancellationToken);
-        _openDatabases.Remove(databaseName);
+        MarkDatabaseClosed(databaseName);
     }
 
     /// <summary>
@@ -261,25 +338,50 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     /// locked between connection open and query (e.g. the user explicitly
     /// hit Lock while a DbContext was alive).
     /// </summary>
-    public async Task<SqlQueryResult> ExecuteSqlAsync(
+    public Task<SqlQueryResult> ExecuteSqlAsync(
         string database,
         string sql,
         Dictionary<string, object?> parameters,
         CancellationToken cancellationToken)
+        => ExecuteSqlAsync(database, sql, parameters, 0, null, deferBlobs: false, cancellationToken);
+
+    /// <summary>
+    /// Execute SQL, returning at most <paramref name="batchSize"/> rows when
+    /// the statement is read-only. If more rows remain,
+    /// <see cref="SqlQueryResult.CursorId"/> is non-zero and the caller owns
+    /// the cursor until it is exhausted via <see cref="FetchCursorAsync"/> or
+    /// released with <see cref="CloseCursorAsync"/>. 0 materializes the whole
+    /// result set. <paramref name="deferBlobs"/> has the worker answer large
+    /// BLOBs with a reference for <see cref="SqliteWasmBlob"/> instead of
+    /// their bytes. <paramref name="timeout"/> as for <see cref="SendAndWaitAsync"/>.
+    /// </summary>
+    internal async Task<SqlQueryResult> ExecuteSqlAsync(
+        string database,
+        string sql,
+        Dictionary<string, object?> parameters,
+        int batchSize,
+        string? begin,
+        bool deferBlobs,
+        CancellationToken cancellationToken,
+        TimeSpan? timeout = null)
     {
         await EnsureInitializedAsync(cancellationToken);
         ThrowIfDiskLocked($"ExecuteSql on '{database}'");
+        ForgetStatementClassesOnSchemaChange(database, sql);
 
         var request = new
         {
             type = "execute",
             database,
             sql,
-            parameters
+            parameters,
+            batchSize,
+            begin,
+            deferBlobs
         };
 
         // SendRequestAsync now returns SqlQueryResult directly - no deserialization needed
-        return await SendRequestAsync(request, cancellationToken);
+        return await SendRequestAsync(request, cancellationToken, timeout);
     }
 
     /// <summary>
@@ -289,59 +391,372 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     /// pointing into <paramref name="packedBlobs"/>; the worker reads bytes
     /// from the binary attachment at the listed offsets. Eliminates the
     /// per-blob Base64 alloc + ~3 MB-of-allocation JSON-marshal chain for
-    /// blob writes.
+    /// blob writes. <paramref name="batchSize"/> and <paramref name="deferBlobs"/>
+    /// have the same semantics as for the batched <c>ExecuteSqlAsync</c> overload.
     /// </summary>
     internal async Task<SqlQueryResult> ExecuteSqlWithBlobsAsync(
         string database,
         string sql,
         Dictionary<string, object?> parameters,
         byte[] packedBlobs,
-        CancellationToken cancellationToken)
+        int batchSize,
+        string? begin,
+        bool deferBlobs,
+        CancellationToken cancellationToken,
+        TimeSpan? timeout = null)
     {
         await EnsureInitializedAsync(cancellationToken);
         ThrowIfDiskLocked($"ExecuteSqlWithBlobs on '{database}'");
+        ForgetStatementClassesOnSchemaChange(database, sql);
+
+        var request = new
+        {
+            type = "execute",
+            database,
+            sql,
+            parameters,
+            batchSize,
+            begin,
+            deferBlobs
+        };
+
+        return await SendBinaryRequestAsync(request, packedBlobs, $"ExecuteSqlWithBlobsAsync on '{database}'", cancellationToken, timeout);
+    }
+
+    /// <summary>
+    /// Execute a command's SQL and parameters as a binary-encoded request
+    /// (<see cref="WorkerRequestEncoder"/>). Falls back to the JSON request
+    /// path when a parameter value has no binary encoding.
+    /// <paramref name="batchSize"/> has the same cursor semantics as the
+    /// batched <c>ExecuteSqlAsync</c> overload. A non-null <paramref name="begin"/>
+    /// is a deferred transaction start the worker runs just before the
+    /// statement, in the same round trip (see <see cref="SqliteWasmTransaction"/>).
+    /// <paramref name="deferBlobs"/> is set for
+    /// <see cref="System.Data.CommandBehavior.SequentialAccess"/> readers.
+    /// Outside a transaction (<paramref name="inTransaction"/>), read-only
+    /// statements may run on a snapshot read worker
+    /// (<see cref="SqliteWasmOptions.ReadWorkerCount"/>).
+    /// <paramref name="priority"/> orders the request in the worker's queue;
+    /// cancelling <paramref name="cancellationToken"/> drops it there or
+    /// interrupts the running statement. So does running past
+    /// <paramref name="timeoutSeconds"/> (an explicitly set
+    /// <see cref="SqliteWasmCommand.CommandTimeout"/>, 0 waits indefinitely,
+    /// null keeps <see cref="DefaultRequestTimeout"/>), which then throws
+    /// <see cref="TimeoutException"/>.
+    /// </summary>
+    internal async Task<SqlQueryResult> ExecuteCommandAsync(
+        string database,
+        string sql,
+        SqliteWasmParameterCollection parameters,
+        int batchSize,
+        string? begin,
+        bool deferBlobs,
+        bool inTransaction,
+        SqliteWasmRequestPriority priority,
+        int? timeoutSeconds,
+        CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+        ThrowIfDiskLocked($"ExecuteSql on '{database}'");
+        ForgetStatementClassesOnSchemaChange(database, sql);
+
+        var timeout = ToRequestTimeout(timeoutSeconds);
 
         var requestId = Interlocked.Increment(ref _nextRequestId);
-        var tcs = new TaskCompletionSource<SqlQueryResult>(TaskCreationOptions.RunContinuationsAsynchronously);
-        _pendingRequests[requestId] = tcs;
+        var writer = WorkerRequestEncoder.TryEncodeExecute(requestId, database, sql, parameters, batchSize, sync: false, begin, deferBlobs, priority);
+        if (writer is null)
+        {
+            var (parameterDict, packedBlobs) = parameters.GetParameterValuesWithBlobs();
+            return packedBlobs is null
+                ? await ExecuteSqlAsync(database, sql, parameterDict, batchSize, begin, deferBlobs, cancellationToken, timeout)
+                : await ExecuteSqlWithBlobsAsync(database, sql, parameterDict, packedBlobs, batchSize, begin, deferBlobs, cancellationToken, timeout);
+        }
 
-        try
+        if (IsReadWorkerCandidate(database, sql, batchSize, begin, deferBlobs, inTransaction))
         {
-            await using var registration = cancellationToken.Register(() =>
+            var readResult = await TryExecuteOnReadWorkerAsync(requestId, writer, database, sql, timeout, cancellationToken);
+            if (readResult is not null)
             {
-                _pendingRequests.TryRemove(requestId, out _);
-                tcs.TrySetCanceled();
-            });
+                return readResult;
+            }
+
+            // A reader refused or failed it: same request for the owning worker
+            requestId = Interlocked.Increment(ref _nextRequestId);
+            writer = WorkerRequestEncoder.TryEncodeExecute(requestId, database, sql, parameters, batchSize, sync: false, begin, deferBlobs, priority)!;
+        }
 
-            var metadataJson = JsonSerializer.Serialize(new
+        return await SendAndWaitAsync(requestId, () =>
+        {
+            // The bridge copies the bytes out before returning; the writer is reusable right after
+            try
             {
-                id = requestId,
-                data = new
-                {
-                    type = "execute",
-                    database,
-                    sql,
-                    parameters,
-                }
-            });
+                SendEncodedToWorker(MemoryMarshal.AsMemory(writer.WrittenMemory).Span, IsKnownReadOnly(database, sql));
+            }
+            finally
+            {
+                WorkerRequestEncoder.Return(writer);
+            }
+        }, cancellationToken, timeout);
+    }
 
-            SendBinaryToWorker(packedBlobs.AsSpan(), metadataJson);
+    /// <summary>
+    /// <see cref="TimeSpan"/> of a command timeout in seconds; 0 (or less)
+    /// is <see cref="Timeout.InfiniteTimeSpan"/>, as in ADO.NET, and an
+    /// unset one <see cref="DefaultRequestTimeout"/>.
+    /// </summary>
+    private static TimeSpan ToRequestTimeout(int? timeoutSeconds) => timeoutSeconds switch
+    {
+        null => DefaultRequestTimeout,
+        > 0 => TimeSpan.FromSeconds(timeoutSeconds.Value),
+        _ => Timeout.InfiniteTimeSpan
+    };
 
-            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
-            timeoutCts.CancelAfter(60000);
+    /// <summary>
+    /// Blocking <see cref="ExecuteCommandAsync"/> over the synchronous
+    /// channel — the backing of the synchronous <see cref="SqliteWasmCommand"/>
+    /// methods. Always returns the whole result set (no cursor).
+    /// <paramref name="timeoutSeconds"/> of 0 waits indefinitely.
+    /// </summary>
+    internal SqlQueryResult ExecuteCommand(
+        string database,
+        string sql,
+        SqliteWasmParameterCollection parameters,
+        string? begin,
+        bool deferBlobs,
+        int timeoutSeconds)
+    {
+        ThrowIfDiskLocked($"ExecuteSql on '{database}'");
+        ForgetStatementClassesOnSchemaChange(database, sql);
+
+        var requestId = Interlocked.Increment(ref _nextRequestId);
+        var writer = WorkerRequestEncoder.TryEncodeExecute(requestId, database, sql, parameters, 0, sync: true, begin, deferBlobs);
+        if (writer is null)
+        {
+            var (parameterDict, packedBlobs) = parameters.GetParameterValuesWithBlobs();
+            return ExecuteSql(database, sql, parameterDict, packedBlobs, begin, deferBlobs, timeoutSeconds);
+        }
+
+        var operation = $"ExecuteSql on '{database}'";
+        var timeoutMs = (int)Math.Min(int.MaxValue, Math.Max(0, timeoutSeconds) * 1000L);
+        SyncStatus status;
+        try
+        {
+            ThrowIfSyncUnavailable(operation);
+            status = (SyncStatus)SendEncodedToWorkerSync(MemoryMarshal.AsMemory(writer.WrittenMemory).Span, IsKnownReadOnly(database, sql), timeoutMs);
+        }
+        finally
+        {
+            WorkerRequestEncoder.Return(writer);
+        }
+        return ReadSyncResponse(status, timeoutMs, operation);
+    }
+
+    /// <summary>
+    /// Run <paramref name="commands"/> in order in a single 'executeBatch'
+    /// round trip, binary-encoded like <see cref="ExecuteCommandAsync"/> and
+    /// with the same JSON fallback. The worker stops at the first failing
+    /// command and reports which one failed; per-command results come back in
+    /// <see cref="SqlQueryResult.BatchResults"/>. <paramref name="begin"/> is
+    /// run ahead of the first command, as for <see cref="ExecuteCommandAsync"/>.
+    /// With <paramref name="atomic"/> the worker wraps the commands in a
+    /// savepoint and rolls it back on failure. <paramref name="priority"/>
+    /// and <paramref name="timeoutSeconds"/> (for the whole batch) as for
+    /// <see cref="ExecuteCommandAsync"/>.
+    /// </summary>
+    internal async Task<SqlQueryResult> ExecuteBatchAsync(
+        string database,
+        IReadOnlyList<(string Sql, SqliteWasmParameterCollection Parameters)> commands,
+        string? begin,
+        bool atomic,
+        SqliteWasmRequestPriority priority,
+        int? timeoutSeconds,
+        CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+        ThrowIfDiskLocked($"ExecuteBatch on '{database}'");
+        foreach (var command in commands)
+        {
+            ForgetStatementClassesOnSchemaChange(database, command.Sql);
+        }
+
+        var timeout = ToRequestTimeout(timeoutSeconds);
+
+        var requestId = Interlocked.Increment(ref _nextRequestId);
+        var writer = WorkerRequestEncoder.TryEncodeBatch(requestId, database, commands, sync: false, begin, atomic, priority);
+        if (writer is null)
+        {
+            var (entries, packedBlobs) = BuildBatchRequest(commands);
+            var request = new
+            {
+                type = "executeBatch",
+                database,
+                commands = entries,
+                begin,
+                atomic
+            };
+
+            return packedBlobs is null
+                ? await SendRequestAsync(request, cancellationToken, timeout)
+                : await SendBinaryRequestAsync(request, packedBlobs, $"ExecuteBatchAsync on '{database}'", cancellationToken, timeout);
+        }
+
+        return await SendAndWaitAsync(requestId, () =>
+        {
             try
             {
-                return await tcs.Task.WaitAsync(timeoutCts.Token).ConfigureAwait(false);
+                SendEncodedToWorker(MemoryMarshal.AsMemory(writer.WrittenMemory).Span, readOnly: false);
             }
-            catch (OperationCanceledException) when (timeoutCts.IsCancellationRequested && !cancellationToken.IsCancellationRequested)
+            finally
             {
-                throw new TimeoutException($"ExecuteSqlWithBlobsAsync on '{database}' timed out");
+                WorkerRequestEncoder.Return(writer);
             }
+        }, cancellationToken, timeout);
+    }
+
+    /// <summary>
+    /// Blocking <see cref="ExecuteBatchAsync"/> over the synchronous channel.
+    /// </summary>
+    internal SqlQueryResult ExecuteBatch(
+        string database,
+        IReadOnlyList<(string Sql, SqliteWasmParameterCollection Parameters)> commands,
+        string? begin,
+        bool atomic,
+        int timeoutSeconds)
+    {
+        ThrowIfDiskLocked($"ExecuteBatch on '{database}'");
+        foreach (var command in commands)
+        {
+            ForgetStatementClassesOnSchemaChange(database, command.Sql);
+        }
+
+        var operation = $"ExecuteBatch on '{database}'";
+        var timeoutMs = (int)Math.Min(int.MaxValue, Math.Max(0, timeoutSeconds) * 1000L);
+        var requestId = Interlocked.Increment(ref _nextRequestId);
+        var writer = WorkerRequestEncoder.TryEncodeBatch(requestId, database, commands, sync: true, begin, atomic);
+        if (writer is null)
+        {
+            var (entries, packedBlobs) = BuildBatchRequest(commands);
+            var request = new
+            {
+                type = "executeBatch",
+                database,
+                commands = entries,
+                begin,
+                atomic
+            };
+
+            return SendRequestSync(request, timeoutMs, operation, packedBlobs);
+        }
+
+        SyncStatus status;
+        try
+        {
+            ThrowIfSyncUnavailable(operation);
+            status = (SyncStatus)SendEncodedToWorkerSync(MemoryMarshal.AsMemory(writer.WrittenMemory).Span, readOnly: false, timeoutMs);
         }
         finally
         {
-            _pendingRequests.TryRemove(requestId, out _);
+            WorkerRequestEncoder.Return(writer);
         }
+        return ReadSyncResponse(status, timeoutMs, operation);
+    }
+
+    /// <summary>
+    /// JSON form of an 'executeBatch' request: one <c>{ sql, parameters,
+    /// blobOffset, blobLength }</c> entry per command. Blob parameters of all
+    /// commands share a single binary attachment; each entry names its own
+    /// slice of it, inside which its <c>__blobOffset</c> placeholders are relative.
+    /// </summary>
+    private static (List<object> Commands, byte[]? PackedBlobs) BuildBatchRequest(
+        IReadOnlyList<(string Sql, SqliteWasmParameterCollection Parameters)> commands)
+    {
+        var entries = new List<object>(commands.Count);
+        List<byte[]>? blobParts = null;
+        var blobTotal = 0;
+
+        foreach (var (sql, parameters) in commands)
+        {
+            var (parameterDict, blobs) = parameters.GetParameterValuesWithBlobs();
+            var blobOffset = blobTotal;
+            if (blobs is not null)
+            {
+                (blobParts ??= []).Add(blobs);
+                blobTotal += blobs.Length;
+            }
+
+            entries.Add(new
+            {
+                sql,
+                parameters = parameterDict,
+                blobOffset,
+                blobLength = blobs?.Length ?? 0
+            });
+        }
+
+        if (blobParts is null)
+        {
+            return (entries, null);
+        }
+
+        var packedBlobs = new byte[blobTotal];
+        var offset = 0;
+        foreach (var part in blobParts)
+        {
+            part.CopyTo(packedBlobs, offset);
+            offset += part.Length;
+        }
+        return (entries, packedBlobs);
+    }
+
+    /// <summary>
+    /// Post <paramref name="request"/> with <paramref name="payload"/> as its
+    /// binary attachment and wait for the response, with
+    /// <see cref="SendAndWaitAsync(int, Action, CancellationToken, TimeSpan?, string)"/>'s
+    /// timeout and cancellation.
+    /// </summary>
+    private Task<SqlQueryResult> SendBinaryRequestAsync(
+        object request,
+        byte[] payload,
+        string operation,
+        CancellationToken cancellationToken,
+        TimeSpan? timeout = null)
+    {
+        var requestId = Interlocked.Increment(ref _nextRequestId);
+        var metadataJson = JsonSerializer.Serialize(new { id = requestId, data = request });
+        return SendAndWaitAsync(requestId, () => SendBinaryToWorker(payload.AsSpan(), metadataJson), cancellationToken, timeout, operation);
+    }
+
+    /// <summary>
+    /// Blocking execute over the synchronous channel — the backing of the
+    /// synchronous <see cref="SqliteWasmCommand"/> methods. Always returns the
+    /// whole result set (no cursor). <paramref name="timeoutSeconds"/> of 0
+    /// waits indefinitely.
+    /// </summary>
+    internal SqlQueryResult ExecuteSql(
+        string database,
+        string sql,
+        Dictionary<string, object?> parameters,
+        byte[]? packedBlobs,
+        string? begin,
+        bool deferBlobs,
+        int timeoutSeconds)
+    {
+        ThrowIfDiskLocked($"ExecuteSql on '{database}'");
+        ForgetStatementClassesOnSchemaChange(database, sql);
+
+        var request = new
+        {
+            type = "execute",
+            database,
+            sql,
+            parameters,
+            batchSize = 0,
+            begin,
+            deferBlobs
+        };
+
+        var timeoutMs = (int)Math.Min(int.MaxValue, Math.Max(0, timeoutSeconds) * 1000L);
+        return SendRequestSync(request, timeoutMs, $"ExecuteSql on '{database}'", packedBlobs);
     }
 
     /// <summary>
@@ -375,7 +790,7 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
         };
 
         await SendRequestAsync(request, cancellationToken);
-        _openDatabases.Remove(databaseName);
+        MarkDatabaseClosed(databaseName);
     }
 
     /// <summary>
@@ -393,7 +808,60 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
         };
 
         await SendRequestAsync(request, cancellationToken);
-        _openDatabases.Remove(oldName);
+        MarkDatabaseClosed(oldName);
+        ForgetStatementClasses(newName);
+    }
+
+    /// <summary>
+    /// Next batch of rows from a cursor opened by a batched
+    /// <see cref="ExecuteSqlAsync(string, string, Dictionary{string, object}, int, string, bool, CancellationToken, Nullable{TimeSpan})"/>.
+    /// The returned <see cref="SqlQueryResult.CursorId"/> is 0 once the
+    /// statement is exhausted; the worker has released the cursor by then.
+    /// Column metadata is only sent with the first batch.
+    /// </summary>
+    internal async Task<SqlQueryResult> FetchCursorAsync(int cursorId, int batchSize, CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+
+        var request = new
+        {
+            type = "fetch", cursorId, batchSize
+        };
+
+        return await SendRequestAsync(request, cancellationToken);
+    }
+
+    /// <summary>
+    /// Release a cursor before it was exhausted (reader disposed early).
+    /// Unknown ids are ignored by the worker.
+    /// </summary>
+    internal async Task CloseCursorAsync(int cursorId, CancellationToken cancellationToken)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+
+        var request = new
+        {
+            type = "closeCursor", cursorId
+        };
+
+        await SendRequestAsync(request, cancellationToken);
+    }
+
+    /// <summary>
+    /// Prepared-statement cache counters for <paramref name="databaseName"/>.
+    /// </summary>
+    public async Task<SqliteWasmStatementCacheStatistics> GetStatementCacheStatisticsAsync(
+        string databaseName, CancellationToken cancellationToken = default)
+    {
+        await EnsureInitializedAsync(cancellationToken);
+
+        var request = new
+        {
+            type = "statementCacheStats", database = databaseName
+        };
+
+        var result = await SendRequestAsync(request, cancellationToken);
+        return result.StatementCache ?? new SqliteWasmStatementCacheStatistics(0, 0, 0, 0);
     }
 
     private Task EnsureInitializedAsync(CancellationToken cancellationToken)
@@ -417,39 +885,79 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     // request/response round-trips through the same TaskCompletionSource map.
     // No behavior change: same-assembly partials (.Encryption.cs / .Delta.cs)
     // continue to see this method exactly as before.
-    internal async Task<SqlQueryResult> SendRequestAsync(object request, CancellationToken cancellationToken)
+    internal Task<SqlQueryResult> SendRequestAsync(object request, CancellationToken cancellationToken, TimeSpan? timeout = null)
     {
         var requestId = Interlocked.Increment(ref _nextRequestId);
-        var tcs = new TaskCompletionSource<SqlQueryResult>();
+        var requestJson = JsonSerializer.Serialize(new
+        {
+            id = requestId,
+            data = request
+        });
 
-        _pendingRequests[requestId] = tcs;
+        return SendAndWaitAsync(requestId, () => SendToWorker(requestJson), cancellationToken, timeout);
+    }
+
+    /// <summary>
+    /// Timeout of requests that do not carry one. Must be long enough for
+    /// heavy operations like FTS5 rebuild on large databases.
+    /// </summary>
+    private static readonly TimeSpan DefaultRequestTimeout = TimeSpan.FromMinutes(5);
+
+    /// <summary>
+    /// Register <paramref name="requestId"/>, post it via <paramref name="send"/>
+    /// and wait for the worker's response. Cancellation also reaches the
+    /// worker, which drops the request if it is still queued or interrupts
+    /// its statement (see the bridge's <c>cancelRequest</c>). Running past
+    /// <paramref name="timeout"/> (default <see cref="DefaultRequestTimeout"/>,
+    /// <see cref="Timeout.InfiniteTimeSpan"/> waits indefinitely) cancels the
+    /// request the same way and throws <see cref="TimeoutException"/> naming
+    /// <paramref name="operation"/>.
+    /// </summary>
+    private Task<SqlQueryResult> SendAndWaitAsync(
+        int requestId,
+        Action send,
+        CancellationToken cancellationToken,
+        TimeSpan? timeout = null,
+        string operation = "Database")
+        => SendAndWaitAsync(_pendingRequests, requestId, send, cancellationToken, timeout, operation);
+
+    /// <summary>
+    /// <see cref="SendAndWaitAsync(int, Action, CancellationToken, TimeSpan?, string)"/>
+    /// for requests answered through <paramref name="pending"/> — raw
+    /// binary responses go through <see cref="_pendingBinaryRequests"/>.
+    /// </summary>
+    private async Task<T> SendAndWaitAsync<T>(
+        ConcurrentDictionary<int, TaskCompletionSource<T>> pending,
+        int requestId,
+        Action send,
+        CancellationToken cancellationToken,
+        TimeSpan? timeout,
+        string operation)
+    {
+        cancellationToken.ThrowIfCancellationRequested();
+        var tcs = new TaskCompletionSource<T>();
+        var limit = timeout ?? DefaultRequestTimeout;
+
+        pending[requestId] = tcs;
 
         try
         {
-            await using var registration = cancellationToken.Register(() =>
-            {
-                _pendingRequests.TryRemove(requestId, out _);
-                tcs.TrySetCanceled();
-            });
+            StartTiming(requestId);
+            send();
 
-            var requestJson = JsonSerializer.Serialize(new
+            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+            timeoutCts.CancelAfter(limit);
+
+            // Registered after the post, so a cancel never overtakes its request
+            await using var registration = timeoutCts.Token.Register(() =>
             {
-                id = requestId,
-                data = request
+                if (pending.TryRemove(requestId, out _))
+                {
+                    CancelRequest(requestId);
+                }
+                tcs.TrySetCanceled();
             });
 
-            SendToWorker(requestJson);
-
-            // Timeout for general SQL operations.
-            // Must be long enough for heavy operations like FTS5 rebuild on large databases.
-#if DEBUG
-            const int defaultTimeoutMs = 300_000; // 5 minutes in debug
-#else
-            const int defaultTimeoutMs = 300_000; // 5 minutes in release
-#endif
-            using var timeoutCts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
-            timeoutCts.CancelAfter(defaultTimeoutMs);
-
             try
             {
                 return await tcs.Task.WaitAsync(timeoutCts.Token);
@@ -457,14 +965,94 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
             catch (OperationCanceledException) when (!cancellationToken.IsCancellationRequested)
             {
                 // Timeout occurred (not user cancellation)
-                throw new TimeoutException($"Database operation timed out after {defaultTimeoutMs / 1000} seconds.");
+                throw new TimeoutException($"{operation} operation timed out after {limit.TotalSeconds:0.#} seconds.");
             }
         }
         catch
         {
-            _pendingRequests.TryRemove(requestId, out _);
+            pending.TryRemove(requestId, out _);
             throw;
         }
+        finally
+        {
+            StopTiming(requestId);
+        }
+    }
+
+    private const int DefaultSyncTimeoutMs = 30_000;
+
+    /// <summary>
+    /// Outcome of a synchronous request, as returned by the bridge's
+    /// <c>sendToWorkerSync</c>. The first three are the worker's payload kinds.
+    /// </summary>
+    private enum SyncStatus
+    {
+        Result = 0,
+        Json = 1,
+        Error = 2,
+        Timeout = 3,
+        Busy = 4
+    }
+
+    /// <summary>
+    /// Post a request and block the calling thread until the worker answers
+    /// through the shared channel. Mirrors <see cref="SendRequestAsync"/>'s
+    /// result and error shapes.
+    /// </summary>
+    private SqlQueryResult SendRequestSync(object request, int timeoutMs, string operation, byte[]? binaryPayload = null)
+    {
+        ThrowIfSyncUnavailable(operation);
+
+        var requestJson = JsonSerializer.Serialize(new
+        {
+            id = Interlocked.Increment(ref _nextRequestId),
+            data = request,
+            sync = true
+        });
+
+        var status = (SyncStatus)(binaryPayload is null
+            ? SendToWorkerSync(requestJson, timeoutMs)
+            : SendBinaryToWorkerSync(binaryPayload.AsSpan(), requestJson, timeoutMs));
+
+        return ReadSyncResponse(status, timeoutMs, operation);
+    }
+
+    private void ThrowIfSyncUnavailable(string operation)
+    {
+        if (!IsSynchronousExecutionAvailable)
+        {
+            throw new InvalidOperationException(
+                $"{operation}: synchronous execution requires SqliteWasmOptions.SynchronousChannelSize on a cross-origin-isolated page.");
+        }
+    }
+
+    private static SqlQueryResult ReadSyncResponse(SyncStatus status, int timeoutMs, string operation)
+    {
+        switch (status)
+        {
+            case SyncStatus.Result:
+                return ColumnarRowSet.ReadResult(TakeSyncPayload());
+
+            case SyncStatus.Json:
+            {
+                var response = JsonSerializer.Deserialize<WorkerResponse>(TakeSyncPayload(), JsonOptions)
+                    ?? throw new InvalidOperationException($"{operation}: empty worker response");
+                return ToQueryResult(response);
+            }
+
+            case SyncStatus.Error:
+                throw new InvalidOperationException($"Worker error: {Encoding.UTF8.GetString(TakeSyncPayload())}");
+
+            case SyncStatus.Timeout:
+                throw new TimeoutException($"{operation} timed out after {timeoutMs / 1000} seconds.");
+
+            case SyncStatus.Busy:
+                throw new InvalidOperationException(
+                    $"{operation}: a previous synchronous request timed out and is still running in the worker.");
+
+            default:
+                throw new InvalidOperationException($"{operation}: unexpected synchronous status {(int)status}");
+        }
     }
 
     // ============================================================================
@@ -641,17 +1229,23 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     }
 
     /// <summary>
-    /// Drop a database from the bridge's open-database mirror. Called by
-    /// encryption / delta ops where the worker autonomously closes the DB
-    /// during an in-place conversion (encrypt / decrypt / rekey-export) so
-    /// the next DbContext open re-enters xOpen.
+    /// Drop a database from the bridge's open-database mirror, and the read
+    /// routing's statement classes with it. Called wherever the worker
+    /// closes the DB — close, delete, rename, import, and encryption / delta
+    /// ops that close it autonomously during an in-place conversion
+    /// (encrypt / decrypt / rekey-export) — so the next DbContext open
+    /// re-enters xOpen.
     /// </summary>
-    internal void MarkDatabaseClosed(string databaseName) => _openDatabases.Remove(databaseName);
+    internal void MarkDatabaseClosed(string databaseName)
+    {
+        _openDatabases.Remove(databaseName);
+        ForgetStatementClasses(databaseName);
+    }
 
     /// <summary>
-    /// Called from JavaScript when worker responds.
-    /// Receives JSON string and deserializes with source-generated context.
-    /// Single deserialization eliminates overhead of parsing twice.
+    /// Called from JavaScript for responses that carry structured fields
+    /// (database lists, manifests, statistics). Receives JSON string and
+    /// deserializes with source-generated context.
     /// </summary>
     [JSExport]
     public static void OnWorkerResponse(string messageJson)
@@ -667,41 +1261,7 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
                 return;
             }
 
-            var response = message.Data;
-
-            // Check for error response — route to either pending requests or pending binary requests
-            if (!response.Success)
-            {
-                if (Instance._pendingRequests.TryRemove(message.Id, out var errorTcs))
-                {
-                    errorTcs.TrySetException(new InvalidOperationException($"Worker error: {response.Error ?? "Unknown error"}"));
-                }
-                else if (Instance._pendingBinaryRequests.TryRemove(message.Id, out var binaryErrorTcs))
-                {
-                    binaryErrorTcs.TrySetException(new InvalidOperationException($"Worker error: {response.Error ?? "Unknown error"}"));
-                }
-
-                return;
-            }
-
-            if (Instance._pendingRequests.TryRemove(message.Id, out var tcs))
-            {
-                // Create SqlQueryResult for non-execute operations (open, close, exists)
-                var result = new SqlQueryResult
-                {
-                    ColumnNames = response.ColumnNames ?? [],
-                    ColumnTypes = response.ColumnTypes ?? [],
-                    Rows = [],
-                    RowsAffected = response.RowsAffected,
-                    LastInsertId = response.LastInsertId,
-                    Databases = response.Databases,
-                    ManifestState = response.ManifestState,
-                    ManifestBody = response.ManifestBody,
-                    ManifestSchemaVersion = response.ManifestSchemaVersion,
-                };
-
-                tcs.TrySetResult(result);
-            }
+            CompleteRequest(message.Id, message.Data);
         }
         catch (Exception ex)
         {
@@ -710,170 +1270,150 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     }
 
     /// <summary>
-    /// Callback for binary MessagePack responses from worker (execute operations).
-    /// Uint8Array is marshalled to byte array for MessagePack deserialization.
-    /// Uses typeless deserialization due to dynamic object?[][] data types.
+    /// Called from JavaScript for acknowledgements and errors — responses
+    /// whose only fields are success / error / rowsAffected / lastInsertId.
+    /// Passed as primitive arguments, so no JSON is built or parsed on
+    /// either side of the boundary.
     /// </summary>
     [JSExport]
-    public static void OnWorkerResponseBinary(int requestId, byte[] messageData)
+    public static void OnWorkerControlResponse(
+        int requestId,
+        bool success,
+        int rowsAffected,
+        [JSMarshalAs<JSType.Number>] long lastInsertId,
+        string? error)
     {
         try
         {
-            // Deserialize MessagePack binary data. byte[] marshaling is the
-            // runtime's supported path for JS-originated buffers crossing
-            // into a JSExport — [JSMarshalAs<MemoryView>] ArraySegment<byte>
-            // asserts at runtime ("Only roundtrip of ArraySegment instance
-            // created by C#") because MemoryView marshal requires the
-            // ArraySegment to have originated in C#. A pinned-managed-byte[]
-            // + round-trip MemoryView pattern would in principle eliminate
-            // the per-call managed allocation (single memcpy via
-            // MemoryView.set on the JS side, buffer reused), and a custom
-            // Module._malloc/_free + IntPtr+Span<byte> on JSExport would
-            // be even leaner — but both depend on runtime-API surface that
-            // is in flux pending the Mono → NativeAOT-on-browser transition.
-            // Decision 2026-05-11: stay on the supported byte[] path until
-            // the .NET maintainers settle the heap-API direction.
-            var responseObj = MessagePackSerializer.Typeless.Deserialize(messageData, MessagePackOptions);
-
-            if (responseObj is null)
-            {
-                Console.Error.WriteLine("[Worker Bridge] Failed to deserialize MessagePack data");
-                return;
-            }
-
-            // MessagePack typeless API returns Dictionary<object, object>
-            if (responseObj is not Dictionary<object, object> responseDict)
+            CompleteRequest(requestId, new WorkerResponse
             {
-                Console.Error.WriteLine($"[Worker Bridge] Unexpected response type: {responseObj.GetType().FullName}");
-                if (Instance._pendingRequests.TryRemove(requestId, out var errorTcs))
-                {
-                    errorTcs.TrySetException(new InvalidCastException($"Expected Dictionary<object, object> but got {responseObj.GetType().FullName}"));
-                }
-                return;
-            }
-
-            // Extract fields with type conversions
-            var columnNames = responseDict.TryGetValue("columnNames", out var cnValue)
-                ? ((object[])cnValue).Cast<string>().ToList()
-                : [];
+                Success = success,
+                Error = error,
+                RowsAffected = rowsAffected,
+                LastInsertId = lastInsertId
+            });
+        }
+        catch (Exception ex)
+        {
+            Console.Error.WriteLine($"[Worker Bridge] Error processing worker response: {ex.Message}");
+        }
+    }
 
-            var columnTypes = responseDict.TryGetValue("columnTypes", out var ctValue)
-                ? ((object[])ctValue).Cast<string>().ToList()
-                : [];
+    private static void CompleteRequest(int requestId, WorkerResponse response)
+    {
+        RecordTiming(requestId);
 
-            // Extract typed rows data
-            object?[][] rows = [];
-            if (responseDict.TryGetValue("typedRows", out var trValue))
+        // Check for error response — route to either pending requests or pending binary requests
+        if (!response.Success)
+        {
+            if (Instance._pendingRequests.TryRemove(requestId, out var errorTcs))
             {
-                var typedRowsDict = (Dictionary<object, object>)trValue;
-                if (typedRowsDict.TryGetValue("data", out var dataValue))
-                {
-                    var dataArray = (object[])dataValue;
-                    rows = dataArray
-                        .Select(rowObj => ((object[])rowObj)
-                            .Select(ConvertMessagePackValue)
-                            .ToArray())
-                        .ToArray();
-                }
+                errorTcs.TrySetException(new InvalidOperationException($"Worker error: {response.Error ?? "Unknown error"}"));
             }
-
-            var rowsAffected = responseDict.TryGetValue("rowsAffected", out var raValue)
-                ? ConvertToInt32(raValue)
-                : 0;
-
-            var lastInsertId = responseDict.TryGetValue("lastInsertId", out var liiValue)
-                ? ConvertToInt64(liiValue)
-                : 0L;
-
-            // Complete the pending request
-            if (Instance._pendingRequests.TryRemove(requestId, out var tcs))
+            else if (Instance._pendingBinaryRequests.TryRemove(requestId, out var binaryErrorTcs))
             {
-                var result = new SqlQueryResult
-                {
-                    ColumnNames = columnNames,
-                    ColumnTypes = columnTypes,
-                    Rows = rows,
-                    RowsAffected = rowsAffected,
-                    LastInsertId = lastInsertId
-                };
-
-                tcs.TrySetResult(result);
+                binaryErrorTcs.TrySetException(new InvalidOperationException($"Worker error: {response.Error ?? "Unknown error"}"));
             }
+
+            return;
         }
-        catch (Exception ex)
+
+        if (Instance._pendingRequests.TryRemove(requestId, out var tcs))
         {
-            Console.Error.WriteLine($"[Worker Bridge] MessagePack deserialization failed: {ex}");
-            if (Instance._pendingRequests.TryRemove(requestId, out var tcs))
-            {
-                tcs.TrySetException(ex);
-            }
+            tcs.TrySetResult(ToQueryResult(response));
         }
     }
 
     /// <summary>
-    /// Convert MessagePack deserialized values to expected C# types.
+    /// SqlQueryResult for the JSON responses of non-execute operations
+    /// (open, close, exists, ...).
     /// </summary>
-    private static object? ConvertMessagePackValue(object? value)
+    private static SqlQueryResult ToQueryResult(WorkerResponse response)
     {
-        return value switch
+        return new SqlQueryResult
         {
-            null => null,
-            byte[] bytes => bytes,           // BLOB (stays binary!)
-            string s => s,                   // TEXT
-            bool b => b ? 1L : 0L,           // BOOLEAN → INTEGER (SQLite stores as 0/1)
-            long l => l,                     // INTEGER
-            int i => (long)i,                // INTEGER (ensure long)
-            double d => d,                   // REAL
-            float f => (double)f,            // REAL (ensure double)
-            byte by => (long)by,             // BYTE → INTEGER
-            short sh => (long)sh,            // SHORT → INTEGER
-            _ => value.ToString()            // Fallback to string
+            ColumnNames = response.ColumnNames ?? [],
+            ColumnTypes = response.ColumnTypes ?? [],
+            Rows = ColumnarRowSet.Empty,
+            RowsAffected = response.RowsAffected,
+            LastInsertId = response.LastInsertId,
+            Databases = response.Databases,
+            ManifestState = response.ManifestState,
+            ManifestBody = response.ManifestBody,
+            ManifestSchemaVersion = response.ManifestSchemaVersion,
+            StatementCache = response.StatementCache,
+            ClosedDatabase = response.ClosedDatabase,
+            Crc32 = response.Crc32,
+            UncompressedLength = response.UncompressedLength,
         };
     }
 
     /// <summary>
-    /// Safely convert MessagePack numeric value to Int32.
+    /// Callback for binary responses from worker (execute / fetch operations).
+    /// Uint8Array is marshalled to byte array and kept as the backing store of
+    /// the result's <see cref="ColumnarRowSet"/> — rows are not unpacked into
+    /// per-cell objects.
     /// </summary>
-    private static int ConvertToInt32(object? value)
+    [JSExport]
+    public static void OnWorkerResponseBinary(int requestId, byte[] messageData)
     {
-        return value switch
+        try
         {
-            int i => i,
-            long l => (int)l,
-            float f => (int)f,
-            double d => (int)d,
-            byte b => b,
-            short s => s,
-            _ => 0
-        };
-    }
+            // byte[] marshaling is the runtime's supported path for
+            // JS-originated buffers crossing into a JSExport —
+            // [JSMarshalAs<MemoryView>] ArraySegment<byte> asserts at runtime
+            // ("Only roundtrip of ArraySegment instance created by C#")
+            // because MemoryView marshal requires the ArraySegment to have
+            // originated in C#. A pinned-managed-byte[] + round-trip
+            // MemoryView pattern would in principle eliminate the per-call
+            // managed allocation (single memcpy via MemoryView.set on the JS
+            // side, buffer reused), and a custom Module._malloc/_free +
+            // IntPtr+Span<byte> on JSExport would be even leaner — but both
+            // depend on runtime-API surface that is in flux pending the
+            // Mono → NativeAOT-on-browser transition.
+            // Decision 2026-05-11: stay on the supported byte[] path until
+            // the .NET maintainers settle the heap-API direction.
+            //
+            // The worker transfers (not clones) the result buffer, and
+            // ColumnarRowSet reads this array in place, so the marshal below
+            // is the only copy between the worker's builder and the reader.
+            var result = ColumnarRowSet.ReadResult(messageData);
+            RecordTiming(requestId);
 
-    /// <summary>
-    /// Safely convert MessagePack numeric value to Int64.
-    /// </summary>
-    private static long ConvertToInt64(object? value)
-    {
-        return value switch
+            // Complete the pending request
+            if (Instance._pendingRequests.TryRemove(requestId, out var tcs))
+            {
+                tcs.TrySetResult(result);
+            }
+        }
+        catch (Exception ex)
         {
-            long l => l,
-            int i => i,
-            float f => (long)f,
-            double d => (long)d,
-            byte b => b,
-            short s => s,
-            _ => 0L
-        };
+            Console.Error.WriteLine($"[Worker Bridge] Columnar result decoding failed: {ex}");
+            Instance._workerTimings.TryRemove(requestId, out _);
+            if (Instance._pendingRequests.TryRemove(requestId, out var tcs))
+            {
+                tcs.TrySetException(ex);
+            }
+        }
     }
 
     /// <summary>
     /// Callback for raw binary responses from worker (export operations).
-    /// Uint8Array is marshalled to byte array.
+    /// Uint8Array is marshalled to byte array. <paramref name="closedDatabase"/>
+    /// names a database the worker had to close to produce the bytes (an
+    /// offline export); online exports leave it open and pass null.
     /// </summary>
     [JSExport]
-    public static void OnWorkerResponseRawBinary(int requestId, byte[] data)
+    public static void OnWorkerResponseRawBinary(int requestId, byte[] data, string? closedDatabase)
     {
         try
         {
+            RecordTiming(requestId);
+            if (closedDatabase is not null)
+            {
+                Instance.MarkDatabaseClosed(closedDatabase);
+            }
+
             if (Instance._pendingBinaryRequests.TryRemove(requestId, out var tcs))
             {
                 tcs.TrySetResult(data);
@@ -908,11 +1448,33 @@ internal sealed partial class SqliteWasmWorkerBridge : ISqliteWasmDatabaseServic
     }
 
     [JSImport("initializeBridge", "sqliteWasmWorker")]
-    private static partial Task InitializeBridgeAsync(string baseHref, string assetRoot);
+    private static partial Task InitializeBridgeAsync(string baseHref, string assetRoot, string workerOptionsJson);
 
     [JSImport("sendToWorker", "sqliteWasmWorker")]
     private static partial void SendToWorker(string messageJson);
 
+    [JSImport("isSyncChannelAvailable", "sqliteWasmWorker")]
+    private static partial bool IsSyncChannelAvailable();
+
+    [JSImport("sendToWorkerSync", "sqliteWasmWorker")]
+    private static partial int SendToWorkerSync(string messageJson, int timeoutMs);
+
+    [JSImport("sendBinaryToWorkerSync", "sqliteWasmWorker")]
+    private static partial int SendBinaryToWorkerSync([JSMarshalAs<JSType.MemoryView>] Span<byte> data, string metadataJson, int timeoutMs);
+
+    [JSImport("cancelRequest", "sqliteWasmWorker")]
+    private static partial void CancelRequest(int requestId);
+
+    [JSImport("sendEncodedToWorker", "sqliteWasmWorker")]
+    private static partial void SendEncodedToWorker([JSMarshalAs<JSType.MemoryView>] Span<byte> request, bool readOnly);
+
+    [JSImport("sendEncodedToWorkerSync", "sqliteWasmWorker")]
+    private static partial int SendEncodedToWorkerSync([JSMarshalAs<JSType.MemoryView>] Span<byte> request, bool readOnly, int timeoutMs);
+
+    [JSImport("takeSyncPayload", "sqliteWasmWorker")]
+    [return: JSMarshalAs<JSType.Array<JSType.Number>>]
+    private static partial byte[] TakeSyncPayload();
+
     [JSImport("sendBinaryToWorker", "sqliteWasmWorker")]
     private static partial void SendBinaryToWorker([JSMarshalAs<JSType.MemoryView>] Span<byte> data, string metadataJson);
 
@@ -934,7 +1496,7 @@ internal sealed class WorkerMessage
 
 /// <summary>
 /// Worker response structure (matches JavaScript response format).
-/// Used only for JSON error messages - execute responses use MessagePack binary format.
+/// Used only for JSON error messages - execute responses use the columnar binary format.
 /// </summary>
 internal sealed class WorkerResponse
 {
@@ -961,17 +1523,47 @@ internal sealed class WorkerResponse
     /// Schema version, see <see cref="SqlQueryResult.ManifestSchemaVersion"/>.
     /// </summary>
     public int? ManifestSchemaVersion { get; set; }
+    /// <summary>
+    /// Returned by the <c>statementCacheStats</c> worker op.
+    /// </summary>
+    public SqliteWasmStatementCacheStatistics? StatementCache { get; set; }
+    /// <summary>
+    /// Set by <c>exportStreamOpen</c>, see <see cref="SqlQueryResult.ClosedDatabase"/>.
+    /// </summary>
+    public string? ClosedDatabase { get; set; }
+    /// <summary>
+    /// See <see cref="SqlQueryResult.Crc32"/>.
+    /// </summary>
+    public uint? Crc32 { get; set; }
+    /// <summary>
+    /// See <see cref="SqlQueryResult.UncompressedLength"/>.
+    /// </summary>
+    public long? UncompressedLength { get; set; }
+}
+
+/// <summary>
+/// Worker tuning carried in the bridge's <c>init</c> message (the
+/// <c>options</c> field). Mirrors the subset of <see cref="SqliteWasmOptions"/>
+/// the bridge and worker consume.
+/// </summary>
+internal sealed class WorkerInitOptions
+{
+    public int StatementCacheSize { get; set; }
+    public int SynchronousChannelSize { get; set; }
+    public int ReadWorkerCount { get; set; }
+    public long ReadWorkerMaxSnapshotSize { get; set; }
 }
 
 /// <summary>
 /// Source-generated JSON serialization context for efficient, zero-allocation serialization.
 /// Uses Web defaults for camelCase and other web-friendly settings.
-/// Used only for error messages - execute responses use MessagePack binary format.
+/// Used only for error messages - execute responses use the columnar binary format.
 /// </summary>
 [JsonSourceGenerationOptions(JsonSerializerDefaults.Web)]
 [JsonSerializable(typeof(WorkerMessage))]
 [JsonSerializable(typeof(WorkerResponse))]
 [JsonSerializable(typeof(SqlQueryResult))]
+[JsonSerializable(typeof(WorkerInitOptions))]
 [JsonSerializable(typeof(BulkExportMetadata))]
 [JsonSerializable(typeof(TableExportSpec))]
 internal partial class WorkerJsonContext : JsonSerializerContext
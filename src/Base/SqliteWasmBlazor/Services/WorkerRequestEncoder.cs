@@ -0,0 +1,250 @@
+// SqliteWasmBlazor - Minimal EF Core compatible provider
+// MIT License
+
+using System.Buffers;
+using System.Buffers.Binary;
+using System.Globalization;
+using System.Text;
+
+namespace SqliteWasmBlazor;
+
+/// <summary>
+/// Binary encoding of 'execute' and 'executeBatch' requests, decoded by the
+/// worker's <c>decodeRequest</c> (TypeScript-Common/src/request-codec.ts; the
+/// layout is documented there). SQL, parameter names, storage-class tags and
+/// values are written straight into a reused buffer — no anonymous-object
+/// reflection serialization, no boxed parameter dictionary, no JSON escaping
+/// of TEXT values and no Base64 or side buffer for BLOBs. The worker binds
+/// the parameters from these bytes by statement index.
+/// </summary>
+internal static class WorkerRequestEncoder
+{
+    private const byte FormatVersion = 1;
+    private const byte OpcodeExecute = 1;
+    private const byte OpcodeExecuteBatch = 2;
+    private const byte FlagSync = 1;
+    private const byte FlagBegin = 2;
+    private const byte FlagAtomic = 4;
+    private const byte FlagDeferBlobs = 8;
+
+    /// <summary>A writer grown past this is dropped instead of kept for reuse.</summary>
+    private const int MaxRetainedCapacity = 1024 * 1024;
+
+    [ThreadStatic]
+    private static ArrayBufferWriter<byte>? t_writer;
+
+    /// <summary>
+    /// Encode an 'execute' request into the thread's reusable writer, with an
+    /// optional deferred <paramref name="begin"/> statement. With
+    /// <paramref name="deferBlobs"/> the worker answers large BLOBs with a
+    /// reference instead of their bytes. Returns null when a parameter value
+    /// has no binary encoding (the caller then uses the JSON request path,
+    /// which keeps its own conversions). <paramref name="priority"/> orders
+    /// the request in the worker's queue.
+    /// </summary>
+    public static ArrayBufferWriter<byte>? TryEncodeExecute(
+        int requestId,
+        string database,
+        string sql,
+        SqliteWasmParameterCollection parameters,
+        int batchSize,
+        bool sync,
+        string? begin = null,
+        bool deferBlobs = false,
+        SqliteWasmRequestPriority priority = SqliteWasmRequestPriority.Interactive)
+    {
+        var flags = (byte)(GetFlags(sync, begin, atomic: false) | (deferBlobs ? FlagDeferBlobs : 0));
+        var writer = BeginRequest(OpcodeExecute, flags, priority, requestId, batchSize, parameters.Count);
+
+        WriteString(writer, database);
+        WriteString(writer, sql);
+        if (begin is not null)
+        {
+            WriteString(writer, begin);
+        }
+
+        return TryWriteParameters(writer, parameters) ? writer : null;
+    }
+
+    /// <summary>
+    /// Encode an 'executeBatch' request: <paramref name="commands"/> in order,
+    /// each with its own parameter block. <paramref name="atomic"/> runs the
+    /// batch under a worker-side savepoint. Returns null under the same
+    /// conditions as <see cref="TryEncodeExecute"/>.
+    /// </summary>
+    public static ArrayBufferWriter<byte>? TryEncodeBatch(
+        int requestId,
+        string database,
+        IReadOnlyList<(string Sql, SqliteWasmParameterCollection Parameters)> commands,
+        bool sync,
+        string? begin,
+        bool atomic,
+        SqliteWasmRequestPriority priority = SqliteWasmRequestPriority.Interactive)
+    {
+        var writer = BeginRequest(OpcodeExecuteBatch, GetFlags(sync, begin, atomic), priority, requestId, 0, commands.Count);
+
+        WriteString(writer, database);
+        if (begin is not null)
+        {
+            WriteString(writer, begin);
+        }
+
+        foreach (var (sql, parameters) in commands)
+        {
+            WriteString(writer, sql);
+            BinaryPrimitives.WriteInt32LittleEndian(writer.GetSpan(4), parameters.Count);
+            writer.Advance(4);
+            if (!TryWriteParameters(writer, parameters))
+            {
+                return null;
+            }
+        }
+
+        return writer;
+    }
+
+    /// <summary>
+    /// Release the writer returned by <see cref="TryEncodeExecute"/> once its
+    /// bytes have been handed to JS.
+    /// </summary>
+    public static void Return(ArrayBufferWriter<byte> writer)
+    {
+        if (writer.Capacity > MaxRetainedCapacity)
+        {
+            t_writer = null;
+        }
+    }
+
+    private static ArrayBufferWriter<byte> BeginRequest(
+        byte opcode, byte flags, SqliteWasmRequestPriority priority, int requestId, int batchSize, int count)
+    {
+        var writer = t_writer ??= new ArrayBufferWriter<byte>(1024);
+        writer.ResetWrittenCount();
+
+        var header = writer.GetSpan(16);
+        header[0] = FormatVersion;
+        header[1] = opcode;
+        header[2] = flags;
+        header[3] = (byte)priority;
+        BinaryPrimitives.WriteInt32LittleEndian(header[4..], requestId);
+        BinaryPrimitives.WriteInt32LittleEndian(header[8..], batchSize);
+        BinaryPrimitives.WriteInt32LittleEndian(header[12..], count);
+        writer.Advance(16);
+        return writer;
+    }
+
+    private static byte GetFlags(bool sync, string? begin, bool atomic)
+    {
+        return (byte)((sync ? FlagSync : 0) | (begin is not null ? FlagBegin : 0) | (atomic ? FlagAtomic : 0));
+    }
+
+    private static bool TryWriteParameters(ArrayBufferWriter<byte> writer, SqliteWasmParameterCollection parameters)
+    {
+        foreach (SqliteWasmParameter parameter in parameters)
+        {
+            WriteString(writer, SqliteWasmParameterCollection.NormalizeParameterName(parameter.ParameterName));
+            if (!TryWriteValue(writer, parameter.Value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Same conversions as <see cref="SqliteWasmParameterCollection.GetParameterValues"/>,
+    /// except that 64-bit integers keep full precision (INTEGER, not TEXT)
+    /// and BLOBs travel inline.
+    /// </summary>
+    private static bool TryWriteValue(ArrayBufferWriter<byte> writer, object? value)
+    {
+        switch (value)
+        {
+            case null or DBNull:
+                WriteTag(writer, SqliteStorageClass.Null);
+                return true;
+            case string s:
+                WriteTag(writer, SqliteStorageClass.Text);
+                WriteString(writer, s);
+                return true;
+            case long l:
+                WriteInteger(writer, l);
+                return true;
+            case int or short or sbyte or byte or ushort or uint:
+                WriteInteger(writer, Convert.ToInt64(value, CultureInfo.InvariantCulture));
+                return true;
+            case ulong ul when ul <= long.MaxValue:
+                WriteInteger(writer, (long)ul);
+                return true;
+            case ulong ul:
+                // Beyond INTEGER range — same TEXT fallback as the JSON path
+                WriteTag(writer, SqliteStorageClass.Text);
+                WriteString(writer, ul.ToString(CultureInfo.InvariantCulture));
+                return true;
+            case bool b:
+                WriteInteger(writer, b ? 1 : 0);
+                return true;
+            case double d:
+                WriteReal(writer, d);
+                return true;
+            case float f:
+                WriteReal(writer, f);
+                return true;
+            case decimal m:
+                WriteReal(writer, (double)m);
+                return true;
+            case DateTime dt:
+                WriteTag(writer, SqliteStorageClass.Text);
+                WriteString(writer, dt.ToString("O"));
+                return true;
+            case DateTimeOffset dto:
+                WriteTag(writer, SqliteStorageClass.Text);
+                WriteString(writer, dto.ToString("O"));
+                return true;
+            case Guid guid:
+                WriteTag(writer, SqliteStorageClass.Text);
+                WriteString(writer, guid.ToString().ToUpperInvariant());
+                return true;
+            case byte[] bytes:
+                WriteTag(writer, SqliteStorageClass.Blob);
+                var span = writer.GetSpan(4 + bytes.Length);
+                BinaryPrimitives.WriteInt32LittleEndian(span, bytes.Length);
+                bytes.CopyTo(span[4..]);
+                writer.Advance(4 + bytes.Length);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    private static void WriteTag(ArrayBufferWriter<byte> writer, SqliteStorageClass tag)
+    {
+        writer.GetSpan(1)[0] = (byte)tag;
+        writer.Advance(1);
+    }
+
+    private static void WriteInteger(ArrayBufferWriter<byte> writer, long value)
+    {
+        var span = writer.GetSpan(9);
+        span[0] = (byte)SqliteStorageClass.Integer;
+        BinaryPrimitives.WriteInt64LittleEndian(span[1..], value);
+        writer.Advance(9);
+    }
+
+    private static void WriteReal(ArrayBufferWriter<byte> writer, double value)
+    {
+        var span = writer.GetSpan(9);
+        span[0] = (byte)SqliteStorageClass.Real;
+        BinaryPrimitives.WriteDoubleLittleEndian(span[1..], value);
+        writer.Advance(9);
+    }
+
+    /// <summary>Int32 byte length followed by the UTF-8 bytes.</summary>
+    private static void WriteString(ArrayBufferWriter<byte> writer, string value)
+    {
+        var span = writer.GetSpan(4 + Encoding.UTF8.GetMaxByteCount(value.Length));
+        var length = Encoding.UTF8.GetBytes(value, span[4..]);
+        BinaryPrimitives.WriteInt32LittleEndian(span, length);
+        writer.Advance(4 + length);
+    }
+}
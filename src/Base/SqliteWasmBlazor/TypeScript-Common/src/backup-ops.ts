@@ -0,0 +1,139 @@
+// backup-ops.ts
+// Online backup for the 'exportDb' path and the export stream
+// (stream-ops.ts): copies an open database into an in-memory image or a
+// temporary file with sqlite3_backup_init / step / finish, a bounded
+// number of pages per step, yielding to the worker's event loop between
+// steps. The source connection stays open with its PRAGMA state, cached
+// statements and cursors, and requests that arrive mid-export are served
+// between steps instead of queueing behind a close + exportFile.
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME, openDatabases, sqlite3 } from './worker-state';
+
+/**
+ * Pages copied per sqlite3_backup_step before yielding — 1 MB of 4 KB
+ * pages, small enough that a query waiting behind a step is not noticed.
+ */
+export const BACKUP_PAGES_PER_STEP = 256;
+
+interface ActiveBackup {
+    pBackup: number;
+    aborted: boolean;
+}
+
+const activeBackups = new Map<string, Set<ActiveBackup>>();
+
+const SQLITE_OK = 0;
+const SQLITE_BUSY = 5;
+const SQLITE_LOCKED = 6;
+const SQLITE_DONE = 101;
+
+function yieldToEventLoop(): Promise<void> {
+    return new Promise(resolve => setTimeout(resolve, 0));
+}
+
+/**
+ * Serialized copy of the open database `dbName` (a regular SQLite file
+ * image, same shape as poolUtil.exportFile after a close). Writes made by
+ * this connection between steps are folded into the copy by SQLite, so
+ * the image is consistent as of the last step.
+ */
+export async function backupDatabase(dbName: string, pagesPerStep = BACKUP_PAGES_PER_STEP): Promise<Uint8Array> {
+    const dest = new sqlite3.oo1.DB(':memory:', 'c');
+    try {
+        await backupDatabaseInto(dbName, dest, pagesPerStep);
+        return sqlite3.capi.sqlite3_js_db_export(dest.pointer);
+    } finally {
+        dest.close();
+    }
+}
+
+/**
+ * Copy the open database `dbName` into the empty database `dest` (an oo1
+ * DB the caller owns — in memory for backupDatabase, a temporary SAH file
+ * for the export stream in stream-ops.ts).
+ */
+export async function backupDatabaseInto(dbName: string, dest: any, pagesPerStep = BACKUP_PAGES_PER_STEP): Promise<void> {
+    const db = openDatabases.get(dbName);
+    if (!db) {
+        throw new Error(`Database ${dbName} not open`);
+    }
+
+    const capi = sqlite3.capi;
+    const backup: ActiveBackup = { pBackup: 0, aborted: false };
+    try {
+        // The destination must match the source page size, or an
+        // in-memory one fails sqlite3_backup_step with SQLITE_READONLY.
+        dest.exec(`PRAGMA page_size = ${Number(db.selectValue('PRAGMA page_size'))}`);
+
+        backup.pBackup = capi.sqlite3_backup_init(dest.pointer, 'main', db.pointer, 'main');
+        if (!backup.pBackup) {
+            throw new Error(`sqlite3_backup_init failed for ${dbName}: ${capi.sqlite3_errmsg(dest.pointer)}`);
+        }
+        track(dbName, backup);
+
+        let rc: number;
+        let steps = 0;
+        for (;;) {
+            rc = capi.sqlite3_backup_step(backup.pBackup, pagesPerStep);
+            if (rc !== SQLITE_OK && rc !== SQLITE_BUSY && rc !== SQLITE_LOCKED) {
+                break;
+            }
+            steps++;
+            await yieldToEventLoop();
+            if (backup.aborted) {
+                throw new Error(`Database ${dbName} was closed during export`);
+            }
+        }
+
+        const pageCount: number = capi.sqlite3_backup_pagecount(backup.pBackup);
+        capi.sqlite3_backup_finish(backup.pBackup);
+        backup.pBackup = 0;
+        if (rc !== SQLITE_DONE) {
+            throw new Error(`sqlite3_backup_step failed for ${dbName}: ${capi.sqlite3_js_rc_str(rc)}`);
+        }
+
+        logger.debug(MODULE_NAME, `Backed up ${dbName}: ${pageCount} pages in ${steps + 1} steps`);
+    } finally {
+        untrack(dbName, backup);
+        if (backup.pBackup) {
+            capi.sqlite3_backup_finish(backup.pBackup);
+        }
+    }
+}
+
+/**
+ * Finish every backup reading from `dbName`; their next step throws.
+ * Called from finalizeDatabaseStatements — a live backup handle pins the
+ * source connection like a statement does.
+ */
+export function abortDatabaseBackups(dbName: string): void {
+    const backups = activeBackups.get(dbName);
+    if (!backups) {
+        return;
+    }
+    for (const backup of backups) {
+        if (backup.pBackup) {
+            sqlite3.capi.sqlite3_backup_finish(backup.pBackup);
+            backup.pBackup = 0;
+        }
+        backup.aborted = true;
+    }
+    activeBackups.delete(dbName);
+}
+
+function track(dbName: string, backup: ActiveBackup): void {
+    let backups = activeBackups.get(dbName);
+    if (!backups) {
+        backups = new Set();
+        activeBackups.set(dbName, backups);
+    }
+    backups.add(backup);
+}
+
+function untrack(dbName: string, backup: ActiveBackup): void {
+    const backups = activeBackups.get(dbName);
+    if (backups?.delete(backup) && backups.size === 0) {
+        activeBackups.delete(dbName);
+    }
+}
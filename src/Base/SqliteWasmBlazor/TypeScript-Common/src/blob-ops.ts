@@ -0,0 +1,239 @@
+// blob-ops.ts
+// Incremental BLOB I/O for SqliteWasmBlob (Ado/SqliteWasmBlob.cs): a handle
+// opened with sqlite3_blob_open stays in the worker and the C# stream reads
+// or writes byte ranges through it ('blobRead' / 'blobWrite'), so a large
+// attachment never crosses to the main thread as a whole. Also resolves
+// which result columns of a statement can be answered with a blob
+// reference instead of their bytes (deferred BLOB cells, see stepRows in
+// sql-execute.ts).
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME, openDatabases, sqlite3 } from './worker-state';
+
+/**
+ * BLOB cells smaller than this stay inline in a deferring result — one
+ * more round trip would cost more than the bytes.
+ */
+export const DEFERRED_BLOB_MIN_BYTES = 16 * 1024;
+
+interface OpenBlob {
+    dbName: string;
+    pBlob: number;
+    length: number;
+}
+
+const blobs = new Map<number, OpenBlob>();
+let nextBlobHandle = 1;
+
+function getBlob(handle: number): OpenBlob {
+    const blob = blobs.get(handle);
+    if (!blob) {
+        throw new Error(`Blob handle ${handle} not open`);
+    }
+    return blob;
+}
+
+/** Throw the database's error message for a failed sqlite3_blob_* call. */
+function checkBlobRc(dbName: string, rc: number, operation: string): void {
+    if (rc === 0) {
+        return;
+    }
+    const db = openDatabases.get(dbName);
+    const message = db ? sqlite3.capi.sqlite3_errmsg(db.pointer) : sqlite3.capi.sqlite3_js_rc_str(rc);
+    throw new Error(`${operation} failed: ${message} (${sqlite3.capi.sqlite3_js_rc_str(rc)})`);
+}
+
+/**
+ * Open `schema.table.column` of row `rowid` for incremental I/O. The
+ * handle stays valid until closeBlob() or until the row is modified by
+ * anything other than writeBlob() (reads then fail with SQLITE_ABORT).
+ * `rowid` arrives as a string so 64-bit values keep their precision.
+ */
+export function openBlob(
+    dbName: string, schema: string, table: string, column: string,
+    rowid: string | number | bigint, writable: boolean,
+): { handle: number; length: number } {
+    const db = openDatabases.get(dbName);
+    if (!db) {
+        throw new Error(`Database ${dbName} not open`);
+    }
+
+    const capi = sqlite3.capi;
+    const wasm = sqlite3.wasm;
+    const stack = wasm.pstack.pointer;
+    try {
+        const ppBlob = wasm.pstack.allocPtr();
+        const rc = capi.sqlite3_blob_open(
+            db.pointer, schema, table, column, BigInt(rowid), writable ? 1 : 0, ppBlob);
+        checkBlobRc(dbName, rc, `sqlite3_blob_open(${table}.${column}, rowid ${rowid})`);
+
+        const pBlob: number = wasm.peekPtr(ppBlob);
+        const handle = nextBlobHandle++;
+        const length: number = capi.sqlite3_blob_bytes(pBlob);
+        blobs.set(handle, { dbName, pBlob, length });
+        logger.debug(MODULE_NAME, `Opened blob ${handle}: ${table}.${column} rowid ${rowid} (${length} bytes)`);
+        return { handle, length };
+    } finally {
+        wasm.pstack.restore(stack);
+    }
+}
+
+/** Up to `count` bytes from `offset`; shorter at the end of the blob. */
+export function readBlob(handle: number, offset: number, count: number): Uint8Array {
+    const blob = getBlob(handle);
+    const length = Math.max(0, Math.min(count, blob.length - offset));
+    if (length === 0) {
+        return new Uint8Array(0);
+    }
+
+    const wasm = sqlite3.wasm;
+    const pOut = wasm.alloc(length);
+    try {
+        checkBlobRc(blob.dbName, sqlite3.capi.sqlite3_blob_read(blob.pBlob, pOut, length, offset), 'sqlite3_blob_read');
+        return wasm.heap8u().slice(pOut, pOut + length);
+    } finally {
+        wasm.dealloc(pOut);
+    }
+}
+
+/** Overwrite `bytes.length` bytes at `offset`. A blob cannot grow this way. */
+export function writeBlob(handle: number, offset: number, bytes: Uint8Array): void {
+    const blob = getBlob(handle);
+    if (offset < 0 || offset + bytes.length > blob.length) {
+        throw new Error(`Write of ${bytes.length} bytes at ${offset} exceeds the blob's ${blob.length} bytes`);
+    }
+    if (bytes.length === 0) {
+        return;
+    }
+
+    const wasm = sqlite3.wasm;
+    const pIn = wasm.alloc(bytes.length);
+    try {
+        wasm.heap8u().set(bytes, pIn);
+        checkBlobRc(blob.dbName, sqlite3.capi.sqlite3_blob_write(blob.pBlob, pIn, bytes.length, offset), 'sqlite3_blob_write');
+    } finally {
+        wasm.dealloc(pIn);
+    }
+}
+
+/** Release a handle. Unknown handles are ignored. */
+export function closeBlob(handle: number): void {
+    const blob = blobs.get(handle);
+    if (!blob) {
+        return;
+    }
+    blobs.delete(handle);
+    const rc = sqlite3.capi.sqlite3_blob_close(blob.pBlob);
+    if (rc !== 0) {
+        logger.warn(MODULE_NAME, `sqlite3_blob_close(${handle}) returned ${sqlite3.capi.sqlite3_js_rc_str(rc)}`);
+    }
+}
+
+/**
+ * Close every blob handle on `dbName`. Called from
+ * finalizeDatabaseStatements — an open blob pins the connection like a
+ * live statement does.
+ */
+export function closeDatabaseBlobs(dbName: string): void {
+    for (const [handle, blob] of blobs) {
+        if (blob.dbName === dbName) {
+            closeBlob(handle);
+        }
+    }
+}
+
+/** Where a result column's BLOB values live, for a deferred BLOB cell. */
+export interface BlobSource {
+    schema: string;
+    table: string;
+    column: string;
+    /** Result column holding the row's rowid. */
+    rowidColumn: number;
+}
+
+const ROWID_NAMES = new Set(['rowid', '_rowid_', 'oid']);
+
+/**
+ * Per result column, the table column it reads and the result column that
+ * carries that table's rowid — the same origin lookup Microsoft.Data.Sqlite
+ * uses for GetStream. Columns without an origin (expressions), from
+ * WITHOUT ROWID tables, or whose table's rowid is not selected get no
+ * source. Returns undefined when the build lacks column metadata
+ * (SQLITE_ENABLE_COLUMN_METADATA) or no column qualifies.
+ */
+export function resolveBlobSources(db: any, pStmt: number, columnCount: number): (BlobSource | undefined)[] | undefined {
+    const capi = sqlite3.capi;
+    if (typeof capi.sqlite3_column_table_name !== 'function'
+        || typeof capi.sqlite3_column_origin_name !== 'function') {
+        return undefined;
+    }
+
+    const schemas: (string | null)[] = new Array(columnCount);
+    const tables: (string | null)[] = new Array(columnCount);
+    const origins: (string | null)[] = new Array(columnCount);
+    for (let i = 0; i < columnCount; i++) {
+        tables[i] = capi.sqlite3_column_table_name(pStmt, i);
+        origins[i] = capi.sqlite3_column_origin_name(pStmt, i);
+        schemas[i] = typeof capi.sqlite3_column_database_name === 'function'
+            ? capi.sqlite3_column_database_name(pStmt, i) ?? 'main'
+            : 'main';
+    }
+
+    // Result column carrying each table's rowid (or its INTEGER PRIMARY KEY alias)
+    const rowidColumns = new Map<string, number>();
+    const rowidColumnOf = (schema: string, table: string): number => {
+        const key = `${schema}.${table}`;
+        let rowidColumn = rowidColumns.get(key);
+        if (rowidColumn === undefined) {
+            rowidColumn = -1;
+            const alias = rowidAlias(db, schema, table);
+            if (alias !== undefined) {
+                for (let i = 0; i < columnCount; i++) {
+                    const origin = origins[i];
+                    if (tables[i] === table && schemas[i] === schema && origin
+                        && (ROWID_NAMES.has(origin.toLowerCase()) || origin.toLowerCase() === alias)) {
+                        rowidColumn = i;
+                        break;
+                    }
+                }
+            }
+            rowidColumns.set(key, rowidColumn);
+        }
+        return rowidColumn;
+    };
+
+    const sources: (BlobSource | undefined)[] = new Array(columnCount);
+    let found = false;
+    for (let i = 0; i < columnCount; i++) {
+        const table = tables[i];
+        const column = origins[i];
+        if (!table || !column) {
+            continue;
+        }
+        const schema = schemas[i]!;
+        const rowidColumn = rowidColumnOf(schema, table);
+        if (rowidColumn >= 0 && rowidColumn !== i) {
+            sources[i] = { schema, table, column, rowidColumn };
+            found = true;
+        }
+    }
+    return found ? sources : undefined;
+}
+
+/**
+ * Lower-cased INTEGER PRIMARY KEY column name of a rowid table, '' for a
+ * rowid table without one, undefined for a WITHOUT ROWID table.
+ */
+function rowidAlias(db: any, schema: string, table: string): string | undefined {
+    const withoutRowid = db.selectValue(
+        'SELECT wr FROM pragma_table_list(?, ?)', [table, schema]);
+    if (withoutRowid !== 0 && withoutRowid !== undefined) {
+        return undefined;
+    }
+    const alias = db.selectValue(
+        `SELECT name FROM pragma_table_info(?, ?)
+         WHERE pk = 1 AND upper(type) = 'INTEGER'
+           AND (SELECT count(*) FROM pragma_table_info(?, ?) WHERE pk > 0) = 1`,
+        [table, schema, table, schema]);
+    return typeof alias === 'string' ? alias.toLowerCase() : '';
+}
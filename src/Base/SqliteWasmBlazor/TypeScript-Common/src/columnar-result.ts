@@ -0,0 +1,299 @@
+// columnar-result.ts
+// Binary wire format for 'execute' / 'fetch' results, decoded on the C# side
+// by ColumnarRowSet (Services/ColumnarRowSet.cs). Replaces the MessagePack
+// object-per-cell encoding: each column is a tag array plus a fixed 8-byte
+// cell per row, so the reader's typed getters index straight into the buffer
+// without materializing a boxed value per cell.
+//
+// Layout (little-endian, every section 8-byte aligned):
+//
+//   header (32 bytes)
+//     u8  version            COLUMNAR_VERSION
+//     u8  flags              bit 0: column metadata present
+//     u16 reserved
+//     i32 columnCount
+//     i32 rowCount
+//     i32 rowsAffected
+//     i32 cursorId           0 = result complete
+//     i32 heapOffset         absolute offset of the variable-length heap
+//     i64 lastInsertId
+//   column metadata (flags bit 0)
+//     per column: i32 nameByteLength, UTF-8 name, u8 affinity (1..4)
+//   column data, per column
+//     u8[rowCount]           storage class per cell (sqlite3_column_type codes,
+//                            or TAG_BLOB_REF)
+//     8 * rowCount bytes     INTEGER: i64 / REAL: f64 /
+//                            TEXT, BLOB, BLOB_REF: u32 heap offset + u32 byte length /
+//                            NULL: zero
+//   heap                     UTF-8 text and blob bytes
+//
+// A BLOB_REF cell (deferred BLOB, SequentialAccess readers only) stands for
+// a BLOB left in the database; its heap entry locates it for
+// sqlite3_blob_open: i64 rowid, i64 blob length, then schema, table and
+// column as i32 byteLength + UTF-8.
+//
+// An 'executeBatch' response frames one such result per command:
+//
+//   u8  BATCH_MARKER         distinguishes a frame from a single result
+//   u8[3] reserved
+//   i32 resultCount
+//   per result: i32 byteLength, i32 reserved, result bytes padded to 8
+
+export const COLUMNAR_VERSION = 1;
+export const BATCH_MARKER = 0x80;
+
+const HEADER_SIZE = 32;
+const FLAG_HAS_METADATA = 1;
+
+// sqlite3_column_type codes, also used as the per-cell tag
+export const TAG_INTEGER = 1;
+export const TAG_FLOAT = 2;
+export const TAG_TEXT = 3;
+export const TAG_BLOB = 4;
+export const TAG_NULL = 5;
+/** Not a SQLite storage class: a BLOB the reader opens on demand (blob-ops.ts). */
+export const TAG_BLOB_REF = 6;
+
+const AFFINITY_CODES: Record<string, number> = { INTEGER: 1, REAL: 2, TEXT: 3, BLOB: 4 };
+
+const textEncoder = new TextEncoder();
+
+function align8(n: number): number {
+    return (n + 7) & ~7;
+}
+
+interface ColumnBuffer {
+    tags: Uint8Array;
+    cells: DataView;
+}
+
+export interface ColumnarResultInfo {
+    /** Omitted for 'fetch' batches — the reader keeps the first batch's metadata. */
+    columnNames?: string[];
+    columnTypes?: string[];
+    rowsAffected: number;
+    lastInsertId: number | bigint;
+    cursorId: number;
+}
+
+/**
+ * Row-at-a-time builder for the columnar result buffer. Call beginRow(),
+ * then one set*() per column, then finish() once.
+ */
+export class ColumnarResultBuilder {
+    private readonly columns: ColumnBuffer[] = [];
+    private capacity: number;
+    private heap: Uint8Array;
+    private heapLength = 0;
+    private row = -1;
+
+    constructor(private readonly columnCount: number, initialRows = 64) {
+        this.capacity = Math.max(1, initialRows);
+        for (let i = 0; i < columnCount; i++) {
+            this.columns.push({
+                tags: new Uint8Array(this.capacity),
+                cells: new DataView(new ArrayBuffer(this.capacity * 8)),
+            });
+        }
+        this.heap = new Uint8Array(1024);
+    }
+
+    get rowCount(): number {
+        return this.row + 1;
+    }
+
+    beginRow(): void {
+        this.row++;
+        if (this.row === this.capacity) {
+            this.grow();
+        }
+    }
+
+    setNull(col: number): void {
+        this.columns[col].tags[this.row] = TAG_NULL;
+    }
+
+    setInteger(col: number, value: bigint | number): void {
+        const c = this.columns[col];
+        c.tags[this.row] = TAG_INTEGER;
+        c.cells.setBigInt64(this.row * 8, typeof value === 'bigint' ? value : BigInt(value), true);
+    }
+
+    setReal(col: number, value: number): void {
+        const c = this.columns[col];
+        c.tags[this.row] = TAG_FLOAT;
+        c.cells.setFloat64(this.row * 8, value, true);
+    }
+
+    /** TEXT from raw UTF-8 bytes (e.g. straight out of the WASM heap). */
+    setTextBytes(col: number, utf8: Uint8Array): void {
+        this.setVariable(col, TAG_TEXT, utf8);
+    }
+
+    setText(col: number, value: string): void {
+        this.setVariable(col, TAG_TEXT, textEncoder.encode(value));
+    }
+
+    setBlob(col: number, bytes: Uint8Array): void {
+        this.setVariable(col, TAG_BLOB, bytes);
+    }
+
+    /**
+     * A BLOB left in the database: where to open it and how long it is.
+     * The bytes themselves are never read.
+     */
+    setBlobReference(col: number, schema: string, table: string, column: string,
+                     rowid: bigint, length: number): void {
+        const names = [schema, table, column].map(n => textEncoder.encode(n));
+        const entry = new Uint8Array(16 + names.reduce((size, n) => size + 4 + n.length, 0));
+        const view = new DataView(entry.buffer);
+        view.setBigInt64(0, rowid, true);
+        view.setBigInt64(8, BigInt(length), true);
+        let offset = 16;
+        for (const name of names) {
+            view.setInt32(offset, name.length, true);
+            entry.set(name, offset + 4);
+            offset += 4 + name.length;
+        }
+        this.setVariable(col, TAG_BLOB_REF, entry);
+    }
+
+    /** Store a JS value as returned by oo1 (db.exec fallback path). */
+    setValue(col: number, value: any): void {
+        if (value === null || value === undefined) {
+            this.setNull(col);
+        } else if (typeof value === 'bigint') {
+            this.setInteger(col, value);
+        } else if (typeof value === 'number') {
+            if (Number.isInteger(value)) {
+                this.setInteger(col, value);
+            } else {
+                this.setReal(col, value);
+            }
+        } else if (typeof value === 'boolean') {
+            this.setInteger(col, value ? 1 : 0);
+        } else if (typeof value === 'string') {
+            this.setText(col, value);
+        } else if (value instanceof Uint8Array) {
+            this.setBlob(col, value);
+        } else if (ArrayBuffer.isView(value)) {
+            this.setBlob(col, new Uint8Array(value.buffer, value.byteOffset, value.byteLength));
+        } else {
+            this.setText(col, String(value));
+        }
+    }
+
+    finish(info: ColumnarResultInfo): Uint8Array {
+        const rowCount = this.rowCount;
+        const hasMetadata = info.columnNames !== undefined;
+
+        const encodedNames = hasMetadata ? info.columnNames!.map(n => textEncoder.encode(n)) : [];
+        let metadataSize = 0;
+        for (const name of encodedNames) {
+            metadataSize += 4 + name.length + 1;
+        }
+
+        const tagsSize = align8(rowCount);
+        const columnSize = tagsSize + rowCount * 8;
+        const columnsOffset = align8(HEADER_SIZE + metadataSize);
+        const heapOffset = columnsOffset + columnSize * this.columnCount;
+
+        const out = new Uint8Array(heapOffset + this.heapLength);
+        const view = new DataView(out.buffer);
+
+        view.setUint8(0, COLUMNAR_VERSION);
+        view.setUint8(1, hasMetadata ? FLAG_HAS_METADATA : 0);
+        view.setInt32(4, this.columnCount, true);
+        view.setInt32(8, rowCount, true);
+        view.setInt32(12, info.rowsAffected, true);
+        view.setInt32(16, info.cursorId, true);
+        view.setInt32(20, heapOffset, true);
+        view.setBigInt64(24, toInt64(info.lastInsertId), true);
+
+        let offset = HEADER_SIZE;
+        for (let i = 0; i < encodedNames.length; i++) {
+            view.setInt32(offset, encodedNames[i].length, true);
+            out.set(encodedNames[i], offset + 4);
+            offset += 4 + encodedNames[i].length;
+            out[offset++] = AFFINITY_CODES[info.columnTypes?.[i] ?? 'TEXT'] ?? AFFINITY_CODES.TEXT;
+        }
+
+        for (let c = 0; c < this.columnCount; c++) {
+            const base = columnsOffset + c * columnSize;
+            const column = this.columns[c];
+            out.set(column.tags.subarray(0, rowCount), base);
+            out.set(new Uint8Array(column.cells.buffer, 0, rowCount * 8), base + tagsSize);
+        }
+
+        out.set(this.heap.subarray(0, this.heapLength), heapOffset);
+        return out;
+    }
+
+    private setVariable(col: number, tag: number, bytes: Uint8Array): void {
+        const heapStart = this.reserveHeap(bytes.length);
+        this.heap.set(bytes, heapStart);
+
+        const c = this.columns[col];
+        c.tags[this.row] = tag;
+        c.cells.setUint32(this.row * 8, heapStart, true);
+        c.cells.setUint32(this.row * 8 + 4, bytes.length, true);
+    }
+
+    private reserveHeap(length: number): number {
+        const start = this.heapLength;
+        const needed = start + length;
+        if (needed > this.heap.length) {
+            let size = this.heap.length * 2;
+            while (size < needed) {
+                size *= 2;
+            }
+            const grown = new Uint8Array(size);
+            grown.set(this.heap.subarray(0, start));
+            this.heap = grown;
+        }
+        this.heapLength = needed;
+        return start;
+    }
+
+    private grow(): void {
+        const capacity = this.capacity * 2;
+        for (const column of this.columns) {
+            const tags = new Uint8Array(capacity);
+            tags.set(column.tags);
+            column.tags = tags;
+
+            const cells = new Uint8Array(capacity * 8);
+            cells.set(new Uint8Array(column.cells.buffer));
+            column.cells = new DataView(cells.buffer);
+        }
+        this.capacity = capacity;
+    }
+}
+
+function toInt64(value: number | bigint): bigint {
+    if (typeof value === 'bigint') {
+        return value;
+    }
+    return Number.isFinite(value) ? BigInt(Math.trunc(value)) : 0n;
+}
+
+/** Frame several finished results into one 'executeBatch' response. */
+export function frameBatchResults(results: Uint8Array[]): Uint8Array {
+    let size = 8;
+    for (const result of results) {
+        size += 8 + align8(result.length);
+    }
+
+    const out = new Uint8Array(size);
+    const view = new DataView(out.buffer);
+    view.setUint8(0, BATCH_MARKER);
+    view.setInt32(4, results.length, true);
+
+    let offset = 8;
+    for (const result of results) {
+        view.setInt32(offset, result.length, true);
+        out.set(result, offset + 8);
+        offset += 8 + align8(result.length);
+    }
+    return out;
+}
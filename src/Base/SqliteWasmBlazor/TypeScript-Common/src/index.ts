@@ -2,8 +2,12 @@
 // for SqliteWasmBlazor's plane-1 worker (and plane-2's worker after Phase 4).
 //
 // Re-exports the worker state singletons, logger, type conversion, plain
-// bulk-insert path, EF Core SQL helpers, and the worker request/response
-// envelope types. Consumers `import { logger, openDatabases, ... } from
+// bulk-insert path, EF Core SQL helpers, the worker request/response
+// envelope types, the prepared-statement cache, the columnar result
+// encoder, the binary request decoder, the shared execute handler, the
+// synchronous channel, incremental BLOB I/O, online backup, chunked
+// export/import streams, ZIP entry compression, snapshot readers and the
+// request scheduler. Consumers `import { logger, openDatabases, ... } from
 // '@sqlitewasmblazor/worker-common'`.
 
 export * from './worker-state';
@@ -12,3 +16,14 @@ export * from './type-conversion';
 export * from './bulk-ops';
 export * from './ef-core-functions';
 export * from './worker-envelope';
+export * from './statement-cache';
+export * from './columnar-result';
+export * from './request-codec';
+export * from './sql-execute';
+export * from './sync-channel';
+export * from './blob-ops';
+export * from './backup-ops';
+export * from './stream-ops';
+export * from './zip-ops';
+export * from './read-snapshot';
+export * from './request-scheduler';
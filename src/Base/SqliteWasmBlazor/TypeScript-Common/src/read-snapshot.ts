@@ -0,0 +1,178 @@
+// read-snapshot.ts
+// Snapshot read workers (SqliteWasmOptions.ReadWorkerCount). The bridge
+// starts extra instances of the worker bundle under READ_WORKER_NAME next
+// to the worker that owns the SAH pool. A reader never installs the VFS —
+// OPFS sync access handles are exclusive to one pool, and the database
+// files use exclusive locking — so it cannot open the files. Instead it
+// holds a read-only in-memory copy of each database, taken with the online
+// backup API on the owning worker ('snapshotDatabase') and loaded with
+// sqlite3_deserialize ('loadSnapshot'). The image travels from the owning
+// worker to each reader over a MessageChannel port of its own, so it never
+// crosses the main thread; the reader acknowledges the load to the bridge.
+// The bridge only routes a statement to a reader while that copy is
+// current, i.e. no write has been sent to the owning worker since the
+// backup was requested.
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME, openDatabases, sqlite3 } from './worker-state';
+import { registerEFCoreFunctions } from './ef-core-functions';
+import { finalizeDatabaseStatements } from './sql-execute';
+import { backupDatabase } from './backup-ops';
+import { getStatementCache, isSingleStatement } from './statement-cache';
+import { installInterruptHandler } from './request-scheduler';
+
+/** Worker name that makes a bundle instance run as a snapshot reader. */
+export const READ_WORKER_NAME = 'sqlitewasmblazor-reader';
+
+const SQLITE_DESERIALIZE_FREEONCLOSE = 1;
+const SQLITE_DESERIALIZE_READONLY = 4;
+
+/**
+ * First keywords a reader executes. Transaction control, PRAGMAs and
+ * ATTACH report sqlite3_stmt_readonly too, but act on the connection —
+ * they must reach the owning worker's connection.
+ */
+const SNAPSHOT_STATEMENT = /^\s*(SELECT|WITH|VALUES)\b/i;
+
+/** Connection-scoped functions whose value only the owning connection knows. */
+const CONNECTION_FUNCTION = /\b(changes|total_changes|last_insert_rowid)\s*\(/i;
+
+/** True in a worker started by the bridge as a snapshot reader. */
+export function isSnapshotReader(): boolean {
+    return self.name === READ_WORKER_NAME;
+}
+
+/**
+ * Throw unless a reader may run `sql` on its copy of `dbName`: a single
+ * query for which sqlite3_stmt_readonly holds, without connection-scoped
+ * functions. The rejection reaches SqliteWasmWorkerBridge like any error;
+ * it retries the statement on the owning worker and keeps the SQL there.
+ */
+export function assertSnapshotReadable(dbName: string, sql: string): void {
+    const db = openDatabases.get(dbName);
+    if (!db) {
+        throw new Error(`No snapshot of ${dbName}`);
+    }
+    let readable = isSingleStatement(sql) && SNAPSHOT_STATEMENT.test(sql) && !CONNECTION_FUNCTION.test(sql);
+    if (readable) {
+        // Prepared through the cache, so executeSql reuses the statement
+        const cache = getStatementCache(dbName);
+        const stmt = cache.acquire(db, sql);
+        readable = sqlite3.capi.sqlite3_stmt_readonly(stmt.pointer) !== 0;
+        cache.release(sql, stmt);
+    }
+    if (!readable) {
+        throw new Error(`Statement is not snapshot-readable: ${sql.substring(0, 100)}`);
+    }
+}
+
+/** Ports to the readers on the owning worker, by reader ('attachSnapshotPorts'). */
+const snapshotPorts = new Map<number, MessagePort>();
+
+/** A reader to load a copy, and the bridge request id it acknowledges. */
+export interface SnapshotLoad {
+    port: number;
+    id: number;
+}
+
+/**
+ * Keep the owning worker's ends of the readers' snapshot channels. The
+ * bridge sends them once, after starting the readers.
+ */
+export function attachSnapshotPorts(ports: MessagePort[]): void {
+    ports.forEach((port, i) => snapshotPorts.set(i, port));
+}
+
+/**
+ * Copy the open database `dbName` to the readers in `loads`
+ * ('snapshotDatabase' on the owning worker). Each reader's port receives a
+ * 'loadSnapshot' request carrying the bridge's id, which the reader answers
+ * to the bridge. The last reader takes the image itself and the others a
+ * copy. Returns the number of readers the image was posted to — 0 when the
+ * database is larger than `maxBytes` (0 = no limit), so its reads stay on
+ * the owning worker. Refused while the connection is inside a transaction,
+ * whose uncommitted rows a backup would copy.
+ */
+export async function snapshotDatabase(dbName: string, loads: SnapshotLoad[], maxBytes: number): Promise<number> {
+    const db = openDatabases.get(dbName);
+    if (!db) {
+        throw new Error(`Database ${dbName} not open`);
+    }
+    if (!sqlite3.capi.sqlite3_get_autocommit(db.pointer)) {
+        throw new Error(`Database ${dbName} is inside a transaction`);
+    }
+    const targets = loads.filter(load => snapshotPorts.has(load.port));
+    if (targets.length === 0) {
+        return 0;
+    }
+    if (maxBytes > 0) {
+        const size = Number(db.selectValue('PRAGMA page_size')) * Number(db.selectValue('PRAGMA page_count'));
+        if (size > maxBytes) {
+            logger.debug(MODULE_NAME, `No snapshot of ${dbName}: ${size} bytes exceed ${maxBytes}`);
+            return 0;
+        }
+    }
+
+    const image = await backupDatabase(dbName);
+    targets.forEach((load, i) => {
+        const own = i === targets.length - 1
+            && image.byteOffset === 0 && image.byteLength === image.buffer.byteLength;
+        const payload = own ? image : image.slice();
+        snapshotPorts.get(load.port)!.postMessage(
+            { id: load.id, data: { type: 'loadSnapshot', database: dbName }, binaryPayload: payload.buffer },
+            [payload.buffer]);
+    });
+    return targets.length;
+}
+
+/**
+ * Replace the reader's copy of `dbName` with `image` (a backupDatabase
+ * image). The copy is deserialized read-only with query_only set, so no
+ * statement can diverge it from the database it mirrors.
+ */
+export function loadSnapshot(dbName: string, image: Uint8Array): void {
+    const capi = sqlite3.capi;
+
+    // Images of WAL databases carry the WAL version bytes; an in-memory
+    // database has no WAL, so load it as rollback-journal.
+    image[18] = 1;
+    image[19] = 1;
+
+    const db = new sqlite3.oo1.DB(':memory:', 'c');
+    try {
+        const pData = sqlite3.wasm.allocFromTypedArray(image);
+        // FREEONCLOSE hands pData to SQLite, also when deserialize fails
+        const rc = capi.sqlite3_deserialize(
+            db.pointer, 'main', pData, image.length, image.length,
+            SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_READONLY);
+        if (rc !== 0) {
+            throw new Error(`sqlite3_deserialize failed for ${dbName}: ${capi.sqlite3_js_rc_str(rc)}`);
+        }
+        db.exec('PRAGMA query_only = 1;');
+        registerEFCoreFunctions(db, sqlite3);
+        installInterruptHandler(db);
+    } catch (error) {
+        db.close();
+        throw error;
+    }
+
+    const previous = openDatabases.get(dbName);
+    if (previous) {
+        finalizeDatabaseStatements(dbName);
+        previous.close();
+    }
+    openDatabases.set(dbName, db);
+    logger.debug(MODULE_NAME, `Loaded snapshot of ${dbName}: ${image.length} bytes`);
+}
+
+/**
+ * Drop every copy this reader holds ('dropSnapshots'). Sent when the disk
+ * locks, so no decrypted copy outlives the session.
+ */
+export function dropSnapshots(): void {
+    for (const [dbName, db] of openDatabases) {
+        finalizeDatabaseStatements(dbName);
+        db.close();
+    }
+    openDatabases.clear();
+}
@@ -0,0 +1,347 @@
+// request-codec.ts
+// Binary wire format for 'execute' and 'executeBatch' requests, encoded on
+// the C# side by WorkerRequestEncoder (Services/WorkerRequestEncoder.cs) and
+// posted by the bridge's sendEncodedToWorker as `{ encoded: ArrayBuffer }`.
+// Replaces the JSON envelope for command execution: parameter values carry
+// their storage class, 64-bit integers keep full precision and BLOBs travel
+// inline.
+//
+// Layout (little-endian, no alignment):
+//
+//   header (16 bytes)
+//     u8  version            REQUEST_CODEC_VERSION
+//     u8  opcode             1 = execute, 2 = executeBatch
+//     u8  flags              bit 0: synchronous request
+//                            bit 1: deferred BEGIN follows the SQL
+//                                   (executeBatch: the database)
+//                            bit 2: atomic batch (executeBatch only)
+//                            bit 3: defer large BLOBs (execute only)
+//     u8  priority           request-scheduler.ts PRIORITY_*
+//     i32 requestId
+//     i32 batchSize          execute only, 0 for executeBatch
+//     i32 count              execute: parameter count
+//                            executeBatch: command count
+//   string database          i32 byteLength + UTF-8
+//
+//   execute:
+//     string sql
+//     string begin           only with flags bit 1
+//     parameter block        `count` parameters
+//
+//   executeBatch:
+//     string begin           only with flags bit 1
+//     per command
+//       string sql
+//       i32 parameterCount
+//       parameter block
+//
+//   parameter block, per parameter
+//     string name            prefixed (@, $ or :)
+//     u8  tag                TAG_* from columnar-result.ts
+//     value                  INTEGER: i64 / REAL: f64 /
+//                            TEXT: string / BLOB: i32 byteLength + bytes /
+//                            NULL: nothing
+//
+// Parameter blocks are not unpacked into objects: ParameterBlock keeps a
+// position in the request buffer and binds from it by statement parameter
+// index (sqlite3_bind_*), TEXT as the UTF-8 bytes C# wrote.
+
+import { TAG_INTEGER, TAG_FLOAT, TAG_TEXT, TAG_BLOB, TAG_NULL } from './columnar-result';
+import { sqlite3 } from './worker-state';
+
+export const REQUEST_CODEC_VERSION = 1;
+
+const OPCODE_EXECUTE = 1;
+const OPCODE_EXECUTE_BATCH = 2;
+const FLAG_SYNC = 1;
+const FLAG_BEGIN = 2;
+const FLAG_ATOMIC = 4;
+const FLAG_DEFER_BLOBS = 8;
+const HEADER_SIZE = 16;
+
+const INT32_MIN = -2147483648n;
+const INT32_MAX = 2147483647n;
+
+const textDecoder = new TextDecoder();
+
+/** Statement parameter name → index, built once per prepared statement. */
+const parameterIndexes = new WeakMap<object, Map<string, number>>();
+
+function getParameterIndexes(stmt: any): Map<string, number> {
+    let indexes = parameterIndexes.get(stmt);
+    if (!indexes) {
+        const capi = sqlite3.capi;
+        indexes = new Map();
+        const count = capi.sqlite3_bind_parameter_count(stmt.pointer);
+        for (let i = 1; i <= count; i++) {
+            const name = capi.sqlite3_bind_parameter_name(stmt.pointer, i);
+            if (name) {
+                indexes.set(name, i);
+            }
+        }
+        parameterIndexes.set(stmt, indexes);
+    }
+    return indexes;
+}
+
+/** Index of `name` in the statement, accepting any of the three prefixes. */
+function resolveParameterIndex(indexes: Map<string, number>, name: string): number {
+    const index = indexes.get(name);
+    if (index) {
+        return index;
+    }
+    const bare = name.slice(1);
+    return indexes.get('@' + bare) ?? indexes.get('$' + bare) ?? indexes.get(':' + bare) ?? 0;
+}
+
+/**
+ * Copy `length` bytes into a WASM allocation that SQLite frees through
+ * SQLITE_WASM_DEALLOC once the binding is released (or the bind fails).
+ */
+function copyToHeap(bytes: Uint8Array, offset: number, length: number): number {
+    const wasm = sqlite3.wasm;
+    const pointer = wasm.alloc(length);
+    wasm.heap8u().set(bytes.subarray(offset, offset + length), pointer);
+    return pointer;
+}
+
+/**
+ * A command's parameters as they sit in the request buffer. The buffer was
+ * transferred for this request only, so views into it stay valid until the
+ * request completes.
+ */
+export class ParameterBlock {
+    constructor(
+        private readonly view: DataView,
+        private readonly bytes: Uint8Array,
+        private readonly start: number,
+        readonly count: number,
+    ) {}
+
+    /**
+     * Bind every parameter to `stmt` by index. TEXT and BLOB bytes are
+     * copied once, from the request buffer into the WASM heap.
+     */
+    bind(db: any, stmt: any): void {
+        const capi = sqlite3.capi;
+        const pStmt = stmt.pointer;
+        const indexes = getParameterIndexes(stmt);
+        const view = this.view;
+        const bytes = this.bytes;
+        let offset = this.start;
+
+        for (let i = 0; i < this.count; i++) {
+            const nameLength = view.getInt32(offset, true);
+            offset += 4;
+            const name = textDecoder.decode(bytes.subarray(offset, offset + nameLength));
+            offset += nameLength;
+
+            const index = resolveParameterIndex(indexes, name);
+            if (index === 0) {
+                throw new Error(`Invalid bind() parameter name: ${name}`);
+            }
+
+            const tag = bytes[offset++];
+            let rc: number;
+            switch (tag) {
+                case TAG_INTEGER: {
+                    const value = view.getBigInt64(offset, true);
+                    offset += 8;
+                    rc = value >= INT32_MIN && value <= INT32_MAX
+                        ? capi.sqlite3_bind_int(pStmt, index, Number(value))
+                        : capi.sqlite3_bind_int64(pStmt, index, value);
+                    break;
+                }
+                case TAG_FLOAT:
+                    rc = capi.sqlite3_bind_double(pStmt, index, view.getFloat64(offset, true));
+                    offset += 8;
+                    break;
+                case TAG_TEXT: {
+                    const length = view.getInt32(offset, true);
+                    offset += 4;
+                    rc = length === 0
+                        ? capi.sqlite3_bind_text(pStmt, index, '', 0, 0)
+                        : capi.sqlite3_bind_text(pStmt, index, copyToHeap(bytes, offset, length), length, capi.SQLITE_WASM_DEALLOC);
+                    offset += length;
+                    break;
+                }
+                case TAG_BLOB: {
+                    const length = view.getInt32(offset, true);
+                    offset += 4;
+                    rc = length === 0
+                        ? capi.sqlite3_bind_zeroblob(pStmt, index, 0)
+                        : capi.sqlite3_bind_blob(pStmt, index, copyToHeap(bytes, offset, length), length, capi.SQLITE_WASM_DEALLOC);
+                    offset += length;
+                    break;
+                }
+                case TAG_NULL:
+                    rc = capi.sqlite3_bind_null(pStmt, index);
+                    break;
+                default:
+                    throw new Error(`Unknown parameter tag ${tag} for ${name}`);
+            }
+
+            if (rc !== 0) {
+                db.checkRc(rc);
+            }
+        }
+    }
+
+    /**
+     * The parameters in the `{ value, type }` shape of JSON requests, for
+     * paths that bind through oo1 (multi-statement scripts).
+     */
+    toRecord(): Record<string, { value: unknown; type: string }> {
+        const view = this.view;
+        const bytes = this.bytes;
+        const parameters: Record<string, { value: unknown; type: string }> = {};
+        let offset = this.start;
+
+        const readString = (): string => {
+            const length = view.getInt32(offset, true);
+            offset += 4;
+            const value = textDecoder.decode(bytes.subarray(offset, offset + length));
+            offset += length;
+            return value;
+        };
+
+        for (let i = 0; i < this.count; i++) {
+            const name = readString();
+            const tag = bytes[offset++];
+            switch (tag) {
+                case TAG_INTEGER: {
+                    const value = view.getBigInt64(offset, true);
+                    offset += 8;
+                    // Plain number where exact, so sqlite-wasm binds it as before
+                    const asNumber = Number(value);
+                    parameters[name] = {
+                        value: Number.isSafeInteger(asNumber) ? asNumber : value,
+                        type: 'integer',
+                    };
+                    break;
+                }
+                case TAG_FLOAT:
+                    parameters[name] = { value: view.getFloat64(offset, true), type: 'real' };
+                    offset += 8;
+                    break;
+                case TAG_TEXT:
+                    parameters[name] = { value: readString(), type: 'text' };
+                    break;
+                case TAG_BLOB: {
+                    const length = view.getInt32(offset, true);
+                    offset += 4;
+                    parameters[name] = { value: bytes.subarray(offset, offset + length), type: 'blob' };
+                    offset += length;
+                    break;
+                }
+                case TAG_NULL:
+                    parameters[name] = { value: null, type: 'null' };
+                    break;
+                default:
+                    throw new Error(`Unknown parameter tag ${tag} for ${name}`);
+            }
+        }
+
+        return parameters;
+    }
+}
+
+/** Same shape as a JSON request envelope, so handlers need not care. */
+export interface DecodedRequest {
+    id: number;
+    sync: boolean;
+    /** Scheduling class, see request-scheduler.ts. */
+    priority: number;
+    data: {
+        type: 'execute';
+        database: string;
+        sql: string;
+        parameters: ParameterBlock;
+        batchSize: number;
+        /** Transaction prefix, see runDeferredBegin in sql-execute.ts. */
+        begin?: string;
+        /** CommandBehavior.SequentialAccess, see executeSql. */
+        deferBlobs: boolean;
+    } | {
+        type: 'executeBatch';
+        database: string;
+        commands: { sql: string; parameters: ParameterBlock }[];
+        begin?: string;
+        atomic: boolean;
+    };
+}
+
+/** Decode a request produced by WorkerRequestEncoder. */
+export function decodeRequest(buffer: ArrayBuffer): DecodedRequest {
+    const view = new DataView(buffer);
+    const bytes = new Uint8Array(buffer);
+
+    if (bytes.length < HEADER_SIZE || bytes[0] !== REQUEST_CODEC_VERSION) {
+        throw new Error(`Unsupported encoded request (version ${bytes[0]}, ${bytes.length} bytes)`);
+    }
+    const opcode = bytes[1];
+    if (opcode !== OPCODE_EXECUTE && opcode !== OPCODE_EXECUTE_BATCH) {
+        throw new Error(`Unknown encoded request opcode ${opcode}`);
+    }
+
+    const flags = bytes[2];
+    const sync = (flags & FLAG_SYNC) !== 0;
+    const priority = bytes[3];
+    const id = view.getInt32(4, true);
+    const batchSize = view.getInt32(8, true);
+    const count = view.getInt32(12, true);
+    let offset = HEADER_SIZE;
+
+    const readString = (): string => {
+        const length = view.getInt32(offset, true);
+        offset += 4;
+        const value = textDecoder.decode(bytes.subarray(offset, offset + length));
+        offset += length;
+        return value;
+    };
+
+    // Walks past a parameter block without unpacking it
+    const readParameterBlock = (parameterCount: number): ParameterBlock => {
+        const block = new ParameterBlock(view, bytes, offset, parameterCount);
+        for (let i = 0; i < parameterCount; i++) {
+            offset += 4 + view.getInt32(offset, true);
+            const tag = bytes[offset++];
+            if (tag === TAG_INTEGER || tag === TAG_FLOAT) {
+                offset += 8;
+            } else if (tag === TAG_TEXT || tag === TAG_BLOB) {
+                offset += 4 + view.getInt32(offset, true);
+            } else if (tag !== TAG_NULL) {
+                throw new Error(`Unknown parameter tag ${tag}`);
+            }
+        }
+        return block;
+    };
+
+    const database = readString();
+
+    if (opcode === OPCODE_EXECUTE) {
+        const sql = readString();
+        const begin = (flags & FLAG_BEGIN) !== 0 ? readString() : undefined;
+        const parameters = readParameterBlock(count);
+        return {
+            id, sync, priority,
+            data: {
+                type: 'execute', database, sql, parameters, batchSize, begin,
+                deferBlobs: (flags & FLAG_DEFER_BLOBS) !== 0,
+            },
+        };
+    }
+
+    const begin = (flags & FLAG_BEGIN) !== 0 ? readString() : undefined;
+    const commands: { sql: string; parameters: ParameterBlock }[] = new Array(count);
+    for (let i = 0; i < count; i++) {
+        const sql = readString();
+        const parameterCount = view.getInt32(offset, true);
+        offset += 4;
+        commands[i] = { sql, parameters: readParameterBlock(parameterCount) };
+    }
+    return {
+        id, sync, priority,
+        data: { type: 'executeBatch', database, commands, begin, atomic: (flags & FLAG_ATOMIC) !== 0 },
+    };
+}
@@ -0,0 +1,224 @@
+// request-scheduler.ts
+// Priority queue in front of the worker's request handler, and cancellation
+// of queued and running requests.
+//
+// Requests are not handled in the message event that delivers them. They
+// are queued and started one per task, highest priority first (FIFO within
+// a class), so requests that piled up while a long statement blocked the
+// worker are not handled in arrival order. Interactive statements overtake
+// background work and maintenance (export, import, snapshots). Starting a
+// request does not wait for the previous one to finish. A request that
+// awaits (an online backup between steps, a stream chunk) still lets
+// others run meanwhile.
+//
+// Cancellation ('cancel' message from the bridge):
+//   - queued:  removed, answered with an error, never run
+//   - running: a statement running on the worker's thread keeps its event
+//              loop busy, so the 'cancel' message cannot arrive in time.
+//              The bridge also writes the request id into a shared
+//              interrupt buffer (cross-origin-isolated pages only). A
+//              progress handler on every connection polls that buffer and
+//              interrupts the statement the same way sqlite3_interrupt does
+//              (SQLITE_INTERRUPT). Without the buffer, only queued requests
+//              are cancelled.
+//
+// Interrupt buffer layout (Int32, mirrored in the bridge):
+//   [0]                  write counter, the bridge's next slot
+//   [1 .. INTERRUPT_SLOTS] ids of recently cancelled requests (ring)
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME, sqlite3 } from './worker-state';
+
+/** Request priority classes; values match SqliteWasmRequestPriority in C#. */
+export const PRIORITY_INTERACTIVE = 0;
+export const PRIORITY_BACKGROUND = 1;
+export const PRIORITY_MAINTENANCE = 2;
+
+/** Slots in the interrupt buffer's ring of cancelled request ids. */
+export const INTERRUPT_SLOTS = 16;
+
+/** VM instructions between progress handler calls. */
+const PROGRESS_INTERVAL = 4000;
+
+/**
+ * Request types that copy, move or rewrite whole databases. They run
+ * behind all other queued work regardless of the priority they carry.
+ * A reader's 'loadSnapshot' is not among them: the bridge routes no
+ * read to the new copy until the load is acknowledged, so it should not
+ * wait behind queued reads.
+ */
+const MAINTENANCE_TYPES = new Set([
+    'exportDb', 'importDb', 'exportStreamOpen', 'exportStreamRead', 'exportStreamClose',
+    'importStreamOpen', 'importStreamWrite', 'importStreamFinish', 'importStreamAbort',
+    'exportDeflatedOpen', 'snapshotDatabase',
+]);
+
+/** Worker-side phases of a request, in milliseconds. */
+export interface RequestTiming {
+    /** Request type ('execute', 'fetch', 'open', ...). */
+    op: string;
+    /** Arrival to start: time spent in the queue. */
+    queueMs: number;
+    /** Start to result: SQLite work including the columnar rows it builds. */
+    executeMs: number;
+    /** Result to response message: finishing and copying the payload. */
+    serializeMs: number;
+}
+
+/**
+ * Measures one request for the bridge's latency statistics
+ * (SqliteWasmWorkerBridge.Metrics.cs). The response carries finish()'s
+ * result as `timing`; the posting itself counts as transfer.
+ */
+export class RequestTimer {
+    private startedAt = 0;
+    private executedAt = 0;
+
+    constructor(private readonly op: string, private readonly receivedAt: number) {}
+
+    started(): void {
+        this.startedAt = performance.now();
+    }
+
+    executed(): void {
+        this.executedAt = performance.now();
+    }
+
+    finish(): RequestTiming {
+        const now = performance.now();
+        const startedAt = this.startedAt || now;
+        const executedAt = this.executedAt || now;
+        return {
+            op: this.op,
+            queueMs: startedAt - this.receivedAt,
+            executeMs: executedAt - startedAt,
+            serializeMs: now - executedAt,
+        };
+    }
+}
+
+interface QueuedRequest {
+    id: number;
+    timer: RequestTimer;
+    run: (timer: RequestTimer) => Promise<void>;
+    cancel: (timer: RequestTimer) => void;
+}
+
+const queues: QueuedRequest[][] = [[], [], []];
+let interruptCells: Int32Array | undefined;
+let activeRequest = 0;
+let drainScheduled = false;
+
+// A MessageChannel task instead of setTimeout: no clamping, and it queues
+// behind the worker messages that are already waiting.
+const drainChannel = new MessageChannel();
+drainChannel.port1.onmessage = drain;
+
+/** Attach the interrupt buffer from the bridge's 'init' message. */
+export function attachInterruptBuffer(buffer: SharedArrayBuffer): void {
+    interruptCells = new Int32Array(buffer);
+}
+
+/**
+ * Priority class of a request: maintenance types always run as
+ * PRIORITY_MAINTENANCE, everything else as the caller asked (the encoded
+ * request's priority byte, or `priority` in a JSON request).
+ */
+export function requestPriority(type: string | undefined, requested: number | undefined): number {
+    if (type !== undefined && MAINTENANCE_TYPES.has(type)) {
+        return PRIORITY_MAINTENANCE;
+    }
+    return requested === PRIORITY_BACKGROUND || requested === PRIORITY_MAINTENANCE
+        ? requested
+        : PRIORITY_INTERACTIVE;
+}
+
+/**
+ * Queue request `id` of type `op`. `run` handles it; `cancel` answers it
+ * as cancelled if it is removed from the queue by cancelRequest. Both get
+ * the request's timer, started when the request leaves the queue.
+ */
+export function scheduleRequest(
+    id: number,
+    op: string,
+    priority: number,
+    run: (timer: RequestTimer) => Promise<void>,
+    cancel: (timer: RequestTimer) => void
+): void {
+    queues[priority].push({ id, timer: new RequestTimer(op, performance.now()), run, cancel });
+    scheduleDrain();
+}
+
+/**
+ * Cancel request `id` ('cancel' message). A queued request is dropped and
+ * answered through its `cancel` callback. A running one is interrupted
+ * through the interrupt buffer, which the bridge has already written.
+ */
+export function cancelRequest(id: number): void {
+    for (const queue of queues) {
+        const index = queue.findIndex(request => request.id === id);
+        if (index >= 0) {
+            const [request] = queue.splice(index, 1);
+            logger.debug(MODULE_NAME, `Cancelled queued request ${id}`);
+            request.cancel(request.timer);
+            return;
+        }
+    }
+}
+
+/**
+ * Install the interrupt progress handler on a newly opened connection.
+ * Without an interrupt buffer there is nothing to poll, and no handler is
+ * installed, so statements pay nothing for it.
+ */
+export function installInterruptHandler(db: any): void {
+    const capi = sqlite3.capi;
+    if (!interruptCells || typeof capi.sqlite3_progress_handler !== 'function') {
+        return;
+    }
+    capi.sqlite3_progress_handler(db.pointer, PROGRESS_INTERVAL, () => isCancelled(activeRequest) ? 1 : 0, 0);
+}
+
+function isCancelled(id: number): boolean {
+    if (id === 0 || !interruptCells) {
+        return false;
+    }
+    for (let i = 1; i <= INTERRUPT_SLOTS; i++) {
+        if (Atomics.load(interruptCells, i) === id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+function scheduleDrain(): void {
+    if (!drainScheduled) {
+        drainScheduled = true;
+        drainChannel.port2.postMessage(null);
+    }
+}
+
+/**
+ * Start the highest-priority queued request, one per task. It runs
+ * synchronously up to its first await. Its statements run in that span
+ * and are attributed to it for interruption.
+ */
+function drain(): void {
+    drainScheduled = false;
+    const request = queues[0].shift() ?? queues[1].shift() ?? queues[2].shift();
+    if (!request) {
+        return;
+    }
+    if (queues.some(queue => queue.length > 0)) {
+        scheduleDrain();
+    }
+
+    activeRequest = request.id;
+    request.timer.started();
+    try {
+        // Responses are posted by `run` itself; it does not throw
+        void request.run(request.timer);
+    } finally {
+        activeRequest = 0;
+    }
+}
@@ -0,0 +1,559 @@
+// sql-execute.ts
+// The 'execute' request handler shared by plane-1's and plane-2's workers.
+// Extracted from both sqlite-worker.ts copies when the prepared-statement
+// cache landed so the two planes can't drift on the hot path.
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME, openDatabases, sqlite3 } from './worker-state';
+import { finalizeStatementCache, getStatementCache, isSingleStatement } from './statement-cache';
+import {
+    ColumnarResultBuilder, frameBatchResults,
+    TAG_INTEGER, TAG_FLOAT, TAG_TEXT, TAG_BLOB, TAG_NULL,
+} from './columnar-result';
+import { ParameterBlock } from './request-codec';
+import { type BlobSource, closeDatabaseBlobs, DEFERRED_BLOB_MIN_BYTES, resolveBlobSources } from './blob-ops';
+import { abortDatabaseBackups } from './backup-ops';
+
+/**
+ * Converts parameters with type metadata for proper SQLite binding
+ * Expects parameters in format: { value: any, type: "blob" | "text" | "integer" | "real" | "null" }
+ */
+export function convertParametersForBinding(
+    parameters: Record<string, any>,
+    binaryPayload?: Uint8Array,
+): Record<string, any> {
+    const converted: Record<string, any> = {};
+
+    for (const [key, paramData] of Object.entries(parameters)) {
+        // Handle new format with type metadata
+        if (paramData && typeof paramData === 'object' && 'value' in paramData && 'type' in paramData) {
+            const { value, type } = paramData;
+
+            if (value === null || value === undefined) {
+                converted[key] = null;
+                logger.debug(MODULE_NAME, `[PARAM] ${key}: null`);
+            }
+            else if (type === 'blob' && binaryPayload && value && typeof value === 'object'
+                     && typeof value.__blobOffset === 'number' && typeof value.__blobLength === 'number') {
+                // Blob bytes carried in the binary attachment, not Base64.
+                // Slice (not subarray-view-passthrough) so SQLite binding owns
+                // an independent buffer — binaryPayload's underlying ArrayBuffer
+                // may be reused on the next request.
+                const offset = value.__blobOffset;
+                const length = value.__blobLength;
+                const bytes = new Uint8Array(length);
+                bytes.set(binaryPayload.subarray(offset, offset + length));
+                converted[key] = bytes;
+                logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${length} bytes from binary attachment @ ${offset})`);
+            }
+            else if (type === 'blob' && value instanceof Uint8Array) {
+                // Inline bytes from an encoded request (request-codec.ts)
+                converted[key] = value;
+                logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${value.length} bytes inline)`);
+            }
+            else if (type === 'blob' && typeof value === 'string') {
+                // Legacy fallback — Base64-encoded blob in the JSON message.
+                try {
+                    const binaryString = atob(value);
+                    const bytes = new Uint8Array(binaryString.length);
+                    for (let i = 0; i < binaryString.length; i++) {
+                        bytes[i] = binaryString.charCodeAt(i);
+                    }
+                    converted[key] = bytes;
+                    logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${bytes.length} bytes from base64)`);
+                } catch (e) {
+                    logger.error(MODULE_NAME, `[PARAM] Failed to decode blob ${key}:`, e);
+                    converted[key] = value;
+                }
+            }
+            else {
+                // For text, integer, real - use value as-is
+                converted[key] = value;
+                logger.debug(MODULE_NAME, `[PARAM] ${key}: ${type} = ${typeof value === 'string' && value.length > 50 ? value.substring(0, 50) + '...' : value}`);
+            }
+        }
+        else {
+            // Fallback for old format (backwards compatibility)
+            logger.warn(MODULE_NAME, `[PARAM] ${key}: using legacy format (no type metadata)`);
+            converted[key] = paramData;
+        }
+    }
+
+    return converted;
+}
+
+// Indexed by sqlite3_column_type code (TAG_* in columnar-result.ts)
+const STORAGE_CLASS_NAMES = ['', 'INTEGER', 'REAL', 'TEXT', 'BLOB', ''];
+
+/**
+ * Normalize a declared column type to the affinity name reported through
+ * GetDataTypeName — same rules as SQLite's own affinity resolution, folded
+ * onto the four names the C# reader understands.
+ */
+function affinityFromDeclType(declType: string): string {
+    const typeUpper = declType.toUpperCase();
+    if (typeUpper.includes('INT')) {
+        return 'INTEGER';
+    }
+    if (typeUpper.includes('REAL') || typeUpper.includes('DOUB') || typeUpper.includes('FLOA')) {
+        return 'REAL';
+    }
+    if (typeUpper.includes('BLOB')) {
+        return 'BLOB';
+    }
+    return 'TEXT';
+}
+
+interface ColumnMetadata {
+    columnNames: string[];
+    /** Affinity per column; '' until an untyped column sees a non-NULL value. */
+    columnTypes: string[];
+    untypedColumns: number;
+    /** Set for deferring results: columns whose large BLOBs go out as references. */
+    blobSources?: (BlobSource | undefined)[];
+}
+
+/**
+ * Column names and declared types, read from the executing statement
+ * (sqlite3_column_name / sqlite3_column_decltype). Expression columns and
+ * JOINs need no table lookup — a column without a declared type takes the
+ * storage class of its first non-NULL value (see stepRows).
+ */
+function readColumnMetadata(pStmt: number): ColumnMetadata {
+    const capi = sqlite3.capi;
+    const columnCount: number = capi.sqlite3_column_count(pStmt);
+
+    const columnNames: string[] = new Array(columnCount);
+    const columnTypes: string[] = new Array(columnCount);
+    let untypedColumns = 0;
+    for (let i = 0; i < columnCount; i++) {
+        columnNames[i] = capi.sqlite3_column_name(pStmt, i);
+        const declType: string | null = capi.sqlite3_column_decltype(pStmt, i);
+        if (declType) {
+            columnTypes[i] = affinityFromDeclType(declType);
+        } else {
+            columnTypes[i] = '';
+            untypedColumns++;
+        }
+    }
+    return { columnNames, columnTypes, untypedColumns };
+}
+
+/** Report still-unresolved columns (NULL in every row seen) as TEXT. */
+function finalColumnTypes(meta: ColumnMetadata): string[] {
+    return meta.columnTypes.map(t => t === '' ? 'TEXT' : t);
+}
+
+/**
+ * Step a bound statement for at most `maxRows` rows into `out`, reading
+ * each value by its own storage class (sqlite3_column_type). TEXT and BLOB
+ * bytes are copied straight from the WASM heap — no JS string is ever
+ * decoded for a TEXT cell. With `meta.blobSources`, a BLOB of at least
+ * DEFERRED_BLOB_MIN_BYTES whose row's rowid is in the result is written as
+ * a reference (TAG_BLOB_REF) and its bytes are not copied at all. Returns
+ * true once step() reported SQLITE_DONE.
+ */
+function stepRows(stmt: any, meta: ColumnMetadata, maxRows: number, out: ColumnarResultBuilder): boolean {
+    const capi = sqlite3.capi;
+    const wasm = sqlite3.wasm;
+    const pStmt = stmt.pointer;
+    const columnCount = meta.columnNames.length;
+    const columnTypes = meta.columnTypes;
+    const blobSources = meta.blobSources;
+
+    for (let stepped = 0; stepped < maxRows; stepped++) {
+        if (!stmt.step()) {
+            return true;
+        }
+
+        out.beginRow();
+        for (let i = 0; i < columnCount; i++) {
+            const storageClass: number = capi.sqlite3_column_type(pStmt, i);
+            switch (storageClass) {
+                case TAG_INTEGER:
+                    out.setInteger(i, capi.sqlite3_column_int64(pStmt, i));
+                    break;
+                case TAG_FLOAT:
+                    out.setReal(i, capi.sqlite3_column_double(pStmt, i));
+                    break;
+                case TAG_BLOB:
+                    if (blobSources?.[i] && setBlobReference(pStmt, i, blobSources[i]!, out)) {
+                        break;
+                    }
+                // falls through
+                case TAG_TEXT: {
+                    // sqlite3_column_blob on a TEXT value yields its UTF-8
+                    // bytes; _bytes must be read after _blob. heap8u() is
+                    // re-fetched per cell since memory growth detaches it.
+                    const ptr: number = capi.sqlite3_column_blob(pStmt, i);
+                    const length: number = capi.sqlite3_column_bytes(pStmt, i);
+                    const bytes = length > 0 ? wasm.heap8u().subarray(ptr, ptr + length) : new Uint8Array(0);
+                    if (storageClass === TAG_TEXT) {
+                        out.setTextBytes(i, bytes);
+                    } else {
+                        out.setBlob(i, bytes);
+                    }
+                    break;
+                }
+                default:
+                    out.setNull(i);
+                    break;
+            }
+
+            if (meta.untypedColumns > 0 && storageClass !== TAG_NULL && columnTypes[i] === '') {
+                columnTypes[i] = STORAGE_CLASS_NAMES[storageClass];
+                meta.untypedColumns--;
+            }
+        }
+    }
+    return false;
+}
+
+/** Write cell `col` as a deferred BLOB if it is large enough and its rowid is known. */
+function setBlobReference(pStmt: number, col: number, source: BlobSource, out: ColumnarResultBuilder): boolean {
+    const capi = sqlite3.capi;
+    const length: number = capi.sqlite3_column_bytes(pStmt, col);
+    if (length < DEFERRED_BLOB_MIN_BYTES || capi.sqlite3_column_type(pStmt, source.rowidColumn) !== TAG_INTEGER) {
+        return false;
+    }
+    out.setBlobReference(col, source.schema, source.table, source.column,
+        BigInt(capi.sqlite3_column_int64(pStmt, source.rowidColumn)), length);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Cursors — read-only statements left open between requests so the C#
+// reader can pull rows in batches ('fetch') instead of receiving the whole
+// result set in one message. The statement stays checked out of the
+// statement cache until the cursor is exhausted or closed.
+// ---------------------------------------------------------------------------
+
+interface Cursor {
+    dbName: string;
+    sql: string;
+    stmt: any;
+    meta: ColumnMetadata;
+}
+
+const cursors = new Map<number, Cursor>();
+let nextCursorId = 1;
+
+function releaseCursor(cursorId: number): void {
+    const cursor = cursors.get(cursorId);
+    if (!cursor) {
+        return;
+    }
+    cursors.delete(cursorId);
+    getStatementCache(cursor.dbName).release(cursor.sql, cursor.stmt);
+}
+
+/**
+ * Next batch of rows for an open cursor. The response carries
+ * `cursorId: 0` once the statement is exhausted (the cursor is released
+ * at that point; no closeCursor needed).
+ */
+export function fetchCursor(cursorId: number, batchSize: number): Uint8Array {
+    const cursor = cursors.get(cursorId);
+    if (!cursor) {
+        throw new Error(`Cursor ${cursorId} not open`);
+    }
+
+    const limit = Math.max(1, batchSize);
+    const out = new ColumnarResultBuilder(cursor.meta.columnNames.length, limit);
+    let done: boolean;
+    try {
+        done = stepRows(cursor.stmt, cursor.meta, limit, out);
+    } catch (error) {
+        releaseCursor(cursorId);
+        throw error;
+    }
+    if (done) {
+        releaseCursor(cursorId);
+    }
+
+    // Column metadata went out with the first batch
+    return out.finish({
+        rowsAffected: 0,
+        lastInsertId: 0,
+        cursorId: done ? 0 : cursorId
+    });
+}
+
+/** Close a cursor before it is exhausted (reader disposed early). Idempotent. */
+export function closeCursor(cursorId: number): void {
+    releaseCursor(cursorId);
+}
+
+/**
+ * Close every cursor, blob handle and online backup on `dbName` and
+ * finalize its statement cache. Called from every worker's closeDatabase
+ * before db.close() — a live Stmt, blob or backup handle pins the
+ * connection.
+ */
+export function finalizeDatabaseStatements(dbName: string): void {
+    for (const [cursorId, cursor] of cursors) {
+        if (cursor.dbName === dbName) {
+            releaseCursor(cursorId);
+        }
+    }
+    closeDatabaseBlobs(dbName);
+    abortDatabaseBackups(dbName);
+    finalizeStatementCache(dbName);
+}
+
+/**
+ * Column types for the multi-statement db.exec() fallback, which exposes no
+ * statement handle: first non-NULL value's JS type per column.
+ */
+function inferColumnTypesFromValues(columnCount: number, rows: any[][]): string[] {
+    const columnTypes: string[] = [];
+    for (let i = 0; i < columnCount; i++) {
+        let inferredType = 'TEXT';
+        const sample = rows.find(r => r[i] !== null && r[i] !== undefined);
+        const value = sample?.[i];
+        if (typeof value === 'number') {
+            inferredType = Number.isInteger(value) ? 'INTEGER' : 'REAL';
+        } else if (typeof value === 'bigint' || typeof value === 'boolean') {
+            inferredType = 'INTEGER';
+        } else if (value instanceof Uint8Array || ArrayBuffer.isView(value)) {
+            inferredType = 'BLOB';
+        }
+        columnTypes.push(inferredType);
+    }
+    return columnTypes;
+}
+
+/**
+ * Execute one 'execute' request and return the columnar result buffer
+ * (see columnar-result.ts).
+ *
+ * Single-statement SQL runs through the per-database prepared-statement
+ * cache: one compile per distinct SQL text for the life of the connection,
+ * column metadata read from the executing statement (readColumnMetadata /
+ * stepRows). Multi-statement scripts (migrations, raw batches) keep the
+ * db.exec() path, which walks every statement in the string.
+ *
+ * With `batchSize > 0` a read-only statement returns at most that many
+ * rows; if more remain the response carries a non-zero `cursorId` to
+ * continue with fetchCursor().
+ *
+ * Parameters of encoded requests arrive as a ParameterBlock and bind to
+ * cached statements straight from the request bytes; JSON requests carry
+ * the `{ value, type }` map handled by convertParametersForBinding.
+ *
+ * `deferBlobs` (CommandBehavior.SequentialAccess) leaves large BLOBs of a
+ * single statement in the database: the result carries a reference the
+ * C# reader opens as a SqliteWasmBlob stream (see blob-ops.ts).
+ */
+export function executeSql(
+    dbName: string, sql: string,
+    parameters: Record<string, any> | ParameterBlock,
+    binaryPayload?: Uint8Array,
+    batchSize = 0,
+    deferBlobs = false,
+): Uint8Array {
+    const db = openDatabases.get(dbName);
+    if (!db) {
+        throw new Error(`Database ${dbName} not open`);
+    }
+
+    try {
+        logger.debug(MODULE_NAME, 'Executing SQL:', sql.substring(0, 100));
+
+        const singleStatement = isSingleStatement(sql);
+        const block = parameters instanceof ParameterBlock ? parameters : undefined;
+
+        // Convert parameters with type metadata for proper SQLite binding.
+        // binaryPayload (if present) carries blob param bytes — see
+        // convertParametersForBinding for the __blobOffset/__blobLength
+        // placeholder shape.
+        let bind: Record<string, any> | undefined;
+        if (!block || (!singleStatement && block.count > 0)) {
+            const convertedParams = convertParametersForBinding(block ? block.toRecord() : parameters as Record<string, any>, binaryPayload);
+            bind = Object.keys(convertedParams).length > 0 ? convertedParams : undefined;
+        }
+
+        let out: ColumnarResultBuilder;
+        let columnNames: string[];
+        let columnTypes: string[];
+        let cursorId = 0;
+
+        if (singleStatement) {
+            const cache = getStatementCache(dbName);
+            const stmt = cache.acquire(db, sql);
+            let keepOpen = false;
+            try {
+                if (block) {
+                    block.bind(db, stmt);
+                } else if (bind) {
+                    stmt.bind(bind);
+                }
+                const meta = readColumnMetadata(stmt.pointer);
+                if (deferBlobs && meta.columnNames.length > 1) {
+                    meta.blobSources = resolveBlobSources(db, stmt.pointer, meta.columnNames.length);
+                }
+                // Only read-only statements become cursors: a write left
+                // mid-step would hold the write lock across requests.
+                const streaming = batchSize > 0 && meta.columnNames.length > 0
+                    && sqlite3.capi.sqlite3_stmt_readonly(stmt.pointer) !== 0;
+                out = new ColumnarResultBuilder(meta.columnNames.length, streaming ? batchSize : 64);
+                const done = stepRows(stmt, meta, streaming ? batchSize : Number.POSITIVE_INFINITY, out);
+                if (!done) {
+                    cursorId = nextCursorId++;
+                    cursors.set(cursorId, { dbName, sql, stmt, meta });
+                    keepOpen = true;
+                }
+                columnNames = meta.columnNames;
+                columnTypes = finalColumnTypes(meta);
+            } finally {
+                if (!keepOpen) {
+                    cache.release(sql, stmt);
+                }
+            }
+        } else {
+            // db.exec fills columnNames from the first statement that has
+            // result columns — no second prepare needed for metadata.
+            columnNames = [];
+            const rows: any[][] = db.exec({
+                sql: sql,
+                bind: bind,
+                returnValue: 'resultRows',
+                rowMode: 'array',
+                columnNames: columnNames
+            });
+            columnTypes = inferColumnTypesFromValues(columnNames.length, rows);
+            out = new ColumnarResultBuilder(columnNames.length, rows.length);
+            for (const row of rows) {
+                out.beginRow();
+                for (let i = 0; i < columnNames.length; i++) {
+                    out.setValue(i, row[i]);
+                }
+            }
+        }
+
+        logger.debug(MODULE_NAME, 'SQL executed successfully, rows:', out.rowCount);
+
+        // Get changes and last insert ID for non-SELECT queries
+        let rowsAffected = 0;
+        let lastInsertId: number | bigint = 0;
+
+        if (sql.trim().toUpperCase().startsWith('INSERT') ||
+            sql.trim().toUpperCase().startsWith('UPDATE') ||
+            sql.trim().toUpperCase().startsWith('DELETE') ||
+            sql.trim().toUpperCase().startsWith('CREATE')) {
+
+            // Check if statement has RETURNING clause
+            // When RETURNING is used, db.changes() doesn't work correctly because
+            // SQLite treats it as a SELECT-like operation
+            const hasReturning = sql.toUpperCase().includes('RETURNING');
+
+            if (hasReturning && out.rowCount > 0) {
+                // For UPDATE/DELETE with RETURNING, the presence of a result row means success
+                rowsAffected = out.rowCount;
+            }
+            else {
+                // For INSERT without RETURNING, or any statement without RETURNING
+                rowsAffected = db.changes();
+            }
+
+            lastInsertId = db.lastInsertRowId;
+        }
+
+        return out.finish({
+            columnNames,
+            columnTypes,
+            rowsAffected,
+            lastInsertId,
+            cursorId
+        });
+    } catch (error) {
+        logger.error(MODULE_NAME, 'SQL execution failed:', error);
+        logger.error(MODULE_NAME, 'SQL:', sql);
+        throw error;
+    }
+}
+
+/** Error prefix the bridge uses to tell a failed deferred BEGIN from a failed statement. */
+export const DEFERRED_BEGIN_FAILED = 'Deferred BEGIN failed';
+
+/**
+ * Open the transaction a request carries as its `begin` prefix (lazy
+ * SqliteWasmTransaction) before its statement runs. If BEGIN fails nothing
+ * else runs; if the statement fails afterwards the transaction stays open,
+ * exactly as with a separate BEGIN round trip.
+ */
+export function runDeferredBegin(dbName: string, beginSql: string | undefined | null): void {
+    if (!beginSql) {
+        return;
+    }
+    const db = openDatabases.get(dbName);
+    if (!db) {
+        throw new Error(`Database ${dbName} not open`);
+    }
+    try {
+        db.exec(beginSql);
+    } catch (error) {
+        throw new Error(`${DEFERRED_BEGIN_FAILED}: ${error instanceof Error ? error.message : String(error)}`);
+    }
+}
+
+export interface BatchCommand {
+    sql: string;
+    parameters?: Record<string, any> | ParameterBlock;
+    /** Slice of the request's binary attachment holding this command's blobs. */
+    blobOffset?: number;
+    blobLength?: number;
+}
+
+/** Savepoint wrapping an atomic 'executeBatch' request. */
+const BATCH_SAVEPOINT = 'sqlitewasm_batch';
+
+/**
+ * Execute one 'executeBatch' request: every command in order, through the
+ * same path as executeSql (statement cache included), answered with one
+ * framed response. Stops at the first failure; the error names the
+ * failing command. With `atomic` the commands run under a savepoint that
+ * is rolled back on failure, so the batch applies all or nothing whether
+ * or not a transaction is open (EF Core SaveChanges batches); otherwise
+ * atomicity is the caller's.
+ */
+export function executeBatch(
+    dbName: string,
+    commands: BatchCommand[],
+    binaryPayload?: Uint8Array,
+    atomic = false,
+): Uint8Array {
+    const db = atomic ? openDatabases.get(dbName) : undefined;
+    if (atomic) {
+        if (!db) {
+            throw new Error(`Database ${dbName} not open`);
+        }
+        db.exec(`SAVEPOINT ${BATCH_SAVEPOINT}`);
+    }
+
+    const results: Uint8Array[] = [];
+    for (let i = 0; i < commands.length; i++) {
+        const command = commands[i];
+        const blobs = binaryPayload && command.blobLength
+            ? binaryPayload.subarray(command.blobOffset ?? 0, (command.blobOffset ?? 0) + command.blobLength)
+            : undefined;
+        try {
+            results.push(executeSql(dbName, command.sql, command.parameters ?? {}, blobs));
+        } catch (error) {
+            if (db) {
+                try {
+                    db.exec(`ROLLBACK TO ${BATCH_SAVEPOINT}; RELEASE ${BATCH_SAVEPOINT}`);
+                } catch (rollbackError) {
+                    logger.error(MODULE_NAME, 'Batch savepoint rollback failed:', rollbackError);
+                }
+            }
+            const message = error instanceof Error ? error.message : String(error);
+            throw new Error(`Batch command ${i + 1} of ${commands.length} failed: ${message}`);
+        }
+    }
+
+    if (db) {
+        db.exec(`RELEASE ${BATCH_SAVEPOINT}`);
+    }
+    return frameBatchResults(results);
+}
@@ -0,0 +1,188 @@
+// statement-cache.ts
+// Per-database LRU of prepared oo1 Stmt objects, keyed by SQL text.
+//
+// EF Core re-issues the same parameterized SQL for every list page / Find /
+// SaveChanges, so compiling it on every call makes the parser + planner a
+// fixed tax on each round trip. Statements are checked out for the duration
+// of one execution (acquire → bind/step → release) so a statement that is
+// still stepping can never be handed to a second caller; release() resets
+// and clears bindings before the statement goes back into the LRU.
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME } from './worker-state';
+
+/** Default LRU capacity per database. Overridden by the bridge's init message. */
+export const DEFAULT_STATEMENT_CACHE_SIZE = 64;
+
+let statementCacheCapacity = DEFAULT_STATEMENT_CACHE_SIZE;
+
+export interface StatementCacheStats {
+    hits: number;
+    misses: number;
+    size: number;
+    capacity: number;
+}
+
+export class StatementCache {
+    // Map iteration order is insertion order — the first key is the LRU entry.
+    private readonly statements = new Map<string, any>();
+    private hits = 0;
+    private misses = 0;
+
+    constructor(private readonly dbName: string) {}
+
+    /**
+     * Check out a prepared statement for `sql`. Removes it from the LRU so
+     * nested / overlapping executions of the same SQL each get their own
+     * handle; the caller MUST hand it back via release() (or finalize it).
+     */
+    acquire(db: any, sql: string): any {
+        const cached = this.statements.get(sql);
+        if (cached) {
+            this.statements.delete(sql);
+            this.hits++;
+            return cached;
+        }
+        this.misses++;
+        return db.prepare(sql);
+    }
+
+    /**
+     * Return a statement obtained from acquire(). Resets it and drops its
+     * bindings so no row cursor or bound blob outlives the execution. When
+     * the cache is disabled, already holds an entry for `sql`, or the reset
+     * itself failed, the statement is finalized instead.
+     */
+    release(sql: string, stmt: any): void {
+        try {
+            stmt.reset();
+            stmt.clearBindings();
+        } catch (error) {
+            logger.debug(MODULE_NAME, `Statement reset failed, finalizing: ${error}`);
+            this.finalizeQuietly(stmt);
+            return;
+        }
+
+        if (statementCacheCapacity <= 0 || this.statements.has(sql)) {
+            this.finalizeQuietly(stmt);
+            return;
+        }
+
+        this.statements.set(sql, stmt);
+        while (this.statements.size > statementCacheCapacity) {
+            const [lruSql, lruStmt] = this.statements.entries().next().value as [string, any];
+            this.statements.delete(lruSql);
+            this.finalizeQuietly(lruStmt);
+        }
+    }
+
+    /** Finalize every cached statement. Required before db.close(). */
+    clear(): void {
+        for (const stmt of this.statements.values()) {
+            this.finalizeQuietly(stmt);
+        }
+        this.statements.clear();
+    }
+
+    stats(): StatementCacheStats {
+        return {
+            hits: this.hits,
+            misses: this.misses,
+            size: this.statements.size,
+            capacity: statementCacheCapacity,
+        };
+    }
+
+    private finalizeQuietly(stmt: any): void {
+        try {
+            stmt.finalize();
+        } catch (error) {
+            logger.warn(MODULE_NAME, `Failed to finalize cached statement for ${this.dbName}:`, error);
+        }
+    }
+}
+
+const statementCaches = new Map<string, StatementCache>();
+
+/** Set the per-database LRU capacity. 0 disables caching (prepare per call). */
+export function setStatementCacheCapacity(capacity: number): void {
+    statementCacheCapacity = Math.max(0, Math.floor(capacity));
+}
+
+export function getStatementCache(dbName: string): StatementCache {
+    let cache = statementCaches.get(dbName);
+    if (!cache) {
+        cache = new StatementCache(dbName);
+        statementCaches.set(dbName, cache);
+    }
+    return cache;
+}
+
+/**
+ * Finalize and forget the statement cache for `dbName`. Reached from every
+ * worker's closeDatabase (via finalizeDatabaseStatements) before db.close()
+ * — a live Stmt pins the connection and would otherwise leak across
+ * close/reopen cycles.
+ */
+export function finalizeStatementCache(dbName: string): void {
+    const cache = statementCaches.get(dbName);
+    if (cache) {
+        cache.clear();
+        statementCaches.delete(dbName);
+    }
+}
+
+/**
+ * True when `sql` holds at most one statement (optionally `;`-terminated).
+ * oo1's db.prepare() silently compiles only the first statement of a
+ * multi-statement string, so those keep going through db.exec(). Skips
+ * quoted identifiers / literals and both comment forms.
+ */
+export function isSingleStatement(sql: string): boolean {
+    let i = 0;
+    const n = sql.length;
+    let sawTerminator = false;
+
+    while (i < n) {
+        const c = sql[i];
+
+        if (c === "'" || c === '"' || c === '`') {
+            const close = sql.indexOf(c, i + 1);
+            if (close < 0) {
+                return true; // unterminated literal — let SQLite report it
+            }
+            i = close + 1;
+            // Doubled quote ('') is an escaped quote inside the same literal.
+            if (sql[i] === c) {
+                continue;
+            }
+        } else if (c === '[') {
+            const close = sql.indexOf(']', i + 1);
+            i = close < 0 ? n : close + 1;
+        } else if (c === '-' && sql[i + 1] === '-') {
+            const eol = sql.indexOf('\n', i + 2);
+            i = eol < 0 ? n : eol + 1;
+            continue;
+        } else if (c === '/' && sql[i + 1] === '*') {
+            const end = sql.indexOf('*/', i + 2);
+            i = end < 0 ? n : end + 2;
+            continue;
+        } else if (c === ';') {
+            sawTerminator = true;
+            i++;
+            continue;
+        } else {
+            if (sawTerminator && !/\s/.test(c)) {
+                return false;
+            }
+            i++;
+            continue;
+        }
+
+        if (sawTerminator) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,305 @@
+// stream-ops.ts
+// Chunked raw-database transfer for the bridge's Stream overloads of
+// ExportDatabaseAsync / ImportDatabaseAsync. An export stream snapshots
+// the database once and hands out byte ranges ('exportStreamRead'); an
+// import stream feeds chunks to poolUtil.importDb's chunked mode as they
+// arrive ('importStreamWrite'), into a temporary file that replaces the
+// database only once complete. Only one chunk at a time is held in the
+// worker, so a multi-hundred-MB database never exists as one buffer in
+// the WASM heap on either side.
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME, poolUtil } from './worker-state';
+import { backupDatabaseInto } from './backup-ops';
+
+interface ExportStream {
+    dbName: string;
+    length: number;
+    read(offset: number, count: number): Uint8Array;
+    dispose(): void;
+}
+
+interface ImportStream {
+    dbName: string;
+    /** Temporary file the chunks go to until 'importStreamFinish'. */
+    tempPath: string;
+    /** Chunks pushed before importDb asked for them; undefined marks EOF. */
+    queue: (Uint8Array | undefined)[];
+    /** importDb's pending request for the next chunk. */
+    waiting?: { resolve: (chunk: Uint8Array | undefined) => void; reject: (error: Error) => void };
+    /** Fired when importDb asks for the next chunk — the previous one is on disk. */
+    onPull?: () => void;
+    aborted: boolean;
+    done: Promise<number>;
+}
+
+/** Directories of the streams' temporary SAH files, outside /databases/. */
+const STREAM_TEMP_DIRS = ['/exports/', '/imports/'];
+
+const exportStreams = new Map<number, ExportStream>();
+const importStreams = new Map<number, ImportStream>();
+let nextStreamId = 1;
+
+/**
+ * Drop temporary stream files left behind by a page that closed or
+ * reloaded mid-transfer; each would hold a pool slot and a full-size copy
+ * forever. Runs once the pool is installed, before any stream opens.
+ */
+export function sweepStreamFiles(): void {
+    for (const path of poolUtil.getFileNames() as string[]) {
+        if (STREAM_TEMP_DIRS.some(dir => path.startsWith(dir))) {
+            poolUtil.unlink(path);
+            logger.info(MODULE_NAME, `Removed leftover stream file ${path}`);
+        }
+    }
+}
+
+/**
+ * Export stream over an online copy of the open database `dbName`. The
+ * backup (backupDatabaseInto) goes to a temporary SAH file outside
+ * /databases/, so it never lists as a database, and ranges are read back
+ * one page at a time through sqlite_dbpage. The source stays open and
+ * writable; the stream returns the database as of the backup. The
+ * temporary file is unlinked when the stream closes.
+ */
+export async function openExportStream(dbName: string): Promise<{ session: number; length: number }> {
+    const session = nextStreamId++;
+    const tempPath = `/exports/${session}.db`;
+    const copy = new poolUtil.OpfsSAHPoolDb(tempPath);
+    let pageStmt: any;
+    try {
+        // The backup copies the source's WAL header bytes; exclusive locking
+        // lets the SAH VFS reopen the copy in WAL mode without shared memory.
+        copy.exec('PRAGMA locking_mode = exclusive; PRAGMA synchronous = OFF;');
+        await backupDatabaseInto(dbName, copy);
+
+        const pageSize = Number(copy.selectValue('PRAGMA page_size'));
+        const length = pageSize * Number(copy.selectValue('PRAGMA page_count'));
+        pageStmt = copy.prepare('SELECT data FROM sqlite_dbpage WHERE pgno = ?');
+
+        exportStreams.set(session, {
+            dbName,
+            length,
+            read(offset, count) {
+                const end = Math.min(length, offset + count);
+                if (end <= offset) {
+                    return new Uint8Array(0);
+                }
+                const out = new Uint8Array(end - offset);
+                for (let pgno = Math.floor(offset / pageSize) + 1; (pgno - 1) * pageSize < end; pgno++) {
+                    pageStmt.bind(1, pgno);
+                    pageStmt.step();
+                    const page: Uint8Array = pageStmt.get(0);
+                    pageStmt.reset();
+
+                    const pageStart = (pgno - 1) * pageSize;
+                    const from = Math.max(offset, pageStart) - pageStart;
+                    const to = Math.min(end, pageStart + pageSize) - pageStart;
+                    out.set(page.subarray(from, to), pageStart + from - offset);
+                }
+                return out;
+            },
+            dispose() {
+                pageStmt.finalize();
+                copy.close();
+                poolUtil.unlink(tempPath);
+            },
+        });
+        logger.debug(MODULE_NAME, `Opened export stream ${session} for ${dbName}: ${length} bytes`);
+        return { session, length };
+    } catch (error) {
+        pageStmt?.finalize();
+        copy.close();
+        poolUtil.unlink(tempPath);
+        throw error;
+    }
+}
+
+/**
+ * Export stream over a file the caller reads by range (the Crypto worker's
+ * copy of slot-format ciphertext, which has to be read as stored).
+ * `read` fills `dest` from byte `at` and returns the bytes read;
+ * `dispose` runs when the stream closes.
+ */
+export function openRangeExportStream(
+    dbName: string,
+    length: number,
+    read: (dest: Uint8Array, at: number) => number,
+    dispose: () => void,
+): { session: number; length: number } {
+    const session = nextStreamId++;
+    exportStreams.set(session, {
+        dbName,
+        length,
+        read(offset, count) {
+            const out = new Uint8Array(Math.max(0, Math.min(length, offset + count) - offset));
+            if (out.length > 0 && read(out, offset) !== out.length) {
+                throw new Error(`Export stream ${session}: short read at ${offset} of ${dbName}`);
+            }
+            return out;
+        },
+        dispose,
+    });
+    return { session, length };
+}
+
+/**
+ * Export stream over bytes the caller already holds (a deflated ZIP entry
+ * from zip-ops.ts, kept as the chunks the compressor produced). Keeps the
+ * image in the worker's JS heap, still never in the WASM heap.
+ */
+export function openBufferedExportStream(dbName: string, image: Uint8Array | Uint8Array[]): { session: number; length: number } {
+    const session = nextStreamId++;
+    const chunks = Array.isArray(image) ? image : [image];
+    const length = chunks.reduce((total, chunk) => total + chunk.length, 0);
+    exportStreams.set(session, {
+        dbName,
+        length,
+        read(offset, count) {
+            const end = Math.min(length, offset + count);
+            const out = new Uint8Array(Math.max(0, end - offset));
+            let chunkStart = 0;
+            for (const chunk of chunks) {
+                const chunkEnd = chunkStart + chunk.length;
+                if (chunkEnd > offset && chunkStart < end) {
+                    const from = Math.max(offset, chunkStart);
+                    out.set(chunk.subarray(from - chunkStart, Math.min(end, chunkEnd) - chunkStart), from - offset);
+                }
+                chunkStart = chunkEnd;
+            }
+            return out;
+        },
+        dispose: () => {},
+    });
+    return { session, length };
+}
+
+/** Up to `count` bytes from `offset`; shorter at the end of the stream. */
+export function readExportStream(session: number, offset: number, count: number): Uint8Array {
+    const stream = exportStreams.get(session);
+    if (!stream) {
+        throw new Error(`Export stream ${session} not open`);
+    }
+    return stream.read(offset, count);
+}
+
+/** Release an export stream. Unknown sessions are ignored. */
+export function closeExportStream(session: number): void {
+    const stream = exportStreams.get(session);
+    if (!stream) {
+        return;
+    }
+    exportStreams.delete(session);
+    try {
+        stream.dispose();
+    } catch (error) {
+        logger.warn(MODULE_NAME, `Failed to release export stream ${session} for ${stream.dbName}:`, error);
+    }
+}
+
+/**
+ * Start a chunked import of `dbName`. The chunks go to a temporary SAH
+ * file outside /databases/, so the existing database stays intact and
+ * usable until finishImportStream replaces it; a failed or aborted stream
+ * drops only the temporary file. It takes a pool slot of its own while
+ * the import runs. `opaque` is passed on to importDb (the Crypto worker's
+ * ciphertext imports).
+ */
+export function openImportStream(dbName: string, opaque = false): number {
+    const session = nextStreamId++;
+    const tempPath = `/imports/${session}.db`;
+    const stream: ImportStream = { dbName, tempPath, queue: [], aborted: false, done: Promise.resolve(0) };
+    stream.done = Promise.resolve(poolUtil.importDb(tempPath, () => pullChunk(stream), opaque));
+    // Failures surface through writeImportStream / finishImportStream
+    stream.done.catch(() => {});
+    importStreams.set(session, stream);
+    return session;
+}
+
+/** Append `chunk`; resolves once it has been written to the SAH. */
+export async function writeImportStream(session: number, chunk: Uint8Array): Promise<void> {
+    const stream = getImportStream(session);
+    const written = new Promise<void>(resolve => stream.onPull = resolve);
+    pushChunk(stream, chunk);
+    await Promise.race([written, stream.done]);
+}
+
+/**
+ * Complete the import. The caller has closed the database. `accept`, if
+ * given, checks the temporary file first; when it returns false, or the
+ * stream failed, the temporary file is dropped and the database stays as
+ * it was. Otherwise the file replaces the database (a rename in the pool,
+ * no copy). Returns whether it did.
+ */
+export async function finishImportStream(session: number, accept?: (tempPath: string) => boolean): Promise<boolean> {
+    const stream = getImportStream(session);
+    importStreams.delete(session);
+    pushChunk(stream, undefined);
+    let written: number;
+    try {
+        written = await stream.done;
+        if (accept && !accept(stream.tempPath)) {
+            poolUtil.unlink(stream.tempPath);
+            return false;
+        }
+    } catch (error) {
+        poolUtil.unlink(stream.tempPath);
+        throw error;
+    }
+
+    const dbPath = `/databases/${stream.dbName}`;
+    poolUtil.unlink(dbPath);
+    poolUtil.renameFile(stream.tempPath, dbPath);
+    logger.info(MODULE_NAME, `✓ Imported database: ${stream.dbName} (${written} bytes, streamed)`);
+    return true;
+}
+
+/**
+ * Abandon an import; only the temporary file is dropped. Unknown sessions
+ * are ignored.
+ */
+export async function abortImportStream(session: number): Promise<void> {
+    const stream = importStreams.get(session);
+    if (!stream) {
+        return;
+    }
+    importStreams.delete(session);
+    stream.aborted = true;
+    const waiting = stream.waiting;
+    stream.waiting = undefined;
+    waiting?.reject(new Error('Import stream aborted'));
+    await stream.done.catch(() => {});
+    poolUtil.unlink(stream.tempPath);
+}
+
+function getImportStream(session: number): ImportStream {
+    const stream = importStreams.get(session);
+    if (!stream) {
+        throw new Error(`Import stream ${session} not open`);
+    }
+    return stream;
+}
+
+function pullChunk(stream: ImportStream): Promise<Uint8Array | undefined> {
+    const onPull = stream.onPull;
+    stream.onPull = undefined;
+    onPull?.();
+
+    if (stream.aborted) {
+        return Promise.reject(new Error('Import stream aborted'));
+    }
+    if (stream.queue.length > 0) {
+        return Promise.resolve(stream.queue.shift());
+    }
+    return new Promise((resolve, reject) => stream.waiting = { resolve, reject });
+}
+
+function pushChunk(stream: ImportStream, chunk: Uint8Array | undefined): void {
+    const waiting = stream.waiting;
+    if (waiting) {
+        stream.waiting = undefined;
+        waiting.resolve(chunk);
+    } else {
+        stream.queue.push(chunk);
+    }
+}
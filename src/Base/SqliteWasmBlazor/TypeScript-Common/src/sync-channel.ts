@@ -0,0 +1,92 @@
+// sync-channel.ts
+// Worker half of the synchronous request channel. The bridge allocates a
+// SharedArrayBuffer (only possible on a cross-origin-isolated page) and hands
+// it over in the 'init' message. A request flagged `sync: true` still arrives
+// through postMessage; its response is written here instead of being posted
+// back, while the .NET thread waits on the state word in the bridge's
+// sendToWorkerSync(). One request is in flight at a time — the caller is
+// blocked until it completes — so the channel is a single slot.
+//
+// Layout (mirrored in both worker-bridge.ts copies):
+//
+//   Int32 header[4]
+//     [0] state     IDLE → PENDING (bridge) → READY (worker) → IDLE (bridge)
+//                   PENDING → ABANDONED (bridge timed out) → IDLE (worker)
+//     [1] kind      RESULT / JSON / ERROR
+//     [2] length    payload byte length
+//     [3] reserved
+//   payload bytes   columnar result, UTF-8 JSON response or UTF-8 error
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME } from './worker-state';
+
+export const SYNC_HEADER_BYTES = 16;
+
+export const SYNC_STATE_IDLE = 0;
+export const SYNC_STATE_PENDING = 1;
+export const SYNC_STATE_READY = 2;
+export const SYNC_STATE_ABANDONED = 3;
+
+export const SYNC_KIND_RESULT = 0;
+export const SYNC_KIND_JSON = 1;
+export const SYNC_KIND_ERROR = 2;
+
+const textEncoder = new TextEncoder();
+
+let header: Int32Array | null = null;
+let payload: Uint8Array | null = null;
+
+/** Adopt the bridge's SharedArrayBuffer (from the 'init' message). */
+export function attachSyncChannel(buffer: SharedArrayBuffer): void {
+    header = new Int32Array(buffer, 0, SYNC_HEADER_BYTES / 4);
+    payload = new Uint8Array(buffer, SYNC_HEADER_BYTES);
+    logger.info(MODULE_NAME, `Synchronous channel attached (${payload.length} bytes)`);
+}
+
+/**
+ * Publish the response to the pending synchronous request: a columnar
+ * buffer, any other handler result as JSON, or the error message. A result
+ * larger than the channel is reported as an error rather than truncated.
+ * Raw bytes (`{ rawBinary, data }`, e.g. 'blobRead') go out under the
+ * result kind as well; the caller knows which of the two it asked for.
+ */
+export function completeSyncRequest(result: unknown, error?: string): void {
+    if (!header || !payload) {
+        logger.error(MODULE_NAME, 'Synchronous request received but no channel is attached');
+        return;
+    }
+
+    let kind: number;
+    let bytes: Uint8Array;
+    if (error !== undefined) {
+        kind = SYNC_KIND_ERROR;
+        bytes = textEncoder.encode(error);
+    } else if (result instanceof Uint8Array) {
+        kind = SYNC_KIND_RESULT;
+        bytes = result;
+    } else if (result && typeof result === 'object' && (result as any).rawBinary === true) {
+        kind = SYNC_KIND_RESULT;
+        bytes = (result as any).data as Uint8Array;
+    } else {
+        kind = SYNC_KIND_JSON;
+        bytes = textEncoder.encode(JSON.stringify({ success: true, ...(result as object) }));
+    }
+
+    if (bytes.length > payload.length) {
+        kind = SYNC_KIND_ERROR;
+        bytes = textEncoder.encode(
+            `Result of ${bytes.length} bytes exceeds the synchronous channel (${payload.length} bytes); ` +
+            'raise SqliteWasmOptions.SynchronousChannelSize or use the async API');
+        bytes = bytes.subarray(0, payload.length);
+    }
+
+    payload.set(bytes);
+    Atomics.store(header, 1, kind);
+    Atomics.store(header, 2, bytes.length);
+
+    // The bridge may have given up waiting; then nobody reads this result.
+    if (Atomics.compareExchange(header, 0, SYNC_STATE_PENDING, SYNC_STATE_READY) === SYNC_STATE_ABANDONED) {
+        Atomics.store(header, 0, SYNC_STATE_IDLE);
+    }
+    Atomics.notify(header, 0);
+}
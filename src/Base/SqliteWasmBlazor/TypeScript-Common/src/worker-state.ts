@@ -8,7 +8,6 @@ export let sqlite3: any;
 export let poolUtil: any;
 export const openDatabases = new Map<string, any>();
 export const pragmasSet = new Set<string>();
-export const schemaCache = new Map<string, Map<string, string>>();
 export let baseHref = '/';
 
 export const MODULE_NAME = 'SQLite Worker';
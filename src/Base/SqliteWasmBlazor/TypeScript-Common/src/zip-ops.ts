@@ -0,0 +1,347 @@
+// zip-ops.ts
+// Deflate for the bridge's ExportAllDatabasesAsync ZIP archive, off the
+// .NET thread. Each entry is compressed to deflate-raw, with its CRC-32,
+// by a helper worker — a second instance of this worker bundle started
+// under ZIP_HELPER_NAME, which never initializes SQLite — so the entries
+// of a multi-database archive compress on as many cores as there are
+// helpers. The SAH files stay with this worker: OPFS sync access handles
+// are exclusive to the pool that opened them, so helpers are fed page
+// ranges from an export stream (stream-ops.ts) instead of opening files.
+// The compressed entry comes back as a buffered export stream; the bridge
+// writes the ZIP headers around it.
+
+import { logger } from './sqlite-logger';
+import { MODULE_NAME } from './worker-state';
+import { openBufferedExportStream, readExportStream, closeExportStream } from './stream-ops';
+
+/** Worker name that makes a bundle instance run as a compression helper. */
+export const ZIP_HELPER_NAME = 'sqlitewasmblazor-zip-helper';
+
+/** Bytes handed to a helper per message. */
+const ZIP_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * Chunks posted to a helper before waiting for it to consume one — bounds
+ * what sits in its inbox while a large database is read.
+ */
+const ZIP_CHUNK_WINDOW = 4;
+
+/** Helpers are capped here; beyond that the single SAH reader is the limit. */
+const MAX_ZIP_HELPERS = 4;
+
+interface DeflatedEntry {
+    chunks: Uint8Array[];
+    crc32: number;
+    length: number;
+}
+
+interface HelperJob {
+    inFlight: number;
+    wake?: () => void;
+    error?: Error;
+    resolve: (entry: DeflatedEntry) => void;
+    reject: (error: Error) => void;
+}
+
+interface ZipHelper {
+    worker: Worker;
+    jobs: Map<number, HelperJob>;
+}
+
+let helpers: ZipHelper[] | undefined;
+let nextJobId = 1;
+
+const CRC_TABLE = (() => {
+    const table = new Uint32Array(256);
+    for (let n = 0; n < 256; n++) {
+        let c = n;
+        for (let k = 0; k < 8; k++) {
+            c = c & 1 ? 0xEDB88320 ^ (c >>> 1) : c >>> 1;
+        }
+        table[n] = c >>> 0;
+    }
+    return table;
+})();
+
+/** CRC-32 (ZIP polynomial) of `bytes`, continuing from `crc`. */
+export function crc32(crc: number, bytes: Uint8Array): number {
+    let c = ~crc;
+    for (let i = 0; i < bytes.length; i++) {
+        c = CRC_TABLE[(c ^ bytes[i]) & 0xff] ^ (c >>> 8);
+    }
+    return ~c >>> 0;
+}
+
+/** One deflate-raw stream; used by a helper, or in-thread without helpers. */
+class Deflater {
+    private readonly writer: WritableStreamDefaultWriter<BufferSource>;
+    private readonly drained: Promise<Uint8Array[]>;
+    private crc = 0;
+    private length = 0;
+
+    constructor() {
+        const stream = new CompressionStream('deflate-raw');
+        this.writer = stream.writable.getWriter();
+        this.drained = collect(stream.readable);
+        // Failures surface through write / finish
+        this.drained.catch(() => {});
+    }
+
+    write(chunk: Uint8Array): Promise<void> {
+        this.crc = crc32(this.crc, chunk);
+        this.length += chunk.length;
+        return this.writer.write(chunk);
+    }
+
+    async finish(): Promise<DeflatedEntry> {
+        await this.writer.close();
+        return { chunks: await this.drained, crc32: this.crc, length: this.length };
+    }
+
+    abort(): void {
+        this.writer.abort().catch(() => {});
+    }
+}
+
+async function collect(readable: ReadableStream<Uint8Array>): Promise<Uint8Array[]> {
+    const reader = readable.getReader();
+    const chunks: Uint8Array[] = [];
+    for (;;) {
+        const { done, value } = await reader.read();
+        if (done) {
+            return chunks;
+        }
+        chunks.push(value);
+    }
+}
+
+/**
+ * Entries the bridge should compress at once: the helper count, 1 when
+ * helpers could not be started (compression then runs in this worker),
+ * 0 when the browser has no deflate-raw CompressionStream — the bridge
+ * falls back to compressing in .NET.
+ */
+export function deflateConcurrency(): number {
+    if (typeof CompressionStream === 'undefined') {
+        return 0;
+    }
+    try {
+        new CompressionStream('deflate-raw');
+    } catch {
+        return 0;
+    }
+    return Math.max(1, getHelpers().length);
+}
+
+/**
+ * Deflate the export stream `session` (`length` bytes) and close it. The
+ * compressed bytes are returned as a new buffered export stream for the
+ * bridge to read, along with the CRC-32 and length of the source.
+ */
+export async function deflateExportStream(
+    dbName: string,
+    session: number,
+    length: number
+): Promise<{ session: number; length: number; crc32: number; uncompressedLength: number }> {
+    let entry: DeflatedEntry;
+    try {
+        const helper = pickHelper();
+        entry = helper
+            ? await deflateOnHelper(helper, session, length)
+            : await deflateInThread(session, length);
+    } finally {
+        closeExportStream(session);
+    }
+
+    const stream = openBufferedExportStream(dbName, entry.chunks);
+    logger.debug(MODULE_NAME, `Deflated ${dbName}: ${entry.length} → ${stream.length} bytes`);
+    return { session: stream.session, length: stream.length, crc32: entry.crc32, uncompressedLength: entry.length };
+}
+
+async function deflateInThread(session: number, length: number): Promise<DeflatedEntry> {
+    const deflater = new Deflater();
+    try {
+        for (let offset = 0; offset < length; offset += ZIP_CHUNK_SIZE) {
+            await deflater.write(readExportStream(session, offset, ZIP_CHUNK_SIZE));
+        }
+        return await deflater.finish();
+    } catch (error) {
+        deflater.abort();
+        throw error;
+    }
+}
+
+async function deflateOnHelper(helper: ZipHelper, session: number, length: number): Promise<DeflatedEntry> {
+    const jobId = nextJobId++;
+    let job!: HelperJob;
+    const result = new Promise<DeflatedEntry>((resolve, reject) => {
+        job = { inFlight: 0, resolve, reject };
+    });
+    // Awaited below; a failure while still reading must not go unhandled
+    result.catch(() => {});
+    helper.jobs.set(jobId, job);
+
+    try {
+        helper.worker.postMessage({ job: jobId, op: 'begin' });
+        for (let offset = 0; offset < length; offset += ZIP_CHUNK_SIZE) {
+            while (job.inFlight >= ZIP_CHUNK_WINDOW && !job.error) {
+                await new Promise<void>(resolve => job.wake = resolve);
+            }
+            if (job.error) {
+                throw job.error;
+            }
+            const data = readExportStream(session, offset, ZIP_CHUNK_SIZE);
+            job.inFlight++;
+            helper.worker.postMessage({ job: jobId, op: 'chunk', data }, [data.buffer]);
+        }
+        helper.worker.postMessage({ job: jobId, op: 'end' });
+        return await result;
+    } catch (error) {
+        helper.worker.postMessage({ job: jobId, op: 'abort' });
+        throw error;
+    } finally {
+        helper.jobs.delete(jobId);
+    }
+}
+
+/** The helper with the fewest running jobs; undefined when there are none. */
+function pickHelper(): ZipHelper | undefined {
+    let best: ZipHelper | undefined;
+    for (const helper of getHelpers()) {
+        if (!best || helper.jobs.size < best.jobs.size) {
+            best = helper;
+        }
+    }
+    return best;
+}
+
+/** Started on first use and kept for the worker's lifetime. */
+function getHelpers(): ZipHelper[] {
+    if (helpers) {
+        return helpers;
+    }
+    helpers = [];
+    if (typeof Worker === 'undefined') {
+        logger.debug(MODULE_NAME, 'Nested workers unavailable; ZIP entries deflate in this worker');
+        return helpers;
+    }
+
+    const count = Math.min(MAX_ZIP_HELPERS, Math.max(1, (navigator.hardwareConcurrency || 2) - 1));
+    try {
+        for (let i = 0; i < count; i++) {
+            helpers.push(startHelper());
+        }
+    } catch (error) {
+        logger.warn(MODULE_NAME, 'Failed to start ZIP compression helpers:', error);
+        for (const helper of helpers) {
+            helper.worker.terminate();
+        }
+        helpers = [];
+    }
+    logger.debug(MODULE_NAME, `Started ${helpers.length} ZIP compression helpers`);
+    return helpers;
+}
+
+function startHelper(): ZipHelper {
+    const helper: ZipHelper = {
+        worker: new Worker(self.location.href, { type: 'module', name: ZIP_HELPER_NAME }),
+        jobs: new Map(),
+    };
+
+    helper.worker.onmessage = (event: MessageEvent) => {
+        const { job: jobId, op } = event.data;
+        const job = helper.jobs.get(jobId);
+        if (!job) {
+            return;
+        }
+        if (op === 'ack') {
+            job.inFlight--;
+        } else if (op === 'done') {
+            job.resolve(event.data.entry);
+        } else if (op === 'error') {
+            failJob(job, new Error(event.data.error));
+        }
+        const wake = job.wake;
+        job.wake = undefined;
+        wake?.();
+    };
+
+    // A helper that fails to load (or crashes) leaves the pool; its jobs
+    // fail, and later entries go to the remaining helpers or in-thread.
+    helper.worker.onerror = (event: ErrorEvent) => {
+        event.preventDefault();
+        logger.warn(MODULE_NAME, 'ZIP compression helper failed:', event.message);
+        helpers = helpers?.filter(h => h !== helper);
+        helper.worker.terminate();
+        for (const job of helper.jobs.values()) {
+            failJob(job, new Error(`ZIP compression helper failed: ${event.message}`));
+        }
+        helper.jobs.clear();
+    };
+
+    return helper;
+}
+
+function failJob(job: HelperJob, error: Error): void {
+    job.error = error;
+    job.reject(error);
+    const wake = job.wake;
+    job.wake = undefined;
+    wake?.();
+}
+
+/**
+ * Run as a compression helper when this bundle was started under
+ * ZIP_HELPER_NAME: replaces the SQL message handler with the deflate
+ * protocol (begin / chunk / end / abort per job). Returns false, and does
+ * nothing, in the SQLite worker itself.
+ */
+export function installZipHelper(): boolean {
+    if (self.name !== ZIP_HELPER_NAME) {
+        return false;
+    }
+
+    const jobs = new Map<number, Deflater>();
+    self.onmessage = async (event: MessageEvent) => {
+        const { job, op } = event.data;
+        try {
+            switch (op) {
+                case 'begin':
+                    jobs.set(job, new Deflater());
+                    return;
+
+                case 'chunk':
+                    await getJob(jobs, job).write(event.data.data);
+                    self.postMessage({ job, op: 'ack' });
+                    return;
+
+                case 'end': {
+                    const deflater = getJob(jobs, job);
+                    jobs.delete(job);
+                    const entry = await deflater.finish();
+                    const buffers = [...new Set(entry.chunks.map(chunk => chunk.buffer as ArrayBuffer))];
+                    self.postMessage({ job, op: 'done', entry }, buffers);
+                    return;
+                }
+
+                case 'abort':
+                    jobs.get(job)?.abort();
+                    jobs.delete(job);
+                    return;
+            }
+        } catch (error) {
+            jobs.get(job)?.abort();
+            jobs.delete(job);
+            self.postMessage({ job, op: 'error', error: error instanceof Error ? error.message : 'Unknown error' });
+        }
+    };
+    return true;
+}
+
+function getJob(jobs: Map<number, Deflater>, job: number): Deflater {
+    const deflater = jobs.get(job);
+    if (!deflater) {
+        throw new Error(`Deflate job ${job} not open`);
+    }
+    return deflater;
+}
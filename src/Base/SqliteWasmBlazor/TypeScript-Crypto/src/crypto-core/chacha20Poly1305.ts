@@ -6,6 +6,7 @@ import { KEY_LENGTH } from './types.js';
 import type { SymmetricEncryptedData } from './types.js';
 
 const NONCE_LENGTH = 12;
+const TAG_LENGTH = 16;
 
 export function encryptChaCha20Poly1305(
     plaintext: Uint8Array,
@@ -43,3 +44,56 @@ export function decryptChaCha20Poly1305(
         : chacha20poly1305(key, encrypted.nonce);
     return cipher.decrypt(encrypted.ciphertext);
 }
+
+// In-place variants for per-page hot paths (the PRF VFS): the caller
+// passes preallocated buffers and nothing is allocated besides the cipher
+// instance. `sealed` is ciphertext || tag, plaintext.length + 16 bytes.
+
+/**
+ * Encrypt `plaintext` into `sealed` under a fresh random nonce, written
+ * into `nonce` (12 bytes).
+ */
+export function encryptChaCha20Poly1305Into(
+    plaintext: Uint8Array,
+    key: Uint8Array,
+    associatedData: Uint8Array,
+    sealed: Uint8Array,
+    nonce: Uint8Array
+): void {
+    checkKeyAndNonce(key, nonce);
+    if (sealed.length !== plaintext.length + TAG_LENGTH) {
+        throw new Error(`Invalid output length: expected ${plaintext.length + TAG_LENGTH}, got ${sealed.length}`);
+    }
+
+    crypto.getRandomValues(nonce);
+    chacha20poly1305(key, nonce, associatedData).encrypt(plaintext, sealed);
+}
+
+/**
+ * Authenticate `sealed` and decrypt it into `plaintext`
+ * (sealed.length - 16 bytes). Throws on a tag mismatch; `plaintext` is
+ * not written then.
+ */
+export function decryptChaCha20Poly1305Into(
+    sealed: Uint8Array,
+    key: Uint8Array,
+    nonce: Uint8Array,
+    associatedData: Uint8Array,
+    plaintext: Uint8Array
+): void {
+    checkKeyAndNonce(key, nonce);
+    if (plaintext.length !== sealed.length - TAG_LENGTH) {
+        throw new Error(`Invalid output length: expected ${sealed.length - TAG_LENGTH}, got ${plaintext.length}`);
+    }
+
+    chacha20poly1305(key, nonce, associatedData).decrypt(sealed, plaintext);
+}
+
+function checkKeyAndNonce(key: Uint8Array, nonce: Uint8Array): void {
+    if (key.length !== KEY_LENGTH) {
+        throw new Error(`Invalid key length: expected ${KEY_LENGTH}, got ${key.length}`);
+    }
+    if (nonce.length !== NONCE_LENGTH) {
+        throw new Error(`Invalid nonce length: expected ${NONCE_LENGTH}, got ${nonce.length}`);
+    }
+}
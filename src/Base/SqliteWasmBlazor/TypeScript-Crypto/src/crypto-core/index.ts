@@ -79,4 +79,9 @@ export { sha256 } from '@awasm/noble';
 export { hmac } from '@awasm/noble/hmac.js';
 
 // ChaCha20-Poly1305
-export { encryptChaCha20Poly1305, decryptChaCha20Poly1305 } from './chacha20Poly1305.js';
+export {
+    encryptChaCha20Poly1305,
+    decryptChaCha20Poly1305,
+    encryptChaCha20Poly1305Into,
+    decryptChaCha20Poly1305Into,
+} from './chacha20Poly1305.js';
@@ -1,5 +1,11 @@
 import { describe, it, expect } from 'vitest';
-import { encryptChaCha20Poly1305, decryptChaCha20Poly1305, generateRandomBytes } from '../src/crypto-core/index.js';
+import {
+    encryptChaCha20Poly1305,
+    decryptChaCha20Poly1305,
+    encryptChaCha20Poly1305Into,
+    decryptChaCha20Poly1305Into,
+    generateRandomBytes,
+} from '../src/crypto-core/index.js';
 import type { SymmetricEncryptedData } from '../src/crypto-core/index.js';
 
 describe('chacha20Poly1305', () => {
@@ -96,4 +102,55 @@ describe('chacha20Poly1305', () => {
         const plaintext = new TextEncoder().encode('data');
         expect(() => encryptChaCha20Poly1305(plaintext, shortKey)).toThrow(/Invalid key length/);
     });
+
+    describe('in-place variants', () => {
+        it('encryptInto output decrypts with the allocating API', () => {
+            const key = generateRandomBytes(32);
+            const aad = new TextEncoder().encode('page-7');
+            const plaintext = generateRandomBytes(4096);
+            const sealed = new Uint8Array(4096 + 16);
+            const nonce = new Uint8Array(12);
+
+            encryptChaCha20Poly1305Into(plaintext, key, aad, sealed, nonce);
+
+            expect(nonce).not.toEqual(new Uint8Array(12));
+            expect(decryptChaCha20Poly1305({ ciphertext: sealed, nonce }, key, aad)).toEqual(plaintext);
+        });
+
+        it('decryptInto recovers the allocating API output', () => {
+            const key = generateRandomBytes(32);
+            const aad = new TextEncoder().encode('page-7');
+            const plaintext = generateRandomBytes(4096);
+            const encrypted = encryptChaCha20Poly1305(plaintext, key, aad);
+            const out = new Uint8Array(4096);
+
+            decryptChaCha20Poly1305Into(encrypted.ciphertext, key, encrypted.nonce, aad, out);
+
+            expect(out).toEqual(plaintext);
+        });
+
+        it('decryptInto rejects a tampered tag without writing the output', () => {
+            const key = generateRandomBytes(32);
+            const aad = new TextEncoder().encode('page-7');
+            const encrypted = encryptChaCha20Poly1305(generateRandomBytes(64), key, aad);
+            encrypted.ciphertext[encrypted.ciphertext.length - 1] ^= 0x01;
+            const out = new Uint8Array(64);
+
+            expect(() =>
+                decryptChaCha20Poly1305Into(encrypted.ciphertext, key, encrypted.nonce, aad, out)
+            ).toThrow();
+            expect(out).toEqual(new Uint8Array(64));
+        });
+
+        it('rejects output buffers of the wrong length', () => {
+            const key = generateRandomBytes(32);
+            const aad = new Uint8Array(0);
+            expect(() =>
+                encryptChaCha20Poly1305Into(new Uint8Array(32), key, aad, new Uint8Array(32), new Uint8Array(12))
+            ).toThrow(/Invalid output length/);
+            expect(() =>
+                decryptChaCha20Poly1305Into(new Uint8Array(48), key, new Uint8Array(12), aad, new Uint8Array(48))
+            ).toThrow(/Invalid output length/);
+        });
+    });
 });
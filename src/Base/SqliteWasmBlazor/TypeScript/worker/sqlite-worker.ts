@@ -8,14 +8,25 @@
 // that AddSqliteWasmBlazorCrypto()'s DI extension points the bridge at.
 
 import sqlite3InitModule from '@sqlite.org/sqlite-wasm';
-import { pack, unpack } from 'msgpackr';
+import { unpack } from 'msgpackr';
 import {
     logger,
     registerEFCoreFunctions,
-    openDatabases, pragmasSet, schemaCache,
+    openDatabases, pragmasSet,
     MODULE_NAME, bigIntUnpackr,
     setSqlite3, setPoolUtil, setBaseHref,
     bulkInsertRows, type BulkInsertHeader,
+    executeSql, executeBatch, runDeferredBegin, fetchCursor, closeCursor, finalizeDatabaseStatements,
+    setStatementCacheCapacity, getStatementCache,
+    attachSyncChannel, completeSyncRequest, decodeRequest, type ParameterBlock,
+    openBlob, readBlob, writeBlob, closeBlob,
+    backupDatabase,
+    openExportStream, readExportStream, closeExportStream,
+    openImportStream, writeImportStream, finishImportStream, abortImportStream, sweepStreamFiles,
+    deflateConcurrency, deflateExportStream, installZipHelper,
+    isSnapshotReader, assertSnapshotReadable, loadSnapshot, dropSnapshots, snapshotDatabase, attachSnapshotPorts,
+    scheduleRequest, requestPriority, cancelRequest, attachInterruptBuffer, installInterruptHandler,
+    RequestTimer, type RequestTiming,
 } from '@sqlitewasmblazor/worker-common';
 
 // Re-export mutable state references for local use
@@ -33,10 +44,15 @@ interface WorkerRequest {
         type: string;
         database?: string;
         sql?: string;
-        parameters?: Record<string, any>;
+        /** ParameterBlock for encoded requests (request-codec.ts). */
+        parameters?: Record<string, any> | ParameterBlock;
     };
     binaryPayload?: ArrayBuffer;
     binaryHeader?: ArrayBuffer;
+    /** Response goes to the shared sync channel instead of postMessage. */
+    sync?: boolean;
+    /** Scheduling class (request-scheduler.ts); encoded requests carry it. */
+    priority?: number;
 }
 
 interface WorkerResponse {
@@ -53,33 +69,7 @@ interface WorkerResponse {
         rowsAffected?: number;
         lastInsertId?: number;
     };
-}
-
-// Helper function to convert BigInt and Uint8Array for JSON serialization
-// BigInts within safe integer range (±2^53-1) are converted to number for efficiency
-// Larger BigInts are converted to string to preserve precision
-// Uint8Arrays are converted to Base64 strings (matches .NET 6+ JSInterop convention)
-// Convert BigInt values for MessagePack serialization
-// MessagePack natively handles Uint8Array, so no Base64 conversion needed
-function convertBigInt(value: any): any {
-    if (typeof value === 'bigint') {
-        // Check if BigInt fits in JavaScript's safe integer range
-        if (value >= Number.MIN_SAFE_INTEGER && value <= Number.MAX_SAFE_INTEGER) {
-            return Number(value);  // Convert to number for efficiency
-        }
-        return value.toString();  // Convert to string to preserve precision
-    }
-    if (Array.isArray(value)) {
-        return value.map(convertBigInt);
-    }
-    if (value && typeof value === 'object' && !(value instanceof Uint8Array)) {
-        const converted: any = {};
-        for (const key in value) {
-            converted[key] = convertBigInt(value[key]);
-        }
-        return converted;
-    }
-    return value;
+    timing?: RequestTiming;
 }
 
 // Initialize sqlite-wasm with OPFS SAHPool
@@ -135,6 +125,14 @@ async function initializeSQLite() {
             logger.debug(MODULE_NAME, 'OPFS VFS auto-installed, but we use SAHPool VFS instead');
         }
 
+        // A snapshot reader (read-snapshot.ts) only holds in-memory copies
+        // and must not claim the SAH pool, which belongs to the owning worker.
+        if (isSnapshotReader()) {
+            self.postMessage({ type: 'ready' });
+            logger.info(MODULE_NAME, 'Ready (snapshot reader)');
+            return;
+        }
+
         // Install vendor OPFS SAHPool VFS (plane 1 — no encryption).
         // Plane-2's worker bundle (SqliteWasmBlazor.Crypto) ships a forked
         // installer that adds per-page ChaCha20-Poly1305 encryption when a
@@ -159,6 +157,9 @@ async function initializeSQLite() {
         // Grow pool if previously created with smaller capacity (initialCapacity only applies on first creation)
         await poolUtil.reserveMinimumCapacity(25);
 
+        // Temporary export / import files of a page closed mid-transfer
+        sweepStreamFiles();
+
         logger.info(MODULE_NAME, 'OPFS SAHPool VFS installed successfully');
         logger.debug(MODULE_NAME, 'Available VFS:', sqlite3.capi.sqlite3_vfs_find(null));
 
@@ -174,14 +175,37 @@ async function initializeSQLite() {
     }
 }
 
+type WorkerMessage = WorkerRequest | { encoded: ArrayBuffer } | { type: 'setLogLevel'; level: number } | { type: 'cancel'; requestId: number } | { type: 'attachSnapshotPorts'; ports: MessagePort[] } | { type: 'init'; baseHref: string; assetRoot?: string; options?: { statementCacheSize?: number }; syncBuffer?: SharedArrayBuffer; interruptBuffer?: SharedArrayBuffer; snapshotPort?: MessagePort };
+
 // Handle messages from main thread
-self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel'; level: number } | { type: 'init'; baseHref: string; assetRoot?: string }>) => {
+self.onmessage = async (event: MessageEvent<string | WorkerMessage>) => {
+    // Requests arrive as the JSON text C# serialized (parsed here, off the
+    // main thread) or, for command execution, binary-encoded
+    // (request-codec.ts); init / setLogLevel / binary sends arrive as objects.
+    const message: WorkerMessage = typeof event.data === 'string'
+        ? JSON.parse(event.data)
+        : 'encoded' in event.data ? decodeRequest(event.data.encoded) : event.data;
+
     // Handle initialization with base href and asset root
-    if ('type' in event.data && event.data.type === 'init' && 'baseHref' in event.data) {
-        baseHref = event.data.baseHref;
+    if ('type' in message && message.type === 'init' && 'baseHref' in message) {
+        baseHref = message.baseHref;
         setBaseHref(baseHref);
-        if (event.data.assetRoot) {
-            assetRoot = event.data.assetRoot;
+        if (message.assetRoot) {
+            assetRoot = message.assetRoot;
+        }
+        if (typeof message.options?.statementCacheSize === 'number') {
+            setStatementCacheCapacity(message.options.statementCacheSize);
+        }
+        if (message.syncBuffer) {
+            attachSyncChannel(message.syncBuffer);
+        }
+        if (message.interruptBuffer) {
+            attachInterruptBuffer(message.interruptBuffer);
+        }
+        if (message.snapshotPort) {
+            // Snapshot reader: the owning worker posts 'loadSnapshot'
+            // requests on this port (read-snapshot.ts)
+            message.snapshotPort.onmessage = event => self.onmessage?.(event);
         }
         // Start initialization after receiving base href
         await initializeSQLite();
@@ -189,33 +213,91 @@ self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel
     }
 
     // Handle log level changes (no response needed)
-    if ('type' in event.data && event.data.type === 'setLogLevel' && 'level' in event.data) {
-        logger.setLogLevel(event.data.level);
+    if ('type' in message && message.type === 'setLogLevel' && 'level' in message) {
+        logger.setLogLevel(message.level);
         return;
     }
 
-    // Handle regular requests
-    const { id, data, binaryPayload, binaryHeader } = event.data as WorkerRequest;
+    // Cancellation from the bridge: drops the request if still queued (a
+    // running one is interrupted through the interrupt buffer)
+    if ('type' in message && message.type === 'cancel' && 'requestId' in message) {
+        cancelRequest(message.requestId);
+        return;
+    }
+
+    // The owning worker's ends of the readers' snapshot channels
+    if ('type' in message && message.type === 'attachSnapshotPorts' && 'ports' in message) {
+        attachSnapshotPorts(message.ports);
+        return;
+    }
+
+    // Regular requests are queued by priority (request-scheduler.ts)
+    const request = message as WorkerRequest;
+    scheduleRequest(
+        request.id,
+        request.data?.type ?? 'unknown',
+        requestPriority(request.data?.type, request.priority),
+        timer => processRequest(request, timer),
+        timer => respondCancelled(request, timer));
+};
+
+function respondCancelled(request: WorkerRequest, timer: RequestTimer): void {
+    const error = `Request ${request.id} was cancelled`;
+    if (request.sync) {
+        completeSyncRequest(undefined, error);
+    } else {
+        self.postMessage({ id: request.id, data: { success: false, error }, timing: timer.finish() });
+    }
+}
+
+// Responses carry the request's worker-side phases as `timing`
+// (RequestTimer); sync responses go through the channel without them.
+async function processRequest(request: WorkerRequest, timer: RequestTimer): Promise<void> {
+    const { id, data, binaryPayload, binaryHeader, sync } = request;
+
+    // The .NET thread is blocked in the bridge's sendToWorkerSync — answer
+    // through the shared channel; a postMessage would never be read.
+    if (sync) {
+        try {
+            completeSyncRequest(await handleRequest(data, binaryPayload, binaryHeader));
+        } catch (error) {
+            completeSyncRequest(undefined, error instanceof Error ? error.message : 'Unknown error');
+        }
+        return;
+    }
 
     try {
         const result = await handleRequest(data, binaryPayload, binaryHeader);
+        timer.executed();
 
         // Check if result contains raw binary data (export operations)
         if (result && typeof result === 'object' && 'rawBinary' in result && result.rawBinary) {
             const binaryData = result.data as Uint8Array;
+            // closedDatabase: an export that had to close the DB names it,
+            // so the bridge drops it from its open-database mirror.
             self.postMessage({
                 id,
                 rawBinary: true,
-                data: binaryData
+                data: binaryData,
+                closedDatabase: (result as any).closedDatabase,
+                timing: timer.finish()
             }, [binaryData.buffer]);
         }
-        // Check if result is MessagePack binary (Uint8Array)
+        // Check if result is columnar binary (Uint8Array). Transferred, not
+        // cloned: a multi-MB result must not be copied on its way to the
+        // main thread. ColumnarResultBuilder.finish() returns a view over
+        // its own buffer; anything narrower is sliced first so a shared
+        // buffer is never detached.
         else if (result instanceof Uint8Array) {
+            const payload = result.byteOffset === 0 && result.byteLength === result.buffer.byteLength
+                ? result
+                : result.slice();
             self.postMessage({
                 id,
                 binary: true,
-                data: result
-            });
+                data: payload,
+                timing: timer.finish()
+            }, [payload.buffer]);
         } else {
             // JSON response for non-execute operations
             const response: WorkerResponse = {
@@ -223,7 +305,8 @@ self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel
                 data: {
                     success: true,
                     ...result
-                }
+                },
+                timing: timer.finish()
             };
             self.postMessage(response);
         }
@@ -233,12 +316,13 @@ self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel
             data: {
                 success: false,
                 error: error instanceof Error ? error.message : 'Unknown error'
-            }
+            },
+            timing: timer.finish()
         };
 
         self.postMessage(response);
     }
-};
+}
 
 async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayBuffer, binaryHeader?: ArrayBuffer) {
     const { type, database, sql, parameters } = data;
@@ -262,13 +346,66 @@ async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayB
             // { __blobOffset, __blobLength } placeholders pointing into the
             // attached buffer instead of Base64 strings in the JSON.
             // convertParametersForBinding reads bytes from binaryPayload.
+            // batchSize > 0 asks for a cursor: first batch now, the rest
+            // via 'fetch' (read-only statements only). `begin` opens a
+            // lazily started transaction first. `deferBlobs` leaves large
+            // BLOBs in the database for SqliteWasmBlob (blob-ops.ts).
+            if (isSnapshotReader()) {
+                assertSnapshotReadable(database!, sql!);
+            }
+            runDeferredBegin(database!, (data as any).begin);
             return await executeSql(
                 database!, sql!, parameters || {},
-                binaryPayload ? new Uint8Array(binaryPayload) : undefined);
+                binaryPayload ? new Uint8Array(binaryPayload) : undefined,
+                (data as any).batchSize ?? 0,
+                (data as any).deferBlobs === true);
+
+        case 'executeBatch':
+            // Ordered (sql, parameters) list → one framed response. Each
+            // command's blobs are a slice of the shared binary attachment.
+            // `atomic` batches (EF Core SaveChanges) run under a savepoint.
+            runDeferredBegin(database!, (data as any).begin);
+            return executeBatch(
+                database!, (data as any).commands ?? [],
+                binaryPayload ? new Uint8Array(binaryPayload) : undefined,
+                (data as any).atomic === true);
+
+        case 'fetch':
+            return fetchCursor((data as any).cursorId, (data as any).batchSize);
+
+        case 'closeCursor':
+            closeCursor((data as any).cursorId);
+            return { success: true };
+
+        case 'blobOpen': {
+            // Handle and length travel as rowsAffected / lastInsertId, so
+            // the bridge answers with a control response (no JSON).
+            const blob = openBlob(
+                database!, (data as any).schema ?? 'main', (data as any).table, (data as any).column,
+                (data as any).rowid, (data as any).writable === true);
+            return { rowsAffected: blob.handle, lastInsertId: blob.length };
+        }
+
+        case 'blobRead':
+            return { rawBinary: true, data: readBlob((data as any).handle, (data as any).offset, (data as any).count) };
+
+        case 'blobWrite':
+            if (!binaryPayload) {
+                throw new Error('blobWrite requires binaryPayload');
+            }
+            writeBlob((data as any).handle, (data as any).offset, new Uint8Array(binaryPayload));
+            return { success: true };
+
+        case 'blobClose':
+            closeBlob((data as any).handle);
+            return { success: true };
 
         case 'close':
             return await closeDatabase(database!);
 
+        case 'statementCacheStats':
+            return { statementCache: getStatementCache(database!).stats() };
+
         case 'exists':
             return await checkDatabaseExists(database!);
 
@@ -289,8 +426,8 @@ async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayB
               );
 
           case 'exportDb': {
-            // Plane 1 only handles VERBATIM export — raw OPFS bytes
-            // (page-level mirror of whatever's on disk, plain or opaque).
+            // Plane 1 only handles VERBATIM export — the plain database
+            // image (online backup of an open DB, raw OPFS bytes otherwise).
             // Plane 2 (SqliteWasmBlazor.Crypto) ships the rekey/encrypt
             // modes that require a VfsKeyHeader payload.
             const mode = (data as any).mode as 'verbatim' | 'plain' | 'rekey' | 'encrypt';
@@ -302,6 +439,94 @@ async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayB
             return await exportDatabase(database!, mode);
         }
 
+        case 'exportStreamOpen':
+            // Stream overload of ExportDatabaseAsync: snapshot once, then
+            // the bridge pulls ranges with 'exportStreamRead' (stream-ops.ts).
+            // Session and length travel as rowsAffected / lastInsertId.
+            return await openDatabaseExportStream(database!);
+
+        case 'exportStreamRead':
+            return {
+                rawBinary: true,
+                data: readExportStream((data as any).session, (data as any).offset, (data as any).count),
+            };
+
+        case 'exportStreamClose':
+            closeExportStream((data as any).session);
+            return { success: true };
+
+        case 'importStreamOpen': {
+            // Same rules as importDb: ciphertext (opaque) never overwrites
+            // an existing DB. Chunks follow with 'importStreamWrite' and go
+            // to a temporary file; the DB stays open and intact until
+            // 'importStreamFinish'. Session and outcome code travel as
+            // rowsAffected / lastInsertId.
+            const opaque = (data as any).opaque === true;
+            if (opaque && poolUtil.getFileNames().includes(`/databases/${database}`)) {
+                logger.warn(MODULE_NAME, `Refused opaque import of ${database}: existing DB; caller must wipe first`);
+                // VfsImportResult.EXISTING_DB_REFUSED = 2
+                return { rowsAffected: 0, lastInsertId: 2 };
+            }
+            return { rowsAffected: openImportStream(database!, opaque), lastInsertId: 0 };
+        }
+
+        case 'importStreamWrite':
+            if (!binaryPayload) {
+                throw new Error('importStreamWrite requires binaryPayload');
+            }
+            await writeImportStream((data as any).session, new Uint8Array(binaryPayload));
+            return { success: true };
+
+        case 'importStreamFinish':
+            // The complete file replaces the DB, closed as for importDb
+            await closeDatabase(database!);
+            await finishImportStream((data as any).session);
+            // VfsImportResult.OK = 0
+            return { rowsAffected: 0 };
+
+        case 'importStreamAbort':
+            await abortImportStream((data as any).session);
+            return { success: true };
+
+        case 'snapshotDatabase':
+            // Online copy posted straight to the bridge's snapshot readers
+            // (read-snapshot.ts); reports how many it went to
+            return {
+                readers: await snapshotDatabase(database!, (data as any).loads ?? [], (data as any).maxBytes ?? 0)
+            };
+
+        case 'loadSnapshot':
+            // Snapshot reader: replace its in-memory copy of `database`.
+            // Arrives on the snapshot port, answered to the bridge.
+            if (!binaryPayload) {
+                throw new Error('loadSnapshot requires binaryPayload');
+            }
+            loadSnapshot(database!, new Uint8Array(binaryPayload));
+            return { success: true };
+
+        case 'dropSnapshots':
+            dropSnapshots();
+            return { success: true };
+
+        case 'deflateConcurrency':
+            // ExportAllDatabasesAsync: entries to compress at once, 0 when
+            // the bridge has to deflate in .NET (zip-ops.ts).
+            return { rowsAffected: deflateConcurrency() };
+
+        case 'exportDeflatedOpen': {
+            // One ZIP entry: snapshot as for 'exportStreamOpen', deflate it
+            // on a compression helper, and return the compressed bytes as
+            // an export stream the bridge reads with 'exportStreamRead'.
+            const source = await openDatabaseExportStream(database!);
+            const entry = await deflateExportStream(database!, source.rowsAffected, source.lastInsertId);
+            return {
+                rowsAffected: entry.session,
+                lastInsertId: entry.length,
+                crc32: entry.crc32,
+                uncompressedLength: entry.uncompressedLength,
+            };
+        }
+
         case 'importRows':
             if (!binaryPayload) {
                 throw new Error('importRows requires binaryPayload (MessagePack)');
@@ -350,6 +575,7 @@ async function openDatabase(dbName: string) {
 
             db = await Promise.race([openPromise, timeoutPromise]);
             openDatabases.set(dbName, db);
+            installInterruptHandler(db);
             logger.info(
                 MODULE_NAME,
                 `✓ Opened database: ${dbName} with OPFS SAHPool${hasGlobalKey() ? ' (encrypted)' : ''}`
@@ -411,245 +637,11 @@ async function openDatabase(dbName: string) {
     return { success: true };
 }
 
-// Get schema info for a table by querying PRAGMA table_info
-// Cache key includes database name to prevent collisions when multiple databases
-// have tables with the same name but different schemas
-function getTableSchema(db: any, dbName: string, tableName: string): Map<string, string> {
-    const cacheKey = `${dbName}:${tableName}`;
-    if (schemaCache.has(cacheKey)) {
-        return schemaCache.get(cacheKey)!;
-    }
-
-    const schema = new Map<string, string>();
-    try {
-        // Query PRAGMA table_info to get column types
-        const result = db.exec({
-            sql: `PRAGMA table_info("${tableName}")`,
-            returnValue: 'resultRows',
-            rowMode: 'array'
-        });
-
-        // PRAGMA table_info returns: [cid, name, type, notnull, dflt_value, pk]
-        for (const row of result) {
-            const columnName = row[1] as string;  // name
-            const columnType = row[2] as string;  // type
-            schema.set(columnName, columnType.toUpperCase());
-        }
-
-        schemaCache.set(cacheKey, schema);
-    } catch (error) {
-        logger.warn(MODULE_NAME, `Failed to load schema for table ${tableName}:`, error);
-    }
-
-    return schema;
-}
-
-// Extract table name from SELECT statement (simple heuristic)
-function extractTableName(sql: string): string | null {
-    // Match: SELECT ... FROM "tableName" or FROM tableName
-    const match = sql.match(/FROM\s+["']?(\w+)["']?/i);
-    return match ? match[1] : null;
-}
-
-/**
- * Converts parameters with type metadata for proper SQLite binding
- * Expects parameters in format: { value: any, type: "blob" | "text" | "integer" | "real" | "null" }
- */
-function convertParametersForBinding(
-    parameters: Record<string, any>,
-    binaryPayload?: Uint8Array,
-): Record<string, any> {
-    const converted: Record<string, any> = {};
-
-    for (const [key, paramData] of Object.entries(parameters)) {
-        // Handle new format with type metadata
-        if (paramData && typeof paramData === 'object' && 'value' in paramData && 'type' in paramData) {
-            const { value, type } = paramData;
-
-            if (value === null || value === undefined) {
-                converted[key] = null;
-                logger.debug(MODULE_NAME, `[PARAM] ${key}: null`);
-            }
-            else if (type === 'blob' && binaryPayload && value && typeof value === 'object'
-                     && typeof value.__blobOffset === 'number' && typeof value.__blobLength === 'number') {
-                // Blob bytes carried in the binary attachment, not Base64.
-                // Slice (not subarray-view-passthrough) so SQLite binding owns
-                // an independent buffer — binaryPayload's underlying ArrayBuffer
-                // may be reused on the next request.
-                const offset = value.__blobOffset;
-                const length = value.__blobLength;
-                const bytes = new Uint8Array(length);
-                bytes.set(binaryPayload.subarray(offset, offset + length));
-                converted[key] = bytes;
-                logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${length} bytes from binary attachment @ ${offset})`);
-            }
-            else if (type === 'blob' && typeof value === 'string') {
-                // Legacy fallback — Base64-encoded blob in the JSON message.
-                try {
-                    const binaryString = atob(value);
-                    const bytes = new Uint8Array(binaryString.length);
-                    for (let i = 0; i < binaryString.length; i++) {
-                        bytes[i] = binaryString.charCodeAt(i);
-                    }
-                    converted[key] = bytes;
-                    logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${bytes.length} bytes from base64)`);
-                } catch (e) {
-                    logger.error(MODULE_NAME, `[PARAM] Failed to decode blob ${key}:`, e);
-                    converted[key] = value;
-                }
-            }
-            else {
-                // For text, integer, real - use value as-is
-                converted[key] = value;
-                logger.debug(MODULE_NAME, `[PARAM] ${key}: ${type} = ${typeof value === 'string' && value.length > 50 ? value.substring(0, 50) + '...' : value}`);
-            }
-        }
-        else {
-            // Fallback for old format (backwards compatibility)
-            logger.warn(MODULE_NAME, `[PARAM] ${key}: using legacy format (no type metadata)`);
-            converted[key] = paramData;
-        }
-    }
-
-    return converted;
-}
-
-async function executeSql(
-    dbName: string, sql: string,
-    parameters: Record<string, any>,
-    binaryPayload?: Uint8Array,
-) {
-    const db = openDatabases.get(dbName);
-    if (!db) {
-        throw new Error(`Database ${dbName} not open`);
-    }
-
-    try {
-        logger.debug(MODULE_NAME, 'Executing SQL:', sql.substring(0, 100));
-
-        // Convert parameters with type metadata for proper SQLite binding.
-        // binaryPayload (if present) carries blob param bytes — see
-        // convertParametersForBinding for the __blobOffset/__blobLength
-        // placeholder shape.
-        const convertedParams = convertParametersForBinding(parameters, binaryPayload);
-
-        // Execute SQL - use returnValue to get the result
-        const result = db.exec({
-            sql: sql,
-            bind: Object.keys(convertedParams).length > 0 ? convertedParams : undefined,
-            returnValue: 'resultRows',
-            rowMode: 'array'
-        });
-
-        logger.debug(MODULE_NAME, 'SQL executed successfully, rows:', result?.length || 0);
-
-        // Extract column metadata if there are results
-        let columnNames: string[] = [];
-        let columnTypes: string[] = [];
-
-        if (result && result.length > 0) {
-            const stmt = db.prepare(sql);
-            try {
-                const colCount = stmt.columnCount;
-
-                // Try to get schema from table (for SELECT queries)
-                let tableSchema: Map<string, string> | null = null;
-                if (sql.trim().toUpperCase().startsWith('SELECT')) {
-                    const tableName = extractTableName(sql);
-                    if (tableName) {
-                        tableSchema = getTableSchema(db, dbName, tableName);
-                    }
-                }
-
-                for (let i = 0; i < colCount; i++) {
-                    const colName = stmt.getColumnName(i);
-                    columnNames.push(colName);
-
-                    // Use declared type from schema if available
-                    let declaredType = tableSchema?.get(colName);
-
-                    // Normalize declared type to SQLite affinity
-                    let inferredType = 'TEXT';
-                    if (declaredType) {
-                        const typeUpper = declaredType.toUpperCase();
-                        if (typeUpper.includes('INT')) {
-                            inferredType = 'INTEGER';
-                        } else if (typeUpper.includes('REAL') || typeUpper.includes('DOUBLE') || typeUpper.includes('FLOAT')) {
-                            inferredType = 'REAL';
-                        } else if (typeUpper.includes('BLOB')) {
-                            inferredType = 'BLOB';
-                        } else {
-                            inferredType = 'TEXT';
-                        }
-                    } else if (result.length > 0 && result[0][i] !== null) {
-                        // Fallback to value-based inference if no schema available
-                        const value = result[0][i];
-
-                        if (typeof value === 'number') {
-                            inferredType = Number.isInteger(value) ? 'INTEGER' : 'REAL';
-                        } else if (typeof value === 'bigint') {
-                            inferredType = 'INTEGER';
-                        } else if (typeof value === 'boolean') {
-                            inferredType = 'INTEGER';
-                        } else if (value instanceof Uint8Array || ArrayBuffer.isView(value)) {
-                            inferredType = 'BLOB';
-                        }
-                    }
-                    columnTypes.push(inferredType);
-                }
-            } finally {
-                stmt.finalize();
-            }
-        }
-
-        // Get changes and last insert ID for non-SELECT queries
-        let rowsAffected = 0;
-        let lastInsertId = 0;
-
-        if (sql.trim().toUpperCase().startsWith('INSERT') ||
-            sql.trim().toUpperCase().startsWith('UPDATE') ||
-            sql.trim().toUpperCase().startsWith('DELETE') ||
-            sql.trim().toUpperCase().startsWith('CREATE')) {
-
-            // Check if statement has RETURNING clause
-            // When RETURNING is used, db.changes() doesn't work correctly because
-            // SQLite treats it as a SELECT-like operation
-            const hasReturning = sql.toUpperCase().includes('RETURNING');
-
-            if (hasReturning && result && result.length > 0) {
-                // For UPDATE/DELETE with RETURNING, the presence of a result row means success
-                rowsAffected = result.length;
-            }
-            else {
-                // For INSERT without RETURNING, or any statement without RETURNING
-                rowsAffected = db.changes();
-            }
-
-            lastInsertId = db.lastInsertRowId;
-        }
-
-        const response = {
-            columnNames,
-            columnTypes,
-            typedRows: {
-                types: columnTypes,
-                data: convertBigInt(result || [])
-            },
-            rowsAffected,
-            lastInsertId: Number(lastInsertId)
-        };
-
-        return pack(response);
-    } catch (error) {
-        logger.error(MODULE_NAME, 'SQL execution failed:', error);
-        logger.error(MODULE_NAME, 'SQL:', sql);
-        throw error;
-    }
-}
-
 async function closeDatabase(dbName: string) {
     const db = openDatabases.get(dbName);
     if (db) {
+        // Open cursors and cached statements pin the connection — finalize before close.
+        finalizeDatabaseStatements(dbName);
         db.close();
         openDatabases.delete(dbName);
         pragmasSet.delete(dbName); // Clear PRAGMA tracking when database is closed
@@ -858,9 +850,12 @@ async function importDatabase(dbName: string, data: Uint8Array, opaque = false)
 function hasGlobalKey(): boolean { return false; }
 
 /**
- * Plane-1 verbatim export — copies raw OPFS bytes to a Uint8Array and
- * returns them. No mode-aware logic (rekey / encrypt require plane 2's
- * vfs-prf). Always closes the DB first for a consistent SAH snapshot.
+ * Plane-1 verbatim export. No mode-aware logic (rekey / encrypt require
+ * plane 2's vfs-prf). An open DB is copied with an online backup
+ * (backupDatabase) that yields between page steps, so the connection and
+ * its PRAGMA state survive and queries keep running during the export.
+ * A DB that isn't open has no pending WAL, so its raw OPFS bytes are
+ * already a consistent snapshot.
  */
 async function exportDatabase(
     dbName: string,
@@ -869,13 +864,36 @@ async function exportDatabase(
     if (!sqlite3 || !poolUtil) {
         throw new Error("SQLite not initialized");
     }
+    if (openDatabases.has(dbName)) {
+        const image = await backupDatabase(dbName);
+        logger.info(MODULE_NAME, `✓ Exported verbatim ${dbName} online: ${image.length}B`);
+        return { rawBinary: true, data: image };
+    }
     const dbPath = `/databases/${dbName}`;
-    await closeDatabase(dbName);
     const raw: Uint8Array = poolUtil.exportFile(dbPath);
     logger.info(MODULE_NAME, `✓ Exported verbatim ${dbName}: ${raw.length}B`);
     return { rawBinary: true, data: raw };
 }
 
+/**
+ * Open an export stream (stream-ops.ts) over an online copy of `dbName`.
+ * A database that isn't open is opened first — the copy needs a
+ * connection — and stays open afterwards.
+ */
+async function openDatabaseExportStream(dbName: string) {
+    if (!sqlite3 || !poolUtil) {
+        throw new Error("SQLite not initialized");
+    }
+    if (!openDatabases.has(dbName)) {
+        if (!poolUtil.getFileNames().includes(`/databases/${dbName}`)) {
+            throw new Error(`Database ${dbName} not found`);
+        }
+        await openDatabase(dbName);
+    }
+    const stream = await openExportStream(dbName);
+    return { rowsAffected: stream.session, lastInsertId: stream.length };
+}
+
 /**
  * Plain (non-encrypted) row import from V2 MessagePack payload.
  * Used for seeding, initial data load, test-data generation.
@@ -911,3 +929,7 @@ function importRows(dbName: string, payload: Uint8Array, metadata: any) {
 // - crypto-permissions.ts: Admin + ShareTarget + permission-table verify + role resolution
 // - crypto-header.ts: CryptoHeader parse/clear + CEK unwrap + binary helpers + schema fingerprint
 // - type-conversion.ts: MessagePack ↔ SQLite value conversion
+
+// ZIP compression helpers are started from this same bundle (zip-ops.ts);
+// in a helper, this replaces the SQL message handler above.
+installZipHelper();
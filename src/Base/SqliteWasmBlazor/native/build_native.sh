@@ -0,0 +1,83 @@
+#!/bin/bash
+# Build the real SQLite engine for in-process use in the .NET WASM module
+# (opt-in alternative to the stub, see SqliteWasmNativeEngine in the csproj)
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+OUTPUT_DIR="${SCRIPT_DIR}/lib"
+BUILD_DIR="${SCRIPT_DIR}/obj"
+
+# Keep in step with the sqlite-wasm build the worker ships (3.53.0)
+SQLITE_VERSION="${SQLITE_VERSION:-3530000}"
+SQLITE_YEAR="${SQLITE_YEAR:-2026}"
+SQLITE_AMALGAMATION_DIR="${SQLITE_AMALGAMATION_DIR:-${BUILD_DIR}/sqlite-amalgamation-${SQLITE_VERSION}}"
+
+echo "========================================="
+echo "Native SQLite Engine Build"
+echo "========================================="
+echo ""
+
+# Needs emcc on PATH (e.g., from GitHub Actions or an activated emsdk),
+# or EMSDK pointing at an emsdk checkout to activate
+if ! command -v emcc &> /dev/null; then
+    if [ -n "${EMSDK}" ] && [ -f "${EMSDK}/emsdk_env.sh" ]; then
+        source "${EMSDK}/emsdk_env.sh" > /dev/null 2>&1
+    fi
+    if ! command -v emcc &> /dev/null; then
+        echo "ERROR: Emscripten not found. Put emcc on PATH or set EMSDK to your emsdk directory"
+        exit 1
+    fi
+fi
+
+mkdir -p "${OUTPUT_DIR}" "${BUILD_DIR}"
+
+# Fetch the amalgamation unless a local copy was supplied
+if [ ! -f "${SQLITE_AMALGAMATION_DIR}/sqlite3.c" ]; then
+    ZIP="${BUILD_DIR}/sqlite-amalgamation-${SQLITE_VERSION}.zip"
+    echo "Downloading SQLite amalgamation ${SQLITE_VERSION}..."
+    curl -fsSL -o "${ZIP}" "https://www.sqlite.org/${SQLITE_YEAR}/sqlite-amalgamation-${SQLITE_VERSION}.zip"
+    unzip -q -o "${ZIP}" -d "${BUILD_DIR}"
+fi
+
+# Single-threaded runtime, no extension loading. The default unix VFS runs
+# on the runtime's in-memory Emscripten FS, so databases are ephemeral.
+# Feature flags follow SQLitePCLRaw's e_sqlite3 so Microsoft.Data.Sqlite
+# sees the surface it expects.
+echo "Compiling sqlite3.c..."
+emcc -O3 \
+    -DSQLITE_THREADSAFE=0 \
+    -DSQLITE_OMIT_LOAD_EXTENSION \
+    -DSQLITE_DEFAULT_MEMSTATUS=0 \
+    -DSQLITE_DEFAULT_FOREIGN_KEYS=1 \
+    -DSQLITE_ENABLE_COLUMN_METADATA \
+    -DSQLITE_ENABLE_FTS4 \
+    -DSQLITE_ENABLE_FTS5 \
+    -DSQLITE_ENABLE_MATH_FUNCTIONS \
+    -DSQLITE_ENABLE_RTREE \
+    -DSQLITE_ENABLE_SNAPSHOT \
+    -DSQLITE_USE_URI=1 \
+    -c "${SQLITE_AMALGAMATION_DIR}/sqlite3.c" \
+    -o "${BUILD_DIR}/sqlite3.o"
+
+# Create static library
+echo "Creating library..."
+rm -f "${OUTPUT_DIR}/e_sqlite3_native.a"
+emar rcs "${OUTPUT_DIR}/e_sqlite3_native.a" "${BUILD_DIR}/sqlite3.o"
+
+# Check result
+if [ -f "${OUTPUT_DIR}/e_sqlite3_native.a" ]; then
+    SIZE=$(du -h "${OUTPUT_DIR}/e_sqlite3_native.a" | cut -f1)
+    echo ""
+    echo "✓ Build successful!"
+    echo ""
+    echo "Output: ${OUTPUT_DIR}/e_sqlite3_native.a"
+    echo "Size:   ${SIZE}"
+    echo ""
+    echo "Link it with <SqliteWasmNativeEngine>true</SqliteWasmNativeEngine>."
+    echo "Microsoft.Data.Sqlite then runs in-process; the worker is unaffected."
+    echo ""
+else
+    echo "ERROR: Build failed"
+    exit 1
+fi
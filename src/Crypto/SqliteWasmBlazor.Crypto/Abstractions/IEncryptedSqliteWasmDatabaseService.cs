@@ -116,6 +116,14 @@ public interface IEncryptedSqliteWasmDatabaseService
     /// succeeds or the disk stays Plain.
     ///
     /// <para>
+    /// Each database is converted in place a chunk of pages at a time, so
+    /// memory use does not grow with its size. A transition cut short by a
+    /// reload or crash leaves the disk Plain with the interrupted database
+    /// refusing to open; calling this method again with the same key
+    /// finishes it, passing over databases already encrypted.
+    /// </para>
+    ///
+    /// <para>
     /// Caller invariant: <see cref="GetStateAsync"/> must currently
     /// return <see cref="EncryptedDiskState.Plain"/>. Throws
     /// <see cref="InvalidOperationException"/> otherwise. The auth flow's
@@ -142,6 +150,12 @@ public interface IEncryptedSqliteWasmDatabaseService
     /// per-DB or batch-ZIP export.
     ///
     /// <para>
+    /// Like <see cref="EnterEncryptedAsync"/>, databases are converted in
+    /// place a chunk at a time; after an interruption the disk is still
+    /// Encrypted, and unlocking and calling this method again finishes it.
+    /// </para>
+    ///
+    /// <para>
     /// Caller invariant: must currently be Encrypted+Unlocked. Throws
     /// <see cref="InvalidOperationException"/> otherwise. Caller is
     /// separately responsible for revoking the passkey credential at the
@@ -15,4 +15,27 @@ public sealed class SqliteWasmBlazorCryptoOptions : SqliteWasmAssetOptions
         // crypto-bridge.js is plane-2-only, served from this package's _content.
         AssetRoot = "_content/SqliteWasmBlazor.Crypto/";
     }
+
+    /// <summary>
+    /// Memory cap in bytes of the worker's cache of decrypted pages, used
+    /// while the disk is unlocked. Repeated reads of a cached page, such as
+    /// the database header or hot interior B-tree pages, skip the
+    /// ChaCha20-Poly1305 decrypt. Cached plaintext is zeroed on eviction,
+    /// on writes to the page, and when the database closes or the key
+    /// changes. Defaults to 0 (no cache). 1–4 MB (1024 * 1024 and up)
+    /// covers the hot pages of typical databases. Applied at each unlock.
+    /// </summary>
+    public int PageCacheSize { get; set; }
+
+    /// <summary>
+    /// Number of crypto helper workers that whole-database operations on an
+    /// encrypted disk use to decrypt and re-encrypt pages in parallel:
+    /// entering and leaving encrypted mode, plain / rekey exports, and
+    /// rekeying imports. The SQLite worker takes a share too, so 3 uses four
+    /// cores. Needs a cross-origin-isolated page (SharedArrayBuffer); elsewhere
+    /// the operations stay single-threaded. Each helper holds a copy of the
+    /// key while it works. Databases under 16 MB are not split. Defaults to
+    /// 0 (off), capped at 8. Applied at each unlock and encrypt.
+    /// </summary>
+    public int CryptoWorkers { get; set; }
 }
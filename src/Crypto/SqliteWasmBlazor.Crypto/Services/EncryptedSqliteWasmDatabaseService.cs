@@ -5,8 +5,10 @@ using System.IO.Compression;
 using System.Runtime.InteropServices;
 using System.Security.Cryptography;
 using MessagePack;
+using Microsoft.Extensions.Options;
 using SqliteWasmBlazor.Crypto.Abstractions;
 using SqliteWasmBlazor.Crypto.Abstractions.Models;
+using SqliteWasmBlazor.Crypto.Configuration;
 using SqliteWasmBlazor.Crypto.Services;
 
 namespace SqliteWasmBlazor;
@@ -48,6 +50,8 @@ internal sealed class EncryptedSqliteWasmDatabaseService
     private readonly IDbInitializationStatus _status;
     private readonly IPrfService _prfService;
     private readonly ICryptoProvider _cryptoProvider;
+    private readonly int _pageCacheSize;
+    private readonly int _cryptoWorkers;
     private bool _isUnlocked;
 
     /// <summary>
@@ -64,7 +68,8 @@ internal sealed class EncryptedSqliteWasmDatabaseService
         IDbInitializationReporter reporter,
         IDbInitializationStatus status,
         IPrfService prfService,
-        ICryptoProvider cryptoProvider)
+        ICryptoProvider cryptoProvider,
+        IOptions<SqliteWasmBlazorCryptoOptions> cryptoOptions)
     {
         _bridge = SqliteWasmWorkerBridge.Instance;
         _encryptedBridge = EncryptedSqliteWasmWorkerBridge.Instance;
@@ -72,6 +77,8 @@ internal sealed class EncryptedSqliteWasmDatabaseService
         _status = status;
         _prfService = prfService;
         _cryptoProvider = cryptoProvider;
+        _pageCacheSize = cryptoOptions.Value.PageCacheSize;
+        _cryptoWorkers = cryptoOptions.Value.CryptoWorkers;
     }
 
     /// <summary>
@@ -288,7 +295,7 @@ internal sealed class EncryptedSqliteWasmDatabaseService
     {
         // Disk-as-unit: install globalKey in the worker and release the
         // bridge gate so DB ops route through the encrypted hot path.
-        await _encryptedBridge.SetEncryptionKeyAsync(key, cancellationToken);
+        await _encryptedBridge.SetEncryptionKeyAsync(key, _pageCacheSize, _cryptoWorkers, cancellationToken);
         _isUnlocked = true;
         _bridge.SetDiskLocked(false);
     }
@@ -378,22 +385,17 @@ internal sealed class EncryptedSqliteWasmDatabaseService
         }
 
         var databases = await _bridge.ListDatabasesAsync(cancellationToken);
-        var backups = new Dictionary<string, byte[]>(databases.Count, StringComparer.Ordinal);
         try
         {
-            // Phase 0: snapshot every plain DB so a later per-DB encrypt or
-            // manifest write failure can restore the whole pool to Plain.
-            foreach (var db in databases)
-            {
-                backups[db] = await _bridge.ExportDatabaseAsync(db, cancellationToken);
-            }
-
             // Phase 1: walk every plain DB in OPFS, encrypt-in-place under K.
             // EncryptDatabaseInPlaceAsync is per-DB; we iterate. The worker
             // closes each DB during the conversion, so OFile state can't leak.
+            // Progress lives in each DB's header sector: a run cut short by a
+            // reload resumes on the next call, which passes over the DBs this
+            // one finished.
             foreach (var db in databases)
             {
-                await _encryptedBridge.EncryptDatabaseInPlaceAsync(db, key, cancellationToken);
+                await _encryptedBridge.EncryptDatabaseInPlaceAsync(db, key, _cryptoWorkers, cancellationToken);
             }
 
             // Phase 2: install the global key. EnterEncrypted writes the
@@ -416,21 +418,14 @@ internal sealed class EncryptedSqliteWasmDatabaseService
         }
         catch
         {
-            await RollBackEnterEncryptedAsync(databases, backups, CancellationToken.None);
+            await RollBackEnterEncryptedAsync(databases, key, CancellationToken.None);
             throw;
         }
-        finally
-        {
-            foreach (var backup in backups.Values)
-            {
-                CryptographicOperations.ZeroMemory(backup);
-            }
-        }
     }
 
     private async Task RollBackEnterEncryptedAsync(
         IReadOnlyList<string> databases,
-        IReadOnlyDictionary<string, byte[]> backups,
+        ReadOnlyMemory<byte> key,
         CancellationToken cancellationToken)
     {
         await _encryptedBridge.ClearEncryptionKeyAsync(cancellationToken);
@@ -438,20 +433,22 @@ internal sealed class EncryptedSqliteWasmDatabaseService
         _expectedCredentialId = null;
         _bridge.SetDiskLocked(false);
 
+        // Decrypt in place under K: reverts the DB that failed partway and
+        // the ones already encrypted; untouched DBs are left as they are.
         foreach (var db in databases)
         {
-            await _bridge.DeleteDatabaseAsync(db, cancellationToken);
-        }
-
-        foreach (var (db, bytes) in backups)
-        {
-            var result = await _bridge.ImportDatabaseAsync(db, bytes, cancellationToken);
-            if (result != DiskImportResult.OK)
+            try
+            {
+                await _encryptedBridge.DecryptDatabaseInPlaceAsync(db, key, _cryptoWorkers, cancellationToken);
+            }
+            catch (Exception ex)
             {
                 throw new InvalidOperationException(
-                    $"EnterEncryptedAsync rollback failed while restoring '{db}' (result={result}).");
+                    $"EnterEncryptedAsync rollback failed while restoring '{db}'; " +
+                    "calling EnterEncryptedAsync again with the same key finishes encrypting it.", ex);
             }
         }
+        await _encryptedBridge.ClearDiskManifestAsync(cancellationToken);
     }
 
     public async Task LeaveEncryptedAsync(CancellationToken cancellationToken = default)
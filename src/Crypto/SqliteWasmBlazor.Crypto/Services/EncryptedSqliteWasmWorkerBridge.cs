@@ -49,12 +49,18 @@ internal sealed partial class EncryptedSqliteWasmWorkerBridge
     /// boundary — SQLite caches plaintext pages after first read; without the
     /// close, K_old plaintext could be served to a K_new session (or vice
     /// versa). The worker pass is authoritative; this bridge pre-pass keeps
-    /// the C# mirror consistent.
+    /// the C# mirror consistent. <paramref name="pageCacheSize"/> sizes the
+    /// VFS's own decrypted page cache, which the key swap wipes
+    /// (<see cref="Configuration.SqliteWasmBlazorCryptoOptions.PageCacheSize"/>);
+    /// <paramref name="cryptoWorkers"/> sizes the worker's crypto helper pool
+    /// (<see cref="Configuration.SqliteWasmBlazorCryptoOptions.CryptoWorkers"/>).
     /// NOT public — production callers go through
     /// <see cref="IEncryptedSqliteWasmDatabaseService.UnlockAsync"/>.
     /// </summary>
     internal async Task SetEncryptionKeyAsync(
         ReadOnlyMemory<byte> key,
+        int pageCacheSize = 0,
+        int cryptoWorkers = 0,
         CancellationToken cancellationToken = default)
     {
         if (key.Length != 32)
@@ -75,7 +81,12 @@ internal sealed partial class EncryptedSqliteWasmWorkerBridge
         try
         {
             await _bridge.PostBinaryAsync(
-                new { type = "setGlobalEncryptionKey" },
+                new
+                {
+                    type = "setGlobalEncryptionKey",
+                    pageCacheSize = Math.Max(0, pageCacheSize),
+                    cryptoWorkers = Math.Max(0, cryptoWorkers)
+                },
                 envelope,
                 cancellationToken);
         }
@@ -106,11 +117,62 @@ internal sealed partial class EncryptedSqliteWasmWorkerBridge
     /// Per-DB crypto primitive — internal only. Production callers go through
     /// <see cref="IEncryptedSqliteWasmDatabaseService.EnterEncryptedAsync"/>
     /// (which loops over <see cref="ISqliteWasmDatabaseService.ListDatabasesAsync"/>).
+    /// No key is installed yet at that point, so <paramref name="cryptoWorkers"/>
+    /// travels with this request as it does with <see cref="SetEncryptionKeyAsync"/>.
+    /// The worker converts the file a chunk at a time and resumes a run that
+    /// was interrupted; a file already encrypted under <paramref name="key"/>
+    /// is left as is.
     /// </summary>
     internal async Task EncryptDatabaseInPlaceAsync(
         string databaseName,
         ReadOnlyMemory<byte> key,
+        int cryptoWorkers = 0,
         CancellationToken cancellationToken = default)
+    {
+        await RekeyDatabaseInPlaceAsync("encryptDb", databaseName, key, cryptoWorkers, cancellationToken);
+    }
+
+    /// <summary>
+    /// Per-DB crypto primitive — internal only. Production callers go through
+    /// <see cref="IEncryptedSqliteWasmDatabaseService.LeaveEncryptedAsync"/>.
+    /// </summary>
+    internal async Task DecryptDatabaseInPlaceAsync(
+        string databaseName,
+        CancellationToken cancellationToken = default)
+    {
+        // No key payload — worker uses its currently-registered K. The caller
+        // is responsible for SetEncryptionKeyAsync(K_old) first.
+        var request = new { type = "decryptDb", database = databaseName };
+        var result = await _bridge.SendRequestAsync(request, cancellationToken);
+        if (result.RowsAffected != 0)
+        {
+            throw new InvalidOperationException(
+                $"Worker returned unexpected in-place decrypt outcome code {result.RowsAffected}");
+        }
+        _bridge.MarkDatabaseClosed(databaseName);
+    }
+
+    /// <summary>
+    /// Decrypt in place under <paramref name="key"/> rather than the registered
+    /// key — the rollback of <see cref="EncryptDatabaseInPlaceAsync"/>, which runs
+    /// with no key installed. Reverts a partly encrypted file; an untouched
+    /// (plain) file is left as is.
+    /// </summary>
+    internal async Task DecryptDatabaseInPlaceAsync(
+        string databaseName,
+        ReadOnlyMemory<byte> key,
+        int cryptoWorkers = 0,
+        CancellationToken cancellationToken = default)
+    {
+        await RekeyDatabaseInPlaceAsync("decryptDb", databaseName, key, cryptoWorkers, cancellationToken);
+    }
+
+    private async Task RekeyDatabaseInPlaceAsync(
+        string type,
+        string databaseName,
+        ReadOnlyMemory<byte> key,
+        int cryptoWorkers,
+        CancellationToken cancellationToken)
     {
         if (key.Length != 32)
         {
@@ -128,7 +190,7 @@ internal sealed partial class EncryptedSqliteWasmWorkerBridge
         try
         {
             var result = await _bridge.PostBinaryAsync(
-                new { type = "encryptDb", database = databaseName },
+                new { type, database = databaseName, cryptoWorkers = Math.Max(0, cryptoWorkers) },
                 envelope,
                 cancellationToken);
 
@@ -148,26 +210,6 @@ internal sealed partial class EncryptedSqliteWasmWorkerBridge
         }
     }
 
-    /// <summary>
-    /// Per-DB crypto primitive — internal only. Production callers go through
-    /// <see cref="IEncryptedSqliteWasmDatabaseService.LeaveEncryptedAsync"/>.
-    /// </summary>
-    internal async Task DecryptDatabaseInPlaceAsync(
-        string databaseName,
-        CancellationToken cancellationToken = default)
-    {
-        // No key payload — worker uses its currently-registered K. The caller
-        // is responsible for SetEncryptionKeyAsync(K_old) first.
-        var request = new { type = "decryptDb", database = databaseName };
-        var result = await _bridge.SendRequestAsync(request, cancellationToken);
-        if (result.RowsAffected != 0)
-        {
-            throw new InvalidOperationException(
-                $"Worker returned unexpected in-place decrypt outcome code {result.RowsAffected}");
-        }
-        _bridge.MarkDatabaseClosed(databaseName);
-    }
-
     /// <summary>
     /// Read the disk-bound passkey manifest. Walks every DB in the SAHPool,
     /// pulls bytes 524..1023 of each header sector, and returns a typed state
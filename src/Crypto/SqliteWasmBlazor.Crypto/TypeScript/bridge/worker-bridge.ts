@@ -1,6 +1,6 @@
 // worker-bridge.ts
 // Bridge between C# JSImport and Web Worker.
-// Exposes a single async initializeBridge(baseHref, assetRoot) entry point;
+// Exposes a single async initializeBridge(baseHref, assetRoot, optionsJson) entry point;
 // C# awaits its returned Promise so worker creation errors surface on the .NET side.
 
 /**
@@ -14,26 +14,172 @@ interface IMemoryView {
 
 let worker: Worker | null = null;
 
+// Snapshot read workers (SqliteWasmOptions.ReadWorkerCount) — see
+// worker-common's read-snapshot.ts. Each holds in-memory copies of
+// databases taken from `worker`, which posts them over a MessageChannel
+// per reader. A copy is current once the reader has acknowledged it and
+// while writeGeneration still has the value it had when the copy was
+// requested; every request to `worker` that may write advances it.
+const READ_WORKER_NAME = 'sqlitewasmblazor-reader';
+
+/** Time without writes before copies of a database are refreshed. */
+const SNAPSHOT_REFRESH_DELAY_MS = 100;
+
+interface ReadWorker {
+    worker: Worker;
+    /** Index of the reader's snapshot port on the owning worker. */
+    port: number;
+    ready: boolean;
+    /** Ids of C# requests posted and not answered yet — the routing load. */
+    pending: Set<number>;
+    /** Database → writeGeneration its copy was taken at. */
+    snapshots: Map<string, number>;
+}
+
+let readWorkers: ReadWorker[] = [];
+let writeGeneration = 0;
+
+/** writeGeneration at the last dropSnapshots; older copies must not load. */
+let snapshotsDroppedAt = 0;
+
+/**
+ * JSON request types that never change a database. Any other request to
+ * the owning worker may write and advances writeGeneration.
+ */
+const NON_WRITING_REQUESTS = new Set([
+    'fetch', 'closeCursor', 'statementCacheStats', 'listDatabases', 'exists',
+    'exportDb', 'exportStreamOpen', 'exportStreamRead', 'exportStreamClose',
+    'exportDeflatedOpen', 'deflateConcurrency',
+    'blobOpen', 'blobRead', 'blobClose', 'readDiskManifest',
+]);
+
+// C# serializes { id, data: { type, ... } }: the first "type" is the request's
+const REQUEST_TYPE = /"type":"(\w+)"/;
+
+function mayWrite(type: string | undefined): boolean {
+    return type === undefined || !NON_WRITING_REQUESTS.has(type);
+}
+
+/** Largest database copied to the readers (SqliteWasmOptions.ReadWorkerMaxSnapshotSize), 0 = any. */
+let snapshotMaxBytes = 0;
+
+/** Databases with a scheduled or running snapshot refresh. */
+const snapshotRefreshes = new Set<string>();
+
+/** Bridge-internal requests (negative ids, never seen by C#). */
+const bridgeRequests = new Map<number, (message: any) => void>();
+let nextBridgeRequestId = -1;
+
+// Interrupt buffer — layout documented in worker-common's
+// request-scheduler.ts: a write counter, then a ring of cancelled ids.
+const INTERRUPT_SLOTS = 16;
+let interruptCells: Int32Array | null = null;
+
+// Synchronous channel — layout and state machine documented in
+// worker-common's sync-channel.ts; the constants below mirror it.
+const SYNC_HEADER_BYTES = 16;
+const SYNC_STATE_IDLE = 0;
+const SYNC_STATE_PENDING = 1;
+const SYNC_STATE_READY = 2;
+const SYNC_STATE_ABANDONED = 3;
+
+// Status codes returned to C# (SqliteWasmWorkerBridge.SyncStatus):
+// 0..2 are the worker's payload kinds (result / JSON / error).
+const SYNC_STATUS_TIMEOUT = 3;
+const SYNC_STATUS_BUSY = 4;
+
+let syncHeader: Int32Array | null = null;
+let syncPayload: Uint8Array | null = null;
+let syncResult: Uint8Array = new Uint8Array(0);
+
+// SqliteWasmWorkerBridge's [JSExport] methods, resolved once.
+let bridgeExports: any = null;
+let bridgeExportsPromise: Promise<any> | null = null;
+
+// Fields of a response that OnWorkerControlResponse carries as arguments
+const CONTROL_RESPONSE_FIELDS = new Set(['success', 'error', 'rowsAffected', 'lastInsertId']);
+
+function loadBridgeExports(): Promise<any> {
+    bridgeExportsPromise ??= (globalThis as any).getDotnetRuntime(0)
+        .getAssemblyExports('SqliteWasmBlazor.dll')
+        .then((exports: any) => bridgeExports = exports.SqliteWasmBlazor.SqliteWasmWorkerBridge);
+    return bridgeExportsPromise!;
+}
+
+/**
+ * Route a worker response to its C# callback. Results and exports are
+ * binary; plain acknowledgements and errors (the bulk of non-query traffic)
+ * go out as primitive arguments; only responses with structured fields
+ * (database lists, manifests, statistics) are passed as JSON.
+ */
+function dispatchResponse(bridge: any, message: any): void {
+    // Worker-side phases first, so C# has them when the response completes
+    const timing = message.timing;
+    if (timing) {
+        bridge.OnWorkerTiming(message.id, timing.op, timing.queueMs, timing.executeMs, timing.serializeMs);
+    }
+
+    if (message.rawBinary && message.data instanceof Uint8Array) {
+        bridge.OnWorkerResponseRawBinary(message.id, message.data, message.closedDatabase ?? null);
+        return;
+    }
+    if (message.binary && message.data instanceof Uint8Array) {
+        bridge.OnWorkerResponseBinary(message.id, message.data);
+        return;
+    }
+
+    const data = message.data ?? {};
+    for (const key in data) {
+        if (!CONTROL_RESPONSE_FIELDS.has(key)) {
+            bridge.OnWorkerResponse(JSON.stringify(message));
+            return;
+        }
+    }
+    bridge.OnWorkerControlResponse(
+        message.id, data.success === true, data.rowsAffected ?? 0, data.lastInsertId ?? 0, data.error ?? null);
+}
+
+/**
+ * Hand a worker response to C#. A failing callback is reported back as an
+ * error response so the request does not hang.
+ */
+async function deliverResponse(message: any): Promise<void> {
+    try {
+        // Resolved once at 'ready'; responses never wait on it again
+        dispatchResponse(bridgeExports ?? await loadBridgeExports(), message);
+    } catch (error) {
+        console.error('[Worker Bridge] Failed to call C# callback:', error);
+        try {
+            (await loadBridgeExports()).OnWorkerControlResponse(
+                message.id, false, 0, 0, `Bridge callback failed: ${error}`);
+        } catch {
+            // Last resort — runtime unavailable, can't notify C#.
+        }
+    }
+}
+
 /**
  * Create the Web Worker and wire up message handling.
  * Called from C# via JSImport after JSHost.ImportAsync has loaded this module.
  * Returns a resolved Promise once the Worker is constructed — the worker's own
  * "ready" signal arrives asynchronously via postMessage → OnWorkerReady.
  */
-export async function initializeBridge(baseHref: string, assetRoot: string): Promise<void> {
+export async function initializeBridge(baseHref: string, assetRoot: string, optionsJson: string): Promise<void> {
     worker = new Worker(
         `${baseHref}${assetRoot}sqlite-wasm-worker.js`,
         { type: 'module' }
     );
 
-    worker.postMessage({ type: 'init', baseHref, assetRoot });
+    const options = optionsJson ? JSON.parse(optionsJson) : {};
+    const syncBuffer = createSyncChannel(options.synchronousChannelSize ?? 0);
+    const interruptBuffer = createInterruptBuffer();
+    worker.postMessage({ type: 'init', baseHref, assetRoot, options, syncBuffer, interruptBuffer });
 
     worker.onmessage = async (event) => {
         if (event.data.type === 'ready') {
             console.log('[Worker Bridge] Worker ready');
             try {
-                const exports = await (globalThis as any).getDotnetRuntime(0).getAssemblyExports("SqliteWasmBlazor.dll");
-                exports.SqliteWasmBlazor.SqliteWasmWorkerBridge.OnWorkerReady();
+                (await loadBridgeExports()).OnWorkerReady();
             } catch (error) {
                 console.error('[Worker Bridge] Failed to call OnWorkerReady:', error);
             }
@@ -43,8 +189,7 @@ export async function initializeBridge(baseHref: string, assetRoot: string): Pro
         if (event.data.type === 'error') {
             console.error('[Worker Bridge] Worker error:', event.data.error);
             try {
-                const exports = await (globalThis as any).getDotnetRuntime(0).getAssemblyExports("SqliteWasmBlazor.dll");
-                exports.SqliteWasmBlazor.SqliteWasmWorkerBridge.OnWorkerError(event.data.error || 'Unknown worker error');
+                (await loadBridgeExports()).OnWorkerError(event.data.error || 'Unknown worker error');
             } catch (error) {
                 console.error('[Worker Bridge] Failed to call OnWorkerError:', error);
             }
@@ -52,35 +197,8 @@ export async function initializeBridge(baseHref: string, assetRoot: string): Pro
         }
 
         if (event.data.id !== undefined) {
-            try {
-                const exports = await (globalThis as any).getDotnetRuntime(0).getAssemblyExports("SqliteWasmBlazor.dll");
-
-                if (event.data.rawBinary && event.data.data instanceof Uint8Array) {
-                    exports.SqliteWasmBlazor.SqliteWasmWorkerBridge.OnWorkerResponseRawBinary(
-                        event.data.id,
-                        event.data.data
-                    );
-                } else if (event.data.binary && event.data.data instanceof Uint8Array) {
-                    exports.SqliteWasmBlazor.SqliteWasmWorkerBridge.OnWorkerResponseBinary(
-                        event.data.id,
-                        event.data.data
-                    );
-                } else {
-                    const messageJson = JSON.stringify(event.data);
-                    exports.SqliteWasmBlazor.SqliteWasmWorkerBridge.OnWorkerResponse(messageJson);
-                }
-            } catch (error) {
-                console.error('[Worker Bridge] Failed to call C# callback:', error);
-                try {
-                    const exports = await (globalThis as any).getDotnetRuntime(0).getAssemblyExports("SqliteWasmBlazor.dll");
-                    const errorJson = JSON.stringify({
-                        id: event.data.id,
-                        data: { success: false, error: `Bridge callback failed: ${error}` }
-                    });
-                    exports.SqliteWasmBlazor.SqliteWasmWorkerBridge.OnWorkerResponse(errorJson);
-                } catch {
-                    // Last resort — runtime unavailable, can't notify C#.
-                }
+            if (!completeBridgeRequest(event.data)) {
+                await deliverResponse(event.data);
             }
         }
     };
@@ -88,16 +206,385 @@ export async function initializeBridge(baseHref: string, assetRoot: string): Pro
     worker.onerror = (error) => {
         console.error('[Worker Bridge] Worker error event:', error);
     };
+
+    startReadWorkers(baseHref, assetRoot, options, interruptBuffer);
+}
+
+/**
+ * Start the snapshot read workers: the same bundle under READ_WORKER_NAME,
+ * which skips the SAH pool. Each gets one end of a MessageChannel and the
+ * owning worker the other, so copies go from worker to reader directly.
+ * They receive copies only once a read of a database finds none current
+ * (scheduleSnapshotRefresh).
+ */
+function startReadWorkers(
+    baseHref: string, assetRoot: string, options: any, interruptBuffer: SharedArrayBuffer | undefined
+): void {
+    const count = Math.max(0, options.readWorkerCount ?? 0);
+    snapshotMaxBytes = Math.max(0, options.readWorkerMaxSnapshotSize ?? 0);
+    const ownerPorts: MessagePort[] = [];
+    for (let i = 0; i < count; i++) {
+        const channel = new MessageChannel();
+        ownerPorts.push(channel.port1);
+        const reader: ReadWorker = {
+            worker: new Worker(
+                `${baseHref}${assetRoot}sqlite-wasm-worker.js`,
+                { type: 'module', name: READ_WORKER_NAME }
+            ),
+            port: i,
+            ready: false,
+            pending: new Set(),
+            snapshots: new Map(),
+        };
+        reader.worker.postMessage({
+            type: 'init', baseHref, assetRoot, options: { statementCacheSize: options.statementCacheSize },
+            interruptBuffer, snapshotPort: channel.port2
+        }, [channel.port2]);
+
+        reader.worker.onmessage = async (event) => {
+            if (event.data.type === 'ready') {
+                reader.ready = true;
+                return;
+            }
+            if (event.data.type === 'error') {
+                dropReadWorker(reader, event.data.error || 'Unknown worker error');
+                return;
+            }
+            if (event.data.id !== undefined && !completeBridgeRequest(event.data)) {
+                reader.pending.delete(event.data.id);
+                await deliverResponse(event.data);
+            }
+        };
+
+        reader.worker.onerror = (error) => {
+            error.preventDefault();
+            dropReadWorker(reader, error.message);
+        };
+
+        readWorkers.push(reader);
+    }
+
+    if (count > 0) {
+        worker!.postMessage({ type: 'attachSnapshotPorts', ports: ownerPorts }, ownerPorts);
+    }
+}
+
+/**
+ * Retire a failed reader. Its unanswered requests fail, and C# retries
+ * them on the owning worker.
+ */
+function dropReadWorker(reader: ReadWorker, reason: string): void {
+    console.error('[Worker Bridge] Read worker failed:', reason);
+    readWorkers = readWorkers.filter(r => r !== reader);
+    reader.worker.terminate();
+    for (const id of reader.pending) {
+        bridgeExports?.OnWorkerControlResponse(id, false, 0, 0, `Read worker failed: ${reason}`);
+    }
+    reader.pending.clear();
+}
+
+/** Post a bridge-internal request; `onResponse` receives the reply. */
+function postBridgeRequest(target: Worker, data: object, onResponse: (message: any) => void): void {
+    const id = nextBridgeRequestId--;
+    bridgeRequests.set(id, onResponse);
+    target.postMessage({ id, data });
+}
+
+function completeBridgeRequest(message: any): boolean {
+    const onResponse = bridgeRequests.get(message.id);
+    if (!onResponse) {
+        return false;
+    }
+    bridgeRequests.delete(message.id);
+    onResponse(message);
+    return true;
+}
+
+/** Least-loaded ready reader holding a current copy of `database`. */
+function pickReadWorker(database: string): ReadWorker | undefined {
+    let best: ReadWorker | undefined;
+    for (const reader of readWorkers) {
+        if (reader.ready && reader.snapshots.get(database) === writeGeneration
+            && (!best || reader.pending.size < best.pending.size)) {
+            best = reader;
+        }
+    }
+    return best;
+}
+
+/**
+ * Refresh the readers' copies of `database` once no write has been sent
+ * for SNAPSHOT_REFRESH_DELAY_MS. The owning worker posts the copy to each
+ * ready reader, which acknowledges it here. A copy that a write overtakes
+ * while it is taken never becomes current; the next read schedules another.
+ */
+function scheduleSnapshotRefresh(database: string): void {
+    if (readWorkers.length === 0 || snapshotRefreshes.has(database)) {
+        return;
+    }
+    snapshotRefreshes.add(database);
+
+    const waitForQuiet = (generation: number) => setTimeout(() => {
+        if (generation !== writeGeneration) {
+            waitForQuiet(writeGeneration);
+            return;
+        }
+        const ready = readWorkers.filter(r => r.ready);
+        if (ready.length === 0) {
+            snapshotRefreshes.delete(database);
+            return;
+        }
+        const loads = ready.map(reader => ({
+            port: reader.port,
+            id: registerSnapshotLoad(reader, database, generation),
+        }));
+        postBridgeRequest(worker!, { type: 'snapshotDatabase', database, loads, maxBytes: snapshotMaxBytes }, (message) => {
+            snapshotRefreshes.delete(database);
+            // Refused (not open, inside a transaction) or over the size
+            // limit: no reader will acknowledge
+            if (!message.data?.readers) {
+                for (const load of loads) {
+                    bridgeRequests.delete(load.id);
+                }
+            }
+        });
+    }, SNAPSHOT_REFRESH_DELAY_MS);
+
+    waitForQuiet(writeGeneration);
 }
 
-/** Send a JSON request to the worker (C# → worker). */
+/** Bridge request id a reader acknowledges its copy of `database` with. */
+function registerSnapshotLoad(reader: ReadWorker, database: string, generation: number): number {
+    const id = nextBridgeRequestId--;
+    bridgeRequests.set(id, (message) => {
+        if (message.data?.success === false) {
+            console.warn(`[Worker Bridge] Read worker could not load ${database}:`, message.data.error);
+            reader.snapshots.delete(database);
+        } else if (generation < snapshotsDroppedAt) {
+            // Taken before the disk locked — discard it
+            postBridgeRequest(reader.worker, { type: 'dropSnapshots' }, () => {});
+        } else {
+            reader.snapshots.set(database, generation);
+        }
+    });
+    return id;
+}
+
+/**
+ * Send a binary-encoded statement that may run on a snapshot reader:
+ * one C# has not seen fail there, `readOnly` once it has seen it succeed.
+ * Posted to the least-loaded reader with a current copy of `database` —
+ * returns true — or otherwise to the owning worker, returning false.
+ */
+export function sendEncodedRead(memoryView: IMemoryView, database: string, requestId: number, readOnly: boolean): boolean {
+    if (!worker) {
+        throw new Error('Worker not initialized');
+    }
+
+    const data = memoryView.slice();
+    const reader = pickReadWorker(database);
+    if (reader) {
+        reader.pending.add(requestId);
+        reader.worker.postMessage({ encoded: data.buffer }, [data.buffer]);
+        return true;
+    }
+
+    if (!readOnly) {
+        writeGeneration++;
+    }
+    worker.postMessage({ encoded: data.buffer }, [data.buffer]);
+    scheduleSnapshotRefresh(database);
+    return false;
+}
+
+/**
+ * Discard every reader's copies (the disk was locked). Later reads go to
+ * the owning worker until new copies are taken.
+ */
+export function dropSnapshots(): void {
+    writeGeneration++;
+    snapshotsDroppedAt = writeGeneration;
+    for (const reader of readWorkers) {
+        reader.snapshots.clear();
+        postBridgeRequest(reader.worker, { type: 'dropSnapshots' }, () => {});
+    }
+}
+
+/**
+ * Send a JSON request to the worker (C# → worker). Posted as the string C#
+ * produced — the worker parses it, keeping JSON.parse off the main thread.
+ */
 export function sendToWorker(messageJson: string): void {
     if (!worker) {
         throw new Error('Worker not initialized');
     }
 
-    const message = JSON.parse(messageJson);
-    worker.postMessage(message);
+    if (mayWrite(REQUEST_TYPE.exec(messageJson)?.[1])) {
+        writeGeneration++;
+    }
+    worker.postMessage(messageJson);
+}
+
+/**
+ * Send a binary-encoded request (WorkerRequestEncoder → request-codec.ts).
+ * The managed bytes are copied once into a fresh buffer that is transferred,
+ * not cloned, to the worker. `readOnly`: an execute C# has seen succeed on
+ * a reader, which leaves the readers' copies current.
+ */
+export function sendEncodedToWorker(memoryView: IMemoryView, readOnly: boolean): void {
+    if (!worker) {
+        throw new Error('Worker not initialized');
+    }
+
+    const data = memoryView.slice();
+    if (!readOnly) {
+        writeGeneration++;
+    }
+    worker.postMessage({ encoded: data.buffer }, [data.buffer]);
+}
+
+/**
+ * Cancel request `requestId` (C# cancelled its token). The worker that has
+ * it drops it if still queued. If it is running, the worker's progress
+ * handler finds the id in the interrupt buffer and interrupts the
+ * statement. Without the buffer (page not cross-origin isolated), only
+ * queued requests are cancelled.
+ */
+export function cancelRequest(requestId: number): void {
+    if (interruptCells) {
+        const slot = (Atomics.add(interruptCells, 0, 1) >>> 0) % INTERRUPT_SLOTS;
+        Atomics.store(interruptCells, 1 + slot, requestId);
+    }
+    const reader = readWorkers.find(r => r.pending.has(requestId));
+    (reader?.worker ?? worker)?.postMessage({ type: 'cancel', requestId });
+}
+
+/**
+ * Allocate the interrupt buffer shared with the workers. Needs a
+ * cross-origin-isolated page, like the synchronous channel.
+ */
+function createInterruptBuffer(): SharedArrayBuffer | undefined {
+    if (!(globalThis as any).crossOriginIsolated || typeof SharedArrayBuffer === 'undefined') {
+        return undefined;
+    }
+    const buffer = new SharedArrayBuffer((1 + INTERRUPT_SLOTS) * 4);
+    interruptCells = new Int32Array(buffer);
+    return buffer;
+}
+
+/**
+ * Allocate the shared synchronous channel. Needs a cross-origin-isolated
+ * page (COOP: same-origin + COEP: require-corp) for SharedArrayBuffer;
+ * otherwise the sync ADO.NET surface keeps its no-op fallback.
+ */
+function createSyncChannel(size: number): SharedArrayBuffer | undefined {
+    if (size <= 0) {
+        return undefined;
+    }
+    if (!(globalThis as any).crossOriginIsolated || typeof SharedArrayBuffer === 'undefined') {
+        console.warn('[Worker Bridge] Synchronous channel requested but the page is not cross-origin isolated; sync commands stay unavailable');
+        return undefined;
+    }
+
+    const buffer = new SharedArrayBuffer(SYNC_HEADER_BYTES + size);
+    syncHeader = new Int32Array(buffer, 0, SYNC_HEADER_BYTES / 4);
+    syncPayload = new Uint8Array(buffer, SYNC_HEADER_BYTES);
+    return buffer;
+}
+
+export function isSyncChannelAvailable(): boolean {
+    return syncHeader !== null;
+}
+
+/**
+ * Block until the worker publishes the response to the request just posted.
+ * Atomics.wait is forbidden on the browser main thread, where .NET runs
+ * without the threaded runtime, so there the wait is a spin on
+ * Atomics.load; off the main thread it parks in Atomics.wait.
+ * Returns the payload kind, or SYNC_STATUS_TIMEOUT.
+ */
+function waitForSyncResponse(timeoutMs: number): number {
+    const header = syncHeader!;
+    const deadline = timeoutMs > 0 ? performance.now() + timeoutMs : Number.POSITIVE_INFINITY;
+    const canPark = typeof (globalThis as any).WorkerGlobalScope !== 'undefined';
+
+    while (Atomics.load(header, 0) === SYNC_STATE_PENDING) {
+        const remaining = deadline - performance.now();
+        if (remaining <= 0) {
+            // Lost the race only if the worker finished in the meantime
+            if (Atomics.compareExchange(header, 0, SYNC_STATE_PENDING, SYNC_STATE_ABANDONED) === SYNC_STATE_PENDING) {
+                return SYNC_STATUS_TIMEOUT;
+            }
+            break;
+        }
+        if (canPark) {
+            Atomics.wait(header, 0, SYNC_STATE_PENDING, Math.min(remaining, 1000));
+        }
+    }
+
+    const kind = Atomics.load(header, 1);
+    const length = Atomics.load(header, 2);
+    syncResult = syncPayload!.slice(0, length);
+    Atomics.store(header, 0, SYNC_STATE_IDLE);
+    return kind;
+}
+
+function beginSyncRequest(): boolean {
+    if (!worker || !syncHeader) {
+        throw new Error('Synchronous channel not initialized');
+    }
+    return Atomics.compareExchange(syncHeader, 0, SYNC_STATE_IDLE, SYNC_STATE_PENDING) === SYNC_STATE_IDLE;
+}
+
+/**
+ * Send a JSON request and block for its response (C# → worker → C#). The
+ * response payload is left for takeSyncPayload(); returns its kind or a
+ * timeout / busy status.
+ */
+export function sendToWorkerSync(messageJson: string, timeoutMs: number): number {
+    if (!beginSyncRequest()) {
+        return SYNC_STATUS_BUSY;
+    }
+    // C# already flagged the envelope `sync: true`
+    if (mayWrite(REQUEST_TYPE.exec(messageJson)?.[1])) {
+        writeGeneration++;
+    }
+    worker!.postMessage(messageJson);
+    return waitForSyncResponse(timeoutMs);
+}
+
+/** sendToWorkerSync for requests carrying a binary attachment (blob parameters). */
+export function sendBinaryToWorkerSync(memoryView: IMemoryView, metadataJson: string, timeoutMs: number): number {
+    if (!beginSyncRequest()) {
+        return SYNC_STATUS_BUSY;
+    }
+    const data = memoryView.slice();
+    const metadata = JSON.parse(metadataJson);
+    if (mayWrite(metadata.data?.type)) {
+        writeGeneration++;
+    }
+    worker!.postMessage({ ...metadata, sync: true, binaryPayload: data.buffer }, [data.buffer]);
+    return waitForSyncResponse(timeoutMs);
+}
+
+/** sendToWorkerSync for binary-encoded requests (sync flag set by C#); `readOnly` as in sendEncodedToWorker. */
+export function sendEncodedToWorkerSync(memoryView: IMemoryView, readOnly: boolean, timeoutMs: number): number {
+    if (!beginSyncRequest()) {
+        return SYNC_STATUS_BUSY;
+    }
+    const data = memoryView.slice();
+    if (!readOnly) {
+        writeGeneration++;
+    }
+    worker!.postMessage({ encoded: data.buffer }, [data.buffer]);
+    return waitForSyncResponse(timeoutMs);
+}
+
+/** Payload of the last synchronous response (marshalled to byte[]). */
+export function takeSyncPayload(): Uint8Array {
+    const result = syncResult;
+    syncResult = new Uint8Array(0);
+    return result;
 }
 
 // Called from C# to send binary data to worker (import operations)
@@ -109,6 +596,9 @@ export function sendBinaryToWorker(memoryView: IMemoryView, metadataJson: string
 
     const data = memoryView.slice();
     const metadata = JSON.parse(metadataJson);
+    if (mayWrite(metadata.data?.type)) {
+        writeGeneration++;
+    }
 
     if (headerView) {
         const header = headerView.slice();
@@ -137,13 +627,25 @@ export const logger = {
             type: 'setLogLevel',
             level: level
         });
+        for (const reader of readWorkers) {
+            reader.worker.postMessage({ type: 'setLogLevel', level });
+        }
     }
 };
 
 (globalThis as any).sqliteWasmWorker = {
     initializeBridge,
     sendToWorker,
-    sendBinaryToWorker
+    sendEncodedToWorker,
+    sendEncodedRead,
+    dropSnapshots,
+    cancelRequest,
+    sendBinaryToWorker,
+    isSyncChannelAvailable,
+    sendToWorkerSync,
+    sendEncodedToWorkerSync,
+    sendBinaryToWorkerSync,
+    takeSyncPayload
 };
 
 (globalThis as any).__sqliteWasmLogger = logger;
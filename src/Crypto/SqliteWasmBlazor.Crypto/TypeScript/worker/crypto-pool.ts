@@ -0,0 +1,325 @@
+// crypto-pool.ts
+// Parallel slot rekeying for whole-database operations on an encrypted disk.
+//
+// rekeySlots (vfs-prf/rekey.ts) decrypts and/or re-encrypts every page of a
+// database: PLAIN / REKEY / ENCRYPT exports, asymmetric and plain imports
+// and their preflight. On a 500 MB disk that
+// is ~120k AEAD operations on this one thread. With a pool configured
+// (SqliteWasmBlazorCryptoOptions.CryptoWorkers, sent with
+// setGlobalEncryptionKey, encryptDb and decryptDb), the source goes through
+// a pair of SharedArrayBuffer windows of MIN_PARALLEL_SLOTS slots each: every
+// window's slots are split into contiguous ranges, one for this worker and
+// one per crypto helper — a second instance of this worker bundle started
+// under CRYPTO_HELPER_NAME, which never initializes SQLite — rekeyed into
+// the shared output window and copied to the destination. Beyond the source
+// and the result, a rekey holds two windows (~33 MB), not two more copies
+// of the database.
+//
+// Opt-in, and only on cross-origin-isolated pages (SharedArrayBuffer).
+// Each helper holds a copy of the source and target keys while it runs a
+// range and wipes it after. Databases below MIN_PARALLEL_SLOTS stay
+// in-thread, where the message round trip costs more than it saves.
+//
+// Encrypt / decrypt in place (rekeyInPlace) works a chunk at a time; with a
+// pool its chunks grow to MIN_PARALLEL_SLOTS and each is split the same way
+// (rekeyRangeParallel).
+//
+// SQLite's own page I/O (xRead / xWrite in sahpool-prf-vfs.ts) is not
+// dispatched: SQLite reads one page per synchronous call, so a VACUUM or
+// an integrity check has no range to split.
+
+import { clearBytes } from '@sqlitewasmblazor/crypto-core';
+import { logger, MODULE_NAME } from '@sqlitewasmblazor/worker-common';
+import { rekeySlots, rekeySlotRange, REKEY_CHUNK_SLOTS } from './vfs-prf/rekey';
+
+/** Worker name that makes a bundle instance run as a crypto helper. */
+export const CRYPTO_HELPER_NAME = 'sqlitewasmblazor-crypto-helper';
+
+/** Slots (16 MB of pages) below which a rekey stays in this worker. */
+const MIN_PARALLEL_SLOTS = 4096;
+
+/** Helpers are capped here whatever the configured count. */
+const MAX_CRYPTO_HELPERS = 8;
+
+const PLAIN_SLOT_SIZE = 4096;
+const ENCRYPTED_SLOT_SIZE = 4124;
+
+interface RangeJob {
+    resolve: () => void;
+    reject: (error: Error) => void;
+}
+
+interface CryptoHelper {
+    worker: Worker;
+    jobs: Map<number, RangeJob>;
+}
+
+let helperCount = 0;
+let helpers: CryptoHelper[] = [];
+let nextJobId = 1;
+
+/**
+ * Set the number of crypto helpers (0 disables the pool). Ignored, as 0,
+ * where SharedArrayBuffer or nested workers are unavailable. Helpers start
+ * on first use and stay for the worker's lifetime; surplus ones left by a
+ * smaller count are stopped once idle.
+ */
+export function setCryptoWorkerCount(count: number): void {
+    const available = typeof SharedArrayBuffer !== 'undefined'
+        && (globalThis as any).crossOriginIsolated === true
+        && typeof Worker !== 'undefined';
+    const wanted = available ? Math.min(MAX_CRYPTO_HELPERS, Math.max(0, Math.floor(count))) : 0;
+    if (wanted !== helperCount) {
+        logger.debug(MODULE_NAME, `Crypto helper pool: ${wanted} helpers${available ? '' : ' (needs cross-origin isolation)'}`);
+    }
+    helperCount = wanted;
+}
+
+/**
+ * {@link rekeySlots} on the helper pool: same input/output layouts, same
+ * errors. Falls back to rekeySlots in this worker when the pool is off,
+ * the database is small, or no helper could be started. The returned
+ * buffer is an ordinary (unshared) copy the caller owns.
+ */
+export async function rekeySlotsParallel(
+    bytesIn: Uint8Array,
+    dbPath: string,
+    sourceKey: Uint8Array | undefined,
+    targetKey: Uint8Array | undefined,
+): Promise<Uint8Array> {
+    const sourceSlotSize = sourceKey === undefined ? PLAIN_SLOT_SIZE : ENCRYPTED_SLOT_SIZE;
+    const targetSlotSize = targetKey === undefined ? PLAIN_SLOT_SIZE : ENCRYPTED_SLOT_SIZE;
+    const slotCount = bytesIn.length / sourceSlotSize;
+
+    const pool = Number.isInteger(slotCount) && slotCount >= MIN_PARALLEL_SLOTS ? getHelpers() : [];
+    if (pool.length === 0) {
+        return rekeySlots(bytesIn, dbPath, sourceKey, targetKey);
+    }
+
+    logger.info(
+        MODULE_NAME,
+        `[rekeySlots] dbPath=${dbPath} slots=${slotCount} across ${pool.length + 1} threads ` +
+        `(sourceSlot=${sourceSlotSize} → targetSlot=${targetSlotSize})`);
+    const out = new Uint8Array(slotCount * targetSlotSize);
+    const shared = allocateWindow(MIN_PARALLEL_SLOTS, sourceSlotSize, targetSlotSize);
+    for (let first = 0; first < slotCount; first += MIN_PARALLEL_SLOTS) {
+        const count = Math.min(MIN_PARALLEL_SLOTS, slotCount - first);
+        await rekeyOnPool(
+            pool,
+            bytesIn.subarray(first * sourceSlotSize, (first + count) * sourceSlotSize),
+            out.subarray(first * targetSlotSize, (first + count) * targetSlotSize),
+            dbPath, sourceKey, targetKey, first, shared);
+    }
+    return out;
+}
+
+/**
+ * Rekey every slot of `bytesIn` into `out` (buffer slot 0 being file slot
+ * `slotBase`), split across the pool when it is on and the range is large
+ * enough, else in this worker. Passed to rekeyInPlace as its `rekeyChunk`.
+ */
+export async function rekeyRangeParallel(
+    bytesIn: Uint8Array,
+    out: Uint8Array,
+    dbPath: string,
+    sourceKey: Uint8Array | undefined,
+    targetKey: Uint8Array | undefined,
+    slotBase: number,
+): Promise<void> {
+    const sourceSlotSize = sourceKey === undefined ? PLAIN_SLOT_SIZE : ENCRYPTED_SLOT_SIZE;
+    const slotCount = bytesIn.length / sourceSlotSize;
+    const pool = slotCount >= MIN_PARALLEL_SLOTS ? getHelpers() : [];
+    if (pool.length === 0) {
+        rekeySlotRange(bytesIn, out, dbPath, sourceKey, targetKey, 0, slotCount, slotBase);
+        return;
+    }
+    const targetSlotSize = out.length / slotCount;
+    await rekeyOnPool(
+        pool, bytesIn, out, dbPath, sourceKey, targetKey, slotBase,
+        allocateWindow(slotCount, sourceSlotSize, targetSlotSize));
+}
+
+/** Chunk size for rekeyInPlace: large enough to split once a pool is configured. */
+export function inPlaceChunkSlots(): number {
+    return helperCount > 0 ? MIN_PARALLEL_SLOTS : REKEY_CHUNK_SLOTS;
+}
+
+/** Shared input and output buffers a range is rekeyed through; reused window to window. */
+interface SharedWindow {
+    input: Uint8Array;
+    output: Uint8Array;
+}
+
+function allocateWindow(slots: number, sourceSlotSize: number, targetSlotSize: number): SharedWindow {
+    return {
+        input: new Uint8Array(new SharedArrayBuffer(slots * sourceSlotSize)),
+        output: new Uint8Array(new SharedArrayBuffer(slots * targetSlotSize)),
+    };
+}
+
+/**
+ * Rekey `bytesIn` into `out` through `shared`, which must hold at least
+ * as many slots. Slots are addressed from the start of the window, so a
+ * short last window uses a prefix of the shared buffers.
+ */
+async function rekeyOnPool(
+    pool: CryptoHelper[],
+    bytesIn: Uint8Array,
+    out: Uint8Array,
+    dbPath: string,
+    sourceKey: Uint8Array | undefined,
+    targetKey: Uint8Array | undefined,
+    slotBase: number,
+    shared: SharedWindow,
+): Promise<void> {
+    const slotCount = bytesIn.length / (sourceKey === undefined ? PLAIN_SLOT_SIZE : ENCRYPTED_SLOT_SIZE);
+    const input = shared.input.subarray(0, bytesIn.length);
+    const output = shared.output.subarray(0, out.length);
+    try {
+        input.set(bytesIn);
+
+        const perRange = Math.ceil(slotCount / (pool.length + 1));
+        const ranges: Promise<void>[] = [];
+        for (let h = 0; h < pool.length; h++) {
+            const firstSlot = (h + 1) * perRange;
+            const count = Math.min(perRange, slotCount - firstSlot);
+            if (count > 0) {
+                ranges.push(runRange(pool[h], {
+                    input: input.buffer, output: output.buffer, dbPath, sourceKey, targetKey, firstSlot, count, slotBase,
+                }));
+            }
+        }
+
+        // The first range runs here while the helpers work on theirs. Every
+        // helper must be done with the shared buffers before they are wiped.
+        let failure: unknown;
+        try {
+            rekeySlotRange(input, output, dbPath, sourceKey, targetKey, 0, Math.min(perRange, slotCount), slotBase);
+        } catch (error) {
+            failure = error;
+        }
+        for (const result of await Promise.allSettled(ranges)) {
+            if (result.status === 'rejected' && failure === undefined) {
+                failure = result.reason;
+            }
+        }
+        if (failure !== undefined) {
+            throw failure;
+        }
+
+        out.set(output);
+    } finally {
+        // Either side may be plaintext pages
+        clearBytes(input);
+        clearBytes(output);
+    }
+}
+
+interface RangeMessage {
+    input: SharedArrayBuffer;
+    output: SharedArrayBuffer;
+    dbPath: string;
+    sourceKey: Uint8Array | undefined;
+    targetKey: Uint8Array | undefined;
+    firstSlot: number;
+    count: number;
+    slotBase: number;
+}
+
+function runRange(helper: CryptoHelper, message: RangeMessage): Promise<void> {
+    const job = nextJobId++;
+    return new Promise((resolve, reject) => {
+        helper.jobs.set(job, { resolve, reject });
+        helper.worker.postMessage({ job, ...message });
+    });
+}
+
+/** Up to helperCount helpers, started on first use. */
+function getHelpers(): CryptoHelper[] {
+    // Surplus helpers from a larger earlier count
+    while (helpers.length > helperCount && helpers[helpers.length - 1].jobs.size === 0) {
+        helpers.pop()!.worker.terminate();
+    }
+
+    try {
+        while (helpers.length < helperCount) {
+            helpers.push(startHelper());
+        }
+    } catch (error) {
+        logger.warn(MODULE_NAME, 'Failed to start crypto helpers; rekeying in this worker:', error);
+        for (const helper of helpers) {
+            helper.worker.terminate();
+        }
+        helpers = [];
+        helperCount = 0;
+    }
+    return helpers.slice(0, helperCount);
+}
+
+function startHelper(): CryptoHelper {
+    const helper: CryptoHelper = {
+        worker: new Worker(self.location.href, { type: 'module', name: CRYPTO_HELPER_NAME }),
+        jobs: new Map(),
+    };
+
+    helper.worker.onmessage = (event: MessageEvent) => {
+        const { job: jobId, error } = event.data;
+        const job = helper.jobs.get(jobId);
+        if (!job) {
+            return;
+        }
+        helper.jobs.delete(jobId);
+        if (error === undefined) {
+            job.resolve();
+        } else {
+            job.reject(new Error(error));
+        }
+    };
+
+    // A helper that fails to load (or crashes) leaves the pool and fails
+    // its ranges; the next rekey starts a replacement.
+    helper.worker.onerror = (event: ErrorEvent) => {
+        event.preventDefault();
+        logger.warn(MODULE_NAME, 'Crypto helper failed:', event.message);
+        helpers = helpers.filter(h => h !== helper);
+        helper.worker.terminate();
+        for (const job of helper.jobs.values()) {
+            job.reject(new Error(`Crypto helper failed: ${event.message}`));
+        }
+        helper.jobs.clear();
+    };
+
+    return helper;
+}
+
+/**
+ * Run as a crypto helper when this bundle was started under
+ * CRYPTO_HELPER_NAME: replaces the SQL message handler with the range
+ * protocol (one message per range, answered with its job id and an error
+ * if it failed). Returns false, and does nothing, in the SQLite worker.
+ */
+export function installCryptoHelper(): boolean {
+    if (self.name !== CRYPTO_HELPER_NAME) {
+        return false;
+    }
+
+    self.onmessage = (event: MessageEvent) => {
+        const { job, input, output, dbPath, sourceKey, targetKey, firstSlot, count, slotBase } = event.data;
+        try {
+            rekeySlotRange(
+                new Uint8Array(input), new Uint8Array(output), dbPath, sourceKey, targetKey, firstSlot, count, slotBase);
+            self.postMessage({ job });
+        } catch (error) {
+            self.postMessage({ job, error: error instanceof Error ? error.message : String(error) });
+        } finally {
+            // Structured-clone copies of the keys; the originals stay with the caller
+            if (sourceKey) {
+                clearBytes(sourceKey);
+            }
+            if (targetKey) {
+                clearBytes(targetKey);
+            }
+        }
+    };
+    return true;
+}
@@ -3,14 +3,25 @@
 // SAHPool provides synchronous OPFS access in worker context
 
 import sqlite3InitModule from '@sqlite.org/sqlite-wasm';
-import { pack, unpack } from 'msgpackr';
+import { unpack } from 'msgpackr';
 import {
     logger,
     registerEFCoreFunctions,
-    openDatabases, pragmasSet, schemaCache,
+    openDatabases, pragmasSet,
     MODULE_NAME, bigIntUnpackr,
     setSqlite3, setPoolUtil, setBaseHref,
     bulkInsertRows, type BulkInsertHeader,
+    executeSql, executeBatch, runDeferredBegin, fetchCursor, closeCursor, finalizeDatabaseStatements,
+    setStatementCacheCapacity, getStatementCache,
+    attachSyncChannel, completeSyncRequest, decodeRequest, type ParameterBlock,
+    openBlob, readBlob, writeBlob, closeBlob,
+    backupDatabase,
+    openExportStream, openRangeExportStream, readExportStream, closeExportStream,
+    openImportStream, writeImportStream, finishImportStream, abortImportStream, sweepStreamFiles,
+    deflateConcurrency, deflateExportStream, installZipHelper,
+    isSnapshotReader, assertSnapshotReadable, loadSnapshot, dropSnapshots, snapshotDatabase, attachSnapshotPorts,
+    scheduleRequest, requestPriority, cancelRequest, attachInterruptBuffer, installInterruptHandler,
+    RequestTimer, type RequestTiming,
 } from '@sqlitewasmblazor/worker-common';
 import { deltaExportEncrypted, deltaImportEncrypted, bulkRotateKey } from './crypto-delta';
 import { installOpfsSAHPoolVfs as installPrfVfs } from './vfs-prf/sahpool-prf-vfs';
@@ -20,7 +31,16 @@ import {
     setGlobalKey,
     clearGlobalKey,
 } from './vfs-prf/key-registry';
-import { rekeySlots } from './vfs-prf/rekey';
+import {
+    rekeySlotsParallel,
+    rekeyRangeParallel,
+    inPlaceChunkSlots,
+    setCryptoWorkerCount,
+    installCryptoHelper,
+} from './crypto-pool';
+import { rekeyInPlace, type RekeyFile } from './vfs-prf/rekey';
+import { parseRekeyProgress, type RekeyDirection } from './vfs-prf/manifest';
+import { setPageCacheCapacity } from './vfs-prf/page-cache';
 import { clearBytes } from '@sqlitewasmblazor/crypto-core';
 import {
     readDiskManifestOp,
@@ -37,16 +57,26 @@ let baseHref = '/';
 // that flatten the underscore-prefixed _content path.
 let assetRoot = '_content/SqliteWasmBlazor/';
 
+/** Streamed opaque imports (session → dbName), verified on finish. */
+const opaqueImportStreams = new Map<number, string>();
+/** Temporary ciphertext copies behind encrypted export streams. */
+let nextCiphertextExport = 1;
+
 interface WorkerRequest {
     id: number;
     data: {
         type: string;
         database?: string;
         sql?: string;
-        parameters?: Record<string, any>;
+        /** ParameterBlock for encoded requests (request-codec.ts). */
+        parameters?: Record<string, any> | ParameterBlock;
     };
     binaryPayload?: ArrayBuffer;
     binaryHeader?: ArrayBuffer;
+    /** Response goes to the shared sync channel instead of postMessage. */
+    sync?: boolean;
+    /** Scheduling class (request-scheduler.ts); encoded requests carry it. */
+    priority?: number;
 }
 
 interface WorkerResponse {
@@ -63,33 +93,7 @@ interface WorkerResponse {
         rowsAffected?: number;
         lastInsertId?: number;
     };
-}
-
-// Helper function to convert BigInt and Uint8Array for JSON serialization
-// BigInts within safe integer range (±2^53-1) are converted to number for efficiency
-// Larger BigInts are converted to string to preserve precision
-// Uint8Arrays are converted to Base64 strings (matches .NET 6+ JSInterop convention)
-// Convert BigInt values for MessagePack serialization
-// MessagePack natively handles Uint8Array, so no Base64 conversion needed
-function convertBigInt(value: any): any {
-    if (typeof value === 'bigint') {
-        // Check if BigInt fits in JavaScript's safe integer range
-        if (value >= Number.MIN_SAFE_INTEGER && value <= Number.MAX_SAFE_INTEGER) {
-            return Number(value);  // Convert to number for efficiency
-        }
-        return value.toString();  // Convert to string to preserve precision
-    }
-    if (Array.isArray(value)) {
-        return value.map(convertBigInt);
-    }
-    if (value && typeof value === 'object' && !(value instanceof Uint8Array)) {
-        const converted: any = {};
-        for (const key in value) {
-            converted[key] = convertBigInt(value[key]);
-        }
-        return converted;
-    }
-    return value;
+    timing?: RequestTiming;
 }
 
 // Initialize sqlite-wasm with OPFS SAHPool
@@ -145,6 +149,14 @@ async function initializeSQLite() {
             logger.debug(MODULE_NAME, 'OPFS VFS auto-installed, but we use SAHPool VFS instead');
         }
 
+        // A snapshot reader (read-snapshot.ts) only holds in-memory copies
+        // and must not claim the SAH pool, which belongs to the owning worker.
+        if (isSnapshotReader()) {
+            self.postMessage({ type: 'ready' });
+            logger.info(MODULE_NAME, 'Ready (snapshot reader)');
+            return;
+        }
+
         // Install PRF-keyed OPFS SAHPool VFS.
         // This fork of sqlite-wasm's `opfs-sahpool` is a drop-in replacement:
         // - For DBs opened without a registered key, it behaves byte-for-byte
@@ -174,6 +186,9 @@ async function initializeSQLite() {
         // Grow pool if previously created with smaller capacity (initialCapacity only applies on first creation)
         await poolUtil.reserveMinimumCapacity(25);
 
+        // Temporary export / import files of a page closed mid-transfer
+        sweepStreamFiles();
+
         logger.info(MODULE_NAME, 'OPFS SAHPool VFS installed successfully');
         logger.debug(MODULE_NAME, 'Available VFS:', sqlite3.capi.sqlite3_vfs_find(null));
 
@@ -189,14 +204,37 @@ async function initializeSQLite() {
     }
 }
 
+type WorkerMessage = WorkerRequest | { encoded: ArrayBuffer } | { type: 'setLogLevel'; level: number } | { type: 'cancel'; requestId: number } | { type: 'attachSnapshotPorts'; ports: MessagePort[] } | { type: 'init'; baseHref: string; assetRoot?: string; options?: { statementCacheSize?: number }; syncBuffer?: SharedArrayBuffer; interruptBuffer?: SharedArrayBuffer; snapshotPort?: MessagePort };
+
 // Handle messages from main thread
-self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel'; level: number } | { type: 'init'; baseHref: string; assetRoot?: string }>) => {
+self.onmessage = async (event: MessageEvent<string | WorkerMessage>) => {
+    // Requests arrive as the JSON text C# serialized (parsed here, off the
+    // main thread) or, for command execution, binary-encoded
+    // (request-codec.ts); init / setLogLevel / binary sends arrive as objects.
+    const message: WorkerMessage = typeof event.data === 'string'
+        ? JSON.parse(event.data)
+        : 'encoded' in event.data ? decodeRequest(event.data.encoded) : event.data;
+
     // Handle initialization with base href and asset root
-    if ('type' in event.data && event.data.type === 'init' && 'baseHref' in event.data) {
-        baseHref = event.data.baseHref;
+    if ('type' in message && message.type === 'init' && 'baseHref' in message) {
+        baseHref = message.baseHref;
         setBaseHref(baseHref);
-        if (event.data.assetRoot) {
-            assetRoot = event.data.assetRoot;
+        if (message.assetRoot) {
+            assetRoot = message.assetRoot;
+        }
+        if (typeof message.options?.statementCacheSize === 'number') {
+            setStatementCacheCapacity(message.options.statementCacheSize);
+        }
+        if (message.syncBuffer) {
+            attachSyncChannel(message.syncBuffer);
+        }
+        if (message.interruptBuffer) {
+            attachInterruptBuffer(message.interruptBuffer);
+        }
+        if (message.snapshotPort) {
+            // Snapshot reader: the owning worker posts 'loadSnapshot'
+            // requests on this port (read-snapshot.ts)
+            message.snapshotPort.onmessage = event => self.onmessage?.(event);
         }
         // Start initialization after receiving base href
         await initializeSQLite();
@@ -204,33 +242,91 @@ self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel
     }
 
     // Handle log level changes (no response needed)
-    if ('type' in event.data && event.data.type === 'setLogLevel' && 'level' in event.data) {
-        logger.setLogLevel(event.data.level);
+    if ('type' in message && message.type === 'setLogLevel' && 'level' in message) {
+        logger.setLogLevel(message.level);
         return;
     }
 
-    // Handle regular requests
-    const { id, data, binaryPayload, binaryHeader } = event.data as WorkerRequest;
+    // Cancellation from the bridge: drops the request if still queued (a
+    // running one is interrupted through the interrupt buffer)
+    if ('type' in message && message.type === 'cancel' && 'requestId' in message) {
+        cancelRequest(message.requestId);
+        return;
+    }
+
+    // The owning worker's ends of the readers' snapshot channels
+    if ('type' in message && message.type === 'attachSnapshotPorts' && 'ports' in message) {
+        attachSnapshotPorts(message.ports);
+        return;
+    }
+
+    // Regular requests are queued by priority (request-scheduler.ts)
+    const request = message as WorkerRequest;
+    scheduleRequest(
+        request.id,
+        request.data?.type ?? 'unknown',
+        requestPriority(request.data?.type, request.priority),
+        timer => processRequest(request, timer),
+        timer => respondCancelled(request, timer));
+};
+
+function respondCancelled(request: WorkerRequest, timer: RequestTimer): void {
+    const error = `Request ${request.id} was cancelled`;
+    if (request.sync) {
+        completeSyncRequest(undefined, error);
+    } else {
+        self.postMessage({ id: request.id, data: { success: false, error }, timing: timer.finish() });
+    }
+}
+
+// Responses carry the request's worker-side phases as `timing`
+// (RequestTimer); sync responses go through the channel without them.
+async function processRequest(request: WorkerRequest, timer: RequestTimer): Promise<void> {
+    const { id, data, binaryPayload, binaryHeader, sync } = request;
+
+    // The .NET thread is blocked in the bridge's sendToWorkerSync — answer
+    // through the shared channel; a postMessage would never be read.
+    if (sync) {
+        try {
+            completeSyncRequest(await handleRequest(data, binaryPayload, binaryHeader));
+        } catch (error) {
+            completeSyncRequest(undefined, error instanceof Error ? error.message : 'Unknown error');
+        }
+        return;
+    }
 
     try {
         const result = await handleRequest(data, binaryPayload, binaryHeader);
+        timer.executed();
 
         // Check if result contains raw binary data (export operations)
         if (result && typeof result === 'object' && 'rawBinary' in result && result.rawBinary) {
             const binaryData = result.data as Uint8Array;
+            // closedDatabase: an export that had to close the DB names it,
+            // so the bridge drops it from its open-database mirror.
             self.postMessage({
                 id,
                 rawBinary: true,
-                data: binaryData
+                data: binaryData,
+                closedDatabase: (result as any).closedDatabase,
+                timing: timer.finish()
             }, [binaryData.buffer]);
         }
-        // Check if result is MessagePack binary (Uint8Array)
+        // Check if result is columnar binary (Uint8Array). Transferred, not
+        // cloned: a multi-MB result must not be copied on its way to the
+        // main thread. ColumnarResultBuilder.finish() returns a view over
+        // its own buffer; anything narrower is sliced first so a shared
+        // buffer is never detached.
         else if (result instanceof Uint8Array) {
+            const payload = result.byteOffset === 0 && result.byteLength === result.buffer.byteLength
+                ? result
+                : result.slice();
             self.postMessage({
                 id,
                 binary: true,
-                data: result
-            });
+                data: payload,
+                timing: timer.finish()
+            }, [payload.buffer]);
         } else {
             // JSON response for non-execute operations
             const response: WorkerResponse = {
@@ -238,7 +334,8 @@ self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel
                 data: {
                     success: true,
                     ...result
-                }
+                },
+                timing: timer.finish()
             };
             self.postMessage(response);
         }
@@ -248,12 +345,13 @@ self.onmessage = async (event: MessageEvent<WorkerRequest | { type: 'setLogLevel
             data: {
                 success: false,
                 error: error instanceof Error ? error.message : 'Unknown error'
-            }
+            },
+            timing: timer.finish()
         };
 
         self.postMessage(response);
     }
-};
+}
 
 async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayBuffer, binaryHeader?: ArrayBuffer) {
     const { type, database, sql, parameters } = data;
@@ -269,11 +367,16 @@ async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayB
             // Install the worker-wide key. Every page I/O across every open
             // DB encrypts under it immediately — xRead / xWrite consult
             // getGlobalKey() per top-level operation. Disk-as-unit model:
-            // file handles need no invalidation on key swap.
+            // file handles need no invalidation on key swap. Carries the
+            // decrypted page cache's cap (PageCacheSize, bytes) and the
+            // crypto helper count (CryptoWorkers).
             if (!binaryPayload) {
                 throw new Error('setGlobalEncryptionKey requires binaryPayload (VfsKeyHeader)');
             }
-            return await setGlobalEncryptionKeyOp(unpackVfsKeyHeader(new Uint8Array(binaryPayload)));
+            setCryptoWorkerCount((data as any).cryptoWorkers ?? 0);
+            return await setGlobalEncryptionKeyOp(
+                unpackVfsKeyHeader(new Uint8Array(binaryPayload)),
+                (data as any).pageCacheSize ?? 0);
 
         case 'clearGlobalEncryptionKey':
             // Drop the worker-wide key. Closes open DBs first for page-cache
@@ -292,13 +395,66 @@ async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayB
             // { __blobOffset, __blobLength } placeholders pointing into the
             // attached buffer instead of Base64 strings in the JSON.
             // convertParametersForBinding reads bytes from binaryPayload.
+            // batchSize > 0 asks for a cursor: first batch now, the rest
+            // via 'fetch' (read-only statements only). `begin` opens a
+            // lazily started transaction first. `deferBlobs` leaves large
+            // BLOBs in the database for SqliteWasmBlob (blob-ops.ts).
+            if (isSnapshotReader()) {
+                assertSnapshotReadable(database!, sql!);
+            }
+            runDeferredBegin(database!, (data as any).begin);
             return await executeSql(
                 database!, sql!, parameters || {},
-                binaryPayload ? new Uint8Array(binaryPayload) : undefined);
+                binaryPayload ? new Uint8Array(binaryPayload) : undefined,
+                (data as any).batchSize ?? 0,
+                (data as any).deferBlobs === true);
+
+        case 'executeBatch':
+            // Ordered (sql, parameters) list → one framed response. Each
+            // command's blobs are a slice of the shared binary attachment.
+            // `atomic` batches (EF Core SaveChanges) run under a savepoint.
+            runDeferredBegin(database!, (data as any).begin);
+            return executeBatch(
+                database!, (data as any).commands ?? [],
+                binaryPayload ? new Uint8Array(binaryPayload) : undefined,
+                (data as any).atomic === true);
+
+        case 'fetch':
+            return fetchCursor((data as any).cursorId, (data as any).batchSize);
+
+        case 'closeCursor':
+            closeCursor((data as any).cursorId);
+            return { success: true };
+
+        case 'blobOpen': {
+            // Handle and length travel as rowsAffected / lastInsertId, so
+            // the bridge answers with a control response (no JSON).
+            const blob = openBlob(
+                database!, (data as any).schema ?? 'main', (data as any).table, (data as any).column,
+                (data as any).rowid, (data as any).writable === true);
+            return { rowsAffected: blob.handle, lastInsertId: blob.length };
+        }
+
+        case 'blobRead':
+            return { rawBinary: true, data: readBlob((data as any).handle, (data as any).offset, (data as any).count) };
+
+        case 'blobWrite':
+            if (!binaryPayload) {
+                throw new Error('blobWrite requires binaryPayload');
+            }
+            writeBlob((data as any).handle, (data as any).offset, new Uint8Array(binaryPayload));
+            return { success: true };
+
+        case 'blobClose':
+            closeBlob((data as any).handle);
+            return { success: true };
 
         case 'close':
             return await closeDatabase(database!);
 
+        case 'statementCacheStats':
+            return { statementCache: getStatementCache(database!).stats() };
+
         case 'exists':
             return await checkDatabaseExists(database!);
 
@@ -403,22 +559,138 @@ async function handleRequest(data: WorkerRequest['data'], binaryPayload?: ArrayB
             }
         }
 
+        case 'exportStreamOpen':
+            // Stream overload of ExportDatabaseAsync: snapshot once, then
+            // the bridge pulls ranges with 'exportStreamRead' (stream-ops.ts).
+            // Session and length travel as rowsAffected / lastInsertId.
+            return await openDatabaseExportStream(database!);
+
+        case 'exportStreamRead':
+            return {
+                rawBinary: true,
+                data: readExportStream((data as any).session, (data as any).offset, (data as any).count),
+            };
+
+        case 'exportStreamClose':
+            closeExportStream((data as any).session);
+            return { success: true };
+
+        case 'importStreamOpen': {
+            // Same rules as importDb: ciphertext (opaque) never overwrites
+            // an existing DB, and it is verified on 'importStreamFinish'.
+            // Chunks follow with 'importStreamWrite' and go to a temporary
+            // file; the DB stays open and intact until the finish. Session
+            // and outcome code travel as rowsAffected / lastInsertId.
+            const opaque = (data as any).opaque === true;
+            if (opaque && poolUtil.getFileNames().includes(`/databases/${database}`)) {
+                logger.warn(MODULE_NAME, `Refused opaque import of ${database}: existing DB; caller must wipe first`);
+                // VfsImportResult.EXISTING_DB_REFUSED = 2
+                return { rowsAffected: 0, lastInsertId: 2 };
+            }
+            const session = openImportStream(database!, opaque);
+            if (opaque) {
+                opaqueImportStreams.set(session, database!);
+            }
+            return { rowsAffected: session, lastInsertId: 0 };
+        }
+
+        case 'importStreamWrite':
+            if (!binaryPayload) {
+                throw new Error('importStreamWrite requires binaryPayload');
+            }
+            await writeImportStream((data as any).session, new Uint8Array(binaryPayload));
+            return { success: true };
+
+        case 'importStreamFinish': {
+            const session = (data as any).session;
+            const opaqueDb = opaqueImportStreams.get(session);
+            opaqueImportStreams.delete(session);
+            if (opaqueDb !== undefined && poolUtil.getFileNames().includes(`/databases/${opaqueDb}`)) {
+                // Created while the stream ran
+                await abortImportStream(session);
+                // VfsImportResult.EXISTING_DB_REFUSED = 2
+                return { rowsAffected: 2 };
+            }
+            await closeDatabase(database!);
+            // Ciphertext is verified in its temporary file, before it
+            // replaces anything
+            const imported = await finishImportStream(session, opaqueDb === undefined
+                ? undefined
+                : tempPath => verifyImportedDatabase(opaqueDb, tempPath) === 0);
+            // VfsImportResult.OK = 0, WRONG_KEY = 1
+            return { rowsAffected: imported ? 0 : 1 };
+        }
+
+        case 'importStreamAbort':
+            opaqueImportStreams.delete((data as any).session);
+            await abortImportStream((data as any).session);
+            return { success: true };
+
+        case 'snapshotDatabase':
+            // Online copy posted straight to the bridge's snapshot readers
+            // (read-snapshot.ts); reports how many it went to
+            return {
+                readers: await snapshotDatabase(database!, (data as any).loads ?? [], (data as any).maxBytes ?? 0)
+            };
+
+        case 'loadSnapshot':
+            // Snapshot reader: replace its in-memory copy of `database`.
+            // Arrives on the snapshot port, answered to the bridge.
+            if (!binaryPayload) {
+                throw new Error('loadSnapshot requires binaryPayload');
+            }
+            loadSnapshot(database!, new Uint8Array(binaryPayload));
+            return { success: true };
+
+        case 'dropSnapshots':
+            dropSnapshots();
+            return { success: true };
+
+        case 'deflateConcurrency':
+            // ExportAllDatabasesAsync: entries to compress at once, 0 when
+            // the bridge has to deflate in .NET (zip-ops.ts).
+            return { rowsAffected: deflateConcurrency() };
+
+        case 'exportDeflatedOpen': {
+            // One ZIP entry: snapshot as for 'exportStreamOpen', deflate it
+            // on a compression helper, and return the compressed bytes as
+            // an export stream the bridge reads with 'exportStreamRead'.
+            const source = await openDatabaseExportStream(database!);
+            const entry = await deflateExportStream(database!, source.rowsAffected, source.lastInsertId);
+            return {
+                rowsAffected: entry.session,
+                lastInsertId: entry.length,
+                crc32: entry.crc32,
+                uncompressedLength: entry.uncompressedLength,
+                closedDatabase: source.closedDatabase,
+            };
+        }
+
         case 'encryptDb':
-            // In-place plain → encrypted: reads OPFS plain pages, re-wraps
-            // under the caller-supplied 32-byte K, writes back as encrypted
-            // slots. Bytes never leave the worker. Caller must
-            // registerEncryptionKey before the next open.
+            // In-place plain → encrypted: re-wraps the OPFS plain pages
+            // under the caller-supplied 32-byte K chunk by chunk, resuming
+            // an interrupted run. Bytes never leave the worker. Caller must
+            // registerEncryptionKey before the next open. Runs before any
+            // key is installed, so it carries the crypto helper count too.
             if (!binaryPayload) {
                 throw new Error("encryptDb requires binaryPayload (VfsKeyHeader for K)");
             }
+            setCryptoWorkerCount((data as any).cryptoWorkers ?? 0);
             return await withVfsKeyHeader(
                 new Uint8Array(binaryPayload),
                 k => encryptDatabaseInPlace(database!, k));
 
         case 'decryptDb':
-            // In-place encrypted → plain: snapshots the registered K,
-            // decrypts to plain pages, writes back as plain. Bytes never
-            // leave the worker.
+            // In-place encrypted → plain under the registered K, or under
+            // the K in binaryPayload (rollback of an encryptDb, when no
+            // key is registered, so the helper count comes along too).
+            // Bytes never leave the worker.
+            if (binaryPayload) {
+                setCryptoWorkerCount((data as any).cryptoWorkers ?? 0);
+                return await withVfsKeyHeader(
+                    new Uint8Array(binaryPayload),
+                    k => decryptDatabaseInPlace(database!, k));
+            }
             return await decryptDatabaseInPlace(database!);
 
         case 'importRows':
@@ -499,6 +771,19 @@ async function openDatabase(dbName: string) {
 
     // Check if database needs to be opened
     if (!db) {
+        // A file whose encrypt / decrypt was interrupted is part plain
+        // pages, part slots: neither key state reads it.
+        if (poolUtil.getFileNames().includes(dbPath)) {
+            const interrupted = parseRekeyProgress(poolUtil.rekeyFile(dbPath).readProgress());
+            if (interrupted !== undefined) {
+                throw new Error(
+                    `Database ${dbName} is partway through an interrupted ${interrupted.direction} ` +
+                    `(${interrupted.doneSlots}/${interrupted.slotCount} pages); run ` +
+                    `${interrupted.direction === 'encrypt' ? 'EnterEncryptedAsync' : 'LeaveEncryptedAsync'} ` +
+                    `again to finish it.`);
+            }
+        }
+
         try {
             // Use OpfsSAHPoolDb from the pool utility
             // Wrap in timeout to detect multi-tab lock conflicts
@@ -519,6 +804,7 @@ async function openDatabase(dbName: string) {
 
             db = await Promise.race([openPromise, timeoutPromise]);
             openDatabases.set(dbName, db);
+            installInterruptHandler(db);
             logger.info(
                 MODULE_NAME,
                 `✓ Opened database: ${dbName} with OPFS SAHPool${hasGlobalKey() ? ' (encrypted)' : ''}`
@@ -593,14 +879,18 @@ async function openDatabase(dbName: string) {
  * we swap to K_new (or vice versa), violating the key-isolation property
  * the encrypted VFS exists to provide.
  *
+ * The VFS's own decrypted page cache (vfs-prf/page-cache.ts) is wiped by
+ * the key swap and resized to `pageCacheSize` bytes (0 disables it).
+ *
  * Idempotent: replaces a previously-set globalKey, wiping the old buffer
  * in place. Caller (C#) wipes its envelope copy after the call returns.
  */
-async function setGlobalEncryptionKeyOp(key: Uint8Array) {
+async function setGlobalEncryptionKeyOp(key: Uint8Array, pageCacheSize: number) {
     for (const dbName of [...openDatabases.keys()]) {
         await closeDatabase(dbName);
     }
     setGlobalKey(key);
+    setPageCacheCapacity(pageCacheSize);
     logger.debug(MODULE_NAME, `Installed global encryption key`);
     return { success: true };
 }
@@ -753,245 +1043,11 @@ async function withImportRekeyEnvelope<T>(
     }
 }
 
-// Get schema info for a table by querying PRAGMA table_info
-// Cache key includes database name to prevent collisions when multiple databases
-// have tables with the same name but different schemas
-function getTableSchema(db: any, dbName: string, tableName: string): Map<string, string> {
-    const cacheKey = `${dbName}:${tableName}`;
-    if (schemaCache.has(cacheKey)) {
-        return schemaCache.get(cacheKey)!;
-    }
-
-    const schema = new Map<string, string>();
-    try {
-        // Query PRAGMA table_info to get column types
-        const result = db.exec({
-            sql: `PRAGMA table_info("${tableName}")`,
-            returnValue: 'resultRows',
-            rowMode: 'array'
-        });
-
-        // PRAGMA table_info returns: [cid, name, type, notnull, dflt_value, pk]
-        for (const row of result) {
-            const columnName = row[1] as string;  // name
-            const columnType = row[2] as string;  // type
-            schema.set(columnName, columnType.toUpperCase());
-        }
-
-        schemaCache.set(cacheKey, schema);
-    } catch (error) {
-        logger.warn(MODULE_NAME, `Failed to load schema for table ${tableName}:`, error);
-    }
-
-    return schema;
-}
-
-// Extract table name from SELECT statement (simple heuristic)
-function extractTableName(sql: string): string | null {
-    // Match: SELECT ... FROM "tableName" or FROM tableName
-    const match = sql.match(/FROM\s+["']?(\w+)["']?/i);
-    return match ? match[1] : null;
-}
-
-/**
- * Converts parameters with type metadata for proper SQLite binding
- * Expects parameters in format: { value: any, type: "blob" | "text" | "integer" | "real" | "null" }
- */
-function convertParametersForBinding(
-    parameters: Record<string, any>,
-    binaryPayload?: Uint8Array,
-): Record<string, any> {
-    const converted: Record<string, any> = {};
-
-    for (const [key, paramData] of Object.entries(parameters)) {
-        // Handle new format with type metadata
-        if (paramData && typeof paramData === 'object' && 'value' in paramData && 'type' in paramData) {
-            const { value, type } = paramData;
-
-            if (value === null || value === undefined) {
-                converted[key] = null;
-                logger.debug(MODULE_NAME, `[PARAM] ${key}: null`);
-            }
-            else if (type === 'blob' && binaryPayload && value && typeof value === 'object'
-                     && typeof value.__blobOffset === 'number' && typeof value.__blobLength === 'number') {
-                // Blob bytes carried in the binary attachment, not Base64.
-                // Slice (not subarray-view-passthrough) so SQLite binding owns
-                // an independent buffer — binaryPayload's underlying ArrayBuffer
-                // may be reused on the next request.
-                const offset = value.__blobOffset;
-                const length = value.__blobLength;
-                const bytes = new Uint8Array(length);
-                bytes.set(binaryPayload.subarray(offset, offset + length));
-                converted[key] = bytes;
-                logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${length} bytes from binary attachment @ ${offset})`);
-            }
-            else if (type === 'blob' && typeof value === 'string') {
-                // Legacy fallback — Base64-encoded blob in the JSON message.
-                try {
-                    const binaryString = atob(value);
-                    const bytes = new Uint8Array(binaryString.length);
-                    for (let i = 0; i < binaryString.length; i++) {
-                        bytes[i] = binaryString.charCodeAt(i);
-                    }
-                    converted[key] = bytes;
-                    logger.debug(MODULE_NAME, `[PARAM] ${key}: blob (${bytes.length} bytes from base64)`);
-                } catch (e) {
-                    logger.error(MODULE_NAME, `[PARAM] Failed to decode blob ${key}:`, e);
-                    converted[key] = value;
-                }
-            }
-            else {
-                // For text, integer, real - use value as-is
-                converted[key] = value;
-                logger.debug(MODULE_NAME, `[PARAM] ${key}: ${type} = ${typeof value === 'string' && value.length > 50 ? value.substring(0, 50) + '...' : value}`);
-            }
-        }
-        else {
-            // Fallback for old format (backwards compatibility)
-            logger.warn(MODULE_NAME, `[PARAM] ${key}: using legacy format (no type metadata)`);
-            converted[key] = paramData;
-        }
-    }
-
-    return converted;
-}
-
-async function executeSql(
-    dbName: string, sql: string,
-    parameters: Record<string, any>,
-    binaryPayload?: Uint8Array,
-) {
-    const db = openDatabases.get(dbName);
-    if (!db) {
-        throw new Error(`Database ${dbName} not open`);
-    }
-
-    try {
-        logger.debug(MODULE_NAME, 'Executing SQL:', sql.substring(0, 100));
-
-        // Convert parameters with type metadata for proper SQLite binding.
-        // binaryPayload (if present) carries blob param bytes — see
-        // convertParametersForBinding for the __blobOffset/__blobLength
-        // placeholder shape.
-        const convertedParams = convertParametersForBinding(parameters, binaryPayload);
-
-        // Execute SQL - use returnValue to get the result
-        const result = db.exec({
-            sql: sql,
-            bind: Object.keys(convertedParams).length > 0 ? convertedParams : undefined,
-            returnValue: 'resultRows',
-            rowMode: 'array'
-        });
-
-        logger.debug(MODULE_NAME, 'SQL executed successfully, rows:', result?.length || 0);
-
-        // Extract column metadata if there are results
-        let columnNames: string[] = [];
-        let columnTypes: string[] = [];
-
-        if (result && result.length > 0) {
-            const stmt = db.prepare(sql);
-            try {
-                const colCount = stmt.columnCount;
-
-                // Try to get schema from table (for SELECT queries)
-                let tableSchema: Map<string, string> | null = null;
-                if (sql.trim().toUpperCase().startsWith('SELECT')) {
-                    const tableName = extractTableName(sql);
-                    if (tableName) {
-                        tableSchema = getTableSchema(db, dbName, tableName);
-                    }
-                }
-
-                for (let i = 0; i < colCount; i++) {
-                    const colName = stmt.getColumnName(i);
-                    columnNames.push(colName);
-
-                    // Use declared type from schema if available
-                    let declaredType = tableSchema?.get(colName);
-
-                    // Normalize declared type to SQLite affinity
-                    let inferredType = 'TEXT';
-                    if (declaredType) {
-                        const typeUpper = declaredType.toUpperCase();
-                        if (typeUpper.includes('INT')) {
-                            inferredType = 'INTEGER';
-                        } else if (typeUpper.includes('REAL') || typeUpper.includes('DOUBLE') || typeUpper.includes('FLOAT')) {
-                            inferredType = 'REAL';
-                        } else if (typeUpper.includes('BLOB')) {
-                            inferredType = 'BLOB';
-                        } else {
-                            inferredType = 'TEXT';
-                        }
-                    } else if (result.length > 0 && result[0][i] !== null) {
-                        // Fallback to value-based inference if no schema available
-                        const value = result[0][i];
-
-                        if (typeof value === 'number') {
-                            inferredType = Number.isInteger(value) ? 'INTEGER' : 'REAL';
-                        } else if (typeof value === 'bigint') {
-                            inferredType = 'INTEGER';
-                        } else if (typeof value === 'boolean') {
-                            inferredType = 'INTEGER';
-                        } else if (value instanceof Uint8Array || ArrayBuffer.isView(value)) {
-                            inferredType = 'BLOB';
-                        }
-                    }
-                    columnTypes.push(inferredType);
-                }
-            } finally {
-                stmt.finalize();
-            }
-        }
-
-        // Get changes and last insert ID for non-SELECT queries
-        let rowsAffected = 0;
-        let lastInsertId = 0;
-
-        if (sql.trim().toUpperCase().startsWith('INSERT') ||
-            sql.trim().toUpperCase().startsWith('UPDATE') ||
-            sql.trim().toUpperCase().startsWith('DELETE') ||
-            sql.trim().toUpperCase().startsWith('CREATE')) {
-
-            // Check if statement has RETURNING clause
-            // When RETURNING is used, db.changes() doesn't work correctly because
-            // SQLite treats it as a SELECT-like operation
-            const hasReturning = sql.toUpperCase().includes('RETURNING');
-
-            if (hasReturning && result && result.length > 0) {
-                // For UPDATE/DELETE with RETURNING, the presence of a result row means success
-                rowsAffected = result.length;
-            }
-            else {
-                // For INSERT without RETURNING, or any statement without RETURNING
-                rowsAffected = db.changes();
-            }
-
-            lastInsertId = db.lastInsertRowId;
-        }
-
-        const response = {
-            columnNames,
-            columnTypes,
-            typedRows: {
-                types: columnTypes,
-                data: convertBigInt(result || [])
-            },
-            rowsAffected,
-            lastInsertId: Number(lastInsertId)
-        };
-
-        return pack(response);
-    } catch (error) {
-        logger.error(MODULE_NAME, 'SQL execution failed:', error);
-        logger.error(MODULE_NAME, 'SQL:', sql);
-        throw error;
-    }
-}
-
 async function closeDatabase(dbName: string) {
     const db = openDatabases.get(dbName);
     if (db) {
+        // Open cursors and cached statements pin the connection — finalize before close.
+        finalizeDatabaseStatements(dbName);
         db.close();
         openDatabases.delete(dbName);
         pragmasSet.delete(dbName); // Clear PRAGMA tracking when database is closed
@@ -1160,27 +1216,9 @@ async function importDatabase(dbName: string, data: Uint8Array, opaque = false)
         // WAL-mode patch, which would corrupt an AEAD tag for encrypted DBs.
         poolUtil.importDb(dbPath, data, opaque);
 
-        // Verify-on-write: when an encryption key is registered for this
-        // path, AEAD-test slot 0 of the freshly written DB. On WrongKey
-        // unlink the file so the failed import leaves no half-written DB
-        // behind. This catches both corrupted ciphertext and recipient-side
-        // key mismatches at write time, instead of waiting for the first
-        // SQLite read to fail.
-        if (opaque && hasGlobalKey()) {
-            const verify = poolUtil.verifyEncryptionKey(dbPath);
-            if (verify === 'wrongKey') {
-                poolUtil.unlink(dbPath);
-                logger.warn(
-                    MODULE_NAME,
-                    `Verify-on-write rejected import of ${dbName}: AEAD failed on slot 0; rolled back`,
-                );
-                // VfsImportResult.WRONG_KEY = 1
-                return { rowsAffected: 1 };
-            }
-            logger.debug(
-                MODULE_NAME,
-                `Verify-on-write OK for ${dbName} (slot 0: ${verify})`,
-            );
+        if (opaque && verifyImportedDatabase(dbName) !== 0) {
+            // VfsImportResult.WRONG_KEY = 1
+            return { rowsAffected: 1 };
         }
 
         logger.info(MODULE_NAME, `✓ Imported database: ${dbName} (${data.length} bytes)`);
@@ -1193,6 +1231,37 @@ async function importDatabase(dbName: string, data: Uint8Array, opaque = false)
     }
 }
 
+/**
+ * Verify-on-write for an opaque import of `dbName` (byte[] or streamed):
+ * when an encryption key is registered, AEAD-test slot 0 of the freshly
+ * written file — the DB itself, or a stream's temporary file at
+ * `filePath`. On WrongKey unlink the file so the failed import leaves no
+ * half-written DB behind. This catches both corrupted ciphertext and
+ * recipient-side key mismatches at write time, instead of waiting for
+ * the first SQLite read to fail. Returns the VfsImportResult code:
+ * 0 = OK, 1 = WRONG_KEY.
+ */
+function verifyImportedDatabase(dbName: string, filePath = `/databases/${dbName}`): number {
+    if (!hasGlobalKey()) {
+        return 0;
+    }
+    const dbPath = `/databases/${dbName}`;
+    const verify = poolUtil.verifyEncryptionKey(filePath, dbPath);
+    if (verify === 'wrongKey') {
+        poolUtil.unlink(filePath);
+        logger.warn(
+            MODULE_NAME,
+            `Verify-on-write rejected import of ${dbName}: AEAD failed on slot 0; rolled back`,
+        );
+        return 1;
+    }
+    logger.debug(
+        MODULE_NAME,
+        `Verify-on-write OK for ${dbName} (slot 0: ${verify})`,
+    );
+    return 0;
+}
+
 /**
  * Diagnostic-only key marker. Keep logs useful for spotting whether a key
  * was present without emitting even a prefix of secret key material.
@@ -1211,7 +1280,7 @@ function keyFingerprint(key: Uint8Array): string {
  * Closes the same audit invariant the v1 verifyEncryptedImportBytes did
  * (24dd02f), adapted to the K_wrap-under-AEAD shape.
  */
-function verifyImportRekey(
+async function verifyImportRekey(
     dbName: string,
     wrapKey: Uint8Array,
     dbBytes: Uint8Array,
@@ -1224,7 +1293,7 @@ function verifyImportRekey(
     try {
         // sourceKey = wrapKey, targetKey = undefined → decrypt-to-plain.
         // Throws on any slot's AEAD tag failure; bytes never touch OPFS.
-        plain = rekeySlots(dbBytes, dbPath, wrapKey, undefined);
+        plain = await rekeySlotsParallel(dbBytes, dbPath, wrapKey, undefined);
         return { rowsAffected: 0 };
     } catch {
         // VfsImportResult.WRONG_KEY = 1
@@ -1276,7 +1345,7 @@ async function importDatabaseWithRekey(
         // rekeySlots: decrypt under wrapKey (sourceKey), re-encrypt under
         // globalKey (targetKey). Same primitive used for ExportDatabaseAsync
         // mode='rekey', just with the source/target keys swapped.
-        rekeyed = rekeySlots(dbBytes, dbPath, wrapKey, globalKey);
+        rekeyed = await rekeySlotsParallel(dbBytes, dbPath, wrapKey, globalKey);
         logger.info(
             MODULE_NAME,
             `[asym-import] rekey-out: rekeyed=${rekeyed.length}B`);
@@ -1328,7 +1397,7 @@ async function importDatabasePlain(
         // aliases each 4096-byte slot as plaintext and emits 4124-byte
         // encrypted slots under globalKey. AAD binds dbPath + slotIndex,
         // matching the VFS read path's per-page AAD.
-        rekeyed = rekeySlots(plainBytes, dbPath, undefined, globalKey);
+        rekeyed = await rekeySlotsParallel(plainBytes, dbPath, undefined, globalKey);
         logger.info(
             MODULE_NAME,
             `[plain-import] rekey-out: rekeyed=${rekeyed.length}B`);
@@ -1360,8 +1429,8 @@ async function importDatabasePlain(
  * tamper-evidence.
  */
 /**
- * Slot-rekey primitive — the single export entry point. Always closes the
- * DB first for a consistent SAH snapshot, then post-processes the raw bytes
+ * Slot-rekey primitive — the single export entry point. Closes the DB
+ * first for a consistent SAH snapshot, then post-processes the raw bytes
  * according to mode:
  *   verbatim → return raw bytes (plain pages or slot-format ciphertext as-is)
  *   plain    → rekeySlots(raw, sourceKey, undefined) → plain SQLite pages
@@ -1372,6 +1441,12 @@ async function importDatabasePlain(
  *
  * AAD binds dbPath, so REKEY / ENCRYPT output must be re-imported to the
  * same DB name.
+ *
+ * PLAIN, and VERBATIM without a registered key, ask for plain pages, which
+ * an online backup (backupDatabase) of an open DB produces without the
+ * close — reads go through the PRF-VFS, so an encrypted source comes out
+ * decrypted. REKEY / ENCRYPT and ciphertext VERBATIM work on slot bytes
+ * and keep the close + exportFile path.
  */
 async function exportDatabase(
     dbName: string,
@@ -1416,6 +1491,14 @@ async function exportDatabase(
     let raw: Uint8Array | null = null;
 
     try {
+        const online = openDatabases.has(dbName)
+            && (mode === 'plain' || (mode === 'verbatim' && !hasGlobalKey()));
+        if (online) {
+            const image = await backupDatabase(dbName);
+            logger.info(MODULE_NAME, `✓ Exported ${mode} ${dbName} online: ${image.length}B`);
+            return { rawBinary: true, data: image };
+        }
+
         await closeDatabase(dbName);
 
         raw = poolUtil.exportFile(dbPath);
@@ -1427,7 +1510,7 @@ async function exportDatabase(
             // expect to retain ownership).
             const out = raw;
             raw = null;
-            return { rawBinary: true, data: out };
+            return { rawBinary: true, data: out, closedDatabase: dbName };
         }
 
         // Shape validation before we hand bytes to rekeySlots — keeps a
@@ -1454,14 +1537,14 @@ async function exportDatabase(
         }
 
         const targetKey = (mode === 'rekey' || mode === 'encrypt') ? newKey : undefined;
-        const out = rekeySlots(raw!, dbPath, sourceKey, targetKey);
+        const out = await rekeySlotsParallel(raw!, dbPath, sourceKey, targetKey);
 
         logger.info(
             MODULE_NAME,
             `✓ Exported ${mode} ${dbName}: ${raw!.length}B → ${out.length}B`,
         );
 
-        return { rawBinary: true, data: out };
+        return { rawBinary: true, data: out, closedDatabase: dbName };
     } catch (error) {
         logger.error(MODULE_NAME, `Failed to export ${mode} ${dbName}:`, error);
         throw error;
@@ -1488,17 +1571,74 @@ async function exportDatabase(
 }
 
 /**
- * In-place plain → encrypted transition. Reads the OPFS file as plain SQLite
- * pages, re-wraps every page under the caller-supplied 32-byte key via
- * rekeySlots, unlinks the existing file, and writes the encrypted slots
- * back to the same path via the opaque importDb path. Bytes never leave
- * the worker — symmetric to ExportDatabaseAsync(REKEY) but local-only.
- *
- * Caller responsibility: no key must be registered for this path before
- * the call (the function rejects otherwise) and the caller must
- * registerEncryptionKey afterwards before opening — the registry is
- * cleared by closeDatabase below.
+ * Open an export stream (stream-ops.ts) for `dbName` with VERBATIM
+ * semantics. Plain databases are copied online, as in exportDatabase;
+ * with a registered key the stream has to carry slot-format ciphertext,
+ * so the DB is closed and its file copied (openCiphertextExportStream).
  */
+async function openDatabaseExportStream(dbName: string) {
+    if (!sqlite3 || !poolUtil) {
+        throw new Error('SQLite not initialized');
+    }
+    const dbPath = `/databases/${dbName}`;
+    if (!poolUtil.getFileNames().includes(dbPath)) {
+        throw new Error(`Database ${dbName} not found`);
+    }
+
+    if (hasGlobalKey()) {
+        await closeDatabase(dbName);
+        const stream = await openCiphertextExportStream(dbName, dbPath);
+        return { rowsAffected: stream.session, lastInsertId: stream.length, closedDatabase: dbName };
+    }
+
+    if (!openDatabases.has(dbName)) {
+        await openDatabase(dbName);
+    }
+    const stream = await openExportStream(dbName);
+    return { rowsAffected: stream.session, lastInsertId: stream.length };
+}
+
+/** Bytes copied per step into an encrypted export's temporary file. */
+const CIPHERTEXT_COPY_CHUNK = 2 * 1024 * 1024;
+
+/**
+ * Export stream over the slot-format ciphertext of the closed DB at
+ * `dbPath`. The file is copied as stored, a chunk at a time, to a
+ * temporary SAH file outside /databases/ (like openExportStream's online
+ * copy), so the stream is a snapshot even if the DB is reopened and
+ * written meanwhile. Ranges are read back from the copy; it is unlinked
+ * when the stream closes.
+ */
+async function openCiphertextExportStream(dbName: string, dbPath: string) {
+    const source: RekeyFile = poolUtil.rekeyFile(dbPath);
+    const length = source.size();
+    const tempPath = `/exports/ciphertext-${nextCiphertextExport++}.db`;
+    const chunk = new Uint8Array(Math.min(length, CIPHERTEXT_COPY_CHUNK));
+    let copied = 0;
+    try {
+        // importDb writes each chunk before asking for the next, so one buffer serves
+        await poolUtil.importDb(tempPath, () => {
+            if (copied >= length) {
+                return undefined;
+            }
+            const n = source.read(chunk.subarray(0, Math.min(chunk.length, length - copied)), copied);
+            if (n === 0) {
+                throw new Error(`Short read copying ${dbName} at ${copied} of ${length} bytes`);
+            }
+            copied += n;
+            return chunk.subarray(0, n);
+        }, true);
+
+        const copy: RekeyFile = poolUtil.rekeyFile(tempPath);
+        return openRangeExportStream(dbName, length, (dest, at) => copy.read(dest, at), () => {
+            poolUtil.unlink(tempPath);
+        });
+    } catch (error) {
+        poolUtil.unlink(tempPath);
+        throw error;
+    }
+}
+
 /**
  * Slot-size constants for shape validation. Plain SQLite pages are 4096
  * bytes; PRF-VFS encrypted slots are 4124 bytes (4096 ciphertext + 12
@@ -1508,9 +1648,10 @@ async function exportDatabase(
  * Length-only validation has a known false-positive:
  *   1024 * 4124 = 4222976 = 1031 * 4096
  * — i.e. an encrypted DB of 1024 pages and a plain DB of 1031 pages
- * have the same byte length. Plain-source paths (ENCRYPT mode +
- * encryptDb) must additionally check the 16-byte SQLite magic header
- * to refuse an encrypted-at-rest source that happens to divide evenly.
+ * have the same byte length. Plain-source paths (ENCRYPT mode here,
+ * encryptDb in rekeyInPlace) must additionally check the 16-byte SQLite
+ * magic header to refuse an encrypted-at-rest source that happens to
+ * divide evenly.
  */
 const PLAIN_SLOT_SIZE = 4096;
 const ENCRYPTED_SLOT_SIZE = 4124;
@@ -1540,86 +1681,14 @@ function hasSqliteMagicHeader(bytes: Uint8Array): boolean {
 }
 
 /**
- * Atomic-ish OPFS file replacement using SAHPool's metadata-only
- * renameFile. Steps: write new bytes to a temp slot, rename original
- * aside as a backup, rename temp into the original's place, unlink
- * backup. On any failure we attempt to roll back so the original
- * survives — the only way the original is destroyed is a successful
- * rekey followed by a successful renameFile pair, which is the
- * intended outcome.
- *
- * Caller responsibility: the worker has already closed the DB and is
- * holding the raw input bytes / new bytes. This helper only touches
- * OPFS.
+ * In-place plain → encrypted transition under `key`, a chunk of pages at a
+ * time (rekeyInPlace, vfs-prf/rekey.ts): memory stays at two chunks however
+ * large the database. Progress is recorded in the file's header sector, so
+ * a run cut short by a crash or reload resumes on the next encryptDb, and
+ * a decryptDb under the same key reverts it. A file already encrypted
+ * under `key` is left as is, so a retried EnterEncryptedAsync passes over
+ * databases it finished before the interruption.
  */
-function replaceOpfsFileAtomically(
-    dbPath: string,
-    newBytes: Uint8Array,
-    opaque: boolean,
-) {
-    const tempPath = `${dbPath}.rekey-tmp`;
-    const backupPath = `${dbPath}.rekey-bak`;
-
-    // Defensive: clean up leftovers from any prior crashed attempt
-    // before starting. unlink is no-op when the file doesn't exist.
-    const before: string[] = poolUtil.getFileNames();
-    for (const stale of [tempPath, backupPath]) {
-        if (before.includes(stale)) {
-            try { poolUtil.unlink(stale); } catch { /* best-effort */ }
-        }
-    }
-
-    let tempWritten = false;
-    let originalRenamed = false;
-    try {
-        // 1. Write new bytes to a temp slot. importDb performs basic
-        //    well-formedness checks (and verify-on-write when the path
-        //    has a registered key — note the temp path doesn't, so
-        //    the verify-on-write branch doesn't fire here regardless of
-        //    `opaque`).
-        poolUtil.importDb(tempPath, newBytes, opaque);
-        tempWritten = true;
-
-        // 2. Move the original aside as a backup so the original path
-        //    is free for the temp rename.
-        poolUtil.renameFile(dbPath, backupPath);
-        originalRenamed = true;
-
-        // 3. Promote temp into the original's place. SAHPool renameFile
-        //    is metadata-only — no file copy.
-        poolUtil.renameFile(tempPath, dbPath);
-        tempWritten = false;
-
-        // 4. Cleanup the backup; original is now the new content.
-        try { poolUtil.unlink(backupPath); } catch (e) {
-            // Step 4 failure is non-fatal: the original path holds the
-            // intended new content; the backup is orphaned but harmless
-            // (subsequent in-place ops clean it up at start).
-            logger.warn(MODULE_NAME, `replaceOpfsFileAtomically: cleanup of ${backupPath} failed`, e);
-        }
-        originalRenamed = false;
-    } catch (error) {
-        // Roll back as far as we got. Order matters:
-        //   - If originalRenamed: backup holds the original; move it
-        //     back so dbPath points at the unmodified file.
-        //   - If tempWritten: temp slot has data we no longer want.
-        if (originalRenamed) {
-            try { poolUtil.renameFile(backupPath, dbPath); } catch (rollbackErr) {
-                logger.error(
-                    MODULE_NAME,
-                    `replaceOpfsFileAtomically: rollback rename ${backupPath}→${dbPath} failed; ` +
-                    `original DB is at ${backupPath}, manual recovery required`,
-                    rollbackErr,
-                );
-            }
-        }
-        if (tempWritten) {
-            try { poolUtil.unlink(tempPath); } catch { /* best-effort */ }
-        }
-        throw error;
-    }
-}
-
 async function encryptDatabaseInPlace(dbName: string, key: Uint8Array) {
     if (!sqlite3 || !poolUtil) {
         throw new Error('SQLite not initialized');
@@ -1628,87 +1697,31 @@ async function encryptDatabaseInPlace(dbName: string, key: Uint8Array) {
         throw new Error(`encryptDb: key must be exactly 32 bytes, got ${key.length}`);
     }
 
-    const dbPath = `/databases/${dbName}`;
-
     if (hasGlobalKey()) {
         throw new Error(
             `encryptDb rejected for ${dbName}: a key is already registered; use rekey-export ceremony to re-encrypt under a different key.`,
         );
     }
 
-    const fileNames: string[] = poolUtil.getFileNames();
-    if (!fileNames.includes(dbPath)) {
-        throw new Error(`encryptDb: no existing DB at ${dbPath}`);
-    }
-
-    let raw: Uint8Array | null = null;
-    let encrypted: Uint8Array | null = null;
-    try {
-        await closeDatabase(dbName);
-
-        raw = poolUtil.exportFile(dbPath);
-
-        // Shape check: source must be plain SQLite pages. The registry
-        // says no key, but a real encrypted-at-rest file after a registry
-        // loss would still be slot-format ciphertext (4124-byte slots).
-        // Reject before rekeySlots so we can't accidentally treat the
-        // ciphertext as plain pages and corrupt it.
-        if (raw!.length === 0 || raw!.length % PLAIN_SLOT_SIZE !== 0) {
-            throw new Error(
-                `encryptDb: ${dbName} length ${raw!.length} is not a non-zero multiple of ` +
-                `the plain page size ${PLAIN_SLOT_SIZE}; refusing to encrypt a non-plain source.`,
-            );
-        }
-
-        // Length is necessary but not sufficient — 1024 encrypted slots
-        // and 1031 plain pages have the same byte length. Verify the
-        // SQLite magic header so we can't misclassify ciphertext.
-        if (!hasSqliteMagicHeader(raw!)) {
-            throw new Error(
-                `encryptDb: ${dbName} does not start with the SQLite magic header — ` +
-                `refusing to treat ciphertext as plain pages.`,
-            );
-        }
-
-        encrypted = rekeySlots(raw!, dbPath, undefined, key);
-
-        // Non-destructive replace: temp-write + double-rename means the
-        // original survives any failure inside replaceOpfsFileAtomically.
-        replaceOpfsFileAtomically(dbPath, encrypted, /* opaque */ true);
-
-        logger.info(
-            MODULE_NAME,
-            `✓ Encrypted in place ${dbName}: ${raw!.length}B → ${encrypted.length}B`,
-        );
-
-        return { rowsAffected: 0 };
-    } finally {
-        // raw is plain SQLite pages from OPFS — sensitive plaintext.
-        if (raw !== null) {
-            clearBytes(raw);
-        }
-        // encrypted is ciphertext (post-write) — not sensitive, but
-        // clearing it costs almost nothing and keeps the GC heap clean.
-        if (encrypted !== null) {
-            clearBytes(encrypted);
-        }
-    }
+    return await rekeyDatabaseInPlace(dbName, key, 'encrypt');
 }
 
 /**
- * In-place encrypted → plain transition. Snapshots the registered key,
- * reads encrypted slots, decrypts to plain pages via rekeySlots, and
- * writes the plain pages back via the atomic-replace helper. Bytes never
- * leave the worker. The caller need not call ClearEncryptionKey
- * separately — this method ALWAYS clears the registry in finally so the
- * post-state reflects the on-disk reality (plain).
+ * In-place encrypted → plain transition, the mirror of
+ * {@link encryptDatabaseInPlace}. Decrypts under `explicitKey` when given
+ * (EnterEncryptedAsync's rollback, which runs with no key installed),
+ * else under a snapshot of the registered key. An already-plain file is
+ * left as is. Does not clear the registry — the caller drops globalKey via
+ * ClearEncryptionKeyAsync if the worker should be in plain mode after.
  */
-async function decryptDatabaseInPlace(dbName: string) {
+async function decryptDatabaseInPlace(dbName: string, explicitKey?: Uint8Array) {
     if (!sqlite3 || !poolUtil) {
         throw new Error('SQLite not initialized');
     }
 
-    const dbPath = `/databases/${dbName}`;
+    if (explicitKey !== undefined) {
+        return await rekeyDatabaseInPlace(dbName, explicitKey, 'decrypt');
+    }
 
     if (!hasGlobalKey()) {
         throw new Error(
@@ -1716,67 +1729,45 @@ async function decryptDatabaseInPlace(dbName: string) {
         );
     }
 
-    const fileNames: string[] = poolUtil.getFileNames();
-    if (!fileNames.includes(dbPath)) {
-        throw new Error(`decryptDb: no existing DB at ${dbPath}`);
-    }
-
-    // Single-key model: source K is the worker-wide globalKey (the
-    // hasGlobalKey() check above passed). Snapshot it as a fresh copy so
-    // the wipe below leaves the original intact — caller controls
-    // globalKey lifecycle via Set/Clear.
+    // Single-key model: source K is the worker-wide globalKey. Snapshot it
+    // as a fresh copy so the wipe below leaves the original intact —
+    // caller controls globalKey lifecycle via Set/Clear.
     const sourceKey = snapshotGlobalKey();
     if (sourceKey === undefined) {
         // Should be unreachable given hasGlobalKey above, but defensive.
         throw new Error(`decryptDb: globalKey not set but hasGlobalKey returned true for ${dbName}`);
     }
-
-    let plain: Uint8Array | null = null;
-    let raw: Uint8Array | null = null;
     try {
-        await closeDatabase(dbName);
-
-        raw = poolUtil.exportFile(dbPath);
-
-        // Shape check: source must be slot-format ciphertext.
-        if (raw!.length === 0 || raw!.length % ENCRYPTED_SLOT_SIZE !== 0) {
-            throw new Error(
-                `decryptDb: ${dbName} length ${raw!.length} is not a non-zero multiple of ` +
-                `the encrypted slot size ${ENCRYPTED_SLOT_SIZE}; registry says encrypted but ` +
-                `the file shape says plain — refusing to decrypt a non-encrypted source.`,
-            );
-        }
-
-        plain = rekeySlots(raw!, dbPath, sourceKey, undefined);
-
-        replaceOpfsFileAtomically(dbPath, plain!, /* opaque */ false);
-
-        logger.info(
-            MODULE_NAME,
-            `✓ Decrypted in place ${dbName}: ${raw!.length}B → ${plain!.length}B`,
-        );
-
-        return { rowsAffected: 0 };
+        return await rekeyDatabaseInPlace(dbName, sourceKey, 'decrypt');
     } finally {
-        // Single-key model: the on-disk DB is now plain, but globalKey may
-        // still be set (caller-controlled). Caller is responsible for
-        // dropping globalKey via ClearEncryptionKeyAsync if the worker
-        // should be in plain mode after this op.
-        // sourceKey is the fresh snapshot — wipe so K_old doesn't
-        // linger past the operation.
         clearBytes(sourceKey);
-        // raw is encrypted ciphertext from OPFS — not a secret.
-        if (raw !== null) {
-            clearBytes(raw);
-        }
-        // plain is the decrypted intermediate — file is now plain on
-        // OPFS, but the in-memory buffer is a copy that should be wiped.
-        if (plain !== null) {
-            clearBytes(plain);
-        }
     }
 }
 
+async function rekeyDatabaseInPlace(dbName: string, key: Uint8Array, direction: RekeyDirection) {
+    const dbPath = `/databases/${dbName}`;
+    const fileNames: string[] = poolUtil.getFileNames();
+    if (!fileNames.includes(dbPath)) {
+        throw new Error(`${direction === 'encrypt' ? 'encryptDb' : 'decryptDb'}: no existing DB at ${dbPath}`);
+    }
+
+    // The VFS must not see the file while its slots change format
+    await closeDatabase(dbName);
+
+    const started = performance.now();
+    const outcome = await rekeyInPlace(poolUtil.rekeyFile(dbPath), dbPath, key, direction, {
+        chunkSlots: inPlaceChunkSlots(),
+        rekeyChunk: rekeyRangeParallel,
+    });
+
+    logger.info(
+        MODULE_NAME,
+        `✓ ${direction === 'encrypt' ? 'Encrypted' : 'Decrypted'} in place ${dbName}: ${outcome} ` +
+        `(${Math.round(performance.now() - started)} ms)`,
+    );
+    return { rowsAffected: 0 };
+}
+
 /**
  * Plain (non-encrypted) row import from V2 MessagePack payload.
  * Used for seeding, initial data load, test-data generation.
@@ -1812,3 +1803,9 @@ function importRows(dbName: string, payload: Uint8Array, metadata: any) {
 // - crypto-permissions.ts: Admin + ShareTarget + permission-table verify + role resolution
 // - crypto-header.ts: CryptoHeader parse/clear + CEK unwrap + binary helpers + schema fingerprint
 // - type-conversion.ts: MessagePack ↔ SQLite value conversion
+
+// ZIP compression helpers (zip-ops.ts) and crypto helpers (crypto-pool.ts)
+// are started from this same bundle; in a helper, this replaces the SQL
+// message handler above.
+installZipHelper();
+installCryptoHelper();
@@ -2,7 +2,7 @@
 //
 // Scope limits: a full SAHPool round-trip requires OPFS (browser-only), so
 // we test the parts we can isolate from SQLite / OPFS:
-//   - aad.ts: buildPageAad shape
+//   - aad.ts: buildPageAad shape, PageAad equivalence
 //   - key-registry.ts: lifecycle + wipe
 //   - envelope round-trip via @sqlitewasmblazor/crypto-core primitives
 // End-to-end SQL tests live in the Demo / TestApp run (browser).
@@ -12,7 +12,7 @@ import {
     encryptChaCha20Poly1305,
     decryptChaCha20Poly1305,
 } from '@sqlitewasmblazor/crypto-core';
-import { buildPageAad } from '../aad.js';
+import { buildPageAad, PageAad } from '../aad.js';
 import {
     setGlobalKey,
     clearGlobalKey,
@@ -60,6 +60,21 @@ describe('buildPageAad', () => {
     });
 });
 
+describe('PageAad', () => {
+    it('matches buildPageAad for every slot it is patched to', () => {
+        const aad = new PageAad('/databases/contacts.db');
+        for (const slot of [0, 1, 255, 256, 0x11223344, 0xffffffff]) {
+            const expected = buildPageAad('/databases/contacts.db', slot);
+            expect(Buffer.from(aad.forSlot(slot)).equals(Buffer.from(expected))).toBe(true);
+        }
+    });
+
+    it('reuses one buffer across slots', () => {
+        const aad = new PageAad('/db');
+        expect(aad.forSlot(1)).toBe(aad.forSlot(2));
+    });
+});
+
 describe('key-registry (global key)', () => {
     it('setGlobalKey installs the disk key (path-agnostic)', () => {
         const key = makeKey(42);
@@ -1,10 +1,15 @@
 import { describe, it, expect } from 'vitest';
 import {
     MANIFEST_LENGTH,
+    REKEY_PROGRESS_LENGTH,
+    clearRekeyProgress,
     deriveManifestMacKey,
     emptyManifestRegion,
     parseManifestRegion,
+    parseRekeyProgress,
     serializeManifestRegion,
+    serializeRekeyProgress,
+    type RekeyProgress,
 } from '../manifest.js';
 
 const sampleGlobalKey = (() => {
@@ -101,3 +106,70 @@ describe('disk-manifest layout', () => {
         expect(parsed.state).toBe('tampered');
     });
 });
+
+describe('rekey progress record', () => {
+    const progress: RekeyProgress = {
+        direction: 'encrypt',
+        sequence: 7,
+        slotCount: 262144,
+        doneSlots: 1536,
+        journalSlots: 512,
+    };
+
+    function write(region: Uint8Array, p: RekeyProgress): void {
+        const { record, at } = serializeRekeyProgress(p);
+        region.set(record, at);
+    }
+
+    it('reads as absent when the region is zero', () => {
+        expect(parseRekeyProgress(new Uint8Array(REKEY_PROGRESS_LENGTH))).toBeUndefined();
+    });
+
+    it('round-trips through serialize → parse', () => {
+        const region = new Uint8Array(REKEY_PROGRESS_LENGTH);
+        write(region, progress);
+        expect(parseRekeyProgress(region)).toEqual(progress);
+    });
+
+    it('alternates copies and reads the newest', () => {
+        const region = new Uint8Array(REKEY_PROGRESS_LENGTH);
+        const next = { ...progress, sequence: 8, doneSlots: 2048, journalSlots: 0 };
+        write(region, progress);
+        write(region, next);
+
+        expect(serializeRekeyProgress(progress).at).not.toBe(serializeRekeyProgress(next).at);
+        expect(parseRekeyProgress(region)).toEqual(next);
+    });
+
+    it('falls back to the previous copy when the newest write was torn', () => {
+        const region = new Uint8Array(REKEY_PROGRESS_LENGTH);
+        const next = { ...progress, sequence: 8, doneSlots: 2048, journalSlots: 0 };
+        write(region, progress);
+        const { record, at } = serializeRekeyProgress(next);
+        region.set(record.subarray(0, 20), at); // crash mid-write
+
+        expect(parseRekeyProgress(region)).toEqual(progress);
+    });
+
+    it('ignores a copy whose checksum does not match', () => {
+        const region = new Uint8Array(REKEY_PROGRESS_LENGTH);
+        write(region, progress);
+        region[serializeRekeyProgress(progress).at + 16] ^= 0x01; // doneSlots
+
+        expect(parseRekeyProgress(region)).toBeUndefined();
+    });
+
+    it('clears the older copy first', () => {
+        const region = new Uint8Array(REKEY_PROGRESS_LENGTH);
+        const finished = { ...progress, sequence: 8, doneSlots: progress.slotCount, journalSlots: 0 };
+        write(region, progress);
+        write(region, finished);
+
+        const [older, newest] = clearRekeyProgress(finished);
+        region.set(older.record, older.at);
+        // A crash here still reads the finished state
+        expect(parseRekeyProgress(region)).toEqual(finished);
+        region.set(newest.record, newest.at);
+        expect(region.every(b => b === 0)).toBe(true);
+    });
+});
@@ -0,0 +1,130 @@
+// Tests for the decrypted page cache behind encryptedRead (page-io.ts).
+//
+// Scope: the cache module on its own — capacity, LRU order, invalidation
+// and zeroize-on-evict. Its use in xRead / xWrite needs OPFS and runs in
+// the browser TestApp.
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import {
+    setPageCacheCapacity,
+    getCachedPage,
+    cachePage,
+    invalidatePage,
+    invalidateFile,
+    clearPageCache,
+    pageCacheSize,
+} from '../page-cache.js';
+import { setGlobalKey, clearGlobalKey } from '../key-registry.js';
+
+const SECTOR_SIZE = 4096;
+
+function makePage(seed: number): Uint8Array {
+    const p = new Uint8Array(SECTOR_SIZE);
+    for (let i = 0; i < p.length; i++) p[i] = (seed * 31 + i * 7 + 1) & 0xff;
+    return p;
+}
+
+function makeKey(seed: number): Uint8Array {
+    const k = new Uint8Array(32);
+    for (let i = 0; i < 32; i++) k[i] = (seed + i) & 0xff;
+    return k;
+}
+
+describe('page cache', () => {
+    beforeEach(() => {
+        setPageCacheCapacity(0);
+    });
+
+    it('is disabled at capacity 0', () => {
+        cachePage('/db', 0, makePage(1));
+        expect(getCachedPage('/db', 0)).toBeUndefined();
+        expect(pageCacheSize()).toBe(0);
+    });
+
+    it('returns a copy of the cached plaintext', () => {
+        setPageCacheCapacity(4 * SECTOR_SIZE);
+        const page = makePage(1);
+        cachePage('/db', 3, page);
+        page.fill(0);
+
+        expect(Buffer.from(getCachedPage('/db', 3)!).equals(Buffer.from(makePage(1)))).toBe(true);
+        expect(getCachedPage('/db', 4)).toBeUndefined();
+        expect(getCachedPage('/other', 3)).toBeUndefined();
+    });
+
+    it('evicts the least recently used slot and zeroes it', () => {
+        setPageCacheCapacity(2 * SECTOR_SIZE);
+        cachePage('/db', 0, makePage(0));
+        cachePage('/db', 1, makePage(1));
+        const slot0 = getCachedPage('/db', 0)!;
+        const slot1 = getCachedPage('/db', 1)!;
+        getCachedPage('/db', 0); // slot 1 is now the oldest
+
+        cachePage('/db', 2, makePage(2));
+
+        expect(pageCacheSize()).toBe(2);
+        expect(getCachedPage('/db', 1)).toBeUndefined();
+        expect(getCachedPage('/db', 0)).toBe(slot0);
+        // The evicted buffer was wiped and reused for slot 2
+        expect(getCachedPage('/db', 2)).toBe(slot1);
+        expect(Buffer.from(slot1).equals(Buffer.from(makePage(2)))).toBe(true);
+    });
+
+    it('invalidates single slots, truncated tails and whole files', () => {
+        setPageCacheCapacity(8 * SECTOR_SIZE);
+        for (let i = 0; i < 4; i++) cachePage('/db', i, makePage(i));
+        cachePage('/db-wal', 0, makePage(9));
+
+        const slot1 = getCachedPage('/db', 1)!;
+        invalidatePage('/db', 1);
+        expect(getCachedPage('/db', 1)).toBeUndefined();
+        expect(slot1.every((b) => b === 0)).toBe(true);
+
+        invalidateFile('/db', 2);
+        expect(getCachedPage('/db', 0)).toBeDefined();
+        expect(getCachedPage('/db', 2)).toBeUndefined();
+        expect(getCachedPage('/db', 3)).toBeUndefined();
+
+        invalidateFile('/db');
+        expect(getCachedPage('/db', 0)).toBeUndefined();
+        expect(getCachedPage('/db-wal', 0)).toBeDefined();
+    });
+
+    it('shrinking the capacity evicts down to the new cap', () => {
+        setPageCacheCapacity(4 * SECTOR_SIZE);
+        for (let i = 0; i < 4; i++) cachePage('/db', i, makePage(i));
+
+        setPageCacheCapacity(SECTOR_SIZE + SECTOR_SIZE / 2); // rounds down to 1 slot
+
+        expect(pageCacheSize()).toBe(1);
+        expect(getCachedPage('/db', 3)).toBeDefined();
+    });
+
+    it('is wiped when the key is installed or cleared', () => {
+        setPageCacheCapacity(4 * SECTOR_SIZE);
+        cachePage('/db', 0, makePage(0));
+        const slot0 = getCachedPage('/db', 0)!;
+
+        setGlobalKey(makeKey(1));
+        expect(pageCacheSize()).toBe(0);
+        expect(slot0.every((b) => b === 0)).toBe(true);
+
+        cachePage('/db', 0, makePage(0));
+        clearGlobalKey();
+        expect(pageCacheSize()).toBe(0);
+    });
+
+    it('clearPageCache zeroes every entry', () => {
+        setPageCacheCapacity(4 * SECTOR_SIZE);
+        cachePage('/a', 0, makePage(1));
+        cachePage('/b', 0, makePage(2));
+        const a = getCachedPage('/a', 0)!;
+        const b = getCachedPage('/b', 0)!;
+
+        clearPageCache();
+
+        expect(pageCacheSize()).toBe(0);
+        expect(a.every((x) => x === 0)).toBe(true);
+        expect(b.every((x) => x === 0)).toBe(true);
+    });
+});
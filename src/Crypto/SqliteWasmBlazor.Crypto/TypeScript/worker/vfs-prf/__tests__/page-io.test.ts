@@ -0,0 +1,214 @@
+// Tests for the run-coalesced slot I/O behind xRead / xWrite.
+//
+// Scope: EncryptedPageIo against an in-memory sync access handle and heap.
+// Every case runs the run path (MAX_RUN_SLOTS slots per SAH call) next to
+// the slot-by-slot path (one slot per call) and expects the same bytes in
+// the destination, the same plaintext on disk and the same result.
+
+import { describe, it, expect, beforeEach } from 'vitest';
+import { EncryptedPageIo, MAX_RUN_SLOTS, type SlotFile, type SlotHandle } from '../page-io.js';
+import { PageAad } from '../aad.js';
+import { setPageCacheCapacity, getCachedPage, clearPageCache } from '../page-cache.js';
+
+const SECTOR_SIZE = 4096;
+const PHYSICAL_SLOT_SIZE = 4124;
+const DATA_OFFSET = 4096;
+const DB_PATH = '/page-io.db';
+const HEAP_SIZE = 256 * SECTOR_SIZE;
+
+function makeKey(seed: number): Uint8Array {
+    const k = new Uint8Array(32);
+    for (let i = 0; i < 32; i++) k[i] = (seed + i) & 0xff;
+    return k;
+}
+
+function makeBytes(seed: number, length: number): Uint8Array {
+    const b = new Uint8Array(length);
+    for (let i = 0; i < length; i++) b[i] = (seed * 31 + i * 7 + 1) & 0xff;
+    return b;
+}
+
+/** A growable file that counts its read and write calls. */
+class MemoryHandle implements SlotHandle {
+    bytes = new Uint8Array(0);
+    reads = 0;
+    writes = 0;
+
+    read(buffer: Uint8Array, options: { at: number }): number {
+        this.reads++;
+        const n = Math.max(0, Math.min(buffer.length, this.bytes.length - options.at));
+        buffer.set(this.bytes.subarray(options.at, options.at + n));
+        return n;
+    }
+
+    write(buffer: Uint8Array, options: { at: number }): number {
+        this.writes++;
+        const end = options.at + buffer.length;
+        if (end > this.bytes.length) {
+            const grown = new Uint8Array(end);
+            grown.set(this.bytes);
+            this.bytes = grown;
+        }
+        this.bytes.set(buffer, options.at);
+        return buffer.length;
+    }
+}
+
+interface Side {
+    io: EncryptedPageIo;
+    file: SlotFile & { sah: MemoryHandle };
+    heap: Uint8Array;
+}
+
+function makeSide(maxRunSlots: number): Side {
+    const heap = new Uint8Array(HEAP_SIZE);
+    return {
+        io: new EncryptedPageIo(() => heap, DATA_OFFSET, maxRunSlots),
+        file: { path: DB_PATH, sah: new MemoryHandle(), aad: new PageAad(DB_PATH) },
+        heap,
+    };
+}
+
+const key = makeKey(7);
+const SRC = 0;
+const DEST = 128 * SECTOR_SIZE;
+
+function write(side: Side, data: Uint8Array, off: number): void {
+    side.heap.set(data, SRC);
+    side.io.encryptedWrite(side.file, key, SRC, data.length, off);
+}
+
+function read(side: Side, n: number, off: number): { complete: boolean; bytes: Uint8Array } {
+    side.heap.fill(0xaa, DEST, DEST + n);
+    const complete = side.io.encryptedRead(side.file, key, DEST, n, off);
+    return { complete, bytes: side.heap.slice(DEST, DEST + n) };
+}
+
+/** Both paths, each over its own file with the same logical contents. */
+function makePair(slots: number, seed = 1): { run: Side; slot: Side; contents: Uint8Array } {
+    const run = makeSide(MAX_RUN_SLOTS);
+    const slot = makeSide(1);
+    const contents = makeBytes(seed, slots * SECTOR_SIZE);
+    for (const side of [run, slot]) {
+        for (let i = 0; i < slots; i++) {
+            write(side, contents.subarray(i * SECTOR_SIZE, (i + 1) * SECTOR_SIZE), i * SECTOR_SIZE);
+        }
+        side.file.sah.reads = 0;
+        side.file.sah.writes = 0;
+    }
+    return { run, slot, contents };
+}
+
+/** Logical contents of a side's file, read back one slot at a time. */
+function plaintextOf(side: Side): Uint8Array {
+    const slots = (side.file.sah.bytes.length - DATA_OFFSET) / PHYSICAL_SLOT_SIZE;
+    const probe = makeSide(1);
+    probe.file.sah.bytes = side.file.sah.bytes;
+    return read(probe, slots * SECTOR_SIZE, 0).bytes;
+}
+
+describe('encrypted page I/O', () => {
+    beforeEach(() => {
+        clearPageCache();
+        setPageCacheCapacity(0);
+    });
+
+    it('reads and writes across the run boundary like the slot-by-slot path', () => {
+        const slots = MAX_RUN_SLOTS + 6;
+        const run = makeSide(MAX_RUN_SLOTS);
+        const slot = makeSide(1);
+        const data = makeBytes(3, slots * SECTOR_SIZE);
+
+        write(run, data, 0);
+        write(slot, data, 0);
+        expect(run.file.sah.writes).toBe(2);
+        expect(slot.file.sah.writes).toBe(slots);
+        expect(run.file.sah.bytes.length).toBe(slot.file.sah.bytes.length);
+        expect(Buffer.from(plaintextOf(run)).equals(Buffer.from(data))).toBe(true);
+        expect(Buffer.from(plaintextOf(slot)).equals(Buffer.from(data))).toBe(true);
+
+        // Unaligned at both ends, every slot of the file
+        const off = 100;
+        const n = data.length - 200;
+        const fromRun = read(run, n, off);
+        const fromSlot = read(slot, n, off);
+        expect(fromRun.complete).toBe(true);
+        expect(fromSlot.complete).toBe(true);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(fromSlot.bytes))).toBe(true);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(data.subarray(off, off + n)))).toBe(true);
+        expect(run.file.sah.reads).toBe(2);
+        expect(slot.file.sah.reads).toBe(slots);
+    });
+
+    it('merges partial first and last slots within one run', () => {
+        const { run, slot, contents } = makePair(8);
+        const off = 2 * SECTOR_SIZE + 300;
+        const update = makeBytes(9, 4 * SECTOR_SIZE);
+
+        write(run, update, off);
+        write(slot, update, off);
+        const expected = contents.slice();
+        expected.set(update, off);
+
+        expect(run.file.sah.writes).toBe(1);
+        expect(Buffer.from(plaintextOf(run)).equals(Buffer.from(expected))).toBe(true);
+        expect(Buffer.from(plaintextOf(slot)).equals(Buffer.from(expected))).toBe(true);
+
+        const fromRun = read(run, update.length, off);
+        const fromSlot = read(slot, update.length, off);
+        expect(fromRun.complete).toBe(true);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(fromSlot.bytes))).toBe(true);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(update))).toBe(true);
+    });
+
+    it('serves a run that mixes cached and uncached slots', () => {
+        const { run, slot, contents } = makePair(10);
+        setPageCacheCapacity(16 * SECTOR_SIZE);
+
+        // Slots 0, 4 and 5 cached; the run reads from slot 1 on
+        read(run, SECTOR_SIZE, 0);
+        read(run, 2 * SECTOR_SIZE, 4 * SECTOR_SIZE);
+        expect(getCachedPage(DB_PATH, 4)).toBeDefined();
+        run.file.sah.reads = 0;
+
+        const fromRun = read(run, 10 * SECTOR_SIZE, 0);
+        expect(fromRun.complete).toBe(true);
+        expect(run.file.sah.reads).toBe(1);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(contents))).toBe(true);
+
+        clearPageCache();
+        const fromSlot = read(slot, 10 * SECTOR_SIZE, 0);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(fromSlot.bytes))).toBe(true);
+    });
+
+    it('reports a short read at EOF inside a run and zeroes the tail', () => {
+        const { run, slot, contents } = makePair(10);
+        const off = 6 * SECTOR_SIZE + 50;
+        const n = 8 * SECTOR_SIZE;
+
+        const fromRun = read(run, n, off);
+        const fromSlot = read(slot, n, off);
+        expect(fromRun.complete).toBe(false);
+        expect(fromSlot.complete).toBe(false);
+        expect(Buffer.from(fromRun.bytes).equals(Buffer.from(fromSlot.bytes))).toBe(true);
+
+        const present = contents.length - off;
+        expect(Buffer.from(fromRun.bytes.subarray(0, present)).equals(Buffer.from(contents.subarray(off)))).toBe(true);
+        expect(fromRun.bytes.subarray(present).every(b => b === 0)).toBe(true);
+    });
+
+    it('fails the whole read on a tampered tag mid-run', () => {
+        const { run, slot } = makePair(10);
+        for (const side of [run, slot]) {
+            // Last byte of slot 6's tag
+            side.file.sah.bytes[DATA_OFFSET + 7 * PHYSICAL_SLOT_SIZE - 1] ^= 0x01;
+        }
+
+        for (const side of [run, slot]) {
+            side.heap.fill(0xaa, DEST, DEST + 10 * SECTOR_SIZE);
+            expect(() => side.io.encryptedRead(side.file, key, DEST, 10 * SECTOR_SIZE, 0)).toThrow();
+            // Slots 0-5 decrypted before slot 6 failed; none of it is left behind
+            expect(side.heap.subarray(DEST, DEST + 10 * SECTOR_SIZE).every(b => b === 0)).toBe(true);
+        }
+    });
+});
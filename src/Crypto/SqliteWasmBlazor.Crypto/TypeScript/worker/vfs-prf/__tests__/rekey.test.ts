@@ -4,14 +4,17 @@
 // Scope: pure helper. We synthesize input buffers in the same shapes the
 // worker would produce via poolUtil.exportFile() (4096-byte plain pages or
 // 4124-byte physical slots) and verify all four source/target combos.
+// rekeyInPlace runs against an in-memory RekeyFile that can crash after a
+// given number of writes, standing in for the SAH behind poolUtil.rekeyFile.
 
 import { describe, it, expect } from 'vitest';
 import {
     encryptChaCha20Poly1305,
     decryptChaCha20Poly1305,
 } from '@sqlitewasmblazor/crypto-core';
-import { rekeySlots } from '../rekey.js';
+import { rekeySlots, rekeySlotRange, rekeyInPlace, type RekeyFile } from '../rekey.js';
 import { buildPageAad } from '../aad.js';
+import { parseRekeyProgress, REKEY_PROGRESS_LENGTH } from '../manifest.js';
 
 const SECTOR_SIZE = 4096;
 const PAGE_NONCE_LEN = 12;
@@ -212,3 +215,282 @@ describe('rekeySlots — input validation', () => {
         expect(() => rekeySlots(bad, '/x', makeKey(1), undefined)).toThrow(/not a multiple/);
     });
 });
+
+describe('rekeySlotRange — split work (crypto helper ranges)', () => {
+    const dbPath = '/databases/ranges.db';
+    const slotCount = 7;
+    const plaintexts = Array.from({ length: slotCount }, (_, i) => makeSlotPlaintext(42, i));
+
+    it('disjoint ranges into one output decrypt like a single rekeySlots pass', () => {
+        const kOld = makeKey(19);
+        const kNew = makeKey(23);
+        const input = buildEncryptedExport(plaintexts, kOld, dbPath);
+        const out = new Uint8Array(slotCount * PHYSICAL_SLOT_SIZE);
+
+        rekeySlotRange(input, out, dbPath, kOld, kNew, 0, 3);
+        rekeySlotRange(input, out, dbPath, kOld, kNew, 3, 3);
+        rekeySlotRange(input, out, dbPath, kOld, kNew, 6, 1);
+
+        const recovered = decryptEncryptedExport(out, kNew, dbPath);
+        for (let i = 0; i < slotCount; i++) {
+            expect(Buffer.from(recovered[i]).equals(Buffer.from(plaintexts[i]))).toBe(true);
+        }
+    });
+
+    it('touches only its own slots of the output', () => {
+        const kOld = makeKey(29);
+        const input = buildEncryptedExport(plaintexts, kOld, dbPath);
+        const out = new Uint8Array(slotCount * SECTOR_SIZE);
+
+        rekeySlotRange(input, out, dbPath, kOld, undefined, 2, 2);
+
+        expect(out.subarray(0, 2 * SECTOR_SIZE).every(b => b === 0)).toBe(true);
+        expect(Buffer.from(out.subarray(2 * SECTOR_SIZE, 3 * SECTOR_SIZE)).equals(Buffer.from(plaintexts[2]))).toBe(true);
+        expect(Buffer.from(out.subarray(3 * SECTOR_SIZE, 4 * SECTOR_SIZE)).equals(Buffer.from(plaintexts[3]))).toBe(true);
+        expect(out.subarray(4 * SECTOR_SIZE).every(b => b === 0)).toBe(true);
+    });
+
+    it('a range binds slot indexes, not range offsets, into the AAD', () => {
+        const kOld = makeKey(31);
+        const input = buildEncryptedExport(plaintexts, kOld, dbPath);
+        // Slot 5 moved to slot 0's position must fail like a reordered page
+        const moved = new Uint8Array(input);
+        moved.copyWithin(0, 5 * PHYSICAL_SLOT_SIZE, 6 * PHYSICAL_SLOT_SIZE);
+
+        expect(() =>
+            rekeySlotRange(moved, new Uint8Array(slotCount * SECTOR_SIZE), dbPath, kOld, undefined, 0, 1),
+        ).toThrow();
+    });
+});
+
+class CrashError extends Error {}
+
+// In-memory RekeyFile that crashes on the write after `writesLeft` more:
+// half of that write's bytes land, then it throws. reload() is the file a
+// restart would find.
+class MemoryRekeyFile implements RekeyFile {
+    data: Uint8Array;
+    progress = new Uint8Array(REKEY_PROGRESS_LENGTH);
+    writesLeft = Infinity;
+    writesAt: number[] = [];
+
+    constructor(data: Uint8Array) {
+        this.data = data.slice();
+    }
+
+    size(): number {
+        return this.data.length;
+    }
+
+    read(dest: Uint8Array, at: number): number {
+        const n = Math.max(0, Math.min(dest.length, this.data.length - at));
+        dest.set(this.data.subarray(at, at + n));
+        return n;
+    }
+
+    write(src: Uint8Array, at: number): void {
+        this.writesAt.push(at);
+        if (this.data.length < at + src.length) {
+            const grown = new Uint8Array(at + src.length);
+            grown.set(this.data);
+            this.data = grown;
+        }
+        this.put(this.data, src, at);
+    }
+
+    truncate(size: number): void {
+        this.put(this.data, new Uint8Array(0), 0);
+        this.data = this.data.slice(0, size);
+    }
+
+    readProgress(): Uint8Array {
+        return this.progress.slice();
+    }
+
+    writeProgress(record: Uint8Array, at: number): void {
+        this.put(this.progress, record, at);
+    }
+
+    reload(): MemoryRekeyFile {
+        const copy = new MemoryRekeyFile(this.data);
+        copy.progress = this.progress.slice();
+        return copy;
+    }
+
+    /** Write all of `bytes`, or the first half of them and crash. */
+    private put(target: Uint8Array, bytes: Uint8Array, at: number): void {
+        if (this.writesLeft-- > 0) {
+            target.set(bytes, at);
+            return;
+        }
+        this.writesLeft = Infinity;
+        target.set(bytes.subarray(0, bytes.length >> 1), at);
+        throw new CrashError('simulated crash');
+    }
+}
+
+/**
+ * Run `convert` on a copy of `source` that crashes after `writes` writes.
+ * Returns the reloaded file, or undefined when the run finished first.
+ */
+async function runUntilCrash(
+    source: Uint8Array,
+    writes: number,
+    convert: (file: RekeyFile) => Promise<unknown>,
+): Promise<MemoryRekeyFile | undefined> {
+    const file = new MemoryRekeyFile(source);
+    file.writesLeft = writes;
+    try {
+        await convert(file);
+        return undefined;
+    } catch (error) {
+        if (!(error instanceof CrashError)) {
+            throw error;
+        }
+        return file.reload();
+    }
+}
+
+function makePlainDb(slotCount: number): Uint8Array {
+    const db = new Uint8Array(slotCount * SECTOR_SIZE);
+    for (let i = 0; i < slotCount; i++) {
+        db.set(makeSlotPlaintext(77, i), i * SECTOR_SIZE);
+    }
+    db.set(new TextEncoder().encode('SQLite format 3\0'), 0);
+    return db;
+}
+
+function expectPlain(file: MemoryRekeyFile, db: Uint8Array): void {
+    expect(Buffer.from(file.data).equals(Buffer.from(db))).toBe(true);
+    expect(parseRekeyProgress(file.progress)).toBeUndefined();
+}
+
+function expectEncrypted(file: MemoryRekeyFile, db: Uint8Array, key: Uint8Array, dbPath: string): void {
+    const recovered = decryptEncryptedExport(file.data, key, dbPath);
+    expect(recovered.length).toBe(db.length / SECTOR_SIZE);
+    for (let i = 0; i < recovered.length; i++) {
+        expect(Buffer.from(recovered[i]).equals(Buffer.from(db.subarray(i * SECTOR_SIZE, (i + 1) * SECTOR_SIZE))))
+            .toBe(true);
+    }
+    expect(parseRekeyProgress(file.progress)).toBeUndefined();
+}
+
+describe('rekeyInPlace — chunked encrypt / decrypt on disk', () => {
+    const dbPath = '/databases/in-place.db';
+    const key = makeKey(50);
+    const chunkSlots = 2;
+    const db = makePlainDb(7);
+
+    const encrypt = (file: RekeyFile, chunk = chunkSlots) =>
+        rekeyInPlace(file, dbPath, key, 'encrypt', { chunkSlots: chunk });
+    const decrypt = (file: RekeyFile, chunk = chunkSlots) =>
+        rekeyInPlace(file, dbPath, key, 'decrypt', { chunkSlots: chunk });
+
+    async function encryptedDb(): Promise<Uint8Array> {
+        const file = new MemoryRekeyFile(db);
+        await encrypt(file);
+        return file.data;
+    }
+
+    it('encrypts a plain file and decrypts it back byte for byte', async () => {
+        const file = new MemoryRekeyFile(db);
+
+        expect(await encrypt(file)).toBe('converted');
+        expectEncrypted(file, db, key, dbPath);
+
+        expect(await decrypt(file)).toBe('converted');
+        expectPlain(file, db);
+    });
+
+    it('leaves a file already in the target format unchanged', async () => {
+        const plain = new MemoryRekeyFile(db);
+        expect(await decrypt(plain)).toBe('unchanged');
+        expectPlain(plain, db);
+
+        const encrypted = new MemoryRekeyFile(await encryptedDb());
+        const before = encrypted.data.slice();
+        expect(await encrypt(encrypted)).toBe('unchanged');
+        expect(Buffer.from(encrypted.data).equals(Buffer.from(before))).toBe(true);
+    });
+
+    it('leaves an empty file unchanged in both directions', async () => {
+        const empty = new MemoryRekeyFile(new Uint8Array(0));
+
+        expect(await encrypt(empty)).toBe('unchanged');
+        expect(await decrypt(empty)).toBe('unchanged');
+        expect(empty.size()).toBe(0);
+        expect(empty.writesAt).toEqual([]);
+        expect(parseRekeyProgress(empty.progress)).toBeUndefined();
+    });
+
+    it('refuses a file in neither format', async () => {
+        const otherKey = new MemoryRekeyFile(await encryptedDb());
+        await expect(rekeyInPlace(otherKey, dbPath, makeKey(51), 'decrypt')).rejects.toThrow(/neither/);
+
+        const garbage = new MemoryRekeyFile(makeSlotPlaintext(3, 0));
+        await expect(encrypt(garbage)).rejects.toThrow(/neither/);
+    });
+
+    it('journals only chunks whose output meets their own input', async () => {
+        // Encrypted slot i starts 28 * i bytes past page i: from slot 147 on
+        // (147 * 28 >= 4096) a one-slot chunk writes clear of its input.
+        const large = makePlainDb(150);
+        const file = new MemoryRekeyFile(large);
+
+        await encrypt(file, 1);
+
+        expect(file.writesAt.filter(at => at === 150 * PHYSICAL_SLOT_SIZE).length).toBe(147);
+        expectEncrypted(file, large, key, dbPath);
+    });
+
+    it('resumes an encrypt interrupted at any write', async () => {
+        let crashes = 0;
+        for (let writes = 0; ; writes++) {
+            const reloaded = await runUntilCrash(db, writes, encrypt);
+            if (reloaded === undefined) {
+                break;
+            }
+            crashes++;
+            // The resumed run may use another chunk size
+            await encrypt(reloaded, chunkSlots + (writes & 1));
+            expectEncrypted(reloaded, db, key, dbPath);
+        }
+        expect(crashes).toBeGreaterThan(10);
+    });
+
+    it('resumes a decrypt interrupted at any write', async () => {
+        const encrypted = await encryptedDb();
+        for (let writes = 0; ; writes++) {
+            const reloaded = await runUntilCrash(encrypted, writes, decrypt);
+            if (reloaded === undefined) {
+                break;
+            }
+            await decrypt(reloaded);
+            expectPlain(reloaded, db);
+        }
+    });
+
+    it('reverts an interrupted encrypt when asked to decrypt', async () => {
+        for (let writes = 0; ; writes++) {
+            const reloaded = await runUntilCrash(db, writes, encrypt);
+            if (reloaded === undefined) {
+                break;
+            }
+            await decrypt(reloaded);
+            expectPlain(reloaded, db);
+        }
+    });
+
+    it('will not finish an encrypt under a different key', async () => {
+        const reloaded = (await runUntilCrash(db, 6, encrypt))!;
+        expect(parseRekeyProgress(reloaded.progress)!.doneSlots).toBeGreaterThan(0);
+        const before = reloaded.data.slice();
+
+        await expect(rekeyInPlace(reloaded, dbPath, makeKey(52), 'encrypt', { chunkSlots }))
+            .rejects.toThrow(/different key/);
+        expect(Buffer.from(reloaded.data).equals(Buffer.from(before))).toBe(true);
+
+        await encrypt(reloaded);
+        expectEncrypted(reloaded, db, key, dbPath);
+    });
+});
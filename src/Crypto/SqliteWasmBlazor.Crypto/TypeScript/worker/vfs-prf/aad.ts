@@ -24,3 +24,27 @@ export function buildPageAad(dbPath: string, slotIndex: number): Uint8Array {
 
     return aad;
 }
+
+/**
+ * The AAD of every slot of one file in a single reusable buffer: the
+ * "prf-vfs-v1|" + dbPath + "|" prefix is encoded once and forSlot only
+ * patches the slot index, so per-page I/O does not allocate. The buffer
+ * returned by forSlot is overwritten by the next call. Byte-identical to
+ * buildPageAad.
+ */
+export class PageAad {
+    private readonly bytes: Uint8Array;
+    private readonly slotView: DataView;
+
+    constructor(dbPath: string) {
+        const prefixBytes = textEncoder.encode(AAD_PREFIX + dbPath + '|');
+        this.bytes = new Uint8Array(prefixBytes.length + 4);
+        this.bytes.set(prefixBytes, 0);
+        this.slotView = new DataView(this.bytes.buffer, prefixBytes.length, 4);
+    }
+
+    forSlot(slotIndex: number): Uint8Array {
+        this.slotView.setUint32(0, slotIndex >>> 0, true); // little-endian
+        return this.bytes;
+    }
+}
@@ -11,9 +11,11 @@
 // ClearEncryptionKeyAsync at lock). The VFS hot path (xRead / xWrite)
 // reads `globalKey` *dynamically* per page I/O — there is no per-OFile
 // snapshot, so a key swap takes effect on every open file immediately
-// without closing them.
+// without closing them. Plaintext decrypted under the previous key is
+// wiped from the VFS's page cache (page-cache.ts) on every swap.
 
 import { clearBytes } from '@sqlitewasmblazor/crypto-core';
+import { clearPageCache } from './page-cache.js';
 
 let globalKey: Uint8Array | undefined;
 
@@ -30,6 +32,7 @@ export function setGlobalKey(key: Uint8Array): void {
     if (globalKey !== undefined && globalKey !== key) {
         clearBytes(globalKey);
     }
+    clearPageCache();
     globalKey = key;
 }
 
@@ -41,6 +44,7 @@ export function clearGlobalKey(): void {
         clearBytes(globalKey);
         globalKey = undefined;
     }
+    clearPageCache();
 }
 
 /**
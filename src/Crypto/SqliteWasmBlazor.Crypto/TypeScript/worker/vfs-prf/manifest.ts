@@ -3,8 +3,8 @@
 // Layout — bytes 524..1023 of every SAHPool slot's header sector
 // (the per-slot first 4096 bytes are SAHPool's plaintext metadata; bytes
 // 0..523 are claimed by SAHPool for path/flags/digest, leaving 524..4095
-// free; we reserve 524..1023 for this manifest, leaving 1024..4095 for
-// future use).
+// free; we reserve 524..1023 for this manifest and 1024..1151 for the rekey
+// progress record, leaving 1152..4095 for future use).
 //
 //   524     4   magic = "PFAM"   (PRF-VFS Passkey Manifest)
 //   528     1   schemaVersion    (0x01 — gradual-evolution knob)
@@ -13,7 +13,8 @@
 //   532     N   body             MessagePack { credentialId, pubkeyFingerprint }
 //   532+N   …   zero-pad to 991
 //   992    32   HMAC-SHA256(macKey, bytes[524..991])
-//  1024     …   (rest of header sector unused)
+//  1024   128   rekey progress (see below)
+//  1152     …   (rest of header sector unused)
 //
 // macKey is HKDF(globalVfsKey, salt=∅, info="sqlite-vfs:manifest-mac:v1", L=32)
 // — domain-separated from anything else derived from the global key, so a
@@ -28,6 +29,25 @@
 // Disk-as-unit invariant: every DB in the pool carries the *same* manifest.
 // Mismatch across DBs is reported as a typed `mismatch` state — corruption
 // or partial-import accident.
+//
+// Rekey progress — bytes 1024..1151, written only while an in-place
+// encrypt / decrypt (rekeyInPlace in rekey.ts) is under way, zero otherwise.
+// Two 64-byte copies, written alternately (sequence & 1 picks the copy), so
+// a write torn by a crash leaves the previous state readable:
+//
+//   +0      4   magic = "PFRK"
+//   +4      1   schemaVersion    (0x01)
+//   +5      1   direction        (1 = encrypt, 2 = decrypt)
+//   +6      2   reserved
+//   +8      4   sequence         (uint32 LE; newest valid copy wins)
+//   +12     4   slotCount        (uint32 LE)
+//   +16     4   doneSlots        (uint32 LE) — the high-water mark
+//   +20     4   journalSlots     (uint32 LE) — next chunk journaled, 0 = none
+//   +24    32   reserved
+//   +56     8   SHA-256(bytes[+0..+55])[0..8] — torn-write check, not a MAC
+//
+// Not authenticated: it names no key material and a forged one can only
+// make the next rekey fail its AEAD checks or mis-detect the file's shape.
 
 import {
     clearBytes,
@@ -48,7 +68,13 @@ const HEADER_LEN = 8; // magic(4) + version(1) + reserved(1) + bodyLen(2)
 const BODY_OFFSET_REL = HEADER_LEN; // 8
 const MAX_BODY_LEN = MAC_OFFSET_REL - HEADER_LEN; // 460
 
+export const REKEY_PROGRESS_OFFSET = MANIFEST_END; // 1024
+export const REKEY_PROGRESS_LENGTH = 128;
+const REKEY_RECORD_LENGTH = 64;
+const REKEY_CHECKSUM_OFFSET_REL = 56;
+
 const MAGIC = new Uint8Array([0x50, 0x46, 0x41, 0x4d]); // "PFAM"
+const REKEY_MAGIC = new Uint8Array([0x50, 0x46, 0x52, 0x4b]); // "PFRK"
 const SCHEMA_VERSION_V1 = 0x01;
 const HKDF_INFO = 'sqlite-vfs:manifest-mac:v1';
 
@@ -182,6 +208,100 @@ export function emptyManifestRegion(): Uint8Array {
     return new Uint8Array(MANIFEST_LENGTH);
 }
 
+export type RekeyDirection = 'encrypt' | 'decrypt';
+
+/** One in-place rekey's persisted state (see the layout above). */
+export interface RekeyProgress {
+    direction: RekeyDirection;
+    sequence: number;
+    slotCount: number;
+    doneSlots: number;
+    journalSlots: number;
+}
+
+/**
+ * Newest valid copy in the 128-byte progress region at 1024..1151, or
+ * undefined when neither copy is valid (no rekey under way, or the first
+ * record's write was torn before anything else happened).
+ */
+export function parseRekeyProgress(region: Uint8Array): RekeyProgress | undefined {
+    if (region.length !== REKEY_PROGRESS_LENGTH) {
+        throw new Error(`Rekey progress region must be ${REKEY_PROGRESS_LENGTH} bytes, got ${region.length}`);
+    }
+    let newest: RekeyProgress | undefined;
+    for (let at = 0; at < REKEY_PROGRESS_LENGTH; at += REKEY_RECORD_LENGTH) {
+        const copy = parseRekeyRecord(region.subarray(at, at + REKEY_RECORD_LENGTH));
+        if (copy !== undefined && (newest === undefined || copy.sequence > newest.sequence)) {
+            newest = copy;
+        }
+    }
+    return newest;
+}
+
+/**
+ * Serialize `progress` into the copy its sequence selects. Returns the
+ * 64-byte record and its offset within the progress region; the caller
+ * writes just that record so the other copy survives a torn write.
+ */
+export function serializeRekeyProgress(progress: RekeyProgress): { record: Uint8Array; at: number } {
+    const record = new Uint8Array(REKEY_RECORD_LENGTH);
+    const view = new DataView(record.buffer);
+    record.set(REKEY_MAGIC, 0);
+    record[4] = SCHEMA_VERSION_V1;
+    record[5] = progress.direction === 'encrypt' ? 1 : 2;
+    view.setUint32(8, progress.sequence, true);
+    view.setUint32(12, progress.slotCount, true);
+    view.setUint32(16, progress.doneSlots, true);
+    view.setUint32(20, progress.journalSlots, true);
+    record.set(
+        sha256(record.subarray(0, REKEY_CHECKSUM_OFFSET_REL)).subarray(0, REKEY_RECORD_LENGTH - REKEY_CHECKSUM_OFFSET_REL),
+        REKEY_CHECKSUM_OFFSET_REL);
+    return { record, at: (progress.sequence & 1) * REKEY_RECORD_LENGTH };
+}
+
+/**
+ * Zeroed records that clear the progress region once `progress` (the
+ * newest record) is finished: the older copy first, so a crash in between
+ * still finds the finished state rather than the one before it.
+ */
+export function clearRekeyProgress(progress: RekeyProgress): Array<{ record: Uint8Array; at: number }> {
+    const newest = (progress.sequence & 1) * REKEY_RECORD_LENGTH;
+    return [
+        { record: new Uint8Array(REKEY_RECORD_LENGTH), at: REKEY_RECORD_LENGTH - newest },
+        { record: new Uint8Array(REKEY_RECORD_LENGTH), at: newest },
+    ];
+}
+
+function parseRekeyRecord(record: Uint8Array): RekeyProgress | undefined {
+    for (let i = 0; i < REKEY_MAGIC.length; i++) {
+        if (record[i] !== REKEY_MAGIC[i]) {
+            return undefined;
+        }
+    }
+    const checksum = sha256(record.subarray(0, REKEY_CHECKSUM_OFFSET_REL));
+    for (let i = REKEY_CHECKSUM_OFFSET_REL; i < REKEY_RECORD_LENGTH; i++) {
+        if (record[i] !== checksum[i - REKEY_CHECKSUM_OFFSET_REL]) {
+            return undefined;
+        }
+    }
+    if (record[4] !== SCHEMA_VERSION_V1 || (record[5] !== 1 && record[5] !== 2)) {
+        return undefined;
+    }
+
+    const view = new DataView(record.buffer, record.byteOffset, record.byteLength);
+    const progress: RekeyProgress = {
+        direction: record[5] === 1 ? 'encrypt' : 'decrypt',
+        sequence: view.getUint32(8, true),
+        slotCount: view.getUint32(12, true),
+        doneSlots: view.getUint32(16, true),
+        journalSlots: view.getUint32(20, true),
+    };
+    if (progress.doneSlots + progress.journalSlots > progress.slotCount) {
+        return undefined;
+    }
+    return progress;
+}
+
 function constantTimeEqual(a: Uint8Array, b: Uint8Array): boolean {
     if (a.length !== b.length) {
         return false;
@@ -0,0 +1,159 @@
+// Decrypted page cache for the PRF-keyed VFS.
+//
+// encryptedRead (page-io.ts) opens the AEAD envelope of a whole 4124-byte
+// slot for every xRead it touches. That includes SQLite's repeated 100-byte
+// reads of the database header in slot 0, and interior B-tree pages read
+// again after SQLite's own page cache dropped them. This cache keeps the
+// plaintext of recently decrypted slots, keyed by (path, slotIndex), so such
+// reads are a copy instead of a ChaCha20-Poly1305 open.
+//
+// Bounded by a byte capacity (SqliteWasmBlazorCryptoOptions.PageCacheSize,
+// sent with setGlobalEncryptionKey); 0 — the default — disables it. The
+// least recently used slot is evicted first. Every buffer leaving the cache
+// (evicted, invalidated or cleared) is zeroed before it is dropped or reused
+// for the next entry, so plaintext lives only in cached entries.
+//
+// Invalidation (callers in page-io.ts, sahpool-prf-vfs.ts and key-registry.ts):
+//   - encryptedWrite                       → the written slots
+//   - xTruncate                            → slots at and past the new size
+//   - xClose, delete, rename, import       → the whole file
+//   - key installed or cleared, pool reset → everything
+//
+// One instance per worker, like the key registry: the worker has one disk.
+
+const SLOT_PLAINTEXT_LEN = 4096;
+
+interface CachedSlot {
+    path: string;
+    slotIndex: number;
+    plaintext: Uint8Array;
+}
+
+/** path → slotIndex → entry. */
+const files = new Map<string, Map<number, CachedSlot>>();
+/** All entries, least recently used first (Set keeps insertion order). */
+const recency = new Set<CachedSlot>();
+/** Zeroed buffers of removed entries, reused before allocating. */
+const spare: Uint8Array[] = [];
+let capacitySlots = 0;
+
+/**
+ * Set the cache's memory cap in bytes, rounded down to whole 4096-byte
+ * slots. 0 disables the cache and wipes it. Shrinking evicts the least
+ * recently used slots.
+ */
+export function setPageCacheCapacity(bytes: number): void {
+    capacitySlots = Math.max(0, Math.floor(bytes / SLOT_PLAINTEXT_LEN));
+    while (recency.size > capacitySlots) {
+        evictOldest();
+    }
+    spare.length = Math.min(spare.length, capacitySlots - recency.size);
+}
+
+/**
+ * Cached plaintext of `slotIndex` in `path`, or undefined. The returned
+ * buffer stays owned by the cache: copy out of it right away and never
+ * keep or modify it.
+ */
+export function getCachedPage(path: string, slotIndex: number): Uint8Array | undefined {
+    const entry = files.get(path)?.get(slotIndex);
+    if (entry === undefined) {
+        return undefined;
+    }
+    recency.delete(entry);
+    recency.add(entry);
+    return entry.plaintext;
+}
+
+/**
+ * Keep a copy of the 4096-byte `plaintext` of `slotIndex` in `path`. The
+ * caller keeps ownership of (and wipes) its own buffer.
+ */
+export function cachePage(path: string, slotIndex: number, plaintext: Uint8Array): void {
+    if (capacitySlots === 0 || plaintext.length !== SLOT_PLAINTEXT_LEN) {
+        return;
+    }
+
+    let slots = files.get(path);
+    const existing = slots?.get(slotIndex);
+    if (existing !== undefined) {
+        existing.plaintext.set(plaintext);
+        recency.delete(existing);
+        recency.add(existing);
+        return;
+    }
+
+    if (recency.size >= capacitySlots) {
+        evictOldest();
+    }
+    const buffer = spare.pop() ?? new Uint8Array(SLOT_PLAINTEXT_LEN);
+    buffer.set(plaintext);
+
+    const entry: CachedSlot = { path, slotIndex, plaintext: buffer };
+    if (slots === undefined) {
+        slots = new Map();
+        files.set(path, slots);
+    }
+    slots.set(slotIndex, entry);
+    recency.add(entry);
+}
+
+/** Drop `slotIndex` of `path` (it was rewritten). */
+export function invalidatePage(path: string, slotIndex: number): void {
+    const entry = files.get(path)?.get(slotIndex);
+    if (entry !== undefined) {
+        remove(entry);
+    }
+}
+
+/**
+ * Drop the slots of `path` from `fromSlot` on: all of them by default
+ * (closed, deleted, renamed or replaced file), or those past a truncation.
+ */
+export function invalidateFile(path: string, fromSlot = 0): void {
+    const slots = files.get(path);
+    if (slots === undefined) {
+        return;
+    }
+    for (const entry of [...slots.values()]) {
+        if (entry.slotIndex >= fromSlot) {
+            remove(entry);
+        }
+    }
+}
+
+/** Wipe every cached slot (key change, pool reset). */
+export function clearPageCache(): void {
+    for (const entry of recency) {
+        entry.plaintext.fill(0);
+    }
+    recency.clear();
+    files.clear();
+    spare.length = 0;
+}
+
+/** Number of cached slots, for tests and diagnostics. */
+export function pageCacheSize(): number {
+    return recency.size;
+}
+
+function evictOldest(): void {
+    const [oldest] = recency;
+    if (oldest !== undefined) {
+        remove(oldest);
+    }
+}
+
+function remove(entry: CachedSlot): void {
+    recency.delete(entry);
+    const slots = files.get(entry.path)!;
+    slots.delete(entry.slotIndex);
+    if (slots.size === 0) {
+        files.delete(entry.path);
+    }
+    entry.plaintext.fill(0);
+    // Spare buffers and entries together stay within the cap
+    if (spare.length + recency.size < capacitySlots) {
+        spare.push(entry.plaintext);
+    }
+}
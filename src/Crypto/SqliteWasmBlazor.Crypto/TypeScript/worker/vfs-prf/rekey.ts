@@ -12,13 +12,25 @@
 //
 // AAD is `prf-vfs-v1|{dbPath}|{slotIndex}` for both decrypt and re-encrypt —
 // the recipient must import to the same dbPath the sender exported from.
+//
+// rekeySlotRange does the work for a range of slots in place; rekeySlots
+// runs it over the whole buffer, and crypto helpers (crypto-pool.ts) run
+// it over their share of a shared one. rekeyInPlace (below) runs it chunk
+// by chunk over a file on disk.
 
 import {
-    encryptChaCha20Poly1305,
-    decryptChaCha20Poly1305,
+    encryptChaCha20Poly1305Into,
+    decryptChaCha20Poly1305Into,
     clearBytes,
 } from '@sqlitewasmblazor/crypto-core';
-import { buildPageAad } from './aad.js';
+import { buildPageAad, PageAad } from './aad.js';
+import {
+    clearRekeyProgress,
+    parseRekeyProgress,
+    serializeRekeyProgress,
+    type RekeyDirection,
+    type RekeyProgress,
+} from './manifest.js';
 
 const SECTOR_SIZE = 4096;
 const PAGE_NONCE_LEN = 12;
@@ -62,75 +74,356 @@ export function rekeySlots(
         `targetKey=${keyFingerprint(targetKey)} ` +
         `slots=${slotCount} (sourceSlot=${sourceSlotSize} → targetSlot=${targetSlotSize})`);
 
-    for (let i = 0; i < slotCount; i++) {
-        const srcStart = i * sourceSlotSize;
-        const aad = buildPageAad(dbPath, i);
-        if (i === 0) {
-            // AAD = "prf-vfs-v1|{dbPath}|" + LE-uint32(slotIndex). Decode
-            // the prefix back to a string so two log lines from sender
-            // and recipient can be diffed at a glance.
-            const aadPrefixLen = aad.length - 4;
-            const aadPrefix = new TextDecoder().decode(aad.subarray(0, aadPrefixLen));
-            const aadIdxLE = Array.from(aad.subarray(aadPrefixLen))
-                .map(b => b.toString(16).padStart(2, '0')).join('');
-            const slotHead = Array.from(bytesIn.subarray(srcStart, srcStart + 8))
-                .map(b => b.toString(16).padStart(2, '0')).join('');
-            console.log(
-                `[rekeySlots] slot[0] aad.prefix="${aadPrefix}" aad.idxLE=${aadIdxLE} ` +
-                `aad.totalLen=${aad.length} sourceSlot[0..8]=${slotHead}`);
-        }
+    // AAD = "prf-vfs-v1|{dbPath}|" + LE-uint32(slotIndex). Decode the
+    // prefix back to a string so two log lines from sender and recipient
+    // can be diffed at a glance.
+    const aad = buildPageAad(dbPath, 0);
+    const aadPrefixLen = aad.length - 4;
+    const aadPrefix = new TextDecoder().decode(aad.subarray(0, aadPrefixLen));
+    const aadIdxLE = Array.from(aad.subarray(aadPrefixLen))
+        .map(b => b.toString(16).padStart(2, '0')).join('');
+    const slotHead = Array.from(bytesIn.subarray(0, 8))
+        .map(b => b.toString(16).padStart(2, '0')).join('');
+    console.log(
+        `[rekeySlots] slot[0] aad.prefix="${aadPrefix}" aad.idxLE=${aadIdxLE} ` +
+        `aad.totalLen=${aad.length} sourceSlot[0..8]=${slotHead}`);
 
-        // When sourceKey is undefined the plaintext is a Uint8Array view
-        // INTO bytesIn (no fresh allocation, callers own the lifetime).
-        // When sourceKey is defined the plaintext is a fresh allocation
-        // returned by decryptChaCha20Poly1305 — that copy is real secret
-        // material and must be wiped after the slot's encrypt/copy step.
-        // Per-slot try/finally so an encrypt failure mid-loop still wipes
-        // the slot's plaintext.
-        let plaintext: Uint8Array;
-        const ownsPlaintext = sourceKey !== undefined;
-        if (sourceKey === undefined) {
-            plaintext = bytesIn.subarray(srcStart, srcStart + SECTOR_SIZE);
-        } else {
-            const ciphertext = bytesIn.subarray(srcStart, srcStart + PAGE_PLAINTEXT_LEN);
-            const nonce = bytesIn.subarray(
-                srcStart + PAGE_PLAINTEXT_LEN,
-                srcStart + PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN,
-            );
-            const tag = bytesIn.subarray(
-                srcStart + PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN,
-                srcStart + PHYSICAL_SLOT_SIZE,
-            );
-            const cipherPlusTag = new Uint8Array(PAGE_PLAINTEXT_LEN + PAGE_TAG_LEN);
-            cipherPlusTag.set(ciphertext, 0);
-            cipherPlusTag.set(tag, PAGE_PLAINTEXT_LEN);
-            plaintext = decryptChaCha20Poly1305(
-                { ciphertext: cipherPlusTag, nonce },
-                sourceKey,
-                aad,
-            );
-        }
+    rekeySlotRange(bytesIn, out, dbPath, sourceKey, targetKey, 0, slotCount);
+    return out;
+}
+
+/**
+ * Rekey slots [firstSlot, firstSlot + count) of `bytesIn` into the same
+ * slots of `out`, both laid out as in {@link rekeySlots} (slot i at
+ * i * slot size). `slotBase` is the file slot index of buffer slot 0 —
+ * non-zero when the buffers hold one chunk of a larger file — and only
+ * enters the AAD. Throws on the first slot whose AEAD tag fails under
+ * `sourceKey`; slots before it are already written to `out`.
+ */
+export function rekeySlotRange(
+    bytesIn: Uint8Array,
+    out: Uint8Array,
+    dbPath: string,
+    sourceKey: Uint8Array | undefined,
+    targetKey: Uint8Array | undefined,
+    firstSlot: number,
+    count: number,
+    slotBase = 0,
+): void {
+    const sourceSlotSize = sourceKey === undefined ? SECTOR_SIZE : PHYSICAL_SLOT_SIZE;
+    const targetSlotSize = targetKey === undefined ? SECTOR_SIZE : PHYSICAL_SLOT_SIZE;
+
+    const aad = new PageAad(dbPath);
+    // ciphertext || tag, the AEAD's view of a slot, for both directions
+    const sealed = new Uint8Array(PAGE_PLAINTEXT_LEN + PAGE_TAG_LEN);
+    const nonce = new Uint8Array(PAGE_NONCE_LEN);
+    // Decrypted pages are real secret material: one scratch page, wiped
+    // in finally so a failure mid-range still clears it. A plain source
+    // is used in place (a view into bytesIn, owned by the caller).
+    const scratch = sourceKey === undefined ? undefined : new Uint8Array(PAGE_PLAINTEXT_LEN);
+
+    try {
+        for (let i = firstSlot; i < firstSlot + count; i++) {
+            const srcStart = i * sourceSlotSize;
+            const slotAad = aad.forSlot(slotBase + i);
+
+            let plaintext: Uint8Array;
+            if (scratch === undefined) {
+                plaintext = bytesIn.subarray(srcStart, srcStart + SECTOR_SIZE);
+            } else {
+                sealed.set(bytesIn.subarray(srcStart, srcStart + PAGE_PLAINTEXT_LEN), 0);
+                sealed.set(
+                    bytesIn.subarray(srcStart + PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN, srcStart + PHYSICAL_SLOT_SIZE),
+                    PAGE_PLAINTEXT_LEN,
+                );
+                decryptChaCha20Poly1305Into(
+                    sealed,
+                    sourceKey!,
+                    bytesIn.subarray(srcStart + PAGE_PLAINTEXT_LEN, srcStart + PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN),
+                    slotAad,
+                    scratch,
+                );
+                plaintext = scratch;
+            }
 
-        try {
             const dstStart = i * targetSlotSize;
             if (targetKey === undefined) {
                 out.set(plaintext, dstStart);
             } else {
-                const enc = encryptChaCha20Poly1305(plaintext, targetKey, aad);
-                // enc.ciphertext = ciphertext(4096) || tag(16) — length 4112.
-                out.set(enc.ciphertext.subarray(0, PAGE_PLAINTEXT_LEN), dstStart);
-                out.set(enc.nonce, dstStart + PAGE_PLAINTEXT_LEN);
-                out.set(
-                    enc.ciphertext.subarray(PAGE_PLAINTEXT_LEN),
-                    dstStart + PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN,
-                );
+                encryptChaCha20Poly1305Into(plaintext, targetKey, slotAad, sealed, nonce);
+                // sealed = ciphertext(4096) || tag(16) → ciphertext | nonce | tag
+                out.set(sealed.subarray(0, PAGE_PLAINTEXT_LEN), dstStart);
+                out.set(nonce, dstStart + PAGE_PLAINTEXT_LEN);
+                out.set(sealed.subarray(PAGE_PLAINTEXT_LEN), dstStart + PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN);
             }
-        } finally {
-            if (ownsPlaintext) {
-                clearBytes(plaintext);
+        }
+    } finally {
+        if (scratch !== undefined) {
+            clearBytes(scratch);
+        }
+        clearBytes(sealed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// In-place rekey
+//
+// rekeyInPlace converts one SAHPool file between plain pages and encrypted
+// slots on disk, a chunk at a time, so it holds two chunks in memory rather
+// than two copies of the database. An encrypted slot is 28 bytes longer
+// than its page, so the walk runs in the direction that keeps every write
+// clear of input not yet converted: encrypt from the last slot down (the
+// file grows into its tail), decrypt from slot 0 up (it shrinks behind the
+// cursor). The file is truncated to its final size at the end.
+//
+// A chunk's output can still overlap its own input — near the start of the
+// file, where the 28-byte shift has not yet added up to a chunk. Such a
+// chunk's input is first copied to a journal past the end of both layouts
+// (slotCount * 4124), so redoing the chunk after a crash reads intact input.
+// The progress record in the header sector (manifest.ts) is the high-water
+// mark. Each record is written after a flush of the data it describes, so
+// a crash at any point resumes from the last one:
+//
+//   {done d}            → copy chunk input to the journal → flush
+//   {done d, journal k} → write chunk output              → flush
+//   {done d + k}        → next chunk …                    → truncate
+//   (zeroed)
+//
+// Calling the opposite direction on an interrupted file reverses it: the
+// slots already converted are converted back.
+// ---------------------------------------------------------------------------
+
+/** Slots per chunk of an in-place rekey (2 MB of pages). */
+export const REKEY_CHUNK_SLOTS = 512;
+
+/**
+ * Data area and progress record of one SAHPool file. Offsets are relative
+ * to the start of the data, past the pool's 4096-byte header sector.
+ */
+export interface RekeyFile {
+    size(): number;
+    /** Reads up to dest.length bytes at `at`; returns the count read. */
+    read(dest: Uint8Array, at: number): number;
+    write(src: Uint8Array, at: number): void;
+    truncate(size: number): void;
+    /** The 128-byte progress region (REKEY_PROGRESS_LENGTH). */
+    readProgress(): Uint8Array;
+    /** Flush the data, then write `record` at `at` in the progress region and flush. */
+    writeProgress(record: Uint8Array, at: number): void;
+}
+
+/**
+ * Rekeys every slot of `bytesIn` into `out` (see {@link rekeySlotRange});
+ * buffer slot 0 is file slot `slotBase`. crypto-pool.ts supplies one that
+ * splits the chunk across its helpers.
+ */
+export type ChunkRekey = (
+    bytesIn: Uint8Array,
+    out: Uint8Array,
+    dbPath: string,
+    sourceKey: Uint8Array | undefined,
+    targetKey: Uint8Array | undefined,
+    slotBase: number,
+) => void | Promise<void>;
+
+export interface RekeyInPlaceOptions {
+    /** Slots per chunk; {@link REKEY_CHUNK_SLOTS} by default. */
+    chunkSlots?: number;
+    /** {@link rekeySlotRange} in this thread by default. */
+    rekeyChunk?: ChunkRekey;
+}
+
+/**
+ * `'converted'` — started and finished here; `'resumed'` — finished an
+ * interrupted run in the same direction; `'reverted'` — undid an
+ * interrupted run in the other direction; `'unchanged'` — the file already
+ * was in the target format (encrypted: under `key`).
+ */
+export type RekeyInPlaceOutcome = 'converted' | 'resumed' | 'reverted' | 'unchanged';
+
+/**
+ * Encrypt (plain pages → slots under `key`) or decrypt (slots under `key` →
+ * plain pages) the file behind `file` in place, resuming or reverting an
+ * interrupted run recorded in its progress region. The file must not be
+ * open in SQLite. Throws when the file is in neither format, or when
+ * `key` does not open the slots already encrypted; the file is left as it
+ * was found (an interrupted run stays resumable).
+ */
+export async function rekeyInPlace(
+    file: RekeyFile,
+    dbPath: string,
+    key: Uint8Array,
+    direction: RekeyDirection,
+    options: RekeyInPlaceOptions = {},
+): Promise<RekeyInPlaceOutcome> {
+    const chunkSlots = Math.max(1, options.chunkSlots ?? REKEY_CHUNK_SLOTS);
+    const rekeyChunk = options.rekeyChunk ?? rekeyWholeChunk;
+
+    let outcome: RekeyInPlaceOutcome = 'resumed';
+    let progress = parseRekeyProgress(file.readProgress());
+    if (progress === undefined) {
+        const slotCount = slotsToConvert(file, dbPath, key, direction);
+        if (slotCount === 0) {
+            return 'unchanged';
+        }
+        progress = recordProgress(file, { direction, sequence: 1, slotCount, doneSlots: 0, journalSlots: 0 });
+        outcome = 'converted';
+    }
+
+    const slotCount = progress.slotCount;
+    const journalAt = slotCount * PHYSICAL_SLOT_SIZE;
+    const bufferSlots = Math.max(chunkSlots, progress.journalSlots);
+    // Either buffer holds plaintext pages, depending on the direction
+    const input = new Uint8Array(bufferSlots * PHYSICAL_SLOT_SIZE);
+    const output = new Uint8Array(bufferSlots * PHYSICAL_SLOT_SIZE);
+
+    const convertChunk = async (p: RekeyProgress, count: number, fromJournal: boolean): Promise<RekeyProgress> => {
+        const encrypt = p.direction === 'encrypt';
+        const sourceSlotSize = encrypt ? SECTOR_SIZE : PHYSICAL_SLOT_SIZE;
+        const targetSlotSize = encrypt ? PHYSICAL_SLOT_SIZE : SECTOR_SIZE;
+        const first = encrypt ? p.slotCount - p.doneSlots - count : p.doneSlots;
+        const chunkIn = input.subarray(0, count * sourceSlotSize);
+        const chunkOut = output.subarray(0, count * targetSlotSize);
+
+        readFully(file, chunkIn, fromJournal ? journalAt : first * sourceSlotSize, dbPath);
+        // Output [first * 4124 ..) or [.. (first + count) * 4096) meets this chunk's own input
+        if (!fromJournal && first * PHYSICAL_SLOT_SIZE < (first + count) * SECTOR_SIZE) {
+            file.write(chunkIn, journalAt);
+            p = recordProgress(file, { ...p, sequence: p.sequence + 1, journalSlots: count });
+        }
+
+        await rekeyChunk(chunkIn, chunkOut, dbPath, encrypt ? undefined : key, encrypt ? key : undefined, first);
+        file.write(chunkOut, first * targetSlotSize);
+        return recordProgress(file, {
+            ...p, sequence: p.sequence + 1, doneSlots: p.doneSlots + count, journalSlots: 0,
+        });
+    };
+
+    // Encrypting more slots under a different key than those already
+    // encrypted would leave a file no key opens. Decryption checks as it goes.
+    const assertSameKey = (p: RekeyProgress): void => {
+        if (p.direction === 'encrypt' && p.doneSlots > 0
+            && !slotOpens(file, dbPath, key, p.slotCount - p.doneSlots)) {
+            throw new Error(
+                `rekeyInPlace: ${dbPath} was partly encrypted under a different key; ` +
+                `resume it with the key it was started with.`);
+        }
+    };
+
+    try {
+        assertSameKey(progress);
+        if (progress.direction !== direction) {
+            // A journaled chunk is only whole in the journal: finish it the
+            // old way, then count the converted slots from the other end.
+            if (progress.journalSlots > 0) {
+                progress = await convertChunk(progress, progress.journalSlots, true);
             }
+            progress = recordProgress(file, {
+                direction,
+                sequence: progress.sequence + 1,
+                slotCount,
+                doneSlots: slotCount - progress.doneSlots,
+                journalSlots: 0,
+            });
+            assertSameKey(progress);
+            outcome = 'reverted';
+        }
+
+        if (progress.journalSlots > 0) {
+            progress = await convertChunk(progress, progress.journalSlots, true);
         }
+        while (progress.doneSlots < slotCount) {
+            progress = await convertChunk(progress, Math.min(chunkSlots, slotCount - progress.doneSlots), false);
+        }
+
+        file.truncate(slotCount * (direction === 'encrypt' ? PHYSICAL_SLOT_SIZE : SECTOR_SIZE));
+        for (const { record, at } of clearRekeyProgress(progress)) {
+            file.writeProgress(record, at);
+        }
+        return outcome;
+    } finally {
+        clearBytes(input);
+        clearBytes(output);
     }
+}
 
-    return out;
+/** "SQLite format 3\0" — mirrors the check in sqlite-worker.ts. */
+const SQLITE_MAGIC_HEADER = new TextEncoder().encode('SQLite format 3\0');
+
+/**
+ * Slots a fresh run converts: all of them when the file is in the source
+ * format, 0 when it already is in the target one or is empty (a database
+ * SQLite has not written yet is valid in both).
+ */
+function slotsToConvert(file: RekeyFile, dbPath: string, key: Uint8Array, direction: RekeyDirection): number {
+    const size = file.size();
+    if (size === 0) {
+        return 0;
+    }
+    const head = new Uint8Array(SQLITE_MAGIC_HEADER.length);
+    const plain = size % SECTOR_SIZE === 0
+        && file.read(head, 0) === head.length
+        && head.every((b, i) => b === SQLITE_MAGIC_HEADER[i]);
+    if (plain) {
+        return direction === 'encrypt' ? size / SECTOR_SIZE : 0;
+    }
+
+    const encrypted = size % PHYSICAL_SLOT_SIZE === 0 && slotOpens(file, dbPath, key, 0);
+    if (encrypted) {
+        return direction === 'decrypt' ? size / PHYSICAL_SLOT_SIZE : 0;
+    }
+
+    throw new Error(
+        `rekeyInPlace: ${dbPath} (${size} B) is neither plain SQLite pages nor slots encrypted under this key; ` +
+        `refusing to ${direction} it.`);
+}
+
+/** Whether encrypted slot `slotIndex` of the file opens under `key`. */
+function slotOpens(file: RekeyFile, dbPath: string, key: Uint8Array, slotIndex: number): boolean {
+    const slot = new Uint8Array(PHYSICAL_SLOT_SIZE);
+    const plaintext = new Uint8Array(PAGE_PLAINTEXT_LEN);
+    try {
+        if (file.read(slot, slotIndex * PHYSICAL_SLOT_SIZE) !== PHYSICAL_SLOT_SIZE) {
+            return false;
+        }
+        const nonce = slot.slice(PAGE_PLAINTEXT_LEN, PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN);
+        slot.copyWithin(PAGE_PLAINTEXT_LEN, PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN);
+        decryptChaCha20Poly1305Into(
+            slot.subarray(0, PAGE_PLAINTEXT_LEN + PAGE_TAG_LEN),
+            key,
+            nonce,
+            buildPageAad(dbPath, slotIndex),
+            plaintext,
+        );
+        return true;
+    } catch {
+        return false;
+    } finally {
+        clearBytes(plaintext);
+    }
+}
+
+function rekeyWholeChunk(
+    bytesIn: Uint8Array,
+    out: Uint8Array,
+    dbPath: string,
+    sourceKey: Uint8Array | undefined,
+    targetKey: Uint8Array | undefined,
+    slotBase: number,
+): void {
+    const sourceSlotSize = sourceKey === undefined ? SECTOR_SIZE : PHYSICAL_SLOT_SIZE;
+    rekeySlotRange(bytesIn, out, dbPath, sourceKey, targetKey, 0, bytesIn.length / sourceSlotSize, slotBase);
+}
+
+function recordProgress(file: RekeyFile, progress: RekeyProgress): RekeyProgress {
+    const { record, at } = serializeRekeyProgress(progress);
+    file.writeProgress(record, at);
+    return progress;
+}
+
+function readFully(file: RekeyFile, dest: Uint8Array, at: number, dbPath: string): void {
+    const n = file.read(dest, at);
+    if (n !== dest.length) {
+        throw new Error(`rekeyInPlace: ${dbPath} is truncated (read ${n} of ${dest.length} bytes at ${at})`);
+    }
 }
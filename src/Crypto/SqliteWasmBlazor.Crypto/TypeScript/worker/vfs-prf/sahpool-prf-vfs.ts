@@ -3,8 +3,9 @@
 // Fork of sqlite.org's sqlite3-vfs-opfs-sahpool.c-pp.js (SQLite 3.53) with
 // ChaCha20-Poly1305 page-level encryption added. The modifications are
 // localized to xRead / xWrite (slot-aligned crypto) and xFileSize /
-// xTruncate (logical ↔ physical size translation). Everything else is
-// byte-for-byte identical to vendor.
+// xTruncate (logical ↔ physical size translation), plus invalidation of the
+// decrypted page cache (page-cache.ts) wherever a file's bytes change or it
+// goes away. Everything else is byte-for-byte identical to vendor.
 //
 // A file opened by this VFS is encrypted iff the worker-wide globalKey is set.
 // xRead / xWrite read that globalKey dynamically for every top-level
@@ -30,13 +31,20 @@
 // between files.
 
 import {
-    encryptChaCha20Poly1305,
     decryptChaCha20Poly1305,
     clearBytes,
 } from '@sqlitewasmblazor/crypto-core';
 import { getGlobalKey, hasGlobalKey } from './key-registry.js';
-import { buildPageAad } from './aad.js';
-import { MANIFEST_OFFSET, MANIFEST_LENGTH } from './manifest.js';
+import { buildPageAad, PageAad } from './aad.js';
+import {
+    MANIFEST_OFFSET,
+    MANIFEST_LENGTH,
+    REKEY_PROGRESS_OFFSET,
+    REKEY_PROGRESS_LENGTH,
+} from './manifest.js';
+import type { RekeyFile } from './rekey.js';
+import { clearPageCache, invalidateFile } from './page-cache.js';
+import { EncryptedPageIo } from './page-io.js';
 
 // ==========================================================================
 // Types — loose because sqlite-wasm has no shipped TypeScript declarations.
@@ -73,11 +81,25 @@ export interface PrfPoolUtil {
     getFileNames(): string[];
     reserveMinimumCapacity(min: number): Promise<number>;
     exportFile(name: string): Uint8Array;
-    importDb(name: string, bytes: Uint8Array | ArrayBuffer, opaque?: boolean): number | Promise<number>;
+    /**
+     * Write a database file from bytes, or chunk by chunk from a callback
+     * returning the next chunk (undefined at the end). `opaque` skips the
+     * SQLite header / size checks and the WAL-mode patch (ciphertext).
+     */
+    importDb(
+        name: string,
+        bytes: Uint8Array | ArrayBuffer | (() => Promise<Uint8Array | undefined> | Uint8Array | undefined),
+        opaque?: boolean,
+    ): number | Promise<number>;
     wipeFiles(): Promise<void>;
     unlink(filename: string): boolean;
     renameFile(oldPath: string, newPath: string): true;
-    verifyEncryptionKey(path: string): VfsKeyVerifyResult;
+    /**
+     * AEAD-test slot 0 of `path` under the global key. `aadPath` is the
+     * path the pages are bound to, when it differs — a streamed import's
+     * temporary file is checked against the database it will replace.
+     */
+    verifyEncryptionKey(path: string, aadPath?: string): VfsKeyVerifyResult;
     /**
      * Names of every main-DB file currently present in the SAHPool —
      * filters out journal/WAL/SHM siblings. Path-stripped: returns just
@@ -99,6 +121,13 @@ export interface PrfPoolUtil {
      * length mismatch or unknown path.
      */
     writeManifestSlot(path: string, region: Uint8Array): void;
+    /**
+     * Data area and rekey progress record (bytes 1024..1151 of the header
+     * sector) of the given path, for an in-place encrypt / decrypt — see
+     * {@link './rekey.js'} rekeyInPlace. Throws when the path is not in
+     * the pool.
+     */
+    rekeyFile(path: string): RekeyFile;
     removeVfs(): Promise<boolean>;
     pauseVfs(): PrfPoolUtil;
     unpauseVfs(): Promise<PrfPoolUtil>;
@@ -292,6 +321,8 @@ class OpfsSAHPool {
     private loggers: Array<(...args: any[]) => void>;
     private flagComputeDigestV2: number;
     private persistentFileTypes: number;
+    // Encrypted slot I/O of xRead / xWrite (page-io.ts)
+    private pageIo = new EncryptedPageIo(() => this.wasm.heap8u(), HEADER_OFFSET_DATA);
     $error?: any;
 
     constructor(sqlite3: Sqlite3, options: PrfSAHPoolOptions) {
@@ -412,6 +443,7 @@ class OpfsSAHPool {
     }
 
     releaseAccessHandles() {
+        clearPageCache();
         for (const ah of this.mapSAHToName.keys()) ah.close();
         this.mapSAHToName.clear();
         this.mapFilenameToSAH.clear();
@@ -501,8 +533,11 @@ class OpfsSAHPool {
         }
     }
 
+    // The passkey manifest and the rekey progress record behind it
     clearManifestRegion(sah: FileSystemSyncAccessHandle): void {
-        sah.write(new Uint8Array(MANIFEST_LENGTH), { at: MANIFEST_OFFSET });
+        sah.write(
+            new Uint8Array(REKEY_PROGRESS_OFFSET + REKEY_PROGRESS_LENGTH - MANIFEST_OFFSET),
+            { at: MANIFEST_OFFSET });
     }
 
     computeDigest(byteArray: Uint8Array, fileFlags: number) {
@@ -543,6 +578,7 @@ class OpfsSAHPool {
     }
 
     deletePath(path: string) {
+        invalidateFile(path);
         const sah = this.mapFilenameToSAH.get(path);
         if (sah) {
             this.mapFilenameToSAH.delete(path);
@@ -564,6 +600,8 @@ class OpfsSAHPool {
     renameFile(oldPath: string, newPath: string): true {
         const sah = this.mapFilenameToSAH.get(oldPath);
         if (!sah) toss('File not found:', oldPath);
+        invalidateFile(oldPath);
+        invalidateFile(newPath);
         sah.read(this.apBody, { at: 0 });
         const flags = this.dvBody.getUint32(HEADER_OFFSET_FLAGS);
         this.mapFilenameToSAH.delete(oldPath);
@@ -582,10 +620,13 @@ class OpfsSAHPool {
      *     global key + slot-0 AAD.
      *   - `'wrongKey'` if the tag fails to verify.
      *
+     * `aadPath` overrides the path bound into the AAD (a temporary import
+     * file holding pages of another path).
+     *
      * Caller is responsible for whatever follow-up the outcome demands —
      * e.g. refusing import / keeping the disk locked on `'wrongKey'`.
      */
-    verifyEncryptionKey(path: string): VfsKeyVerifyResult {
+    verifyEncryptionKey(path: string, aadPath: string = path): VfsKeyVerifyResult {
         const sah = this.mapFilenameToSAH.get(path);
         if (!sah) return 'noExistingDb';
 
@@ -608,7 +649,7 @@ class OpfsSAHPool {
         const cipherPlusTag = new Uint8Array(PAGE_PLAINTEXT_LEN + PAGE_TAG_LEN);
         cipherPlusTag.set(ciphertext, 0);
         cipherPlusTag.set(tag, PAGE_PLAINTEXT_LEN);
-        const aad = buildPageAad(path, 0);
+        const aad = buildPageAad(aadPath, 0);
         let slot0pt: Uint8Array | undefined;
         try {
             slot0pt = decryptChaCha20Poly1305(
@@ -660,6 +701,40 @@ class OpfsSAHPool {
         sah!.flush();
     }
 
+    /**
+     * The file of `path` as rekeyInPlace sees it: its data area (offsets
+     * past the header sector) and its rekey progress record. Progress
+     * writes flush the data written before them and then themselves, which
+     * is the ordering rekeyInPlace's crash recovery relies on. The file
+     * must not be open in SQLite; its cached pages are dropped here.
+     */
+    rekeyFile(path: string): RekeyFile {
+        const sah = this.mapFilenameToSAH.get(path);
+        if (!sah) toss('rekeyFile: file not found:', path);
+        invalidateFile(path);
+        return {
+            size: () => sah!.getSize() - HEADER_OFFSET_DATA,
+            read: (dest, at) => sah!.read(dest, { at: HEADER_OFFSET_DATA + at }),
+            write: (src, at) => {
+                const nWrote = sah!.write(src, { at: HEADER_OFFSET_DATA + at });
+                if (nWrote !== src.length) {
+                    toss('rekeyFile: expected to write', src.length, 'bytes but wrote', nWrote);
+                }
+            },
+            truncate: (size) => sah!.truncate(HEADER_OFFSET_DATA + size),
+            readProgress: () => {
+                const region = new Uint8Array(REKEY_PROGRESS_LENGTH);
+                sah!.read(region, { at: REKEY_PROGRESS_OFFSET });
+                return region;
+            },
+            writeProgress: (record, at) => {
+                sah!.flush();
+                sah!.write(record, { at: REKEY_PROGRESS_OFFSET + at });
+                sah!.flush();
+            },
+        };
+    }
+
     storeErr(e?: any, code?: number): number | undefined {
         if (e) {
             (e as any).sqlite3Rc = code || this.capi.SQLITE_IOERR;
@@ -711,15 +786,16 @@ class OpfsSAHPool {
         return b;
     }
 
-    async importDbChunked(name: string, callback: () => any) {
+    async importDbChunked(name: string, callback: () => any, opaque: boolean = false) {
         const sah =
             this.mapFilenameToSAH.get(name) ||
             this.nextAvailableSAH() ||
             toss('No available handles to import to.');
+        invalidateFile(name);
         sah.truncate(0);
         let nWrote = 0,
             chunk: any,
-            checkedHeader = false;
+            checkedHeader = opaque;
         try {
             while (undefined !== (chunk = await callback())) {
                 if (chunk instanceof ArrayBuffer) chunk = new Uint8Array(chunk);
@@ -730,15 +806,19 @@ class OpfsSAHPool {
                 sah.write(chunk, { at: HEADER_OFFSET_DATA + nWrote });
                 nWrote += chunk.byteLength;
             }
-            if (nWrote < 512 || 0 !== nWrote % 512) {
-                toss('Input size', nWrote, 'is not correct for an SQLite database.');
-            }
-            if (!checkedHeader) {
-                const header = new Uint8Array(20);
-                sah.read(header, { at: 0 });
-                this.util.affirmDbHeader(header);
+            // Opaque (ciphertext) input skips the same checks and WAL patch
+            // as in importDb below
+            if (!opaque) {
+                if (nWrote < 512 || 0 !== nWrote % 512) {
+                    toss('Input size', nWrote, 'is not correct for an SQLite database.');
+                }
+                if (!checkedHeader) {
+                    const header = new Uint8Array(20);
+                    sah.read(header, { at: 0 });
+                    this.util.affirmDbHeader(header);
+                }
+                sah.write(new Uint8Array([1, 1]), { at: HEADER_OFFSET_DATA + 18 });
             }
-            sah.write(new Uint8Array([1, 1]), { at: HEADER_OFFSET_DATA + 18 });
         } catch (e) {
             this.setAssociatedPath(sah, '', 0);
             throw e;
@@ -754,11 +834,12 @@ class OpfsSAHPool {
         opaque: boolean = false
     ) {
         if (bytes instanceof ArrayBuffer) bytes = new Uint8Array(bytes);
-        else if (bytes instanceof Function) return this.importDbChunked(name, bytes);
+        else if (bytes instanceof Function) return this.importDbChunked(name, bytes, opaque);
         const sah =
             this.mapFilenameToSAH.get(name) ||
             this.nextAvailableSAH() ||
             toss('No available handles to import to.');
+        invalidateFile(name);
         const n = (bytes as Uint8Array).byteLength;
 
         // Skip the SQLite-format-3 header check, the 512-byte alignment
@@ -874,6 +955,7 @@ class OpfsSAHPool {
                     try {
                         pool.log(`xClose ${file.path}`);
                         pool.mapS3FileToOFileSet(pFile, false);
+                        invalidateFile(file.path);
                         file.sah.flush();
                         if (file.flags & capi.SQLITE_OPEN_DELETEONCLOSE) {
                             pool.deletePath(file.path);
@@ -934,7 +1016,7 @@ class OpfsSAHPool {
                         }
                         return 0;
                     }
-                    return self.encryptedRead(file, key, pDest, n, off);
+                    return self.pageIo.encryptedRead(file, key, pDest, n, off) ? 0 : capi.SQLITE_IOERR_SHORT_READ;
                 } catch (e) {
                     return pool.storeErr(e, capi.SQLITE_IOERR)!;
                 }
@@ -962,6 +1044,8 @@ class OpfsSAHPool {
                     const physicalSz = !hasGlobalKey()
                         ? logicalSz
                         : logicalToPhysicalSize(logicalSz);
+                    // Slots from the first one not kept whole are gone
+                    invalidateFile(file.path, Math.floor(logicalSz / SECTOR_SIZE));
                     file.sah.truncate(HEADER_OFFSET_DATA + physicalSz);
                     return 0;
                 } catch (e) {
@@ -988,7 +1072,8 @@ class OpfsSAHPool {
                         );
                         return n === nBytes ? 0 : pool.storeErr(new Error('short write'), capi.SQLITE_IOERR)!;
                     }
-                    return self.encryptedWrite(file, key, pSrc, n, off);
+                    self.pageIo.encryptedWrite(file, key, pSrc, n, off);
+                    return 0;
                 } catch (e) {
                     return pool.storeErr(e, capi.SQLITE_IOERR)!;
                 }
@@ -996,201 +1081,6 @@ class OpfsSAHPool {
         };
     }
 
-    // ==========================================================================
-    // Encryption hot paths (offset-remapping).
-    //
-    // A logical SECTOR_SIZE-byte slot at logical offset (slotIndex*4096) maps
-    // to a 4124-byte physical slot at physical offset (slotIndex*4124) on disk
-    // (relative to HEADER_OFFSET_DATA). Physical layout:
-    //     [ ciphertext(4096) | nonce(12) | tag(16) ]
-    //
-    // ChaCha20-Poly1305 returns ciphertext-with-tag-appended of length
-    // plaintext.length + 16 = 4112. We split that into ciphertext(4096) at the
-    // slot head and tag(16) after the nonce.
-    //
-    // Logical bytes ↔ physical bytes is a pure 4096/4124 remap — no
-    // "reserved tail" is exposed to SQLite, so every logical byte has a real
-    // plaintext counterpart on disk.
-    // ==========================================================================
-
-    private slotScratch = new Uint8Array(PHYSICAL_SLOT_SIZE);
-    private plaintextScratch = new Uint8Array(PAGE_PLAINTEXT_LEN);
-
-    private encryptedRead(file: OFile, key: Uint8Array, pDest: number, n: number, off: number): number {
-        if (n <= 0) return 0;
-
-        const heap = this.wasm.heap8u();
-        const endOff = off + n;
-        let cursor = off;
-        let destPtr = Number(pDest);
-
-        while (cursor < endOff) {
-            const slotIndex = Math.floor(cursor / SECTOR_SIZE);
-            const slotStart = slotIndex * SECTOR_SIZE;
-            const slotEnd = slotStart + SECTOR_SIZE;
-
-            const thisSliceEnd = Math.min(endOff, slotEnd);
-            const startInSlot = cursor - slotStart;
-            const bytesFromSlot = thisSliceEnd - cursor;
-
-            const physicalSlotStart = slotIndex * PHYSICAL_SLOT_SIZE;
-            const nRead = file.sah.read(this.slotScratch, {
-                at: HEADER_OFFSET_DATA + physicalSlotStart,
-            });
-            if (nRead < PHYSICAL_SLOT_SIZE) {
-                // Partial/absent physical slot → short read (SQLite handles
-                // this as "past EOF", e.g. a fresh DB where the page hasn't
-                // been written yet).
-                heap.fill(0, destPtr, destPtr + (endOff - cursor));
-                return this.capi.SQLITE_IOERR_SHORT_READ;
-            }
-
-            const ciphertext = this.slotScratch.subarray(0, PAGE_PLAINTEXT_LEN);
-            const nonce = this.slotScratch.subarray(
-                PAGE_PLAINTEXT_LEN,
-                PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN
-            );
-            const tag = this.slotScratch.subarray(PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN);
-            const cipherPlusTag = new Uint8Array(PAGE_PLAINTEXT_LEN + PAGE_TAG_LEN);
-            cipherPlusTag.set(ciphertext, 0);
-            cipherPlusTag.set(tag, PAGE_PLAINTEXT_LEN);
-
-            const aad = buildPageAad(file.path, slotIndex);
-            let plaintext: Uint8Array | undefined;
-            try {
-                plaintext = decryptChaCha20Poly1305(
-                    { ciphertext: cipherPlusTag, nonce },
-                    key,
-                    aad
-                );
-
-                heap.set(
-                    plaintext.subarray(startInSlot, startInSlot + bytesFromSlot),
-                    destPtr
-                );
-                destPtr += bytesFromSlot;
-                cursor = thisSliceEnd;
-            } finally {
-                if (plaintext) { clearBytes(plaintext); }
-                clearBytes(cipherPlusTag);
-            }
-        }
-
-        // Defense-in-depth: the plaintext scratch buffer used by the
-        // read-modify-write path (readSlotPlaintextOrZero) retains the last
-        // decrypted page until overwritten. Zero it after each op so a
-        // heap-snapshot attacker sees only the most recent sub-microsecond
-        // window rather than the last page accessed at any earlier time.
-        // ~4 KB memset per page op ≈ <1 µs; negligible vs the crypto cost.
-        this.plaintextScratch.fill(0);
-
-        return 0;
-    }
-
-    private encryptedWrite(file: OFile, key: Uint8Array, pSrc: number, n: number, off: number): number {
-        if (n <= 0) return 0;
-
-        const heap = this.wasm.heap8u();
-        const endOff = off + n;
-        let cursor = off;
-        let srcPtr = Number(pSrc);
-
-        while (cursor < endOff) {
-            const slotIndex = Math.floor(cursor / SECTOR_SIZE);
-            const slotStart = slotIndex * SECTOR_SIZE;
-            const slotEnd = slotStart + SECTOR_SIZE;
-
-            const thisSliceEnd = Math.min(endOff, slotEnd);
-            const startInSlot = cursor - slotStart;
-            const bytesFromSlot = thisSliceEnd - cursor;
-
-            const isFullSlot = startInSlot === 0 && bytesFromSlot === PAGE_PLAINTEXT_LEN;
-
-            let plaintext: Uint8Array;
-            if (isFullSlot) {
-                plaintext = this.plaintextScratch;
-                plaintext.set(heap.subarray(srcPtr, srcPtr + bytesFromSlot), 0);
-            } else {
-                // Read-modify-write: pull existing plaintext (or zero-fill
-                // if past-EOF), overlay new bytes, re-encrypt.
-                plaintext = this.readSlotPlaintextOrZero(file, key, slotIndex);
-                plaintext.set(
-                    heap.subarray(srcPtr, srcPtr + bytesFromSlot),
-                    startInSlot
-                );
-            }
-
-            const aad = buildPageAad(file.path, slotIndex);
-            const enc = encryptChaCha20Poly1305(plaintext, key, aad);
-            // enc.ciphertext = ciphertext(4096) || tag(16) — length 4112.
-
-            // Assemble physical slot: ciphertext(4096) | nonce(12) | tag(16)
-            this.slotScratch.set(enc.ciphertext.subarray(0, PAGE_PLAINTEXT_LEN), 0);
-            this.slotScratch.set(enc.nonce, PAGE_PLAINTEXT_LEN);
-            this.slotScratch.set(
-                enc.ciphertext.subarray(PAGE_PLAINTEXT_LEN),
-                PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN
-            );
-
-            const physicalSlotStart = slotIndex * PHYSICAL_SLOT_SIZE;
-            const nWrote = file.sah.write(this.slotScratch, {
-                at: HEADER_OFFSET_DATA + physicalSlotStart,
-            });
-            if (nWrote !== PHYSICAL_SLOT_SIZE) {
-                return this.pool_storeErr(
-                    new Error('short slot write'),
-                    this.capi.SQLITE_IOERR
-                );
-            }
-
-            srcPtr += bytesFromSlot;
-            cursor = thisSliceEnd;
-        }
-
-        // Same defense-in-depth as encryptedRead: clear the plaintext scratch.
-        this.plaintextScratch.fill(0);
-
-        return 0;
-    }
-
-    private readSlotPlaintextOrZero(file: OFile, key: Uint8Array, slotIndex: number): Uint8Array {
-        const physicalSlotStart = HEADER_OFFSET_DATA + slotIndex * PHYSICAL_SLOT_SIZE;
-        const nRead = file.sah.read(this.slotScratch, { at: physicalSlotStart });
-        if (nRead < PHYSICAL_SLOT_SIZE) {
-            // No existing data → zero-initialized plaintext.
-            this.plaintextScratch.fill(0);
-            return this.plaintextScratch;
-        }
-        const ciphertext = this.slotScratch.subarray(0, PAGE_PLAINTEXT_LEN);
-        const nonce = this.slotScratch.subarray(
-            PAGE_PLAINTEXT_LEN,
-            PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN
-        );
-        const tag = this.slotScratch.subarray(PAGE_PLAINTEXT_LEN + PAGE_NONCE_LEN);
-        const cipherPlusTag = new Uint8Array(PAGE_PLAINTEXT_LEN + PAGE_TAG_LEN);
-        cipherPlusTag.set(ciphertext, 0);
-        cipherPlusTag.set(tag, PAGE_PLAINTEXT_LEN);
-        const aad = buildPageAad(file.path, slotIndex);
-        let pt: Uint8Array | undefined;
-        try {
-            pt = decryptChaCha20Poly1305(
-                { ciphertext: cipherPlusTag, nonce },
-                key,
-                aad
-            );
-            this.plaintextScratch.set(pt, 0);
-            return this.plaintextScratch;
-        } finally {
-            if (pt) { clearBytes(pt); }
-            clearBytes(cipherPlusTag);
-        }
-    }
-
-    private pool_storeErr(e: any, code: number): number {
-        this.storeErr(e, code);
-        return code;
-    }
-
     // ==========================================================================
     // sqlite3_vfs registration.
     // ==========================================================================
@@ -1296,6 +1186,7 @@ class OpfsSAHPool {
                         flags,
                         sah: sah!,
                         lockType: capi.SQLITE_LOCK_NONE,
+                        aad: new PageAad(path),
                     };
                     pool.mapS3FileToOFileSet(pFile, file);
 
@@ -1385,8 +1276,8 @@ class OpfsSAHPoolUtil {
     renameFile(oldPath: string, newPath: string) {
         return this.p.renameFile(oldPath, newPath);
     }
-    verifyEncryptionKey(path: string) {
-        return this.p.verifyEncryptionKey(path);
+    verifyEncryptionKey(path: string, aadPath?: string) {
+        return this.p.verifyEncryptionKey(path, aadPath);
     }
     async removeVfs() {
         return this.p.removeVfs();
@@ -1411,6 +1302,9 @@ class OpfsSAHPoolUtil {
     writeManifestSlot(path: string, region: Uint8Array) {
         return this.p.writeManifestSlot(path, region);
     }
+    rekeyFile(path: string) {
+        return this.p.rekeyFile(path);
+    }
 }
 
 // ==========================================================================
@@ -1423,6 +1317,8 @@ interface OFile {
     flags: number;
     sah: FileSystemSyncAccessHandle;
     lockType: number;
+    /** AAD of this file's slots (path prefix encoded once at xOpen). */
+    aad: PageAad;
 }
 
 // ==========================================================================